@@ -0,0 +1,367 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "core/pic/tile.h"
+
+
+// Shared helpers for the standalone C++ benchmarks:
+//  - synthetic tile generation (random fields + uniform plasma)
+//  - repeated timing with mean/std/min statistics
+//  - minimal JSON output
+namespace bench {
+
+//--------------------------------------------------
+// command line parsing; arguments are given as --key value
+
+class Args {
+
+  std::vector<std::string> argv;
+
+  public:
+
+  Args(int argc, char** argv_) : argv(argv_ + 1, argv_ + argc) {}
+
+  bool has(const std::string& key) const
+  {
+    return std::find(argv.begin(), argv.end(), "--" + key) != argv.end();
+  }
+
+  template<typename T>
+  T get(const std::string& key, T def) const
+  {
+    auto it = std::find(argv.begin(), argv.end(), "--" + key);
+    if(it == argv.end() || std::next(it) == argv.end()) return def;
+
+    T val;
+    std::istringstream(*std::next(it)) >> val;
+    return val;
+  }
+
+};
+
+
+//--------------------------------------------------
+// synthetic tiles
+
+/// fill all E/B components, including halos, with random values of amplitude `amp`
+template<std::size_t D>
+void randomize_fields(emf::Tile<D>& tile, float amp, std::mt19937& rng)
+{
+  std::uniform_real_distribution<float> dist(-amp, amp);
+  auto& gs = tile.get_grids();
+
+  for(auto* m : {&gs.ex, &gs.ey, &gs.ez, &gs.bx, &gs.by, &gs.bz, &gs.jx, &gs.jy, &gs.jz}) {
+    float* ptr = m->data();
+    for(size_t i=0; i<m->size(); i++) ptr[i] = dist(rng);
+  }
+}
+
+/// set tile limits for tile with grid index `ind`; tiles are placed
+// next to each other with unit cell spacing starting from origin
+template<std::size_t D>
+void set_tile_limits(emf::Tile<D>& tile, std::array<int,3> ind = {0,0,0})
+{
+  for(size_t i=0; i<D; i++) {
+    tile.mins[i] = static_cast<double>( ind[i]*tile.mesh_lengths[i] );
+    tile.maxs[i] = static_cast<double>( (ind[i]+1)*tile.mesh_lengths[i] );
+  }
+}
+
+/// add two species (electrons and positrons) with `ppc` particles per cell
+// per species and thermal spread `uth`.
+//
+// Every other particle drifts along +z or -z with four-velocity `uz0`;
+// non-zero drift gives two counter-streaming beams (Weibel setup).
+template<std::size_t D>
+void inject_plasma(
+    pic::Tile<D>& tile,
+    int ppc,
+    float uth,
+    float uz0,
+    std::mt19937& rng)
+{
+  std::uniform_real_distribution<float> uni(0.0f, 1.0f);
+  std::normal_distribution<float> gauss(0.0f, uth);
+
+  const int nx = tile.mesh_lengths[0];
+  const int ny = tile.mesh_lengths[1];
+  const int nz = tile.mesh_lengths[2];
+  const float wgt = 1.0f/ppc;
+
+  const float x0 = tile.mins[0];
+  const float y0 = D >= 2 ? tile.mins[1] : 0.0f;
+  const float z0 = D >= 3 ? tile.mins[2] : 0.0f;
+
+  for(int ispc=0; ispc<2; ispc++) {
+
+    pic::ParticleContainer<D> con;
+    con.q = ispc == 0 ? -1.0 : 1.0;
+    con.m = 1.0;
+    con.type = ispc == 0 ? "e-" : "e+";
+    con.reserve(static_cast<size_t>(nx)*ny*nz*ppc);
+
+    for(int k=0; k<nz; k++)
+    for(int j=0; j<ny; j++)
+    for(int i=0; i<nx; i++) {
+      for(int n=0; n<ppc; n++) {
+        float x = x0 + i + uni(rng);
+        float y = D >= 2 ? y0 + j + uni(rng) : 0.0f;
+        float z = D >= 3 ? z0 + k + uni(rng) : 0.0f;
+
+        float ux = gauss(rng);
+        float uy = gauss(rng);
+        float uz = (n % 2 == 0 ? uz0 : -uz0) + gauss(rng);
+
+        con.add_particle({x, y, z}, {ux, uy, uz}, wgt);
+      }
+    }
+
+    tile.set_container(con);
+  }
+}
+
+
+/// snapshot of particle phase-space used to restore the tile between repeats
+template<std::size_t D>
+class ParticleState {
+
+  std::vector<std::vector<float>> locs, vels;
+
+  public:
+
+  void save(pic::Tile<D>& tile)
+  {
+    locs.clear();
+    vels.clear();
+    for(auto&& con : tile.containers) {
+      const size_t N = con.size();
+      std::vector<float> loc(3*N), vel(3*N);
+      for(size_t i=0; i<3; i++) {
+        std::copy(&con.loc(i,0), &con.loc(i,0) + N, loc.begin() + i*N);
+        std::copy(&con.vel(i,0), &con.vel(i,0) + N, vel.begin() + i*N);
+      }
+      locs.push_back(loc);
+      vels.push_back(vel);
+    }
+  }
+
+  void restore(pic::Tile<D>& tile) const
+  {
+    for(size_t c=0; c<tile.containers.size(); c++) {
+      auto& con = tile.containers[c];
+      const size_t N = con.size();
+      for(size_t i=0; i<3; i++) {
+        std::copy(locs[c].begin() + i*N, locs[c].begin() + (i+1)*N, &con.loc(i,0));
+        std::copy(vels[c].begin() + i*N, vels[c].begin() + (i+1)*N, &con.vel(i,0));
+      }
+    }
+  }
+
+};
+
+
+/// total number of particles in the tile
+template<std::size_t D>
+size_t num_particles(pic::Tile<D>& tile)
+{
+  size_t n = 0;
+  for(auto&& con : tile.containers) n += con.size();
+  return n;
+}
+
+
+//--------------------------------------------------
+// timing
+
+struct Result {
+  std::string name;
+  std::string group;
+  std::string unit;  // what is counted: "particles" or "cells"
+  size_t items = 0;  // items processed per call
+  int reps = 0;
+
+  double t_mean = 0.0;  // seconds per call
+  double t_std  = 0.0;
+  double t_min  = 0.0;
+
+  /// items per second based on the fastest repeat
+  double rate() const { return t_min > 0.0 ? items/t_min : 0.0; }
+};
+
+
+/// run `kernel` `warmup + reps` times; `reset` is called before every call
+// and is not included in the timing.
+template<typename F, typename R>
+Result measure(
+    const std::string& name,
+    const std::string& group,
+    const std::string& unit,
+    size_t items,
+    int warmup,
+    int reps,
+    F&& kernel,
+    R&& reset)
+{
+  using clock = std::chrono::steady_clock;
+
+  std::vector<double> ts;
+  ts.reserve(reps);
+
+  for(int r=0; r<warmup+reps; r++) {
+    reset();
+
+    auto t0 = clock::now();
+    kernel();
+    auto t1 = clock::now();
+
+    if(r >= warmup) ts.push_back( std::chrono::duration<double>(t1 - t0).count() );
+  }
+
+  Result res;
+  res.name  = name;
+  res.group = group;
+  res.unit  = unit;
+  res.items = items;
+  res.reps  = reps;
+
+  if(!ts.empty()) {
+    double sum = 0.0, sum2 = 0.0;
+    for(double t : ts) { sum += t; sum2 += t*t; }
+    res.t_mean = sum/ts.size();
+    res.t_std  = std::sqrt( std::max(0.0, sum2/ts.size() - res.t_mean*res.t_mean) );
+    res.t_min  = *std::min_element(ts.begin(), ts.end());
+  }
+
+  return res;
+}
+
+
+/// per-stage wall-clock timer
+//
+// Printing mimics pytools.Timer.comp_stats() so that the output can be
+// parsed with projects/scaling/perf_analysis.py
+class StageTimer {
+
+  using clock = std::chrono::steady_clock;
+
+  // insertion order of the stages
+  std::vector<std::string> names;
+  std::map<std::string, std::vector<double>> times;
+
+  clock::time_point t0;
+  std::string current;
+
+  public:
+
+  void start(const std::string& name)
+  {
+    if(times.find(name) == times.end()) {
+      names.push_back(name);
+      times[name] = {};
+    }
+    current = name;
+    t0 = clock::now();
+  }
+
+  void stop()
+  {
+    times[current].push_back( std::chrono::duration<double>(clock::now() - t0).count() );
+  }
+
+  /// mean time per call of stage
+  double mean(const std::string& name) const
+  {
+    auto& ts = times.at(name);
+    if(ts.empty()) return 0.0;
+    double sum = 0.0;
+    for(double t : ts) sum += t;
+    return sum/ts.size();
+  }
+
+  void print(std::ostream& out) const
+  {
+    double ttot = 0.0;
+    for(auto& [name, ts] : times) for(double t : ts) ttot += t;
+
+    char line[256];
+    double totper = 0.0;
+
+    out << "--------------------------------------------------------------------------------\n";
+    for(auto& name : names) {
+      auto& ts = times.at(name);
+      if(ts.empty()) continue;
+
+      double tsum = 0.0;
+      for(double t : ts) tsum += t;
+      const double tavg = tsum/ts.size();
+      const double relt = ttot > 0.0 ? 100.0*tsum/ttot : 0.0;
+      totper += relt;
+
+      if(tavg < 1.0e-5) {
+        std::snprintf(line, sizeof(line), "--- %-25.25s   %5.2f%%  |  time: %6.3f mus/%3zu    (%8.5e)\n",
+            name.c_str(), relt, tavg*1.0e6, ts.size(), tavg);
+      } else if(tavg < 1.0e-2) {
+        std::snprintf(line, sizeof(line), "--- %-25.25s   %5.2f%%  |  time: %6.3f ms /%3zu    (%8.5e)\n",
+            name.c_str(), relt, tavg*1.0e3, ts.size(), tavg);
+      } else {
+        std::snprintf(line, sizeof(line), "--- %-25.25s   %5.2f%%  |  time: %6.3f s  /%3zu    (%8.5e)\n",
+            name.c_str(), relt, tavg, ts.size(), tavg);
+      }
+      out << line;
+    }
+
+    std::snprintf(line, sizeof(line), "                            += %6.3f%% \n", totper);
+    out << line;
+    out << "--------------------------------------------------------------------------------\n";
+  }
+
+  /// clear timings but keep stage order
+  void purge()
+  {
+    for(auto& [name, ts] : times) ts.clear();
+  }
+
+};
+
+
+//--------------------------------------------------
+// output
+
+inline std::string to_json(const Result& r)
+{
+  std::ostringstream out;
+  out.precision(8);
+  out << "{\"name\": \"" << r.name << "\""
+      << ", \"group\": \"" << r.group << "\""
+      << ", \"unit\": \"" << r.unit << "\""
+      << ", \"items\": " << r.items
+      << ", \"reps\": " << r.reps
+      << ", \"t_mean\": " << r.t_mean
+      << ", \"t_std\": " << r.t_std
+      << ", \"t_min\": " << r.t_min
+      << ", \"rate\": " << r.rate()
+      << "}";
+  return out.str();
+}
+
+inline void print_row(const Result& r)
+{
+  std::cerr.precision(4);
+  std::cerr << "--- " << r.group << "/" << r.name
+            << "   " << r.t_mean*1.0e3 << " +- " << r.t_std*1.0e3 << " ms"
+            << "   " << r.rate()/1.0e6 << " M" << r.unit << "/s\n";
+}
+
+} // end of namespace bench
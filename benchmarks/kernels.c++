@@ -0,0 +1,389 @@
+// Kernel-level micro-benchmarks of the PIC and EMF solvers.
+//
+// Builds a single synthetic tile with random fields and a two-species
+// uniform plasma and times every pusher, interpolator, depositer, field
+// propagator, and current filter on it. Results are written as JSON
+// (particles/s or cells/s per kernel) to stdout or to --out.
+//
+// usage:
+//   bin/bench-kernels --dim 3 --nx 32 --ny 32 --nz 32 --ppc 16 --reps 10 --out kernels.json
+//
+// Options:
+//   --dim      spatial dimensionality (1, 2, or 3)
+//   --nx/ny/nz tile size in cells
+//   --ppc      particles per cell per species
+//   --reps     timed repeats per kernel; --warmup untimed repeats
+//   --only     run only kernels whose name contains this substring
+//   --seed     random number seed
+
+#include <iostream>
+#include <memory>
+#include <functional>
+
+#include "benchmarks/bench.h"
+
+#include "core/pic/pushers/boris.h"
+#include "core/pic/pushers/boris_drag.h"
+#include "core/pic/pushers/boris_rad.h"
+#include "core/pic/pushers/boris_grav.h"
+#include "core/pic/pushers/vay.h"
+#include "core/pic/pushers/higuera_cary.h"
+#include "core/pic/pushers/rgca.h"
+#include "core/pic/pushers/photon.h"
+#include "core/pic/pushers/pulsar.h"
+#include "core/pic/pushers/push_zigzag.h"
+
+#include "core/pic/interpolators/linear_1st.h"
+#include "core/pic/interpolators/quadratic_2nd.h"
+#include "core/pic/interpolators/cubic_3rd.h"
+#include "core/pic/interpolators/quartic_4th.h"
+
+#include "core/pic/depositers/zigzag.h"
+#include "core/pic/depositers/zigzag_2nd.h"
+#include "core/pic/depositers/zigzag_3rd.h"
+#include "core/pic/depositers/zigzag_4th.h"
+#include "core/pic/depositers/esikerpov_2nd.h"
+#include "core/pic/depositers/esikerpov_4th.h"
+
+#include "core/emf/propagators/fdtd2.h"
+#include "core/emf/propagators/fdtd4.h"
+#include "core/emf/propagators/fdtd_general.h"
+#include "core/emf/propagators/fdtd_stencil.h"
+
+#include "core/emf/filters/binomial2.h"
+#include "core/emf/filters/general_binomial.h"
+#include "core/emf/filters/strided_binomial.h"
+#include "core/emf/filters/compensator.h"
+#ifdef RUNKO_FFTW
+#include "core/emf/filters/fourier.h"
+#endif
+
+
+struct Config {
+  int dim    = 3;
+  int nx     = 32;
+  int ny     = 32;
+  int nz     = 32;
+  int ppc    = 16;
+  int reps   = 10;
+  int warmup = 2;
+  int seed   = 42;
+  std::string only;
+  std::string out;
+};
+
+
+template<std::size_t D>
+class Suite {
+
+  public:
+
+  Config conf;
+  std::vector<bench::Result> results;
+
+  pic::Tile<D> tile;
+  bench::ParticleState<D> state;
+
+  size_t nprtcls = 0;
+  size_t ncells  = 0;
+
+  Suite(const Config& conf) :
+    conf(conf),
+    tile(conf.nx, D >= 2 ? conf.ny : 1, D >= 3 ? conf.nz : 1)
+  {
+    std::mt19937 rng(conf.seed);
+
+    tile.cfl = 0.45;
+    bench::set_tile_limits(tile);
+    bench::randomize_fields(tile, 0.1f, rng);
+    bench::inject_plasma(tile, conf.ppc, 0.1f, 0.0f, rng);
+
+    state.save(tile);
+
+    nprtcls = bench::num_particles(tile);
+    ncells  = static_cast<size_t>(tile.mesh_lengths[0])*tile.mesh_lengths[1]*tile.mesh_lengths[2];
+  }
+
+  bool selected(const std::string& name) const
+  {
+    return conf.only.empty() || name.find(conf.only) != std::string::npos;
+  }
+
+  void add(const bench::Result& res)
+  {
+    bench::print_row(res);
+    results.push_back(res);
+  }
+
+  //--------------------------------------------------
+  void pusher(const std::string& name, pic::Pusher<D,3>& pusher)
+  {
+    if(!selected(name)) return;
+
+    // pushers read the interpolated fields
+    pic::LinearInterpolator<D,3> intp;
+    intp.solve(tile);
+
+    add( bench::measure(name, "pusher", "particles", nprtcls, conf.warmup, conf.reps,
+          [&](){ pusher.solve(tile); },
+          [&](){ state.restore(tile); }) );
+  }
+
+  void interpolator(const std::string& name, pic::Interpolator<D,3>& intp)
+  {
+    if(!selected(name)) return;
+
+    add( bench::measure(name, "interpolator", "particles", nprtcls, conf.warmup, conf.reps,
+          [&](){ intp.solve(tile); },
+          [&](){ state.restore(tile); }) );
+  }
+
+  // depositers reconstruct the previous location from the velocity so
+  // particle state is restored to the (pushed) initial state every time
+  void depositer(const std::string& name, pic::Depositer<D,3>& dep)
+  {
+    if(!selected(name)) return;
+
+    add( bench::measure(name, "depositer", "particles", nprtcls, conf.warmup, conf.reps,
+          [&](){ dep.solve(tile); },
+          [&](){ state.restore(tile); }) );
+  }
+
+  // fused pusher-depositers read the interpolated fields like the pushers
+  // and restore the particles like the depositers
+  template<typename F>
+  void fused(const std::string& name, F& step)
+  {
+    if(!selected(name)) return;
+
+    pic::LinearInterpolator<D,3> intp;
+    intp.solve(tile);
+
+    add( bench::measure(name, "fused", "particles", nprtcls, conf.warmup, conf.reps,
+          [&](){ step.solve(tile); },
+          [&](){ state.restore(tile); }) );
+  }
+
+  void propagator(const std::string& name, emf::Propagator<D>& fld)
+  {
+    if(!selected(name + "_e") && !selected(name + "_b")) return;
+
+    add( bench::measure(name + "_e", "propagator", "cells", ncells, conf.warmup, conf.reps,
+          [&](){ fld.push_e(tile); }, [](){}) );
+
+    add( bench::measure(name + "_b", "propagator", "cells", ncells, conf.warmup, conf.reps,
+          [&](){ fld.push_half_b(tile); }, [](){}) );
+  }
+
+  // temporally blocked propagators advance several full steps per call;
+  // cells are counted once per step
+  template<typename F>
+  void steps(const std::string& name, F& fld)
+  {
+    if(!selected(name)) return;
+
+    add( bench::measure(name, "propagator", "cells", ncells*fld.max_steps, conf.warmup, conf.reps,
+          [&](){ fld.push_steps(tile, fld.max_steps); }, [](){}) );
+  }
+
+  void filter(const std::string& name, emf::Filter<D>& flt)
+  {
+    if(!selected(name)) return;
+
+    add( bench::measure(name, "filter", "cells", ncells, conf.warmup, conf.reps,
+          [&](){ flt.solve(tile); }, [](){}) );
+  }
+
+  //--------------------------------------------------
+  void run()
+  {
+    const int nx = tile.mesh_lengths[0];
+    const int ny = tile.mesh_lengths[1];
+    const int nz = tile.mesh_lengths[2];
+
+    // pushers
+    { pic::BorisPusher<D,3> p;        pusher("BorisPusher", p); }
+    { pic::VayPusher<D,3> p;          pusher("VayPusher", p); }
+    { pic::HigueraCaryPusher<D,3> p;  pusher("HigueraCaryPusher", p); }
+    { pic::BorisPusherFloat<D,3> p;   pusher("BorisPusherFloat", p); }
+    { pic::VayPusherFloat<D,3> p;     pusher("VayPusherFloat", p); }
+    { pic::HigueraCaryPusherFloat<D,3> p; pusher("HigueraCaryPusherFloat", p); }
+    { pic::rGCAPusher<D,3> p;         pusher("rGCAPusher", p); }
+    { pic::PhotonPusher<D,3> p;       pusher("PhotonPusher", p); }
+
+    {
+      pic::BorisPusherDrag<D,3> p;
+      p.drag = 1.0e-3;
+      p.temp = 0.0;
+      pusher("BorisPusherDrag", p);
+    }
+
+    {
+      pic::BorisPusherRad<D,3> p;
+      p.drag = 1.0e-3;
+      p.beam_locx = 0.5*nx;
+      pusher("BorisPusherRad", p);
+    }
+
+    {
+      pic::BorisPusherGrav<D,3> p;
+      p.g0 = 1.0e-3;
+      p.cenx = 0.5*nx;
+      pusher("BorisPusherGrav", p);
+    }
+
+    {
+      // star is placed at the tile corner so that particles sit outside of it
+      pic::PulsarPusher<D,3> p;
+      p.rad_star = 1.0;
+      p.rad_pcap = 0.5;
+      p.period_star = 100.0;
+      p.cenx = -2.0;
+      p.ceny = D >= 2 ? -2.0 : 0.0;
+      p.cenz = D >= 3 ? -2.0 : 0.0;
+      pusher("PulsarPusher", p);
+    }
+
+    // interpolators
+    { pic::LinearInterpolator<D,3> i; interpolator("LinearInterpolator", i); }
+    { pic::LinearInterpolator<D,3> i; i.collocated = true; interpolator("LinearInterpolatorCollocated", i); }
+    { pic::LinearInterpolator<D,3> i; i.collocated = true; i.bricked = true; interpolator("LinearInterpolatorBricked", i); }
+    if constexpr (D >= 2) {
+      { pic::QuadraticInterpolator<D> i; interpolator("QuadraticInterpolator", i); }
+      { pic::CubicInterpolator<D>     i; interpolator("CubicInterpolator", i); }
+      { pic::QuarticInterpolator<D>   i; interpolator("QuarticInterpolator", i); }
+    }
+
+    // depositers
+    { pic::ZigZag<D,3>     d; depositer("ZigZag", d); }
+    { pic::ZigZag_2nd<D,3> d; depositer("ZigZag_2nd", d); }
+    { pic::ZigZag_3rd<D,3> d; depositer("ZigZag_3rd", d); }
+    { pic::ZigZag_4th<D,3> d; depositer("ZigZag_4th", d); }
+    if constexpr (D == 3) {
+      { pic::Esikerpov_2nd<D,3> d; depositer("Esikerpov_2nd", d); }
+      { pic::Esikerpov_4th<D,3> d; depositer("Esikerpov_4th", d); }
+    }
+
+    // fused push + deposit; compare to BorisPusher + ZigZag
+    { pic::BorisZigZag<D,3> p; fused("BorisZigZag", p); }
+
+    // field propagators
+    { emf::FDTD2<D> f; propagator("FDTD2", f); }
+    { emf::FDTD2<D> f; steps("FDTD2_steps", f); }
+    if(selected("FDTD2_fused")) {
+      emf::FDTD2<D> f;
+      add( bench::measure("FDTD2_fused", "propagator", "cells", ncells, conf.warmup, conf.reps,
+            [&](){ f.push_fused(tile); }, [](){}) );
+    }
+    if constexpr (D >= 2) {
+      { emf::FDTD4<D> f; propagator("FDTD4", f); }
+      { emf::FDTD4<D> f; f.coeff1 = 9.0/8.0 + 1.0e-12; propagator("FDTD4_runtime", f); }
+      { emf::FDTDPukhov<D> f; propagator("FDTDPukhov", f); }
+    }
+    if constexpr (D == 3) {
+      { emf::FDTDGen<D> f; propagator("FDTDGen", f); }
+    }
+
+    // current filters
+    { emf::Binomial2<D> f(nx, ny, nz); filter("Binomial2", f); }
+    if constexpr (D >= 2) {
+      { emf::General3p<D>         f(nx, ny, nz); filter("General3p", f); }
+      { emf::General3pStrided<D>  f(nx, ny, nz); f.stride = 2; filter("General3pStrided", f); }
+      { emf::Compensator2<D>      f(nx, ny, nz); filter("Compensator2", f); }
+      { emf::MultiBinomial2<D>    f(nx, ny, nz); f.npasses = 3; filter("MultiBinomial2", f); }
+#ifdef RUNKO_FFTW
+      { emf::Fourier<D>           f(nx, ny, nz); f.set_kernel(emf::fourier::binomial(3)); filter("Fourier", f); }
+#endif
+    }
+    if constexpr (D == 2) {
+      { emf::Binomial2Strided2<D> f(nx, ny, nz); filter("Binomial2Strided2", f); }
+    }
+
+    // interpolators and depositers on cell-block sorted particles; last
+    // since sorting changes the particle order seen by all other kernels
+    tile.sort_in_cell_blocks(2);
+    state.save(tile);
+    { pic::LinearInterpolator<D,3> i; interpolator("LinearInterpolatorBlocked", i); }
+    if constexpr (D >= 2) {
+      { pic::QuadraticInterpolator<D> i; interpolator("QuadraticInterpolatorBlocked", i); }
+      { pic::QuarticInterpolator<D>   i; interpolator("QuarticInterpolatorBlocked", i); }
+    }
+    { pic::ZigZag<D,3> d; depositer("ZigZagBlocked", d); }
+    { pic::BorisZigZag<D,3> p; fused("BorisZigZagBlocked", p); }
+    if constexpr (D == 3) {
+      { pic::Esikerpov_2nd<D,3> d; depositer("Esikerpov_2ndBlocked", d); }
+      { pic::Esikerpov_4th<D,3> d; depositer("Esikerpov_4thBlocked", d); }
+    }
+  }
+
+  //--------------------------------------------------
+  void write(std::ostream& out) const
+  {
+    out << "{\n";
+    out << "  \"config\": {\"dim\": " << D
+        << ", \"nx\": " << tile.mesh_lengths[0]
+        << ", \"ny\": " << tile.mesh_lengths[1]
+        << ", \"nz\": " << tile.mesh_lengths[2]
+        << ", \"ppc\": " << conf.ppc
+        << ", \"particles\": " << nprtcls
+        << ", \"cells\": " << ncells
+        << ", \"reps\": " << conf.reps
+        << ", \"warmup\": " << conf.warmup
+        << "},\n";
+    out << "  \"results\": [\n";
+    for(size_t i=0; i<results.size(); i++) {
+      out << "    " << bench::to_json(results[i]);
+      out << (i+1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+  }
+
+};
+
+
+template<std::size_t D>
+int run_suite(const Config& conf)
+{
+  Suite<D> suite(conf);
+  suite.run();
+
+  if(conf.out.empty()) {
+    suite.write(std::cout);
+  } else {
+    std::ofstream out(conf.out);
+    suite.write(out);
+  }
+
+  return 0;
+}
+
+
+int main(int argc, char** argv)
+{
+  bench::Args args(argc, argv);
+
+  if(args.has("help")) {
+    std::cout << "usage: bench-kernels [--dim 3] [--nx 32] [--ny 32] [--nz 32] [--ppc 16]"
+              << " [--reps 10] [--warmup 2] [--only name] [--seed 42] [--out file.json]\n";
+    return 0;
+  }
+
+  Config conf;
+  conf.dim    = args.get("dim",    conf.dim);
+  conf.nx     = args.get("nx",     conf.nx);
+  conf.ny     = args.get("ny",     conf.ny);
+  conf.nz     = args.get("nz",     conf.nz);
+  conf.ppc    = args.get("ppc",    conf.ppc);
+  conf.reps   = args.get("reps",   conf.reps);
+  conf.warmup = args.get("warmup", conf.warmup);
+  conf.seed   = args.get("seed",   conf.seed);
+  conf.only   = args.get("only",   conf.only);
+  conf.out    = args.get("out",    conf.out);
+
+  if(conf.dim == 1) return run_suite<1>(conf);
+  if(conf.dim == 2) return run_suite<2>(conf);
+  if(conf.dim == 3) return run_suite<3>(conf);
+
+  std::cerr << "bench-kernels: unsupported dimension " << conf.dim << "\n";
+  return 1;
+}
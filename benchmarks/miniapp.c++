@@ -0,0 +1,471 @@
+// PIC mini-app for weak and strong scaling studies without python.
+//
+// Runs the same per-lap stage sequence as projects/pic-turbulence/pic.py
+// (FDTD2 + LinearInterpolator + BorisPusher + ZigZag + Binomial2) on a
+// periodic box filled with a uniform pair plasma or with two counter-
+// streaming beams (Weibel instability). Per-stage timings are printed every
+// --interval laps in the pytools.Timer format so that the output can be
+// analyzed with projects/scaling/perf_analysis.py.
+//
+// usage:
+//   mpirun -np 4 bin/miniapp --dim 2 --nx 8 --ny 8 --nxm 32 --nym 32 --ppc 16 --laps 100
+//
+// Options:
+//   --dim          spatial dimensionality (2 or 3)
+//   --nx/ny/nz     number of tiles
+//   --nxm/nym/nzm  tile size in cells
+//   --ppc          particles per cell per species
+//   --setup        uniform | weibel
+//   --laps         number of laps; --interval laps between timing reports
+//   --npasses      number of current filter passes
+//   --threads      OpenMP threads per rank (default: OMP_NUM_THREADS)
+//   --seed         random number seed
+//   --fused        push and deposit in one sweep (pic::BorisZigZag)
+//   --fused-fields one FDTD2::push_fused sweep and one exchange per lap
+//   --ghosts       virtual tiles are pic::GhostTiles (fields + particle messages)
+//
+// Weak scaling: keep tiles per rank fixed and grow --nx/--ny/--nz with the
+// rank count. Strong scaling: keep the box fixed and grow the rank count.
+// Tiles are distributed along a Hilbert curve if the tile counts are powers
+// of 2 and in x-stripes otherwise.
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <mpi.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "benchmarks/bench.h"
+
+#include "external/corgi/corgi.h"
+#include "tools/hilbert.h"
+
+#include "core/pic/ghost_tile.h"
+
+#include "core/pic/pushers/boris.h"
+#include "core/pic/pushers/push_zigzag.h"
+#include "core/pic/interpolators/linear_1st.h"
+#include "core/pic/depositers/zigzag.h"
+#include "core/emf/propagators/fdtd2.h"
+#include "core/emf/filters/binomial2.h"
+
+
+struct Config {
+  int dim = 2;
+  int nx  = 4;
+  int ny  = 4;
+  int nz  = 1;
+  int nxm = 32;
+  int nym = 32;
+  int nzm = 1;
+  int ppc = 16;
+  int laps     = 100;
+  int interval = 10;
+  int npasses  = 8;
+  int threads  = 0;
+  int seed     = 42;
+  double cfl   = 0.45;
+  std::string setup = "uniform";
+  bool fused = false;
+  bool fused_fields = false;
+  bool ghosts = false;
+};
+
+
+inline bool is_pow2(int n) { return n > 0 && (n & (n - 1)) == 0; }
+
+inline int ilog2(int n) { int m = 0; while(n >>= 1) m++; return m; }
+
+
+template<std::size_t D>
+class MiniApp {
+
+  using Tile_t = pic::Tile<D>;
+  using Ghost_t = pic::GhostTile<D>;
+
+  public:
+
+  Config conf;
+  corgi::Grid<D> grid;
+  bench::StageTimer timer;
+
+  int rank = 0;
+  int size = 1;
+
+  MiniApp(const Config& conf) :
+    conf(conf),
+    grid( make_grid(conf) )
+  {
+    rank = grid.rank();
+    size = grid.size();
+
+    std::array<double, D> gmins, gmaxs;
+    const std::array<int,3> ntiles = {conf.nx, conf.ny, conf.nz};
+    const std::array<int,3> nmesh  = {conf.nxm, conf.nym, conf.nzm};
+    for(size_t i=0; i<D; i++) {
+      gmins[i] = 0.0;
+      gmaxs[i] = static_cast<double>( ntiles[i]*nmesh[i] );
+    }
+    grid.set_grid_lims(gmins, gmaxs);
+  }
+
+  static corgi::Grid<D> make_grid(const Config& conf)
+  {
+    if constexpr (D == 2) return corgi::Grid<D>(conf.nx, conf.ny);
+    if constexpr (D == 3) return corgi::Grid<D>(conf.nx, conf.ny, conf.nz);
+  }
+
+  //--------------------------------------------------
+  // domain decomposition
+
+  /// owner rank of tile (i,j,k)
+  int owner(int i, int j, int k) const
+  {
+    const bool hilb = is_pow2(conf.nx) && is_pow2(conf.ny) && (D == 2 || is_pow2(conf.nz));
+
+    if(hilb) {
+      // curve visits every tile once so indices run from 0 to ntiles-1
+      unsigned int hind = 0;
+      double ntiles = 1.0;
+      if constexpr (D == 2) {
+        hilbert::Hilbert2D hgen( ilog2(conf.nx), ilog2(conf.ny) );
+        hind = hgen.hindex(i, j);
+        ntiles = static_cast<double>(conf.nx)*conf.ny;
+      } else {
+        hilbert::Hilbert3D hgen( ilog2(conf.nx), ilog2(conf.ny), ilog2(conf.nz) );
+        hind = hgen.hindex(i, j, k);
+        ntiles = static_cast<double>(conf.nx)*conf.ny*conf.nz;
+      }
+      return static_cast<int>( std::floor( size*static_cast<double>(hind)/ntiles ) );
+    }
+
+    return static_cast<int>( std::floor( size*static_cast<double>(i)/conf.nx ) );
+  }
+
+  /// set tile limits, cfl, and (empty) species of a new tile
+  void initialize_tile(Tile_t& tile, std::array<int,3> ind)
+  {
+    tile.cfl = conf.cfl;
+    bench::set_tile_limits(tile, ind);
+
+    for(int ispc=0; ispc<2; ispc++) {
+      pic::ParticleContainer<D> con;
+      con.q = ispc == 0 ? -1.0 : 1.0;
+      con.m = 1.0;
+      con.type = ispc == 0 ? "e-" : "e+";
+      tile.set_container(con);
+    }
+  }
+
+  void load_tiles()
+  {
+    // every rank computes the same decomposition; bcast keeps corgi in sync
+    for(int k=0; k<(D == 3 ? conf.nz : 1); k++)
+    for(int j=0; j<conf.ny; j++)
+    for(int i=0; i<conf.nx; i++) {
+      if constexpr (D == 2) grid.set_mpi_grid(i, j, owner(i,j,k));
+      if constexpr (D == 3) grid.set_mpi_grid(i, j, k, owner(i,j,k));
+    }
+    grid.bcast_mpi_grid();
+
+    std::mt19937 rng(conf.seed + rank);
+    const float uth = 0.1f;
+    const float uz0 = conf.setup == "weibel" ? 0.5f : 0.0f;
+
+    for(int k=0; k<(D == 3 ? conf.nz : 1); k++)
+    for(int j=0; j<conf.ny; j++)
+    for(int i=0; i<conf.nx; i++) {
+      if(owner(i,j,k) != rank) continue;
+
+      auto tile = std::make_shared<Tile_t>(conf.nxm, conf.nym, D == 3 ? conf.nzm : 1);
+      bench::set_tile_limits(*tile, {i,j,k});
+      bench::inject_plasma(*tile, conf.ppc, uth, uz0, rng);
+      tile->cfl = conf.cfl;
+
+      if constexpr (D == 2) grid.add_tile(tile, {i, j});
+      if constexpr (D == 3) grid.add_tile(tile, {i, j, k});
+    }
+
+    grid.analyze_boundaries();
+    grid.send_tiles();
+    grid.recv_tiles();
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    // replace received corgi tiles with pic (or ghost) tiles;
+    // load_metainfo has to be after add_tile because add_tile modifies tile content
+    for(auto cid : grid.get_virtual_tiles()) {
+      auto& orig = grid.get_tile(cid);
+      auto ind  = orig.index;
+      auto comm = orig.communication;
+
+      std::array<int,3> ind3 = {0,0,0};
+      ind3[0] = std::get<0>(ind);
+      ind3[1] = std::get<1>(ind);
+      if constexpr (D == 3) ind3[2] = std::get<2>(ind);
+
+      if(conf.ghosts) {
+        auto tile = std::make_shared<Ghost_t>(conf.nxm, conf.nym, D == 3 ? conf.nzm : 1, 2);
+        grid.add_tile(tile, ind);
+        tile->load_metainfo(comm);
+
+        tile->cfl = conf.cfl;
+        bench::set_tile_limits(*tile, ind3);
+        continue;
+      }
+
+      auto tile = std::make_shared<Tile_t>(conf.nxm, conf.nym, D == 3 ? conf.nzm : 1);
+      grid.add_tile(tile, ind);
+      tile->load_metainfo(comm);
+      initialize_tile(*tile, ind3);
+    }
+  }
+
+  //--------------------------------------------------
+  // stage helpers
+
+  Tile_t& tile(uint64_t cid) { return dynamic_cast<Tile_t&>( grid.get_tile(cid) ); }
+
+  template<typename F>
+  void local(const std::string& name, F&& f)
+  {
+    timer.start(name);
+    for(auto cid : grid.get_local_tiles()) f(tile(cid));
+    timer.stop();
+  }
+
+  template<typename F>
+  void boundary(const std::string& name, F&& f)
+  {
+    timer.start(name);
+    for(auto cid : grid.get_boundary_tiles()) f(tile(cid));
+    timer.stop();
+  }
+
+  Ghost_t& ghost(uint64_t cid) { return dynamic_cast<Ghost_t&>( grid.get_tile(cid) ); }
+
+  /// f is called with either Tile_t& or Ghost_t& (--ghosts)
+  template<typename F>
+  void virtuals(const std::string& name, F&& f)
+  {
+    timer.start(name);
+    for(auto cid : grid.get_virtual_tiles()) {
+      if(conf.ghosts) f(ghost(cid));
+      else            f(tile(cid));
+    }
+    timer.stop();
+  }
+
+  void mpi(const std::string& name, int mode)
+  {
+    timer.start(name);
+    grid.send_data(mode);
+    grid.recv_data(mode);
+    grid.wait_data(mode);
+    timer.stop();
+  }
+
+  //--------------------------------------------------
+  void run()
+  {
+    emf::FDTD2<D> fldprop;
+    pic::BorisPusher<D,3> pusher;
+    pic::LinearInterpolator<D,3> fintp;
+    pic::ZigZag<D,3> currint;
+    pic::BorisZigZag<D,3> pushdep;
+    emf::Binomial2<D> flt(conf.nxm, conf.nym, D == 3 ? conf.nzm : 1);
+
+    if(rank == 0) {
+      std::cout << "miniapp: dim " << D
+        << " tiles " << conf.nx << "x" << conf.ny << "x" << (D == 3 ? conf.nz : 1)
+        << " mesh "  << conf.nxm << "x" << conf.nym << "x" << (D == 3 ? conf.nzm : 1)
+        << " ppc "   << conf.ppc
+        << " setup " << conf.setup
+        << " ranks " << size;
+      if(conf.ghosts) std::cout << " ghosts";
+#ifdef _OPENMP
+      std::cout << " threads " << omp_get_max_threads();
+#endif
+      std::cout << "\n";
+    }
+
+    // the fused field lap is shifted by half a B step; B^{1/2} first
+    if(conf.fused_fields) {
+      mpi("mpi_b0", 2);
+      mpi("mpi_e0", 1);
+      local("upd_bc", [&](Tile_t& t){ t.update_boundaries(grid, {1,2}); });
+      local("push_half_b1", [&](Tile_t& t){ fldprop.push_half_b(t); });
+      mpi("mpi_b1", 2);
+      local("upd_bc", [&](Tile_t& t){ t.update_boundaries(grid, {2}); });
+    }
+
+    double time = 0.0;
+    for(int lap=1; lap<=conf.laps; lap++) {
+
+      if(!conf.fused_fields) {
+        //--------------------------------------------------
+        // comm E and B
+        mpi("mpi_b0", 2);
+        mpi("mpi_e0", 1);
+        local("upd_bc", [&](Tile_t& t){ t.update_boundaries(grid, {1,2}); });
+
+        //--------------------------------------------------
+        // push B half
+        local("push_half_b1", [&](Tile_t& t){ fldprop.push_half_b(t); });
+        mpi("mpi_b1", 2);
+        local("upd_bc", [&](Tile_t& t){ t.update_boundaries(grid, {2}); });
+      }
+
+      //--------------------------------------------------
+      // move particles
+      local("interp_em", [&](Tile_t& t){ fintp.solve(t); });
+      if(conf.fused) {
+        // currents are deposited by the push; exchanged after the particles
+        local("push_curr", [&](Tile_t& t){ pushdep.solve(t); });
+      } else {
+        local("push",      [&](Tile_t& t){ pusher.solve(t); });
+        local("clear_cur", [&](Tile_t& t){ t.clear_current(); });
+      }
+
+      //--------------------------------------------------
+      // push B half and E
+      if(!conf.fused_fields) {
+        local("push_half_b2", [&](Tile_t& t){ fldprop.push_half_b(t); });
+        mpi("mpi_b2", 2);
+        local("upd_bc", [&](Tile_t& t){ t.update_boundaries(grid, {2}); });
+        local("push_e", [&](Tile_t& t){ fldprop.push_e(t); });
+      }
+
+      //--------------------------------------------------
+      // particle communication
+      local("check_outg_prtcls",  [&](Tile_t& t){ t.check_outgoing_particles(); });
+      boundary("pack_outg_prtcls", [&](Tile_t& t){ t.pack_outgoing_particles(); });
+
+      timer.start("mpi_prtcls");
+      grid.send_data(3);
+      grid.recv_data(3);
+      grid.wait_data(3);
+      grid.send_data(4);
+      grid.recv_data(4);
+      grid.wait_data(4);
+      timer.stop();
+
+      virtuals("unpack_vir_prtcls",     [&](auto& t){ t.unpack_incoming_particles(); });
+      virtuals("check_outg_vir_prtcls", [&](auto& t){ t.check_outgoing_particles(); });
+      local("get_inc_prtcls",     [&](Tile_t& t){ t.get_incoming_particles(grid); });
+      local("del_trnsfrd_prtcls", [&](Tile_t& t){ t.delete_transferred_particles(); });
+      virtuals("del_vir_prtcls",  [&](auto& t){ t.delete_all_particles(); });
+
+      //--------------------------------------------------
+      // current calculation
+      if(!conf.fused) local("comp_curr", [&](Tile_t& t){ currint.solve(t); });
+      virtuals("clear_vir_cur", [&](auto& t){ t.clear_current(); });
+      mpi("mpi_cur", 0);
+      local("cur_exchange", [&](Tile_t& t){ t.exchange_currents(grid); });
+
+      //--------------------------------------------------
+      // filter
+      for(int fj=0; fj<conf.npasses; fj++) {
+        if(fj % 2 == 0) {
+          mpi("mpi_cur_flt", 0);
+          local("upd_bc", [&](Tile_t& t){ t.update_boundaries(grid, {0}); });
+          MPI_Barrier(MPI_COMM_WORLD);
+        }
+        local("filter", [&](Tile_t& t){ flt.solve(t); });
+      }
+
+      //--------------------------------------------------
+      // add current to E
+      if(conf.fused_fields) {
+        // B half, E with the current, and B half of the next lap after a
+        // single exchange of J, E, and B
+        mpi("mpi_j1", 0);
+        mpi("mpi_e1", 1);
+        mpi("mpi_b1", 2);
+        local("upd_bc", [&](Tile_t& t){ t.update_boundaries(grid, {0,1,2}); });
+        local("push_fused", [&](Tile_t& t){ fldprop.push_fused(t); });
+      } else {
+        local("add_cur", [&](Tile_t& t){ t.deposit_current(); });
+      }
+
+      time += conf.cfl;
+
+      //--------------------------------------------------
+      if(lap % conf.interval == 0) {
+        if(rank == 0) {
+          std::cout << "--------------------------------------------------\n";
+          std::cout << "------ lap: " << lap << " / t: " << time << "\n";
+          timer.print(std::cout);
+          std::cout << std::flush;
+        }
+        timer.purge();
+      }
+    }
+  }
+
+};
+
+
+template<std::size_t D>
+int run_app(const Config& conf)
+{
+  MiniApp<D> app(conf);
+  app.load_tiles();
+  app.run();
+  return 0;
+}
+
+
+int main(int argc, char** argv)
+{
+  int provided;
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
+
+  bench::Args args(argc, argv);
+
+  if(args.has("help")) {
+    std::cout << "usage: miniapp [--dim 2] [--nx 4] [--ny 4] [--nz 1] [--nxm 32] [--nym 32] [--nzm 1]"
+              << " [--ppc 16] [--setup uniform|weibel] [--laps 100] [--interval 10]"
+              << " [--npasses 8] [--threads 0] [--seed 42] [--fused] [--fused-fields] [--ghosts]\n";
+    MPI_Finalize();
+    return 0;
+  }
+
+  Config conf;
+  conf.dim      = args.get("dim",      conf.dim);
+  conf.nx       = args.get("nx",       conf.nx);
+  conf.ny       = args.get("ny",       conf.ny);
+  conf.nz       = args.get("nz",       conf.nz);
+  conf.nxm      = args.get("nxm",      conf.nxm);
+  conf.nym      = args.get("nym",      conf.nym);
+  conf.nzm      = args.get("nzm",      conf.nzm);
+  conf.ppc      = args.get("ppc",      conf.ppc);
+  conf.laps     = args.get("laps",     conf.laps);
+  conf.interval = args.get("interval", conf.interval);
+  conf.npasses  = args.get("npasses",  conf.npasses);
+  conf.threads  = args.get("threads",  conf.threads);
+  conf.seed     = args.get("seed",     conf.seed);
+  conf.setup    = args.get("setup",    conf.setup);
+  conf.fused    = args.has("fused");
+  conf.fused_fields = args.has("fused-fields");
+  conf.ghosts   = args.has("ghosts");
+
+#ifdef _OPENMP
+  if(conf.threads > 0) omp_set_num_threads(conf.threads);
+#endif
+
+  int ret = 1;
+  if(conf.dim == 2) {
+    ret = run_app<2>(conf);
+  } else if(conf.dim == 3) {
+    ret = run_app<3>(conf);
+  } else {
+    std::cerr << "miniapp: unsupported dimension " << conf.dim << "\n";
+  }
+
+  MPI_Finalize();
+  return ret;
+}
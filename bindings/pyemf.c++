@@ -1,5 +1,6 @@
 #include <string>
 #include <pybind11/numpy.h>
+#include <pybind11/functional.h>
 
 #include "py_submodules.h"
 
@@ -15,6 +16,7 @@
 #include "core/emf/propagators/fdtd2_pml.h"
 #include "core/emf/propagators/fdtd4.h"
 #include "core/emf/propagators/fdtd_general.h"
+#include "core/emf/propagators/fdtd_stencil.h"
 
 #include "core/emf/filters/filter.h"
 #include "core/emf/filters/binomial2.h"
@@ -22,6 +24,9 @@
 #include "core/emf/filters/strided_binomial.h"
 #include "core/emf/filters/general_binomial.h"
 #include "core/emf/filters/sweeping_binomial.h"
+#ifdef RUNKO_FFTW
+#include "core/emf/filters/fourier.h"
+#endif
 
 
 #include "core/emf/boundaries/damping_tile.h"
@@ -63,6 +68,10 @@ auto declare_tile(
     .def("update_boundaries",   &emf::Tile<D>::update_boundaries,
             py::arg("grid"),
             py::arg("iarr")=iarr)
+    .def("has_background",      &emf::Tile<D>::has_background)
+    .def("release_background",  &emf::Tile<D>::release_background)
+    .def("get_background",      &emf::Tile<D>::get_background,
+        py::return_value_policy::reference_internal)
     .def("get_grids",             &emf::Tile<D>::get_grids,
         py::arg("i")=0,
         py::return_value_policy::reference,
@@ -89,6 +98,15 @@ auto declare_TileDamped(
   // does not function properly; maybe not triggering template?
   // have to use explicit name instead like this
 
+  // reference fields are allocated on first access
+  using Ref = toolbox::Mesh<float,1> emf::damping::Tile<D,S>::*;
+  auto get_ref = [](Ref f) { 
+    return [f](emf::damping::Tile<D,S>& t) -> toolbox::Mesh<float,1>& { t.alloc_refs(); return t.*f; };
+  };
+  auto set_ref = [](Ref f) { 
+    return [f](emf::damping::Tile<D,S>& t, const toolbox::Mesh<float,1>& m) { t.*f = m; };
+  };
+
   return py::class_<
              emf::damping::Tile<D,S>,
              emf::Tile<D>,
@@ -99,15 +117,16 @@ auto declare_TileDamped(
             py::multiple_inheritance()
             )
   .def(py::init<int, int, int>())
-  .def_readwrite("ex_ref",   &emf::damping::Tile<D,S>::ex_ref, py::return_value_policy::reference,py::keep_alive<1,0>())
-  .def_readwrite("ey_ref",   &emf::damping::Tile<D,S>::ey_ref, py::return_value_policy::reference,py::keep_alive<1,0>())
-  .def_readwrite("ez_ref",   &emf::damping::Tile<D,S>::ez_ref, py::return_value_policy::reference,py::keep_alive<1,0>())
-  .def_readwrite("bx_ref",   &emf::damping::Tile<D,S>::bx_ref, py::return_value_policy::reference,py::keep_alive<1,0>())
-  .def_readwrite("by_ref",   &emf::damping::Tile<D,S>::by_ref, py::return_value_policy::reference,py::keep_alive<1,0>())
-  .def_readwrite("bz_ref",   &emf::damping::Tile<D,S>::bz_ref, py::return_value_policy::reference,py::keep_alive<1,0>())
+  .def_property("ex_ref",    get_ref(&emf::damping::Tile<D,S>::ex_ref), set_ref(&emf::damping::Tile<D,S>::ex_ref), py::return_value_policy::reference_internal)
+  .def_property("ey_ref",    get_ref(&emf::damping::Tile<D,S>::ey_ref), set_ref(&emf::damping::Tile<D,S>::ey_ref), py::return_value_policy::reference_internal)
+  .def_property("ez_ref",    get_ref(&emf::damping::Tile<D,S>::ez_ref), set_ref(&emf::damping::Tile<D,S>::ez_ref), py::return_value_policy::reference_internal)
+  .def_property("bx_ref",    get_ref(&emf::damping::Tile<D,S>::bx_ref), set_ref(&emf::damping::Tile<D,S>::bx_ref), py::return_value_policy::reference_internal)
+  .def_property("by_ref",    get_ref(&emf::damping::Tile<D,S>::by_ref), set_ref(&emf::damping::Tile<D,S>::by_ref), py::return_value_policy::reference_internal)
+  .def_property("bz_ref",    get_ref(&emf::damping::Tile<D,S>::bz_ref), set_ref(&emf::damping::Tile<D,S>::bz_ref), py::return_value_policy::reference_internal)
   .def_readwrite("fld1",     &emf::damping::Tile<D,S>::fld1)
   .def_readwrite("fld2",     &emf::damping::Tile<D,S>::fld2)
   .def_readwrite("ksupp",    &emf::damping::Tile<D,S>::ksupp)
+  .def("alloc_refs",         &emf::damping::Tile<D,S>::alloc_refs)
   .def("damp_fields",        &emf::damping::Tile<D,S>::damp_fields);
 }
 
@@ -229,6 +248,15 @@ class PyFilter : public Filter<D>
 
 void bind_emf(py::module& m_sub)
 {
+
+  // currents and charge density are allocated on first access
+  using Comp = toolbox::Mesh<float,3> emf::Grids::*;
+  auto get_cur = [](Comp f) { 
+    return [f](emf::Grids& g) -> toolbox::Mesh<float,3>& { g.alloc_currents(); return g.*f; };
+  };
+  auto set_cur = [](Comp f) { 
+    return [f](emf::Grids& g, const toolbox::Mesh<float,3>& m) { g.alloc_currents(); g.*f = m; };
+  };
     
   py::class_<
     emf::Grids,
@@ -241,10 +269,29 @@ void bind_emf(py::module& m_sub)
     .def_readwrite("bx",   &emf::Grids::bx , py::return_value_policy::reference, py::keep_alive<1,0>())
     .def_readwrite("by",   &emf::Grids::by , py::return_value_policy::reference, py::keep_alive<1,0>())
     .def_readwrite("bz",   &emf::Grids::bz , py::return_value_policy::reference, py::keep_alive<1,0>())
-    .def_readwrite("jx",   &emf::Grids::jx , py::return_value_policy::reference, py::keep_alive<1,0>())
-    .def_readwrite("jy",   &emf::Grids::jy , py::return_value_policy::reference, py::keep_alive<1,0>())
-    .def_readwrite("jz",   &emf::Grids::jz , py::return_value_policy::reference, py::keep_alive<1,0>())
-    .def_readwrite("rho",  &emf::Grids::rho, py::return_value_policy::reference, py::keep_alive<1,0>());
+    .def_property("jx",    get_cur(&emf::Grids::jx), set_cur(&emf::Grids::jx), py::return_value_policy::reference_internal)
+    .def_property("jy",    get_cur(&emf::Grids::jy), set_cur(&emf::Grids::jy), py::return_value_policy::reference_internal)
+    .def_property("jz",    get_cur(&emf::Grids::jz), set_cur(&emf::Grids::jz), py::return_value_policy::reference_internal)
+    .def_property("rho",   
+        [](emf::Grids& g) -> toolbox::Mesh<float,3>& { g.alloc_rho(); return g.rho; },
+        [](emf::Grids& g, const toolbox::Mesh<float,3>& m) { g.rho = m; },
+        py::return_value_policy::reference_internal)
+    .def("has_rho",        &emf::Grids::has_rho)
+    .def("has_currents",   &emf::Grids::has_currents)
+    .def("alloc_rho",      &emf::Grids::alloc_rho)
+    .def("free_rho",       &emf::Grids::free_rho)
+    .def("alloc_currents", &emf::Grids::alloc_currents)
+    .def("free_currents",  &emf::Grids::free_currents);
+
+  // tabulated background field; filled by e.g. Conductor.tabulate_background
+  py::class_<emf::BackgroundGrids>(m_sub, "BackgroundGrids")
+    .def_readonly("ex",  &emf::BackgroundGrids::ex)
+    .def_readonly("ey",  &emf::BackgroundGrids::ey)
+    .def_readonly("ez",  &emf::BackgroundGrids::ez)
+    .def_readonly("bx",  &emf::BackgroundGrids::bx)
+    .def_readonly("by",  &emf::BackgroundGrids::by)
+    .def_readonly("bz",  &emf::BackgroundGrids::bz)
+    .def_readonly("key", &emf::BackgroundGrids::key);
 
 
 
@@ -375,7 +422,12 @@ void bind_emf(py::module& m_sub)
   // fdtd2 propagator
   py::class_<emf::FDTD2<1>, Propagator<1>, PyFDTD2<1>>(m_1d, "FDTD2")
     .def(py::init<>())
-    .def_readwrite("corr",     &emf::FDTD2<1>::corr);
+    .def_readwrite("corr",     &emf::FDTD2<1>::corr)
+    .def_readonly_static("max_steps", &emf::FDTD2<1>::max_steps)
+    .def("push_steps",         &emf::FDTD2<1>::push_steps,
+        py::arg("tile"),
+        py::arg("nsteps")=emf::FDTD2<1>::max_steps)
+    .def("push_fused",         &emf::FDTD2<1>::push_fused);
 
 
   //--------------------------------------------------
@@ -390,7 +442,12 @@ void bind_emf(py::module& m_sub)
   // fdtd2 propagator
   py::class_<emf::FDTD2<2>>(m_2d, "FDTD2", emfpropag2d)
     .def_readwrite("corr",     &emf::FDTD2<2>::corr)
-    .def(py::init<>());
+    .def(py::init<>())
+    .def_readonly_static("max_steps", &emf::FDTD2<2>::max_steps)
+    .def("push_steps",         &emf::FDTD2<2>::push_steps,
+        py::arg("tile"),
+        py::arg("nsteps")=emf::FDTD2<2>::max_steps)
+    .def("push_fused",         &emf::FDTD2<2>::push_fused);
     
   // fdtd2 propagator with perfectly matched ouer layer
   py::class_<emf::FDTD2_pml<2>> pml2d(m_2d, "FDTD2_pml", emfpropag2d);
@@ -406,6 +463,7 @@ void bind_emf(py::module& m_sub)
     .def_readwrite("norm_abs", &emf::FDTD2_pml<2>::norm_abs)
     .def_readwrite("corr",     &emf::FDTD2_pml<2>::corr)
     .def_readwrite("mode",     &emf::FDTD2_pml<2>::mode)
+    .def("absorbs",            &emf::FDTD2_pml<2>::absorbs)
     .def("push_e",             &emf::FDTD2_pml<2>::push_e)
     .def("push_half_b",        &emf::FDTD2_pml<2>::push_half_b);
     //.def("push_eb",            &emf::FDTD2_pml<2>::push_eb); // TODO not implemented
@@ -414,8 +472,15 @@ void bind_emf(py::module& m_sub)
   // fdtd4 propagator
   py::class_<emf::FDTD4<2>, Propagator<2>, PyFDTD4<2> >(m_2d, "FDTD4")
     .def_readwrite("corr",     &emf::FDTD4<2>::corr)
+    .def_readwrite("coeff1",   &emf::FDTD4<2>::coeff1)
+    .def_readwrite("coeff2",   &emf::FDTD4<2>::coeff2)
     .def(py::init<>());
 
+  // fdtd propagator with Pukhov's compile-time transverse stencil
+  py::class_<emf::FDTDPukhov<2>>(m_2d, "FDTDPukhov", emfpropag2d)
+    .def(py::init<>())
+    .def_readwrite("corr",     &emf::FDTDPukhov<2>::corr);
+
 
   //--------------------------------------------------
   // 3D Propagator bindings
@@ -428,7 +493,12 @@ void bind_emf(py::module& m_sub)
   // fdtd2 propagator
   py::class_<emf::FDTD2<3>>(m_3d, "FDTD2", emfpropag3d)
     .def(py::init<>())
-    .def_readwrite("corr",     &emf::FDTD2<3>::corr);
+    .def_readwrite("corr",     &emf::FDTD2<3>::corr)
+    .def_readonly_static("max_steps", &emf::FDTD2<3>::max_steps)
+    .def("push_steps",         &emf::FDTD2<3>::push_steps,
+        py::arg("tile"),
+        py::arg("nsteps")=emf::FDTD2<3>::max_steps)
+    .def("push_fused",         &emf::FDTD2<3>::push_fused);
 
   // fdtd2 propagator with perfectly matched ouer layer
   py::class_<emf::FDTD2_pml<3>> pml3d(m_3d, "FDTD2_pml", emfpropag3d);
@@ -444,6 +514,7 @@ void bind_emf(py::module& m_sub)
     .def_readwrite("norm_abs", &emf::FDTD2_pml<3>::norm_abs)
     .def_readwrite("corr",     &emf::FDTD2_pml<3>::corr)
     .def_readwrite("mode",     &emf::FDTD2_pml<3>::mode)
+    .def("absorbs",            &emf::FDTD2_pml<3>::absorbs)
     .def("push_e",             &emf::FDTD2_pml<3>::push_e)
     .def("push_half_b",        &emf::FDTD2_pml<3>::push_half_b)
     .def("push_eb",            &emf::FDTD2_pml<3>::push_eb);
@@ -452,8 +523,15 @@ void bind_emf(py::module& m_sub)
   // fdtd4 propagator
   py::class_<emf::FDTD4<3>, Propagator<3>, PyFDTD4<3> >(m_3d, "FDTD4")
     .def_readwrite("corr",     &emf::FDTD4<3>::corr)
+    .def_readwrite("coeff1",   &emf::FDTD4<3>::coeff1)
+    .def_readwrite("coeff2",   &emf::FDTD4<3>::coeff2)
     .def(py::init<>());
 
+  // fdtd propagator with Pukhov's compile-time transverse stencil
+  py::class_<emf::FDTDPukhov<3>>(m_3d, "FDTDPukhov", emfpropag3d)
+    .def(py::init<>())
+    .def_readwrite("corr",     &emf::FDTDPukhov<3>::corr);
+
 
   // fdtd general propagator
   //py::class_<emf::FDTDGen<3>, Propagator<3>, PyFDTDGen<3> >(m_3d, "FDTDGen")
@@ -470,6 +548,18 @@ void bind_emf(py::module& m_sub)
   //--------------------------------------------------
   // 1D, 2D, and 3D FILTERS
 
+#ifdef RUNKO_FFTW
+  // k-space kernels of the spectral filter
+  py::class_<emf::fourier::Kernel>(m_sub, "FourierKernel")
+    .def(py::init<std::function<float(float,float,float)>, int>(), py::arg("response"), py::arg("reach"))
+    .def_readwrite("response", &emf::fourier::Kernel::response)
+    .def_readwrite("reach",    &emf::fourier::Kernel::reach);
+
+  m_sub.def("fourier_binomial",    &emf::fourier::binomial,    py::arg("npasses"));
+  m_sub.def("fourier_compensated", &emf::fourier::compensated, py::arg("npasses"));
+  m_sub.def("fourier_cutoff",      &emf::fourier::cutoff,      py::arg("kmax"), py::arg("reach"));
+#endif
+
   // 1D filters
   py::class_< emf::Filter<1>, PyFilter<1> > emffilter1d(m_1d, "Filter");
   emffilter1d
@@ -514,6 +604,23 @@ void bind_emf(py::module& m_sub)
     .def(py::init<int, int, int>())
     .def("solve",              &emf::Compensator2<2>::solve);
 
+  py::class_<emf::MultiBinomial2<2>>(m_2d, "MultiBinomial2", emffilter2d)
+    .def(py::init<int, int, int>())
+    .def_readwrite("npasses",    &emf::MultiBinomial2<2>::npasses)
+    .def_readwrite("compensate", &emf::MultiBinomial2<2>::compensate)
+    .def("groups",               &emf::MultiBinomial2<2>::groups)
+    .def("solve", static_cast<void(emf::MultiBinomial2<2>::*)(emf::Tile<2>&     )>(&emf::MultiBinomial2<2>::solve))
+    .def("solve", static_cast<void(emf::MultiBinomial2<2>::*)(emf::Tile<2>&, int)>(&emf::MultiBinomial2<2>::solve));
+
+#ifdef RUNKO_FFTW
+  py::class_<emf::Fourier<2>>(m_2d, "Fourier", emffilter2d)
+    .def(py::init<int, int, int>())
+    .def("set_kernel",           &emf::Fourier<2>::set_kernel)
+    .def("commit",               &emf::Fourier<2>::commit)
+    .def("solve", static_cast<void(emf::Fourier<2>::*)(emf::Tile<2>&                  )>(&emf::Fourier<2>::solve))
+    .def("solve", static_cast<void(emf::Fourier<2>::*)(emf::Tile<2>&, corgi::Grid<2>&)>(&emf::Fourier<2>::solve));
+#endif
+
 
 
   // 3D filters
@@ -527,6 +634,38 @@ void bind_emf(py::module& m_sub)
     .def(py::init<int, int, int>())
     .def("solve",      &emf::Binomial2<3>::solve);
 
+  py::class_<emf::General3p<3>>(m_3d, "General3p", emffilter3d)
+    .def(py::init<int, int, int>())
+    .def_readwrite("alpha",    &emf::General3p<3>::alpha)
+    .def("solve",              &emf::General3p<3>::solve);
+
+  py::class_<emf::General3pStrided<3>>(m_3d, "General3pStrided", emffilter3d)
+    .def(py::init<int, int, int>())
+    .def_readwrite("alpha",    &emf::General3pStrided<3>::alpha)
+    .def_readwrite("stride",   &emf::General3pStrided<3>::stride)
+    .def("solve",              &emf::General3pStrided<3>::solve);
+
+  py::class_<emf::Compensator2<3>>(m_3d, "Compensator2", emffilter3d)
+    .def(py::init<int, int, int>())
+    .def("solve",              &emf::Compensator2<3>::solve);
+
+  py::class_<emf::MultiBinomial2<3>>(m_3d, "MultiBinomial2", emffilter3d)
+    .def(py::init<int, int, int>())
+    .def_readwrite("npasses",    &emf::MultiBinomial2<3>::npasses)
+    .def_readwrite("compensate", &emf::MultiBinomial2<3>::compensate)
+    .def("groups",               &emf::MultiBinomial2<3>::groups)
+    .def("solve", static_cast<void(emf::MultiBinomial2<3>::*)(emf::Tile<3>&     )>(&emf::MultiBinomial2<3>::solve))
+    .def("solve", static_cast<void(emf::MultiBinomial2<3>::*)(emf::Tile<3>&, int)>(&emf::MultiBinomial2<3>::solve));
+
+#ifdef RUNKO_FFTW
+  py::class_<emf::Fourier<3>>(m_3d, "Fourier", emffilter3d)
+    .def(py::init<int, int, int>())
+    .def("set_kernel",           &emf::Fourier<3>::set_kernel)
+    .def("commit",               &emf::Fourier<3>::commit)
+    .def("solve", static_cast<void(emf::Fourier<3>::*)(emf::Tile<3>&                  )>(&emf::Fourier<3>::solve))
+    .def("solve", static_cast<void(emf::Fourier<3>::*)(emf::Tile<3>&, corgi::Grid<3>&)>(&emf::Fourier<3>::solve));
+#endif
+
 
 
   //--------------------------------------------------
@@ -551,6 +690,7 @@ void bind_emf(py::module& m_sub)
     .def_readwrite("Nx",       &emf::Conductor<1>::Nx)
     .def_readwrite("Ny",       &emf::Conductor<1>::Ny)
     .def_readwrite("Nz",       &emf::Conductor<1>::Nz)
+    .def("tabulate_background",&emf::Conductor<1>::tabulate_background)
     .def("insert_em",          &emf::Conductor<1>::insert_em)
     .def("update_b",           &emf::Conductor<1>::update_b)
     .def("update_e",           &emf::Conductor<1>::update_e);
@@ -575,6 +715,7 @@ void bind_emf(py::module& m_sub)
     .def_readwrite("Nx",       &emf::Conductor<2>::Nx)
     .def_readwrite("Ny",       &emf::Conductor<2>::Ny)
     .def_readwrite("Nz",       &emf::Conductor<2>::Nz)
+    .def("tabulate_background",&emf::Conductor<2>::tabulate_background)
     .def("insert_em",          &emf::Conductor<2>::insert_em)
     .def("update_b",           &emf::Conductor<2>::update_b)
     .def("update_e",           &emf::Conductor<2>::update_e);
@@ -599,6 +740,7 @@ void bind_emf(py::module& m_sub)
     .def_readwrite("Nx",       &emf::Conductor<3>::Nx)
     .def_readwrite("Ny",       &emf::Conductor<3>::Ny)
     .def_readwrite("Nz",       &emf::Conductor<3>::Nz)
+    .def("tabulate_background",&emf::Conductor<3>::tabulate_background)
     .def("insert_em",          &emf::Conductor<3>::insert_em)
     .def("update_e",           &emf::Conductor<3>::update_e)
     .def("update_b",           &emf::Conductor<3>::update_b);
@@ -9,6 +9,7 @@ namespace py = pybind11;
 // experimental PIC module
   
 #include "core/pic/tile.h"
+#include "core/pic/ghost_tile.h"
 #include "core/pic/pushers/pusher.h"
 #include "core/pic/pushers/boris.h"
 #include "core/pic/pushers/boris_drag.h"
@@ -19,6 +20,7 @@ namespace py = pybind11;
 #include "core/pic/pushers/rgca.h"
 #include "core/pic/pushers/pulsar.h"
 #include "core/pic/pushers/photon.h"
+#include "core/pic/pushers/push_zigzag.h"
 
 #include "core/pic/interpolators/interpolator.h"
 #include "core/pic/interpolators/linear_1st.h"
@@ -55,6 +57,30 @@ namespace py = pybind11;
 namespace pic {
 
 
+//--------------------------------------------------
+// analytic external field of the unit tests; a constant field function
+// so that the pusher can be compared against policy::ConstExtField
+struct ConstFieldFunction {
+  template<typename P>
+  explicit ConstFieldFunction(const P& /*p*/) { }
+
+  template<typename T>
+  DEVCALLABLE inline void operator()(
+      T /*x*/, T /*y*/, T /*z*/,
+      T& ex, T& ey, T& ez,
+      T& bx, T& by, T& bz) const
+  {
+    ex += T(0.1); ey += T(0.2); ez += T(0.3);
+    bx += T(0.4); by += T(0.5); bz += T(0.6);
+  }
+};
+
+template<size_t D, size_t V>
+class BorisPusherAnalytic :
+  public PolicyPusher<D,V, policy::Boris, policy::AnalyticExtField<ConstFieldFunction>, policy::NoForce>
+{ };
+
+
 //--------------------------------------------------
 template<size_t D>
 auto declare_tile(
@@ -84,7 +110,61 @@ auto declare_tile(
     .def("pack_all_particles",           &pic::Tile<D>::pack_all_particles)
     .def("unpack_incoming_particles",    &pic::Tile<D>::unpack_incoming_particles)
     .def("delete_all_particles",         &pic::Tile<D>::delete_all_particles)
-    .def("shrink_to_fit_all_particles",  &pic::Tile<D>::shrink_to_fit_all_particles);
+    .def("shrink_to_fit_all_particles",  &pic::Tile<D>::shrink_to_fit_all_particles)
+    .def("set_subcycle_lap",             &pic::Tile<D>::set_subcycle_lap)
+    .def("accumulate_subcycle_fields",   &pic::Tile<D>::accumulate_subcycle_fields)
+    .def("sort_in_cell_blocks",          &pic::Tile<D>::sort_in_cell_blocks);
+}
+
+//--------------------------------------------------
+template<size_t D>
+auto declare_ghost_tile(
+    py::module& m,
+    const std::string& pyclass_name) 
+{
+
+  return 
+  py::class_<pic::GhostTile<D>, 
+             emf::Tile<D>,
+             corgi::Tile<D>, 
+             std::shared_ptr<pic::GhostTile<D>>
+             >(m, 
+               pyclass_name.c_str(),
+               py::multiple_inheritance()
+               )
+    .def(py::init<int, int, int, int>())
+    .def_readwrite("cfl",       &pic::GhostTile<D>::cfl)
+    .def("Nspecies",            &pic::GhostTile<D>::Nspecies)
+    .def("number_of_particles", [](pic::GhostTile<D>& t, int i) { return t.get_messages(i).size(); })
+
+    //temporary binding; only needed for unit tests
+    //
+    // stores the packed messages of tile as if they were received from
+    // its owning rank
+    .def("receive_particles", [](pic::GhostTile<D>& t, pic::Tile<D>& tile)
+        {
+          const int first_message_size = pic::ParticleContainer<D>::first_message_size;
+          assert(tile.Nspecies() == t.Nspecies());
+
+          for(int ispc=0; ispc<t.Nspecies(); ispc++) {
+            auto& msg = t.get_messages(ispc);
+            auto& container = tile.get_container(ispc);
+
+            msg.incoming_particles.resize(first_message_size);
+            for(size_t n=0; n<container.outgoing_particles.size(); n++)
+              msg.incoming_particles[n] = container.outgoing_particles[n];
+
+            msg.incoming_extra_particles.clear();
+            for(size_t n=0; n<container.outgoing_extra_particles.size(); n++)
+              msg.incoming_extra_particles.push_back( container.outgoing_extra_particles[n] );
+          }
+        })
+
+    .def("check_outgoing_particles",     &pic::GhostTile<D>::check_outgoing_particles)
+    .def("unpack_incoming_particles",    &pic::GhostTile<D>::unpack_incoming_particles)
+    .def("delete_all_particles",         &pic::GhostTile<D>::delete_all_particles)
+    .def("shrink_to_fit_all_particles",  &pic::GhostTile<D>::shrink_to_fit_all_particles)
+    .def("set_subcycle_lap",             &pic::GhostTile<D>::set_subcycle_lap);
 }
 
 template<size_t D>
@@ -99,6 +179,10 @@ auto declare_prtcl_container(
     .def_readwrite("q",   &pic::ParticleContainer<D>::q)
     .def_readwrite("m",   &pic::ParticleContainer<D>::m)
     .def_readwrite("type",&pic::ParticleContainer<D>::type)
+    .def_readwrite("subcycle", &pic::ParticleContainer<D>::subcycle)
+    .def_readonly("substep",   &pic::ParticleContainer<D>::substep)
+    .def("is_active",     &pic::ParticleContainer<D>::is_active)
+    .def("is_cell_sorted",&pic::ParticleContainer<D>::is_cell_sorted)
     .def("reserve",       &pic::ParticleContainer<D>::reserve)
     .def("size",          &pic::ParticleContainer<D>::size)
     .def("add_particle",  &pic::ParticleContainer<D>::add_particle)
@@ -328,18 +412,21 @@ void bind_pic(py::module& m_sub)
   // 1D bindings
   py::module m_1d = m_sub.def_submodule("oneD", "1D specializations");
   auto t1 = pic::declare_tile<1>(m_1d, "Tile");
+  auto g1 = pic::declare_ghost_tile<1>(m_1d, "GhostTile");
   auto pc1 =pic::declare_prtcl_container<1>(m_1d, "ParticleContainer");
 
   //--------------------------------------------------
   // 2D bindings
   py::module m_2d = m_sub.def_submodule("twoD", "2D specializations");
   auto t2 = pic::declare_tile<2>(m_2d, "Tile");
+  auto g2 = pic::declare_ghost_tile<2>(m_2d, "GhostTile");
   auto pc2 =pic::declare_prtcl_container<2>(m_2d, "ParticleContainer");
 
   //--------------------------------------------------
   // 3D bindings
   py::module m_3d = m_sub.def_submodule("threeD", "3D specializations");
   auto t3 = pic::declare_tile<3>(m_3d, "Tile");
+  auto g3 = pic::declare_ghost_tile<3>(m_3d, "GhostTile");
   auto pc3 =pic::declare_prtcl_container<3>(m_3d, "ParticleContainer");
 
 
@@ -368,9 +455,21 @@ void bind_pic(py::module& m_sub)
   py::class_<pic::BorisPusher<1,3>>(m_1d, "BorisPusher", picpusher1d)
     .def(py::init<>());
 
+  // Boris pusher fused with the ZigZag depositer; solve() pushes and deposits
+  py::class_<pic::BorisZigZag<1,3>>(m_1d, "BorisZigZag", picpusher1d)
+    .def(py::init<>())
+    .def("solve", &pic::BorisZigZag<1,3>::solve);
+
   // 1D Higuera-Cary pusher
   py::class_<pic::HigueraCaryPusher<1,3>>(m_1d, "HigueraCaryPusher", picpusher1d)
     .def(py::init<>());
+
+  // single precision versions
+  py::class_<pic::BorisPusherFloat<1,3>>(m_1d, "BorisPusherFloat", picpusher1d)
+    .def(py::init<>());
+
+  py::class_<pic::HigueraCaryPusherFloat<1,3>>(m_1d, "HigueraCaryPusherFloat", picpusher1d)
+    .def(py::init<>());
     
   // Photon pusher
   py::class_<pic::PhotonPusher<1,3>>(m_1d, "PhotonPusher", picpusher1d)
@@ -399,6 +498,15 @@ void bind_pic(py::module& m_sub)
   py::class_<pic::BorisPusher<2,3>>(m_2d, "BorisPusher", picpusher2d)
     .def(py::init<>());
 
+  //temporary binding; only needed for unit tests
+  py::class_<pic::BorisPusherAnalytic<2,3>>(m_2d, "BorisPusherAnalytic", picpusher2d)
+    .def(py::init<>());
+
+  // Boris pusher fused with the ZigZag depositer; solve() pushes and deposits
+  py::class_<pic::BorisZigZag<2,3>>(m_2d, "BorisZigZag", picpusher2d)
+    .def(py::init<>())
+    .def("solve", &pic::BorisZigZag<2,3>::solve);
+
   // Boris pusher with drag force
   py::class_<pic::BorisPusherDrag<2,3>>(m_2d, "BorisDragPusher", picpusher2d)
     .def_readwrite("drag", &pic::BorisPusherDrag<2,3>::drag)
@@ -426,9 +534,24 @@ void bind_pic(py::module& m_sub)
   py::class_<pic::HigueraCaryPusher<2,3>>(m_2d, "HigueraCaryPusher", picpusher2d)
     .def(py::init<>());
 
+  // single precision versions
+  py::class_<pic::BorisPusherFloat<2,3>>(m_2d, "BorisPusherFloat", picpusher2d)
+    .def(py::init<>());
+
+  py::class_<pic::VayPusherFloat<2,3>>(m_2d, "VayPusherFloat", picpusher2d)
+    .def(py::init<>());
+
+  py::class_<pic::HigueraCaryPusherFloat<2,3>>(m_2d, "HigueraCaryPusherFloat", picpusher2d)
+    .def(py::init<>());
+
   // reduced guiding center approximation
   py::class_<pic::rGCAPusher<2,3>>(m_2d, "rGCAPusher", picpusher2d)
-    .def(py::init<>());
+    .def(py::init<>())
+    .def_readwrite("full_orbit",    &pic::rGCAPusher<2,3>::full_orbit)
+    .def_readwrite("gca_max_eb",    &pic::rGCAPusher<2,3>::gca_max_eb)
+    .def_readwrite("gca_min_phase", &pic::rGCAPusher<2,3>::gca_min_phase)
+    .def_readwrite("max_phase",     &pic::rGCAPusher<2,3>::max_phase)
+    .def_readwrite("max_substeps",  &pic::rGCAPusher<2,3>::max_substeps);
 
   // special rGCA + gravity pusher for pulsars
   py::class_<pic::PulsarPusher<2,3>>(m_2d, "PulsarPusher", picpusher2d)
@@ -439,6 +562,7 @@ void bind_pic(py::module& m_sub)
     .def_readwrite("ceny",      &pic::PulsarPusher<2,3>::ceny)
     .def_readwrite("cenz",      &pic::PulsarPusher<2,3>::cenz)
     .def_readwrite("grav_const",&pic::PulsarPusher<2,3>::gravity_const)
+    .def_readwrite("add_background", &pic::PulsarPusher<2,3>::add_background)
     //.def_readwrite("B0",       &pic::PulsarPusher<2>::B0)
     //.def_readwrite("chi",      &pic::PulsarPusher<2>::chi)
     //.def_readwrite("phase",    &pic::PulsarPusher<2>::phase)
@@ -471,6 +595,11 @@ void bind_pic(py::module& m_sub)
   // Boris pusher
   py::class_<pic::BorisPusher<3,3>>(m_3d, "BorisPusher", picpusher3d)
     .def(py::init<>());
+
+  // Boris pusher fused with the ZigZag depositer; solve() pushes and deposits
+  py::class_<pic::BorisZigZag<3,3>>(m_3d, "BorisZigZag", picpusher3d)
+    .def(py::init<>())
+    .def("solve", &pic::BorisZigZag<3,3>::solve);
     
   // Boris pusher with drag force
   py::class_<pic::BorisPusherDrag<3,3>>(m_3d, "BorisDragPusher", picpusher3d)
@@ -499,9 +628,24 @@ void bind_pic(py::module& m_sub)
   py::class_<pic::HigueraCaryPusher<3,3>>(m_3d, "HigueraCaryPusher", picpusher3d)
     .def(py::init<>());
 
+  // single precision versions
+  py::class_<pic::BorisPusherFloat<3,3>>(m_3d, "BorisPusherFloat", picpusher3d)
+    .def(py::init<>());
+
+  py::class_<pic::VayPusherFloat<3,3>>(m_3d, "VayPusherFloat", picpusher3d)
+    .def(py::init<>());
+
+  py::class_<pic::HigueraCaryPusherFloat<3,3>>(m_3d, "HigueraCaryPusherFloat", picpusher3d)
+    .def(py::init<>());
+
   // reduced guiding center approximation
   py::class_<pic::rGCAPusher<3,3>>(m_3d, "rGCAPusher", picpusher3d)
-    .def(py::init<>());
+    .def(py::init<>())
+    .def_readwrite("full_orbit",    &pic::rGCAPusher<3,3>::full_orbit)
+    .def_readwrite("gca_max_eb",    &pic::rGCAPusher<3,3>::gca_max_eb)
+    .def_readwrite("gca_min_phase", &pic::rGCAPusher<3,3>::gca_min_phase)
+    .def_readwrite("max_phase",     &pic::rGCAPusher<3,3>::max_phase)
+    .def_readwrite("max_substeps",  &pic::rGCAPusher<3,3>::max_substeps);
 
   // special rGCA + gravity pusher for pulsars
   py::class_<pic::PulsarPusher<3,3>>(m_3d, "PulsarPusher", picpusher3d)
@@ -512,6 +656,7 @@ void bind_pic(py::module& m_sub)
     .def_readwrite("ceny",      &pic::PulsarPusher<3,3>::ceny)
     .def_readwrite("cenz",      &pic::PulsarPusher<3,3>::cenz)
     .def_readwrite("grav_const",&pic::PulsarPusher<3,3>::gravity_const)
+    .def_readwrite("add_background", &pic::PulsarPusher<3,3>::add_background)
     //.def_readwrite("B0",       &pic::PulsarPusher<3>::B0)
     //.def_readwrite("chi",      &pic::PulsarPusher<3>::chi)
     //.def_readwrite("phase",    &pic::PulsarPusher<3>::phase)
@@ -535,7 +680,9 @@ void bind_pic(py::module& m_sub)
 
   // Linear pusher
   py::class_<pic::LinearInterpolator<1,3>>(m_1d, "LinearInterpolator", picinterp1d)
-    .def(py::init<>());
+    .def(py::init<>())
+    .def_readwrite("collocated", &pic::LinearInterpolator<1,3>::collocated)
+    .def_readwrite("bricked",    &pic::LinearInterpolator<1,3>::bricked);
 
   //--------------------------------------------------
   // 2D version
@@ -546,7 +693,9 @@ void bind_pic(py::module& m_sub)
 
   // Linear pusher
   py::class_<pic::LinearInterpolator<2,3>>(m_2d, "LinearInterpolator", picinterp2d)
-    .def(py::init<>());
+    .def(py::init<>())
+    .def_readwrite("collocated", &pic::LinearInterpolator<2,3>::collocated)
+    .def_readwrite("bricked",    &pic::LinearInterpolator<2,3>::bricked);
 
   // 2nd order quadratic
   py::class_<pic::QuadraticInterpolator<2>>(m_2d, "QuadraticInterpolator", picinterp2d)
@@ -562,7 +711,9 @@ void bind_pic(py::module& m_sub)
 
   // Linear pusher
   py::class_<pic::LinearInterpolator<3,3>>(m_3d, "LinearInterpolator", picinterp3d)
-    .def(py::init<>());
+    .def(py::init<>())
+    .def_readwrite("collocated", &pic::LinearInterpolator<3,3>::collocated)
+    .def_readwrite("bricked",    &pic::LinearInterpolator<3,3>::bricked);
 
   // 2nd order quadratic
   py::class_<pic::QuadraticInterpolator<3>>(m_3d, "QuadraticInterpolator", picinterp3d)
@@ -5,6 +5,7 @@
 #include "tools/mesh.h"
 #include "core/vlv/amr/mesh.h"
 #include "tools/hilbert.h"
+#include "external/timer/tracer.h"
 
 #include <exception>
 
@@ -210,6 +211,63 @@ void bind_tools(pybind11::module& m)
     .def("inv",    &hilbert::Hilbert3D::inv);
 
 
+  //--------------------------------------------------
+  // timeline tracer; see external/timer/tracer.h
+
+  py::module m_trace = m.def_submodule("trace", "Chrome trace-event timeline recorder");
+
+  m_trace.def("enable",      [](){ trace::Tracer::get().enable(); });
+  m_trace.def("disable",     [](){ trace::Tracer::get().disable(); });
+  m_trace.def("is_enabled",  [](){ return trace::Tracer::get().is_enabled(); });
+  m_trace.def("reset_epoch", [](){ trace::Tracer::get().reset_epoch(); });
+  m_trace.def("clear",       [](){ trace::Tracer::get().clear(); });
+  m_trace.def("size",        [](){ return trace::Tracer::get().size(); });
+  m_trace.def("set_capacity",[](size_t cap){ trace::Tracer::get().set_capacity(cap); });
+  m_trace.def("begin",       [](const std::string& name, const std::string& cat)
+      { trace::Tracer::get().begin(name, cat); },
+      py::arg("name"), py::arg("cat")="stage");
+  m_trace.def("end",         [](){ trace::Tracer::get().end(); });
+  m_trace.def("dump",        [](const std::string& fname, int rank)
+      { trace::Tracer::get().dump(fname, rank); },
+      py::arg("fname"), py::arg("rank")=0);
+
+
+  //--------------------------------------------------
+  // hardware performance counters per kernel; see external/timer/perfcounters.h
+
+  py::module m_perf = m.def_submodule("perf", "hardware performance counters per kernel");
+
+  m_perf.def("enable",        [](){ return perf::Counters::get().enable(); });
+  m_perf.def("disable",       [](){ perf::Counters::get().disable(); });
+  m_perf.def("is_enabled",    [](){ return perf::Counters::get().is_enabled(); });
+  m_perf.def("clear",         [](){ perf::Counters::get().clear(); });
+  m_perf.def("add_raw_event", [](const std::string& name, uint64_t config)
+      { perf::Counters::get().add_raw_event(name, config); });
+  m_perf.def("counter_names", []()
+      {
+        std::vector<std::string> names;
+        for(auto& spec : perf::Counters::get().specs) names.push_back(spec.name);
+        return names;
+      });
+
+  // kernel name -> {calls, time, <counter name>: count, ...}
+  m_perf.def("report", []()
+      {
+        auto& counters = perf::Counters::get();
+        std::map<std::string, std::map<std::string, double>> ret;
+
+        for(auto const& [sig, s] : counters.stats) {
+          auto [name, tparams] = trace::split_signature(sig);
+          if(!tparams.empty()) name += " [" + tparams + "]";
+
+          auto& r = ret[name];
+          r["calls"] = s.calls;
+          r["time"]  = s.time;
+          for(size_t i=0; i<s.counts.size(); i++) r[counters.specs[i].name] = s.counts[i];
+        }
+        return ret;
+      });
+
 
 }
 
@@ -3,6 +3,7 @@
 
 #include <cmath> 
 #include <cassert>
+#include <vector>
 
 using std::min;
 using std::max;
@@ -81,15 +82,17 @@ Vec3<float> emf::Conductor<3>::dipole(Vec3<float>& xvec)
 
 
 template<size_t D>
-void emf::Conductor<D>::insert_em(
+void emf::Conductor<D>::tabulate_background(
     emf::Tile<D>& tile)
 {
+  // parameters the background depends on; the tile limits are fixed
+  std::vector<float> key = {B0, chi_mu, chi_om, phase_mu, phase_om, period, cenx, ceny, cenz};
+
+  auto& bg = tile.get_background();
+  if( bg.is_valid(key) ) return;
 
   // Tile limits
   auto mins = tile.mins;
-  //auto maxs = tile.maxs;
-
-  auto& gs = tile.get_grids();
 
   //--------------------------------------------------
   // angular velocity
@@ -122,10 +125,10 @@ void emf::Conductor<D>::insert_em(
     kmin = -3, kmax = tile.mesh_lengths[2]+3;
   }
 
-
-  for(int k=kmin; k<kmax; k++) 
-  for(int j=jmin; j<jmax; j++) 
-  for(int i=imin; i<imax; i++) {
+  #pragma omp parallel for
+  for(int k=kmin; k<kmax; k++) {
+    for(int j=jmin; j<jmax; j++) {
+      for(int i=imin; i<imax; i++) {
 
     // global grid coordinates
     float iglob = (D>=1) ? i + mins[0] : 0;
@@ -133,79 +136,84 @@ void emf::Conductor<D>::insert_em(
     float kglob = (D>=3) ? k + mins[2] : 0;
 
     //--------------------------------------------------
-    // magnetic field
-    
-    //--------------------------------------------------
-    // bx
+    // magnetic field; dipole at the B staggering
     auto r1  = coord.bx().vec(iglob, jglob, kglob, D); // cartesian position vector in "star's coordinates"
     auto bxd = B0*dipole(r1); // diple field
 
-    // by
-    auto r2  = coord.by().vec(iglob, jglob, kglob, D); // cartesian position vector in "star's coordinates"
-    auto byd = B0*dipole(r2); // diple field
-
-    // bz
-    auto r3  = coord.bz().vec(iglob, jglob, kglob, D); // cartesian position vector in "star's coordinates"
-    auto bzd = B0*dipole(r3); // diple field
+    auto r2  = coord.by().vec(iglob, jglob, kglob, D);
+    auto byd = B0*dipole(r2);
 
-    gs.bx(i,j,k) = bxd(0);
-    gs.by(i,j,k) = byd(1);
-    gs.bz(i,j,k) = bzd(2);
+    auto r3  = coord.bz().vec(iglob, jglob, kglob, D);
+    auto bzd = B0*dipole(r3);
 
+    bg.bx(i,j,k) = bxd(0);
+    bg.by(i,j,k) = byd(1);
+    bg.bz(i,j,k) = bzd(2);
 
     //--------------------------------------------------
-    // electric field
+    // electric field; corotation E = -(Omega x r) x B at the E staggering
+    auto r4  = coord.ex().vec(iglob, jglob, kglob, D);
+    auto exd = B0*dipole(r4);
+    auto vrot1 = cross(Om, r4); // Omega x r
+    auto erot1 = -1.0f*cross(vrot1, exd); //-v x B
+
+    auto r5  = coord.ey().vec(iglob, jglob, kglob, D);
+    auto eyd = B0*dipole(r5);
+    auto vrot2 = cross(Om, r5); // Omega x r
+    auto erot2 = -1.0f*cross(vrot2, eyd);
+
+    auto r6  = coord.ez().vec(iglob, jglob, kglob, D);
+    auto ezd = B0*dipole(r6);
+    auto vrot3 = cross(Om, r6); // Omega x r
+    auto erot3 = -1.0f*cross(vrot3, ezd);
+
+    bg.ex(i,j,k) = erot1(0);
+    bg.ey(i,j,k) = erot2(1);
+    bg.ez(i,j,k) = erot3(2);
+  }}}
 
-    //--------------------------------------------------
-    // x coord staggering for Ex
-    //xr = (D>=1) ? coord.ex().x(iglob) : 0;
-    //yr = (D>=2) ? coord.ex().y(jglob) : 0;
-    //zr = (D>=3) ? coord.ex().z(kglob) : 0;
-    //r.set(xr,yr,zr);
-
-    //Bd(0) = B0*dipole(xr,yr,zr,0);
-    //Bd(1) = B0*dipole(xr,yr,zr,1);
-    //Bd(2) = B0*dipole(xr,yr,zr,2);
-
-    //auto vrot1 = cross(Om, r);
-    //auto erot1 = -1.0f*cross(vrot1, Bd);
-    //exd = erot1(0); // x component
-
-    ////--------------------------------------------------
-    //// y coord staggering for Ey
-    //xr = (D>=1) ? coord.ey().x(iglob) : 0;
-    //yr = (D>=2) ? coord.ey().y(jglob) : 0;
-    //zr = (D>=3) ? coord.ey().z(kglob) : 0;
-    //r.set(xr,yr,zr);
-
-    //Bd(0) = B0*dipole(xr,yr,zr,0);
-    //Bd(1) = B0*dipole(xr,yr,zr,1);
-    //Bd(2) = B0*dipole(xr,yr,zr,2);
-
-    //auto vrot2 = cross(Om, r);
-    //auto erot2 = -1.0f*cross(vrot2, Bd);
-    //eyd = erot2(1); // y component
-
-    ////--------------------------------------------------
-    //// z coord staggering for Ez
-    //xr = (D>=1) ? coord.ez().x(iglob) : 0;
-    //yr = (D>=2) ? coord.ez().y(jglob) : 0;
-    //zr = (D>=3) ? coord.ez().z(kglob) : 0;
-    //r.set(xr,yr,zr);
-    //        
-    //Bd(0) = B0*dipole(xr,yr,zr,0);
-    //Bd(1) = B0*dipole(xr,yr,zr,1);
-    //Bd(2) = B0*dipole(xr,yr,zr,2);
-    //        
-    //auto vrot3 = cross(Om, r);
-    //auto erot3 = -1.0f*cross(vrot3, Bd);
-    //ezd = erot3(2); // z component
-
-    //gs.ex(i,j,k) = exd;
-    //gs.ey(i,j,k) = eyd;
-    //gs.ez(i,j,k) = ezd;
+  bg.key = key;
+}
 
+
+template<size_t D>
+void emf::Conductor<D>::insert_em(
+    emf::Tile<D>& tile)
+{
+  // background tabulated only for the insertion is not kept; update_b and
+  // update_e tabulate it again on the tiles that need it
+  const bool keep = tile.has_background();
+  tabulate_background(tile);
+
+  auto& gs = tile.get_grids();
+  auto& bg = tile.get_background();
+
+  // loop indices
+  int imin, imax, jmin, jmax, kmin, kmax;
+  if(D == 1){
+    imin = -3, imax = tile.mesh_lengths[0]+3;
+    jmin =  0, jmax = 1;
+    kmin =  0, kmax = 1;
+  } else if (D == 2) {
+    imin = -3, imax = tile.mesh_lengths[0]+3;
+    jmin = -3, jmax = tile.mesh_lengths[1]+3;
+    kmin =  0, kmax = 1;
+  } else if (D == 3) {
+    imin = -3, imax = tile.mesh_lengths[0]+3;
+    jmin = -3, jmax = tile.mesh_lengths[1]+3;
+    kmin = -3, kmax = tile.mesh_lengths[2]+3;
   }
+
+  // only the magnetic dipole is inserted; E is set by update_e
+  for(int k=kmin; k<kmax; k++) 
+  for(int j=jmin; j<jmax; j++) 
+  for(int i=imin; i<imax; i++) {
+    gs.bx(i,j,k) = bg.bx(i,j,k);
+    gs.by(i,j,k) = bg.by(i,j,k);
+    gs.bz(i,j,k) = bg.bz(i,j,k);
+  }
+
+  if(!keep) tile.release_background();
 }
 
 
@@ -320,6 +328,40 @@ void emf::Conductor<D>::update_b(
     norm(x7) < 1.1*radius ||
     norm(x8) < 1.1*radius;
 
+  //--------------------------------------------------
+  // cylindrical region around the pcap
+    
+  // norm2d gives the length of the vector x and y components (ignoring z)
+  // this gives us the cylindrical coordinate
+
+  bool inside_cyl_bcs = false;
+  float rbox = 0.0;
+
+  // N/A for 1D; ignored
+
+  if(D == 2) {
+    rbox = 0.5*Nx - 0.5*tile.mesh_lengths[0]; // half of box - half tile
+                               
+    inside_cyl_bcs = 
+      norm1d(x1) > rbox || norm1d(x2) > rbox || norm1d(x3) > rbox || norm1d(x4) > rbox ||
+      norm1d(x5) > rbox || norm1d(x6) > rbox || norm1d(x7) > rbox || norm1d(x8) > rbox;
+  } else if(D == 3) {
+    rbox = 0.5*Nx-H-1; // half of box size in x direction (not incl halos)
+                               
+    inside_cyl_bcs = 
+      norm2d(x1) > rbox || norm2d(x2) > rbox || norm2d(x3) > rbox || norm2d(x4) > rbox ||
+      norm2d(x5) > rbox || norm2d(x6) > rbox || norm2d(x7) > rbox || norm2d(x8) > rbox;
+  }
+
+  //--------------------------------------------------
+  // every region below blends towards the dipole; tiles outside all of them
+  // are left untouched and never allocate the background
+  if( !(inside_star || inside_cyl_bcs || top || bot || left || right || front || back) ) return;
+
+  // analytic dipole on the Yee lattice; re-tabulated only if parameters changed
+  tabulate_background(tile);
+  auto& bg = tile.get_background();
+
   const float b_offset = 0.0; // height offset of b smoothing
 
   if( inside_star) {
@@ -338,57 +380,32 @@ void emf::Conductor<D>::update_b(
       //--------------------------------------------------
       // bx
       auto r1  = coord.bx().vec(iglob, jglob, kglob, D); // cartesian position vector in "star's coordinates"
-      auto bxd = B0*dipole(r1); // diple field
       auto h1  = abs(r1(D-1)); // cylindrical coordinate system height
       //auto sx  = shape( norm(r1), radius + b_offset, delta); // radial smoothing parameter
       auto sx  = shape( h1, radius + b_offset, delta); // radial smoothing parameter
 
       // by
       auto r2  = coord.by().vec(iglob, jglob, kglob, D); // cartesian position vector in "star's coordinates"
-      auto byd = B0*dipole(r2); // diple field
       auto h2  = abs(r2(D-1)); // cylindrical coordinate system height
       //auto sy  = shape( norm(r2), radius + b_offset, delta); // radial smoothing parameter
       auto sy  = shape( h2, radius + b_offset, delta); // radial smoothing parameter
 
       // bz
       auto r3  = coord.bz().vec(iglob, jglob, kglob, D); // cartesian position vector in "star's coordinates"
-      auto bzd = B0*dipole(r3); // diple field
       auto h3  = abs(r3(D-1)); // cylindrical coordinate system height
       //auto sz  = shape( norm(r3), radius + b_offset, delta); // radial smoothing parameter
       auto sz  = shape( h3, radius + b_offset, delta); // radial smoothing parameter
 
       //--------------------------------------------------
       // blending of old + new solution
-      gs.bx(i,j,k) = sx*bxd(0) + (1.0f - sx)*gs.bx(i,j,k); 
-      gs.by(i,j,k) = sy*byd(1) + (1.0f - sy)*gs.by(i,j,k); 
-      gs.bz(i,j,k) = sz*bzd(2) + (1.0f - sz)*gs.bz(i,j,k); 
+      gs.bx(i,j,k) = sx*bg.bx(i,j,k) + (1.0f - sx)*gs.bx(i,j,k); 
+      gs.by(i,j,k) = sy*bg.by(i,j,k) + (1.0f - sy)*gs.by(i,j,k); 
+      gs.bz(i,j,k) = sz*bg.bz(i,j,k) + (1.0f - sz)*gs.bz(i,j,k); 
     }}}
   }
 
   //--------------------------------------------------
   // damping on a cylindrical region around the pcap
-    
-  // norm2d gives the length of the vector x and y components (ignoring z)
-  // this gives us the cylindrical coordinate
-
-  bool inside_cyl_bcs = false;
-  float rbox = 0.0;
-
-  // N/A for 1D; ignored
-
-  if(D == 2) {
-    rbox = 0.5*Nx - 0.5*tile.mesh_lengths[0]; // half of box - half tile
-                               
-    inside_cyl_bcs = 
-      norm1d(x1) > rbox || norm1d(x2) > rbox || norm1d(x3) > rbox || norm1d(x4) > rbox ||
-      norm1d(x5) > rbox || norm1d(x6) > rbox || norm1d(x7) > rbox || norm1d(x8) > rbox;
-  } else if(D == 3) {
-    rbox = 0.5*Nx-H-1; // half of box size in x direction (not incl halos)
-                               
-    inside_cyl_bcs = 
-      norm2d(x1) > rbox || norm2d(x2) > rbox || norm2d(x3) > rbox || norm2d(x4) > rbox ||
-      norm2d(x5) > rbox || norm2d(x6) > rbox || norm2d(x7) > rbox || norm2d(x8) > rbox;
-  }
 
   if( (D>=2) && inside_cyl_bcs ) {
 
@@ -407,17 +424,14 @@ void emf::Conductor<D>::update_b(
       //--------------------------------------------------
       // bx
       auto r1    = coord.bx().vec(iglob, jglob, kglob, D); // cartesian position vector in "star's coordinates"
-      auto bxd   = B0*dipole(r1); // diple field
       auto rcyl1 = (D == 2) ? norm1d(r1) : norm2d(r1); // cylindrical radius
 
       // by
       auto r2    = coord.by().vec(iglob, jglob, kglob, D); // cartesian position vector in "star's coordinates"
-      auto byd   = B0*dipole(r2); // diple field
       auto rcyl2 = (D == 2) ? norm1d(r2) : norm2d(r2); // cylindrical radius
 
       // bz
       auto r3    = coord.bz().vec(iglob, jglob, kglob, D); // cartesian position vector in "star's coordinates"
-      auto bzd   = B0*dipole(r3); // diple field
       auto rcyl3 = (D == 2) ? norm1d(r3) : norm2d(r3); // cylindrical radius
 
       //--------------------------------------------------
@@ -434,9 +448,9 @@ void emf::Conductor<D>::update_b(
 
       //--------------------------------------------------
       // damp to dipole solution
-      gs.bx(i,j,k) = sx*gs.bx(i,j,k) + (1.0f-sx)*bxd(0);
-      gs.by(i,j,k) = sy*gs.by(i,j,k) + (1.0f-sy)*byd(1);
-      gs.bz(i,j,k) = sz*gs.bz(i,j,k) + (1.0f-sz)*bzd(2);
+      gs.bx(i,j,k) = sx*gs.bx(i,j,k) + (1.0f-sx)*bg.bx(i,j,k);
+      gs.by(i,j,k) = sy*gs.by(i,j,k) + (1.0f-sy)*bg.by(i,j,k);
+      gs.bz(i,j,k) = sz*gs.bz(i,j,k) + (1.0f-sz)*bg.bz(i,j,k);
     }}}
   }
 
@@ -470,19 +484,6 @@ void emf::Conductor<D>::update_b(
           //auto h = (D == 2 ) ? jglob : kglob; // height
           const auto h = (D==1) ? iglob : (D==2) ? jglob : kglob; // height
 
-          //--------------------------------------------------
-          // bx
-          auto r1  = coord.bx().vec(iglob, jglob, kglob, D); // cartesian position vector in "star's coordinates"
-          auto bxd = B0*dipole(r1); // diple field
-
-          // by
-          auto r2  = coord.by().vec(iglob, jglob, kglob, D); // cartesian position vector in "star's coordinates"
-          auto byd = B0*dipole(r2); // diple field
-
-          // bz
-          auto r3  = coord.bz().vec(iglob, jglob, kglob, D); // cartesian position vector in "star's coordinates"
-          auto bzd = B0*dipole(r3); // diple field
-
           //--------------------------------------------------
           // ver 1; tanh profile
           auto s = shape(h, radius_ext, delta_ext); // tanh
@@ -501,9 +502,9 @@ void emf::Conductor<D>::update_b(
 
           //--------------------------------------------------
           // damp to dipole solution
-          gs.bx(i,j,k) = s*gs.bx(i,j,k) + (1.0f-s)*bxd(0);
-          gs.by(i,j,k) = s*gs.by(i,j,k) + (1.0f-s)*byd(1);
-          gs.bz(i,j,k) = s*gs.bz(i,j,k) + (1.0f-s)*bzd(2);
+          gs.bx(i,j,k) = s*gs.bx(i,j,k) + (1.0f-s)*bg.bx(i,j,k);
+          gs.by(i,j,k) = s*gs.by(i,j,k) + (1.0f-s)*bg.by(i,j,k);
+          gs.bz(i,j,k) = s*gs.bz(i,j,k) + (1.0f-s)*bg.bz(i,j,k);
     }}}
   }
 
@@ -531,19 +532,6 @@ void emf::Conductor<D>::update_b(
           const auto h = (D==1) ? iglob : (D==2) ? jglob : kglob; // height
           const auto rcyl = (D==1) ? 0.0f : (D==2) ? norm1d(rvec) : norm2d(rvec); // cylindrical radius
 
-          //--------------------------------------------------
-          // bx
-          auto r1  = coord.bx().vec(iglob, jglob, kglob, D); // cartesian position vector in "star's coordinates"
-          auto bxd = B0*dipole(r1); // diple field
-
-          // by
-          auto r2  = coord.by().vec(iglob, jglob, kglob, D); // cartesian position vector in "star's coordinates"
-          auto byd = B0*dipole(r2); // diple field
-
-          // bz
-          auto r3  = coord.bz().vec(iglob, jglob, kglob, D); // cartesian position vector in "star's coordinates"
-          auto bzd = B0*dipole(r3); // diple field
-
           //--------------------------------------------------
           // ver 1; tanh profile
           //auto s = 1.0f - shape(h, radius_ext, delta_ext); // tanh
@@ -554,9 +542,9 @@ void emf::Conductor<D>::update_b(
                                                     
           //--------------------------------------------------
           // damp to dipole solution
-          gs.bx(i,j,k) = s*gs.bx(i,j,k) + (1.0f-s)*bxd(0);
-          gs.by(i,j,k) = s*gs.by(i,j,k) + (1.0f-s)*byd(1);
-          gs.bz(i,j,k) = s*gs.bz(i,j,k) + (1.0f-s)*bzd(2);
+          gs.bx(i,j,k) = s*gs.bx(i,j,k) + (1.0f-s)*bg.bx(i,j,k);
+          gs.by(i,j,k) = s*gs.by(i,j,k) + (1.0f-s)*bg.by(i,j,k);
+          gs.bz(i,j,k) = s*gs.bz(i,j,k) + (1.0f-s)*bg.bz(i,j,k);
     }}}
 
   }
@@ -587,19 +575,6 @@ void emf::Conductor<D>::update_b(
           float jglob = (D>=2) ? j + mins[1] : 0;
           float kglob = (D>=3) ? k + mins[2] : 0;
 
-          //--------------------------------------------------
-          // bx
-          auto r1  = coord.bx().vec(iglob, jglob, kglob, D); // cartesian position vector in "star's coordinates"
-          auto bxd = B0*dipole(r1); // diple field
-
-          // by
-          auto r2  = coord.by().vec(iglob, jglob, kglob, D); // cartesian position vector in "star's coordinates"
-          auto byd = B0*dipole(r2); // diple field
-
-          // bz
-          auto r3  = coord.bz().vec(iglob, jglob, kglob, D); // cartesian position vector in "star's coordinates"
-          auto bzd = B0*dipole(r3); // diple field
-
           //--------------------------------------------------
           // sides
           bool inside_bot   = (D==1) ? iglob < H    : (D==2) ? jglob < H    : kglob < H; // y or z direction flip 
@@ -623,9 +598,9 @@ void emf::Conductor<D>::update_b(
           // vector friendly application of boolean boundary
           auto s = static_cast<float>(inside_box_bcs);
 
-          gs.bx(i,j,k) = s*bxd(0) + (1.0f-s)*gs.bx(i,j,k);
-          gs.by(i,j,k) = s*byd(1) + (1.0f-s)*gs.by(i,j,k);
-          gs.bz(i,j,k) = s*bzd(2) + (1.0f-s)*gs.bz(i,j,k);
+          gs.bx(i,j,k) = s*bg.bx(i,j,k) + (1.0f-s)*gs.bx(i,j,k);
+          gs.by(i,j,k) = s*bg.by(i,j,k) + (1.0f-s)*gs.by(i,j,k);
+          gs.bz(i,j,k) = s*bg.bz(i,j,k) + (1.0f-s)*gs.bz(i,j,k);
     }}}
   }
 
@@ -638,17 +613,6 @@ void emf::Conductor<D>::update_e(
     emf::Tile<D>& tile)
 {
 
-  // angular velocity
-  Vec3<float> Om; 
-  float Omega = 2.0*PI/period;
-  if(period < EPS) Omega = 0.0; // reality check
-
-  if(D == 1) Om.set(Omega, 0.0, 0.0); // Omega unit vector along y-axis
-  if(D == 2) Om.set(0.0, Omega, 0.0); // Omega unit vector along y-axis
-  if(D == 3) Om.set( sin(chi_om)*cos(phase_om)*Omega, sin(chi_om)*sin(phase_om)*Omega, cos(chi_om)*Omega ); 
-
-  //if(D == 3) Om.set( sin(chi_om)*Omega, 0.0,   cos(chi_om)*Omega ); // general Omega unit vector 
-    
   // helper class for staggered grid positions
   StaggeredSphericalCoordinates coord(cenx,ceny,cenz,1.0);
 
@@ -905,6 +869,10 @@ void emf::Conductor<D>::update_e(
 
   if( inside_star ) {
 
+    // corotation electric field on the Yee lattice; re-tabulated only if parameters changed
+    tabulate_background(tile);
+    const auto& bg = tile.get_background();
+
     #pragma omp parallel for
     for(int k=kmin; k<kmax; k++) {
       for(int j=jmin; j<jmax; j++) {
@@ -921,7 +889,6 @@ void emf::Conductor<D>::update_e(
           //--------------------------------------------------
           // ex
           auto r1  = coord.ex().vec(iglob, jglob, kglob, D); // cartesian position vector in "star's coordinates"
-          auto bxd = B0*dipole(r1); // diple field
           auto h1  = abs(r1(D-1)); // cylindrical coordinate system height
           //auto sx  = shape( norm(r1), radius, delta); // radial smoothing parameter
           auto sx  = shape( h1, radius, delta); // height smoothing parameter
@@ -929,14 +896,11 @@ void emf::Conductor<D>::update_e(
           auto rcyl1 = (D==1) ? 0.0f : (D==2) ? norm1d(r1) : norm2d(r1); // cylindrical radius
           sx        *= shape(rcyl1, radius_pc + offs, delta_pc); // damp off edges of polar cap
                                                              
-          auto vrot1 = cross(Om, r1); // Omega x r
-          auto erot1 = -1.0f*cross(vrot1, bxd); //-v x B
 
 
           //--------------------------------------------------
           // ey
           auto r2  = coord.ey().vec(iglob, jglob, kglob, D); // cartesian position vector in "star's coordinates"
-          auto byd = B0*dipole(r2); // diple field
           auto h2  = abs(r2(D-1)); // cylindrical coordinate system height
 
           auto sy  = shape( h2, radius, delta); // height smoothing parameter
@@ -944,14 +908,11 @@ void emf::Conductor<D>::update_e(
           auto rcyl2 = (D==1) ? 0.0f : (D==2) ? norm1d(r2) : norm2d(r2); // cylindrical radius
           sy      *= shape(rcyl2, radius_pc + offs, delta_pc); // damp off edges of polar cap
 
-          auto vrot2 = cross(Om, r2); // Omega x r
-          auto erot2 = -1.0f*cross(vrot2, byd); //-v x B
 
 
           //--------------------------------------------------
           // ez
           auto r3  = coord.ez().vec(iglob, jglob, kglob, D); // cartesian position vector in "star's coordinates"
-          auto bzd = B0*dipole(r3); // diple field
           auto h3  = abs(r3(D-1)); // cylindrical coordinate system height
           //auto sz  = shape( norm(r3), radius, delta); // radial smoothing parameter
           auto sz  = shape( h3, radius, delta); // height smoothing parameter
@@ -959,15 +920,13 @@ void emf::Conductor<D>::update_e(
           auto rcyl3 = (D==1) ? 0.0f : (D==2) ? norm1d(r3) : norm2d(r3); // cylindrical radius
           sz        *= shape(rcyl3, radius_pc + offs, delta_pc); // damp off edges of polar cap
                                                              
-          auto vrot3 = cross(Om, r3); // Omega x r
-          auto erot3 = -1.0f*cross(vrot3, bzd); //-v x B
 
 
           //--------------------------------------------------
           // blending of old + new solution
-          gs.ex(i,j,k) = sx*erot1(0) + (1.0f - sx)*gs.ex(i,j,k); 
-          gs.ey(i,j,k) = sy*erot2(1) + (1.0f - sy)*gs.ey(i,j,k); 
-          gs.ez(i,j,k) = sz*erot3(2) + (1.0f - sz)*gs.ez(i,j,k); 
+          gs.ex(i,j,k) = sx*bg.ex(i,j,k) + (1.0f - sx)*gs.ex(i,j,k); 
+          gs.ey(i,j,k) = sy*bg.ey(i,j,k) + (1.0f - sy)*gs.ey(i,j,k); 
+          gs.ez(i,j,k) = sz*bg.ez(i,j,k) + (1.0f - sz)*gs.ez(i,j,k); 
 
     }}}
   }
@@ -140,6 +140,12 @@ class Conductor
 
   Vec3<float> dipole(Vec3<float>& xvec);
 
+  /// \brief tabulate the dipole B and corotation E on the tile's Yee lattice
+  //
+  // Stored in tile.background; re-tabulated only if the dipole or rotation
+  // parameters (e.g., phase_mu/phase_om) have changed since the last call.
+  void tabulate_background(emf::Tile<D>&  tile);
+
   void insert_em(emf::Tile<D>&  tile);
 
   void update_b(emf::Tile<D>&  tile);
@@ -26,6 +26,28 @@ using std::exp;
 //}
 
 
+template<
+  std::size_t D, 
+  int S
+>
+void emf::damping::Tile<D,S>::alloc_refs()
+{
+  if(ex_ref.size() > 0) return;
+
+  const int nx = emf::Tile<D>::mesh_lengths[0];
+  const int ny = emf::Tile<D>::mesh_lengths[1];
+  const int nz = emf::Tile<D>::mesh_lengths[2];
+
+  ex_ref = toolbox::Mesh<float, 1>(nx, ny, nz);
+  ey_ref = toolbox::Mesh<float, 1>(nx, ny, nz);
+  ez_ref = toolbox::Mesh<float, 1>(nx, ny, nz);
+
+  bx_ref = toolbox::Mesh<float, 1>(nx, ny, nz);
+  by_ref = toolbox::Mesh<float, 1>(nx, ny, nz);
+  bz_ref = toolbox::Mesh<float, 1>(nx, ny, nz);
+}
+
+
 /// Damp EM field into the reference field
 //
 // Combined directions:
@@ -46,6 +68,7 @@ void emf::damping::Tile<D,S>::damp_fields()
 {
 
   auto& gs = this->get_grids();
+  alloc_refs();
 
   float lambda2;
 
@@ -24,7 +24,8 @@ class Tile :
   public:
 
   //--------------------------------------------------
-  // reference field to relax tile into
+  // reference field to relax tile into; allocated on first use (see
+  // alloc_refs) so that tiles that are never damped do not carry them
 
   /// Electric field 
   toolbox::Mesh<float, 1> ex_ref;
@@ -39,17 +40,12 @@ class Tile :
 
   /// constructor
   Tile(int nx, int ny, int nz) :
-    emf::Tile<D>{nx,ny,nz},
-
-    ex_ref{nx,ny,nz},
-    ey_ref{nx,ny,nz},
-    ez_ref{nx,ny,nz},
-
-    bx_ref{nx,ny,nz},
-    by_ref{nx,ny,nz},
-    bz_ref{nx,ny,nz}
+    emf::Tile<D>{nx,ny,nz}
   { }
 
+  /// allocate the (zero) reference fields unless already done
+  void alloc_refs();
+
   //void push_e() override;
   //using Tile::push_e;
   //using Tile::push_half_b;
@@ -1,12 +1,16 @@
 
 #include <cmath>
+#include <algorithm>
 
 #include "core/emf/filters/binomial2.h"
+#include "core/emf/filters/separable.h"
 #include "external/iter/devcall.h"
 #include "external/iter/iter.h"
 #include "external/iter/allocator.h"
 
 
+#include "external/timer/tracer.h"
+
 #ifdef GPU
 #include <nvtx3/nvToolsExt.h> 
 #endif
@@ -86,7 +90,17 @@ template<>
 void emf::Binomial2<2>::solve(
     emf::Tile<2>& tile)
 {
-    
+#ifdef GPU
+  nvtxRangePush(__PRETTY_FUNCTION__);
+#endif
+
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
+#ifndef GPU
+  // separable 1-2-1 passes over [-H, N+H) with H = 2 as below
+  sweep.apply<2>(tile.get_grids(), separable::general3p(0.5), 2);
+#else
+
   // 2D 3-point binomial coefficients
   const float C2[3][3] = 
         { {1./16., 2./16., 1./16.},
@@ -156,6 +170,7 @@ void emf::Binomial2<2>::solve(
  
   UniIter::sync();
   std::swap(mesh.jz, tmp);
+#endif
 
   //--------------------------------------------------
 #ifdef GPU
@@ -173,6 +188,12 @@ void emf::Binomial2<3>::solve(
   nvtxRangePush(__PRETTY_FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
+#ifndef GPU
+  // separable 1-2-1 passes over [-H, N+H) with H = 2 as below
+  sweep.apply<3>(tile.get_grids(), separable::general3p(0.5), 2);
+#else
 
   // 3D 3-point binomial coefficients
   const float C3[3][3][3] = 
@@ -227,7 +248,7 @@ void emf::Binomial2<3>::solve(
 
   UniIter::sync();
   std::swap(mesh.jz, tmp);
-  
+#endif
 
   //--------------------------------------------------
 #ifdef GPU
@@ -236,6 +257,49 @@ void emf::Binomial2<3>::solve(
 }
 
 
+template<size_t D>
+int emf::MultiBinomial2<D>::groups() const
+{
+  const int H = 3; // current halo depth
+  const int passes = npasses + (compensate ? 1 : 0);
+  return (passes + H - 1)/H;
+}
+
+
+template<size_t D>
+void emf::MultiBinomial2<D>::solve(
+    emf::Tile<D>& tile,
+    int g)
+{
+#ifdef GPU
+  nvtxRangePush(__PRETTY_FUNCTION__);
+#endif
+
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
+  const int H = 3; // current halo depth
+  const int passes = npasses + (compensate ? 1 : 0);
+
+  // pass p of the group reads [-H+p, N+H-p) and fills one cell less
+  for(int q=g*H; q<std::min(passes, (g+1)*H); q++) {
+    const int R = H - 1 - q%H;
+
+    if(compensate && q == passes-1) {
+      sweep.apply<D>(tile.get_grids(), separable::compensator2<D>(), R);
+    } else {
+      sweep.apply<D>(tile.get_grids(), separable::general3p(0.5), R);
+    }
+  }
+
+#ifdef GPU
+  nvtxRangePop();
+#endif
+}
+
+
 template class emf::Binomial2<1>; // 1D
 template class emf::Binomial2<2>; // 2D
 template class emf::Binomial2<3>; // 3D
+
+template class emf::MultiBinomial2<2>; // 2D
+template class emf::MultiBinomial2<3>; // 3D
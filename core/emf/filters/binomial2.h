@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/emf/filters/filter.h"
+#include "core/emf/filters/separable.h"
 
 namespace emf {
 
@@ -13,8 +14,48 @@ class Binomial2 :
 
   using Filter<D>::Filter;
 
+  /// slice buffers of the separable 2D/3D passes
+  separable::Sweep sweep;
+
   void solve(emf::Tile<D>& tile) override;
 
 };
 
+
+/// Several Binomial2 passes per current halo update
+//
+// A pass leaves valid values one cell less deep into the halo, so one
+// update of the 3-cell halo (update_boundaries with the currents) serves
+// three passes on the shrinking regions [-2, N+2), [-1, N+1), and [0, N).
+// The passes are split into groups() such groups; group g is applied by
+// solve(tile, g) after the halo update of that group. An optional
+// Compensator2 pass counts as the last pass.
+template<size_t D>
+class MultiBinomial2 :
+  public virtual Filter<D>
+{
+  public:
+
+  using Filter<D>::Filter;
+
+  /// number of binomial passes
+  int npasses = 1;
+
+  /// apply Compensator2 after the binomial passes
+  bool compensate = false;
+
+  /// slice buffers of the separable passes
+  separable::Sweep sweep;
+
+  /// number of halo updates (pass groups) needed
+  int groups() const;
+
+  /// passes of group g
+  void solve(emf::Tile<D>& tile, int g);
+
+  /// passes of the first group
+  void solve(emf::Tile<D>& tile) override { solve(tile, 0); }
+
+};
+
 } // end of namespace emf
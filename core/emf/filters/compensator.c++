@@ -6,6 +6,8 @@
 #include "external/iter/iter.h"
 #include "external/iter/allocator.h"
 
+#include "external/timer/tracer.h"
+
 
 #ifdef GPU
 #include <nvtx3/nvToolsExt.h> 
@@ -23,6 +25,16 @@ template<>
 void emf::Compensator2<2>::solve(
     emf::Tile<2>& tile)
 {
+#ifdef GPU
+  nvtxRangePush(__PRETTY_FUNCTION__);
+#endif
+
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
+#ifndef GPU
+  // 21/12 f minus the separable 3x3 box sum over [-H, N+H) with H = 2 as below
+  sweep.apply<2>(tile.get_grids(), separable::compensator2<2>(), 2);
+#else
   // 2D general coefficients
   const double winv=1./12.; //normalization
   const double wtm=20.0*winv, //middle M
@@ -84,6 +96,7 @@ void emf::Compensator2<2>::solve(
  
   UniIter::sync();
   std::swap(mesh.jz, tmp);
+#endif
 
   //--------------------------------------------------
 #ifdef GPU
@@ -92,7 +105,29 @@ void emf::Compensator2<2>::solve(
 }
 
 
+/// 3D compensator; 7/4 f minus the 27-point box sum over 36,
+//  as separable passes over [-2, N+2)
+//
+// NOTE: runs on the host also in GPU builds
+template<>
+void emf::Compensator2<3>::solve(
+    emf::Tile<3>& tile)
+{
+#ifdef GPU
+  nvtxRangePush(__PRETTY_FUNCTION__);
+#endif
+
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
+  sweep.apply<3>(tile.get_grids(), separable::compensator2<3>(), 2);
+
+#ifdef GPU
+  nvtxRangePop();
+#endif
+}
+
+
 
 //template class emf::Compensator2<1>; // 1D
   template class emf::Compensator2<2>; // 2D
-//template class emf::Compensator2<3>; // 3D
+  template class emf::Compensator2<3>; // 3D
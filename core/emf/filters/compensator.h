@@ -1,10 +1,14 @@
 #pragma once
 
 #include "core/emf/filters/filter.h"
+#include "core/emf/filters/separable.h"
 
 namespace emf {
 
 /// 2D 3-point compensator filter from Birdsall & Langdon
+//
+// The 3D version has the same form with the 27-point box
+// (see separable::compensator2).
 template<size_t D>
 class Compensator2 :
   public virtual Filter<D>
@@ -13,6 +17,9 @@ class Compensator2 :
 
   using Filter<D>::Filter;
 
+  /// slice buffers of the separable passes
+  separable::Sweep sweep;
+
   void solve(emf::Tile<D>& tile) override;
 
 };
@@ -1,720 +1,426 @@
-#pragma once
-
-#include <iostream>
-#include <vector>
-#include <tuple>
+#include <cmath>
 #include <cassert>
+#include <initializer_list>
+#include <stdexcept>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include <fftw3.h>
 
-#include "core/emf/tile.h"
-//#include "communicate.h"
-
-#include "units.h"
-#include "fftw3.h"
-
-
-
-namespace emf {
-
+#include "core/emf/filters/fourier.h"
 
+#include "external/timer/tracer.h"
 
+#ifdef GPU
+#include <nvtx3/nvToolsExt.h>
+#endif
 
-using units::pi;
+#ifndef _OPENMP
+namespace {
+// single-threaded fftw plans when built without OpenMP threads (e.g. -fopenmp-simd)
+inline int omp_get_max_threads() { return 1; }
+}
+#endif
 
-//! Spatial current filter using fftw
-//
-// Because of the fftw3 usage this class is internally heavily relying on C code
-// instead of C++.
-class Filter {
 
-  private:
+//--------------------------------------------------
+// k-space kernels
 
-  /// image size
-  int Nx, Ny, Nz;
+emf::fourier::Kernel emf::fourier::binomial(int npasses)
+{
+  auto response = [npasses](float kx, float ky, float kz) {
+    const float c = std::cos(0.5f*kx)*std::cos(0.5f*ky)*std::cos(0.5f*kz);
+    return float( std::pow(c*c, npasses) );
+  };
 
-    
-  /// circular/wrap indexing
-  inline int circular(int x, int M)
-  {
-    if(x<0)    return x+M;
-    if(x >= M) return x-M;
-    return x;
-  }
+  return { response, npasses };
+}
 
-  /// internal circular indexing, 
-  // NOTE: this is different from the rest of the code but done like this
-  // in order to appear consistent with the fttw examples.
-  inline int index(int i, int j) {
-    i = circular(i, Nx);
-    j = circular(j, Ny);
 
-    assert(i >= 0 && i < Nx);
-    assert(j >= 0 && j < Ny);
+emf::fourier::Kernel emf::fourier::compensated(int npasses)
+{
+  const auto smooth = binomial(npasses).response;
+  const float a = 0.5f*npasses; // alpha - 1 of the compensator
 
-    return i + j*Nx;
-  }
+  auto response = [=](float kx, float ky, float kz) {
+    return smooth(kx, ky, kz)
+      *(1.0f + a*(1.0f - std::cos(kx)))
+      *(1.0f + a*(1.0f - std::cos(ky)))
+      *(1.0f + a*(1.0f - std::cos(kz)));
+  };
 
+  return { response, npasses + 1 };
+}
 
-  /// neighbor-padded arrays for convolution
-  fftwf_complex *jx, *jy, *jz;
 
-  /// actual (zero-padded) convolution kernel
-  fftwf_complex *kernel;
+emf::fourier::Kernel emf::fourier::cutoff(float kmax, int reach)
+{
+  auto response = [kmax](float kx, float ky, float kz) {
+    return kx*kx + ky*ky + kz*kz < kmax*kmax ? 1.0f : 0.0f;
+  };
 
-  /// fftw3 transform plans
-  fftwf_plan p_kernel, 
-            p_forw_jx, p_forw_jy, p_forw_jz, 
-            p_back_jx, p_back_jy, p_back_jz;
+  return { response, reach };
+}
 
-  public:
 
-  /// Build filter assuming information from 3x3x1 tiles
-  Filter(int NxMesh, int NyMesh) :
-      Nx( 3*NxMesh ),
-      Ny( 3*NyMesh ),
-      Nz( 1) 
-  {
+//--------------------------------------------------
+// transforms
 
-    // allocate
-    //jx = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * Nx*Ny*Nz);
-    //jy = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * Nx*Ny*Nz);
-    //jz = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * Nx*Ny*Nz);
-    jx = (fftwf_complex*) fftwf_alloc_complex(Nx*Ny*Nz);
-    jy = (fftwf_complex*) fftwf_alloc_complex(Nx*Ny*Nz);
-    jz = (fftwf_complex*) fftwf_alloc_complex(Nx*Ny*Nz);
+namespace {
 
-    for(int j = 0 ; j < Ny ; ++j) {
-      for(int i = 0 ; i < Nx ; ++i) {
-        jx[ index(i,j) ][0] = 0.0;
-        jx[ index(i,j) ][1] = 0.0;
+/// smallest size >= n with only the prime factors 2, 3, 5, and 7
+int good_size(int n)
+{
+  for(;; n++) {
+    int m = n;
+    for(int f : {2, 3, 5, 7}) while(m % f == 0) m /= f;
+    if(m == 1) return n;
+  }
+}
 
-        jy[ index(i,j) ][0] = 0.0;
-        jy[ index(i,j) ][1] = 0.0;
+/// wavenumber of mode m of a periodic box of L cells
+float wavenumber(int m, int L)
+{
+  const double pi = 3.14159265358979323846;
+  return 2.0*pi*(2*m <= L ? m : m - L)/L;
+}
 
-        jz[ index(i,j) ][0] = 0.0;
-        jz[ index(i,j) ][1] = 0.0;
-      }
-    }
+/// threaded planning is enabled once per process
+void init_threads()
+{
+  static const bool done = fftwf_init_threads() != 0;
+  (void)done;
+}
 
+} // end of anonymous namespace
 
-    //kernel = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * Nx*Ny*Nz);
-    kernel = (fftwf_complex*) fftwf_alloc_complex(Nx*Ny*Nz);
 
+/// batched r2c/c2r transforms of jx/jy/jz in a padded box
+//
+// The three real components are stored one after another in image and
+// their half-spectra in modes; one guru plan transforms all of them.
+template<size_t D>
+struct emf::Fourier<D>::Plan {
 
-    // in-place complex to complex transform
-    // TODO: change to real2complex and complex2real plans
-    // TODO: use fftw guru interface to apply same plan for all arrays (in same direction)
-    p_kernel    = fftwf_plan_dft_2d( Nx,Ny, kernel, kernel, FFTW_FORWARD,  FFTW_MEASURE);
+  /// padded box size; 1 along collapsed dimensions
+  std::array<int,3> L;
 
-    p_forw_jx   = fftwf_plan_dft_2d( Nx,Ny, jx, jx, FFTW_FORWARD,  FFTW_MEASURE );
-    p_forw_jy   = fftwf_plan_dft_2d( Nx,Ny, jy, jy, FFTW_FORWARD,  FFTW_MEASURE );
-    p_forw_jz   = fftwf_plan_dft_2d( Nx,Ny, jz, jz, FFTW_FORWARD,  FFTW_MEASURE );
+  /// real and complex elements per component
+  size_t nr, nc;
 
-    p_back_jx   = fftwf_plan_dft_2d( Nx,Ny, jx, jx, FFTW_BACKWARD, FFTW_MEASURE );
-    p_back_jy   = fftwf_plan_dft_2d( Nx,Ny, jy, jy, FFTW_BACKWARD, FFTW_MEASURE );
-    p_back_jz   = fftwf_plan_dft_2d( Nx,Ny, jz, jz, FFTW_BACKWARD, FFTW_MEASURE );
+  float* image;
+  fftwf_complex* modes;
 
+  /// kernel response per mode, divided by the box volume
+  std::vector<float> response;
 
-    /*
-    fftw_print_plan(p_forw_jx);
-    fftw_print_plan(p_forw_jy);
-    fftw_print_plan(p_forw_jy);
+  fftwf_plan forward, backward;
 
-    fftw_print_plan(p_back_jx);
-    fftw_print_plan(p_back_jy);
-    fftw_print_plan(p_back_jz);
-    */
-  }
+  explicit Plan(const std::array<int,3>& L) :
+    L{L}
+  {
+    // fftwf_init_threads has to precede any other fftw call
+    init_threads();
 
+    const int Lh = L[0]/2 + 1; // modes along x of the real transform
+    nr = size_t(L[0])*L[1]*L[2];
+    nc = size_t(Lh)*L[1]*L[2];
 
-  /// explicit destructor for fftw arrays and plans
-  virtual ~Filter() {
-    fftwf_free(jx);
-    fftwf_free(jy);
-    fftwf_free(jz);
-    fftwf_free(kernel);
+    image = fftwf_alloc_real(3*nr);
+    modes = fftwf_alloc_complex(3*nc);
+    response.resize(nc);
 
-    fftwf_destroy_plan(p_forw_jx);
-    fftwf_destroy_plan(p_forw_jy);
-    fftwf_destroy_plan(p_forw_jz);
+    // row-major dimensions with the slowest first; collapsed ones are dropped
+    fftwf_iodim fw[3], bw[3];
+    int rank = 0;
+    if(D >= 3) { fw[rank] = {L[2], L[0]*L[1], Lh*L[1]}; rank++; }
+    if(D >= 2) { fw[rank] = {L[1], L[0],      Lh     }; rank++; }
+    fw[rank] = {L[0], 1, 1}; rank++;
 
-    fftwf_destroy_plan(p_back_jx);
-    fftwf_destroy_plan(p_back_jy);
-    fftwf_destroy_plan(p_back_jz);
-  }
+    for(int r=0; r<rank; r++) bw[r] = {fw[r].n, fw[r].os, fw[r].is};
 
+    // one transform per current component
+    const fftwf_iodim fbatch = {3, int(nr), int(nc)};
+    const fftwf_iodim bbatch = {3, int(nc), int(nr)};
 
-  /// zero-padded centralized index
-  //
-  //NOTE:
-  // The FFT is relative to the middle and in its scale there are negative points.
-  // In the memory the points are 0...n-1, but the FFT treats them as 
-  // -ceil(n/2)...floor(n/2), 
-  // where 0 is -ceil(n/2) and n-1 is floor(n/2)
-  //
-  //NOTE: this is not how fftw3 does its indexing anymore!
-  //
-  //inline virtual std::tuple<int,int> zero_padded_index(int i, int j) 
-  //{
-  //  int iff = ceil(height/2);
-  //  int jff = ceil(width /2);
-  //  
-  //  return std::make_tuple(iff, jff);
-  //}
-
-  /// zero-wrapped index convention used by fftw3
-  inline virtual std::tuple<int,int> zero_wrapped_index(int i, int j) 
-  {
-    int iff = i >= 0 ? i : Nx + i;
-    int jff = j >= 0 ? j : Ny + j;
+    fftwf_plan_with_nthreads(omp_get_max_threads());
 
-    return std::make_tuple(iff, jff);
+    forward  = fftwf_plan_guru_dft_r2c(rank, fw, 1, &fbatch, image, modes, FFTW_MEASURE);
+    backward = fftwf_plan_guru_dft_c2r(rank, bw, 1, &bbatch, modes, image, FFTW_MEASURE);
   }
 
-
-  /// initialize kernel 
-  //
-  // In practice this is just a complex way to set kernel[0,0] = 1,
-  // but we do it like this for clarity as the syntax is used later on.
-  virtual void init_kernel() 
+  ~Plan()
   {
-    float val;
-
-    // kernel size (even number because of initialization)
-    //int knx = height/3;
-    //int kny = width /3;
-
-    // halo region size
-    int h1 = Nx/2; // division is floor(x/y) automatically
-    int w1 = Ny/2;
-    //int h2 = (height + 2 - 1)/2; // ceil(x/y)
-    //int w2 = (width  + 2 - 1)/2;
-
-    int wi,wj;
-
-    for(int j=-w1; j<=w1 ; ++j) {
-      for(int i =-h1; i<=h1 ; ++i) {
-        auto zindx = zero_wrapped_index(i,j);
-        wi = std::get<0>(zindx);
-        wj = std::get<1>(zindx);
-          
-        val = 0.0;
-        if ((i ==  0) && (j ==  0)) val = 1.0;
-
-        //if ((i ==  1) && (j ==  0)) val = 1.0;
-        //if ((i ==  0) && (j ==  1)) val = 1.0;
-        //if ((i ==  1) && (j ==  1)) val = 1.0;
-        //if ((i == -1) && (j ==  0)) val = 1.0;
-        //if ((i ==  0) && (j == -1)) val = 1.0;
-        //if ((i == -1) && (j == -1)) val = 1.0;
-        //if ((i == 1 ) && (j == -1)) val = 1.0;
-        //if ((i ==-1 ) && (j ==  1)) val = 1.0;
-        
-        kernel[ index(wi,wj) ][0] = val; // real part
-        kernel[ index(wi,wj) ][1] = 0.0; // complex part
-      }
-    }
+    fftwf_destroy_plan(forward);
+    fftwf_destroy_plan(backward);
+    fftwf_free(image);
+    fftwf_free(modes);
   }
 
-
-  /// Apply 3-point digital filter directly
-  virtual void direct_convolve_3point()
+  /// tabulate the response of kernel k
+  void tabulate(const emf::fourier::Kernel& k)
   {
-
-    // 3-point digital filter
-    std::vector<float> coeffs = {{ 1., 2., 1.,
-                                    2., 4., 2.,
-                                    1., 2., 1. }};
-    // normalize
-    float norm = 0.0;
-    for(auto& coeff : coeffs) norm += coeff;
-    for(auto& coeff : coeffs) coeff /= norm;
-
-    std::vector<float> image1, image2, image3;
-    image1.resize(Nx*Ny*Nz); 
-    image2.resize(Nx*Ny*Nz); 
-    image3.resize(Nx*Ny*Nz); 
-
-    for (int j=0; j < Ny;  ++j) {
-      for (int i=0; i < Nx; ++i) {
-        image1[ index(i,j) ] = jx[ index(i,j) ][0];
-        image2[ index(i,j) ] = jy[ index(i,j) ][0];
-        image3[ index(i,j) ] = jz[ index(i,j) ][0];
-      }
-    }
-
-    direct_convolve(image1.data(), coeffs.data(), sqrt( coeffs.size() ) );
-    direct_convolve(image2.data(), coeffs.data(), sqrt( coeffs.size() ) );
-    direct_convolve(image3.data(), coeffs.data(), sqrt( coeffs.size() ) );
-
-    // normalize and copy back
-    norm = 1.0;
-    for (int j=0; j < Ny;  ++j) {
-      for (int i=0; i < Nx; ++i) {
-        jx[ index(i,j) ][0] = image1[ index(i,j) ]/norm;
-        jy[ index(i,j) ][0] = image2[ index(i,j) ]/norm;
-        jz[ index(i,j) ][0] = image3[ index(i,j) ]/norm;
-      }
+    const int Lh = L[0]/2 + 1;
+    const float norm = 1.0f/nr; // the transforms are unnormalized
+
+    for(int c=0; c<L[2]; c++)
+    for(int b=0; b<L[1]; b++)
+    for(int a=0; a<Lh;   a++) {
+      response[a + Lh*(b + L[1]*c)] =
+        norm*k.response(wavenumber(a, L[0]), wavenumber(b, L[1]), wavenumber(c, L[2]));
     }
-
-
   }
+};
 
 
-  /// initialize 3-point digital filter into kernel array for FFT transformations
-  virtual void init_3point_kernel(int times)
-  {
-
-    // kernel
-    //int K = 3; // three point kernel
-
-    // 3-point digital filter
-    std::vector<float> coeffs = {{ 1., 2., 1.,
-                                    2., 4., 2.,
-                                    1., 2., 1. }};
+template<size_t D>
+emf::Fourier<D>::Fourier(int Nx, int Ny, int Nz) :
+  Filter<D>(Nx, Ny, Nz)
+{ }
 
-    float norm = 0.0;
-    for(auto& coeff : coeffs) norm += coeff;
-    for(auto& coeff : coeffs) coeff /= norm;
 
+template<size_t D>
+emf::Fourier<D>::~Fourier() = default;
 
-    // create temporary Real number image array
-    // NOTE: can not easily copy kernel into pure real part due to interleaved nature
-    std::vector<float> image;
-    image.resize(Nx*Ny*Nz); 
 
-    for (int j=0; j < Ny;  ++j) 
-    for (int i=0; i < Nx; ++i)
-        image[ index(i,j) ] = kernel[ index(i,j) ][0];
+template<size_t D>
+typename emf::Fourier<D>::Plan& emf::Fourier<D>::plan(
+    const std::array<int,3>& L)
+{
+  auto it = plans.find(L);
+  if(it != plans.end()) return *it->second;
 
-    // perform convolution N times
-    for(int N=0; N < times; N++) direct_convolve(image.data(), coeffs.data(), sqrt( coeffs.size() ) );
-    
-    // normalize
-    // norm = 0.0;
-    //for (int i=0; i < height; ++i)
-    //  for (int j=0; j < width;  ++j) 
-    //    norm += image[ index(i,j) ];
-    norm = 1.0;
+  auto p = std::make_unique<Plan>(L);
+  p->tabulate(kernel);
 
-    // normalize and copy back
-    for (int j=0; j < Ny;  ++j) 
-      for (int i=0; i < Nx; ++i)
-        kernel[ index(i,j) ][0] = image[ index(i,j) ]/norm;
+  return *(plans[L] = std::move(p));
+}
 
-  }
 
+template<size_t D>
+void emf::Fourier<D>::set_kernel(
+    const fourier::Kernel& k)
+{
+  kernel = k;
+  for(auto& [L, p] : plans) p->tabulate(kernel);
+}
 
-  /// Direct circular convolve two arrays
-  // NOTE: assumes height x width for image size
-  //
-  // in, out are m x n images (integer data)
-  // K is the kernel size (KxK) - currently needs to be an odd number, e.g. 3
-  // coeffs[K][K] is a 2D array of integer coefficients
-  // scale is a scaling factor to normalise the filter gain
-  //
-  void direct_convolve(
-      float* image,
-      float* kernel,
-      int K)
-  {
 
-    // out array
-    float data;
-    std::vector<float> out;
-    out.resize(Nx*Ny*Nz);
-
-    //for (int j = K/2; j < width -K/2; ++j) // iterate through image
-    for (int j=0; j < Ny; ++j) // iterate through circular image
-    {
-      //for (int i = K/2; i < height - K/2; ++i) // iterate through image
-      for (int i=0; i < Nx; ++i) // iterate through circular image
-      {
-        float sum = 0.0; // sum will be the sum of input data * coeff terms
-
-        // convolution of single point
-        for (int jj = -K/2; jj <= K/2; ++jj)
-        {
-          for (int ii = -K/2; ii <= K/2; ++ii) // iterate over kernel
-          {
-            data = image[ index(i+ii, j+jj) ]; 
-            float coeff = kernel[ (ii + K/2)*K + (jj + K/2) ];
-
-            sum += data * coeff;
-          }
-        }
-        out[ index(i,j) ] = sum; // sum of convolution products and store in output
-      }
-    } // end of conv
+template<size_t D>
+template<typename Source, typename Dest>
+void emf::Fourier<D>::filter(
+    emf::Tile<D>& tile,
+    const std::array<int,3>& pad,
+    const Source& source,
+    const Dest& dest)
+{
+  const std::array<int,3> N = {{ tile.mesh_lengths[0], tile.mesh_lengths[1], tile.mesh_lengths[2] }};
 
-    // copy (real part) back
-    for (int j=0; j < Ny;  ++j) 
-      for (int i=0; i < Nx; ++i)
-        image[ index(i,j) ] = out[ index(i,j) ];
+  std::array<int,3> L;
+  for(size_t d=0; d<3; d++) L[d] = d < D ? good_size(N[d] + 2*pad[d]) : 1;
 
-  } 
+  Plan& p = plan(L);
 
+  // tile offset of cell c along dimension d; 2 beyond the padding
+  auto offset = [&](int c, int d) { return c < 0 ? -1 : c < N[d] ? 0 : c < N[d] + pad[d] ? 1 : 2; };
 
+  //--------------------------------------------------
+  // gather the padded currents; box cell b holds tile cell b - pad
+  #pragma omp parallel for collapse(2)
+  for(int z=0; z<L[2]; z++)
+  for(int y=0; y<L[1]; y++) {
+    const int j = y - pad[1];
+    const int k = z - pad[2];
+    const int oj = offset(j, 1);
+    const int ok = offset(k, 2);
 
+    const size_t row = size_t(L[0])*(y + size_t(L[1])*z);
 
-  /// initialize Gaussian kernel given the sigma
-  virtual void init_gaussian_kernel(float sigx, float sigy) 
-  {
-    // kernel size (even number because of initialization)
-    //int knx = height/3;
-    //int kny = width /3;
-
-    // halo region size
-    int h1 = Nx/2; // division is floor(x/y) automatically
-    int w1 = Ny /2;
-    int h2 = (Nx + 2 - 1)/2; // ceil(x/y)
-    int w2 = (Ny + 2 - 1)/2;
-
-    int wi,wj;
-    float val;
-
-    float sum = 0.0;
-    for(int j=-w1; j<w2; ++j) {
-      for(int i =-h1; i<h2; ++i) {
-        auto zindx = zero_wrapped_index(i,j);
-        wi = std::get<0>(zindx);
-        wj = std::get<1>(zindx);
-
-        assert(wi >= 0 && wi < Nx);
-        assert(wj >= 0 && wj < Ny);
-
-        val = 1.0;
-        val *= exp( -0.5*((float)(i*i))/sigx/sigx);
-        val *= exp( -0.5*((float)(j*j))/sigy/sigy);
-
-        kernel[ index(wi,wj) ][0] = val; // real part
-        kernel[ index(wi,wj) ][1] = 0.0; // complex part
-        sum += val;
-      }
-    }
+    // x segments of the lower neighbour, the tile, the upper neighbour, and
+    // the zeros that fill the box up to its transform size
+    const int edges[5] = { -pad[0], 0, N[0], N[0] + pad[0], L[0] - pad[0] };
 
-    // normalize 
-    //for(int i=0; i<height; ++i)
-    //for(int j=0; j<width;  ++j)
-    //  kernel[ index(i,j) ][0] /= sum;
+    for(int oi=-1; oi<=2; oi++) {
+      const int i0 = edges[oi+1];
+      const int i1 = edges[oi+2];
 
-  }
+      const auto src = oi == 2 || oj == 2 || ok == 2 ? decltype(source(0,0,0)){} : source(oi, oj, ok);
 
+      for(int c=0; c<3; c++) {
+        float* dst = p.image + c*p.nr + row + pad[0];
 
-  /// initialize 2d box sinc filter (in frequency space)
-  /*
-  virtual void init_sinc_kernel(double X, double Y) 
-  {
-    double val, u,v;
-    int h2 = floor(height/2);
-    int w2 = floor(width /2);
-    int wi, wj;
-
-    double sum = 0.0;
-    for(int i =-h2; i<=h2 ; ++i) {
-      for(int j=-w2; j<=w2 ; ++j) {
-        auto zindx = zero_wrapped_index(i,j);
-        wi = std::get<0>(zindx);
-        wj = std::get<1>(zindx);
-
-        u = (double)i;
-        v = (double)j;
-
-        val = 0.0;
-        if ((abs(i) < height/3) || (abs(j) < width/3)){
-          val = X*sin(pi*X*u)/(pi*X*u) * 
-                Y*sin(pi*Y*v)/(pi*Y*v);
+        if(src.gs == nullptr) {
+          for(int i=i0; i<i1; i++) dst[i] = 0.0f;
+          continue;
         }
-        //val = (X*sin(pi*X*u)/(pi*X*u)) * (Y*sin(pi*Y*v)/(pi*Y*v));
-        if ((i == 0) && (j == 0)) val = 4.0*pi*pi*X*Y; // center to avoid 0/0
-        else if (i == 0) val = 2.0*pi*X*Y*sin(pi*Y*v)/(pi*Y*v);
-        else if (j == 0) val = 2.0*pi*X*Y*sin(pi*X*u)/(pi*X*u);
-
-        // windowing
-        val *= 0.42 - 0.5*cos(2*pi*3.0/height) + 0.08*cos(4.0*pi*3.0/height);
-        val *= 0.42 - 0.5*cos(2*pi*3.0/width ) + 0.08*cos(4.0*pi*3.0/width);
-
-        kernel[ index(wi,wj) ][0] = val; // real part
-        kernel[ index(wi,wj) ][1] = 0.0; // complex part
-        sum += val;
-      }
-    }
-
-    // normalize 
-    for(int i =0; i<height ; ++i)
-    for(int j=0; j<width ; ++j)
-      kernel[ index(i,j) ][0] /= sum;
-
-  }
-  */
 
+        const toolbox::Mesh<float,3>& m = c == 0 ? src.gs->jx : c == 1 ? src.gs->jy : src.gs->jz;
+        const float* f = m.data() + m.indx(-src.s[0], j - src.s[1], k - src.s[2]);
 
-  /// Low-pass filter in frequency space
-  // uses cutoff to describe how many array elements are filtered
-  virtual void init_lowpass_fft_kernel(int cutoff) 
-  {
-
-    // kernel size (even number because of initialization)
-    //int knx = height/3;
-    //int kny = width /3;
-
-    // halo region size
-    int h1 = Nx/2; // division is floor(x/y) automatically
-    int w1 = Ny/2;
-    int h2 = (Nx + 2 - 1)/2; // ceil(x/y)
-    int w2 = (Ny + 2 - 1)/2;
-
-    int wi,wj;
-    float val;
-
-    float sum = 0.0;
-    for(int i =-h1; i<h2; ++i) {
-      for(int j=-w1; j<w2; ++j) {
-        auto zindx = zero_wrapped_index(i,j);
-        wi = std::get<0>(zindx);
-        wj = std::get<1>(zindx);
-
-        assert(wi >= 0 && wi < Nx);
-        assert(wj >= 0 && wj < Ny);
-
-        val = 0.0;
-        if (sqrt(i*i + j*j) < cutoff) val = 1.0; // circle (Bessel)
-        //if ((sqrt(i*i) < cutoff) && (sqrt(j*j) < cutoff)) val = 1.0; // box (2D Sinc)
-
-        kernel[ index(wi,wj) ][0] = val; // real part
-        kernel[ index(wi,wj) ][1] = 0.0; // complex part
-        sum += val;
+        #pragma omp simd
+        for(int i=i0; i<i1; i++) dst[i] = f[i];
       }
     }
   }
 
+  //--------------------------------------------------
+  // filter all three components in k-space
+  fftwf_execute(p.forward);
 
-  // normalize fft transformation
-  void normalize() 
-  {
-    for(int k = 0 ; k < Nz ; ++k) {
-      for(int j = 0 ; j < Ny ; ++j) {
-        for(int i  = 0 ; i < Nx ; ++i) {
-          jx[ index(i,j) ][0] /= Nx*Ny*Nz;
-          jy[ index(i,j) ][0] /= Nx*Ny*Nz;
-          jz[ index(i,j) ][0] /= Nx*Ny*Nz;
-        }
-      }
-    }
+  #pragma omp parallel for collapse(2)
+  for(int c=0; c<3; c++)
+  for(size_t n=0; n<p.nc; n++) {
+    p.modes[c*p.nc + n][0] *= p.response[n];
+    p.modes[c*p.nc + n][1] *= p.response[n];
   }
 
+  fftwf_execute(p.backward);
 
+  //--------------------------------------------------
+  // scatter the interior
+  #pragma omp parallel for collapse(2)
+  for(int k=0; k<N[2]; k++)
+  for(int j=0; j<N[1]; j++) {
+    const size_t row = size_t(L[0])*((j + pad[1]) + size_t(L[1])*(k + pad[2])) + pad[0];
 
+    for(int c=0; c<3; c++) {
+      const float* src = p.image + c*p.nr + row;
+      float* f = dest(c, j, k);
 
-  /// FFT kernel (once is enough)
-  virtual void fft_kernel() { fftwf_execute(p_kernel); }
-
-  /// FFT image forward
-  virtual void fft_image_forward()  
-  { 
-    fftwf_execute(p_forw_jx);   
-    fftwf_execute(p_forw_jy);   
-    fftwf_execute(p_forw_jz);   
+      #pragma omp simd
+      for(int i=0; i<N[0]; i++) f[i] = src[i];
+    }
   }
+}
 
-  /// FFT image backwards and normalize 
-  virtual void fft_image_backward() { 
-    fftwf_execute(p_back_jx);
-    fftwf_execute(p_back_jy);
-    fftwf_execute(p_back_jz);
-    normalize();
-  }
 
+namespace {
 
-  /// Multiply kernel and image
-  void apply_kernel()
-  {
-    float x1, y1, x2, y2, x3, y3;
-    float u, v;
-    for(int j = 0 ; j < Ny ; ++j) {
-      for(int i  = 0 ; i < Nx ; ++i) {
+/// grids of a padding tile and the shift of their cell indices
+struct Shifted {
+  const emf::Grids* gs = nullptr;
+  std::array<int,3> s = {{0,0,0}};
+};
 
-        x1 = jx[ index(i,j) ][0];
-        y1 = jx[ index(i,j) ][1];
+} // end of anonymous namespace
 
-        x2 = jy[ index(i,j) ][0];
-        y2 = jy[ index(i,j) ][1];
 
-        x3 = jz[ index(i,j) ][0];
-        y3 = jz[ index(i,j) ][1];
+template<size_t D>
+void emf::Fourier<D>::solve(
+    emf::Tile<D>& tile)
+{
+  const int H = 3; // halo of the tile meshes
 
-        u = kernel[ index(i,j) ][0];
-        v = kernel[ index(i,j) ][1];
+  if(kernel.reach > H)
+    throw std::invalid_argument("Fourier::solve: kernel reaches beyond the tile halo; use solve(tile, grid)");
 
-        jx[ index(i,j) ][0] = x1*u - y1*v;
-        jx[ index(i,j) ][1] = x1*v + y1*u;
+#ifdef GPU
+  nvtxRangePush(__PRETTY_FUNCTION__);
+#endif
 
-        jy[ index(i,j) ][0] = x2*u - y2*v;
-        jy[ index(i,j) ][1] = x2*v + y2*u;
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
 
-        jz[ index(i,j) ][0] = x3*u - y3*v;
-        jz[ index(i,j) ][1] = x3*v + y3*u;
-      }
-    }
+  std::array<int,3> pad = {{0,0,0}};
+  for(size_t d=0; d<D; d++) pad[d] = kernel.reach;
 
+  // the halo cells of the tile itself
+  auto& gs = tile.get_grids();
+  toolbox::Mesh<float,3>* ms[3] = {&gs.jx, &gs.jy, &gs.jz};
 
-  }
+  filter(tile, pad,
+    [&](int, int, int) { return Shifted{&gs, {{0,0,0}}}; },
+    [&](int c, int j, int k) { return ms[c]->data() + ms[c]->indx(0, j, k); });
 
+#ifdef GPU
+  nvtxRangePop();
+#endif
+}
 
-  /// Copy currents from neighbors into fftw array
-  void get_padded_current(
-      emf::Tile<2>& tile, 
-      corgi::Grid<2>& grid
-      )
-  {
 
-    //int NxMesh = tile.Nx;
-    //int NyMesh = tile.Ny;
-    //int NzMesh = tile.Nz;
-    int indx;
-
-    // copy local patch to filter's memory
-    emf::Grids& mesh = tile.get_grids();
-
-    int s=0;
-    int i=0, j=0; //, k=0;
-    for(int r=0; r<(int)mesh.Ny; r++) {
-      for(int q=0; q<(int)mesh.Nx; q++) {
-        indx = index((i+1)*mesh.Nx + q, (j+1)*mesh.Ny + r);
-        jx[ indx ][0] = mesh.jx(q,r,s);
-        jy[ indx ][0] = mesh.jy(q,r,s);
-        jz[ indx ][0] = mesh.jz(q,r,s);
-      }
-    }
+template<size_t D>
+void emf::Fourier<D>::solve(
+    emf::Tile<D>& tile,
+    corgi::Grid<D>& grid)
+{
+  const std::array<int,3> N = {{ tile.mesh_lengths[0], tile.mesh_lengths[1], tile.mesh_lengths[2] }};
 
-    // copy external neighbor patches to filter's memory
-    //int k = 0;
-    for (i=-1; i<=1; i++)
-    for (j=-1; j<=1; j++) {
-    //for (int k=-1; k<=1; k++) { // TODO: hack to get 2d tiles working
-      if ((i==0)&&(j==0)) continue;
-
-      auto cneigh = 
-        std::dynamic_pointer_cast<emf::Tile<2>>(grid.get_tileptr( tile.neighs(i, j) ));
-      if (cneigh) {
-        emf::Grids& mesh = cneigh->get_grids();
-
-        /*
-        std::cout << "--------------------------------------------------\n";
-        std::cout << " Nx: " << mesh.Nx;
-        std::cout << " Ny: " << mesh.Ny;
-        std::cout << " Nz: " << mesh.Nz;
-        std::cout << " i: " << i;
-        std::cout << " j: " << j;
-        std::cout << "\n";
-        std::cout << "==============================\n";
-        */
-
-        int s = 0;
-        for(int r=0; r<(int)mesh.Ny; r++) {
-          for(int q=0; q<(int)mesh.Nx; q++) {
-            //for(int s=0; r<Nz; s++) {
-            
-            indx = index((i+1)*mesh.Nx + q, (j+1)*mesh.Ny + r);
-            jx[ indx ][0] = mesh.jx(q,r,s);
-            jy[ indx ][0] = mesh.jy(q,r,s);
-            jz[ indx ][0] = mesh.jz(q,r,s);
-          }
-        }
-      } // end if(cneigh)
-    }
+  std::array<int,3> pad = {{0,0,0}};
+  for(size_t d=0; d<D; d++) {
+    if(kernel.reach > N[d])
+      throw std::invalid_argument("Fourier::solve: kernel reaches beyond the neighbour tiles");
+    pad[d] = kernel.reach;
   }
 
-  /// set (filtered) current back to Yee lattice
-  // NOTE: we export the current to jx1/jy1/jz1 instead of jx/jy/jz to 
-  //       ensure thread safety
-  void set_current( emf::Tile<2>& tile)
-  {
-    emf::Grids& mesh = tile.get_grids();
-
-    int indx;
-
-    // set only "central" tile values
-    int i = 0;
-    int j = 0;
-
-    int halo = 3;
-    int s = 0; // TODO: third index for 3D case
-
-    //for(int s=0; r<Nz; s++) {
-    for(int r=-halo; r<(int)mesh.Ny+halo; r++) {
-      for(int q=-halo; q<(int)mesh.Nx+halo; q++) {
-
-        indx = index((i+1)*mesh.Nx + q, (j+1)*mesh.Ny + r);
-
-        /*
-        std::cout << "setting " << q << " " << r << " " << s;
-        std::cout << " to indx " << indx;
-        std::cout << " jx " <<  jx[ indx ][0];
-        std::cout << " jy " <<  jy[ indx ][0];
-        std::cout << " jz " <<  jz[ indx ][0];
-        std::cout << " \n";
-        */
-
-        mesh.jx1(q,r,s) = jx[ indx ][0];
-        mesh.jy1(q,r,s) = jy[ indx ][0];
-        mesh.jz1(q,r,s) = jz[ indx ][0];
-      }
-    }
-
-  }
+#ifdef GPU
+  nvtxRangePush(__PRETTY_FUNCTION__);
+#endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
 
-  // --------------------------------------------------
-  // auxiliary/utility functions for debugging
+  // neighbour tiles; missing ones (outside the grid) pad with zeros
+  std::array<std::shared_ptr<emf::Tile<D>>, 27> neighs;
 
-  void set_kernel(std::vector<float>& in)
-  {
-    if(in.size() != (size_t)Nx*Ny*Nz) std::cout << "error in size!\n";
+  for(int ok=-1; ok<=1; ok++)
+  for(int oj=-1; oj<=1; oj++)
+  for(int oi=-1; oi<=1; oi++) {
+    if((D < 3 && ok != 0) || (D < 2 && oj != 0)) continue;
+    if(oi == 0 && oj == 0 && ok == 0) continue;
 
-    int q = 0;
-    for(int j = 0 ; j < Ny ; ++j)  
-    for(int i = 0 ; i < Nx ; ++i, q++)  
-      kernel[ index(i,j) ][0] = in[q];
+    const int n = (oi+1) + 3*(oj+1) + 9*(ok+1);
+    if constexpr (D == 1) neighs[n] = std::dynamic_pointer_cast<emf::Tile<D>>(grid.get_tileptr( tile.neighs(oi) ));
+    if constexpr (D == 2) neighs[n] = std::dynamic_pointer_cast<emf::Tile<D>>(grid.get_tileptr( tile.neighs(oi, oj) ));
+    if constexpr (D == 3) neighs[n] = std::dynamic_pointer_cast<emf::Tile<D>>(grid.get_tileptr( tile.neighs(oi, oj, ok) ));
   }
 
+  // the neighbours still read the unfiltered currents of this tile, so
+  // the result is staged until commit
+  const size_t n = size_t(N[0])*N[1]*N[2];
+  auto& out = staged[tile.cid];
+  out.resize(3*n);
 
-  void set_image(std::vector<float>& in)
-  {
-    if(in.size() != (size_t)Nx*Ny*Nz) std::cout << "error in size!\n";
+  filter(tile, pad,
+    [&](int oi, int oj, int ok) {
+      if(oi == 0 && oj == 0 && ok == 0) return Shifted{&tile.get_grids(), {{0,0,0}}};
 
-    int q = 0;
-    for(int j = 0 ; j < Ny ; ++j)  
-    for(int i = 0 ; i < Nx ; ++i, q++)  
-      jx[ index(i,j) ][0] = in[q];
-  }
+      const auto& t = neighs[(oi+1) + 3*(oj+1) + 9*(ok+1)];
+      if(!t || !t->get_grids().has_currents()) return Shifted{}; // released currents are zero
 
+      return Shifted{&t->get_grids(), {{oi*N[0], oj*N[1], ok*N[2]}}};
+    },
+    [&](int c, int j, int k) { return out.data() + c*n + size_t(N[0])*(j + size_t(N[1])*k); });
 
-  std::vector<float> get_kernel()
-  {
-    std::vector<float> ret;
+#ifdef GPU
+  nvtxRangePop();
+#endif
+}
 
-    for(int j = 0 ; j < Ny ; ++j)  
-    for(int i = 0 ; i < Nx ; ++i)  
-      ret.push_back( kernel[ index(i,j) ][0] );
 
-    return ret;
-  }
+template<size_t D>
+void emf::Fourier<D>::commit(
+    emf::Tile<D>& tile)
+{
+  auto it = staged.find(tile.cid);
+  assert(it != staged.end());
 
+  const std::array<int,3> N = {{ tile.mesh_lengths[0], tile.mesh_lengths[1], tile.mesh_lengths[2] }};
+  const size_t n = size_t(N[0])*N[1]*N[2];
 
-  std::vector<float> get_image()
-  {
-    std::vector<float> ret;
+  auto& gs = tile.get_grids();
+  toolbox::Mesh<float,3>* ms[3] = {&gs.jx, &gs.jy, &gs.jz};
 
-    for(int j = 0 ; j < Ny ; ++j)  
-    for(int i = 0 ; i < Nx ; ++i)  
-      ret.push_back( jx[ index(i,j) ][0] );
+  #pragma omp parallel for collapse(2)
+  for(int k=0; k<N[2]; k++)
+  for(int j=0; j<N[1]; j++) {
+    for(int c=0; c<3; c++) {
+      const float* src = it->second.data() + c*n + size_t(N[0])*(j + size_t(N[1])*k);
+      float* f = ms[c]->data() + ms[c]->indx(0, j, k);
 
-    return ret;
+      #pragma omp simd
+      for(int i=0; i<N[0]; i++) f[i] = src[i];
+    }
   }
+}
 
 
-
-
-};
-
-} // end of namespace emf
+template class emf::Fourier<2>; // 2D
+template class emf::Fourier<3>; // 3D
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <array>
+#include <map>
+#include <memory>
+#include <vector>
+#include <functional>
+
+#include "core/emf/filters/filter.h"
+
+namespace emf {
+namespace fourier {
+
+/// k-space kernel of a spectral current filter
+//
+// response(kx, ky, kz) multiplies the Fourier mode with wavenumbers
+// k in [-pi, pi] per cell (zero along collapsed dimensions); reach is the
+// extent in cells of the equivalent real-space stencil, i.e., the depth
+// of neighbour data the filter pads the tile with.
+struct Kernel {
+  std::function<float(float, float, float)> response;
+  int reach;
+};
+
+/// npasses of Binomial2: prod_d cos^2(k_d/2)^npasses
+Kernel binomial(int npasses);
+
+/// npasses of Binomial2 followed by the 3-point compensator with
+//  alpha = 1 + npasses/2 that cancels their k^2 damping
+//
+// Ref: Vay, Geddes, Cormier-Michel, Grote, J. Comp. Phys. 2011
+Kernel compensated(int npasses);
+
+/// sharp cutoff of the modes with |k| >= kmax
+//
+// The real-space kernel is not compact; the result is exact only for
+// reach equal to the tile size.
+Kernel cutoff(float kmax, int reach);
+
+} // end of namespace fourier
+
+
+/// Spectral current filter using batched fftw transforms
+//
+// The currents of the tile, padded with up to kernel.reach cells of
+// neighbour data, are transformed with one real-to-complex plan for
+// jx/jy/jz, multiplied by the kernel response, and transformed back; the
+// tile interior is then exact for kernels that reach no further than the
+// padding (the halos need an update afterwards). Many stencil passes
+// thereby cost one transform and one neighbour exchange.
+//
+// The plans and kernel responses are cached per padded box size.
+template<size_t D>
+class Fourier :
+  public virtual Filter<D>
+{
+  struct Plan;
+
+  /// cached transforms per padded box size
+  std::map<std::array<int,3>, std::unique_ptr<Plan>> plans;
+
+  fourier::Kernel kernel = fourier::binomial(1);
+
+  /// cached plan of the padded box L
+  Plan& plan(const std::array<int,3>& L);
+
+  /// filtered currents of solve(tile, grid) per tile id
+  std::map<int, std::vector<float>> staged;
+
+  /// filter the currents padded by pad cells; source(oi,oj,ok) gives the
+  //  grids of the tile at offset o and the shift of their cell indices,
+  //  dest(c,j,k) the output row of component c
+  template<typename Source, typename Dest>
+  void filter(emf::Tile<D>& tile, const std::array<int,3>& pad, const Source& source, const Dest& dest);
+
+  public:
+
+  Fourier(int Nx, int Ny, int Nz);
+  ~Fourier();
+
+  /// set the k-space kernel; defaults to one Binomial2 pass
+  void set_kernel(const fourier::Kernel& k);
+
+  /// filter padded with the tile halo
+  //
+  // Throws std::invalid_argument for kernels that reach further than the
+  // 3-cell halo.
+  void solve(emf::Tile<D>& tile) override;
+
+  /// filter padded with the interiors of the neighbour tiles
+  //
+  // Virtual tiles need the currents of the last mpi exchange. The result
+  // is staged so that the neighbours keep reading unfiltered currents;
+  // call commit for every tile once all of them are solved. Throws
+  // std::invalid_argument for kernels that reach further than one tile.
+  void solve(emf::Tile<D>& tile, corgi::Grid<D>& grid);
+
+  /// write the staged result of solve(tile, grid) to the tile currents
+  void commit(emf::Tile<D>& tile);
+};
+
+
+} // end of namespace emf
@@ -6,6 +6,8 @@
 #include "external/iter/iter.h"
 #include "external/iter/allocator.h"
 
+#include "external/timer/tracer.h"
+
 
 #ifdef GPU
 #include <nvtx3/nvToolsExt.h> 
@@ -16,6 +18,16 @@ template<>
 void emf::General3p<2>::solve(
     emf::Tile<2>& tile)
 {
+#ifdef GPU
+  nvtxRangePush(__PRETTY_FUNCTION__);
+#endif
+
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
+#ifndef GPU
+  // separable passes of the 1D kernel over [-H, N+H) with H = 2 as below
+  sweep.apply<2>(tile.get_grids(), separable::general3p(alpha), 2);
+#else
 
   // 2D general coefficients
   const double winv=1./4.;                         //normalization
@@ -79,6 +91,7 @@ void emf::General3p<2>::solve(
  
   UniIter::sync();
   std::swap(mesh.jz, tmp);
+#endif
 
   //--------------------------------------------------
 #ifdef GPU
@@ -87,6 +100,27 @@ void emf::General3p<2>::solve(
 }
 
 
+/// 3D filter as separable passes of the 1D kernel over [-2, N+2)
+//
+// NOTE: runs on the host also in GPU builds
+template<>
+void emf::General3p<3>::solve(
+    emf::Tile<3>& tile)
+{
+#ifdef GPU
+  nvtxRangePush(__PRETTY_FUNCTION__);
+#endif
+
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
+  sweep.apply<3>(tile.get_grids(), separable::general3p(alpha), 2);
+
+#ifdef GPU
+  nvtxRangePop();
+#endif
+}
+
+
 //template class emf::General3p<1>; // 1D
 template class emf::General3p<2>; // 2D
-//template class emf::General3p<3>; // 3D
+template class emf::General3p<3>; // 3D
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/emf/filters/filter.h"
+#include "core/emf/filters/separable.h"
 
 namespace emf {
 
@@ -20,6 +21,9 @@ class General3p :
   /// 3-point weight
   double alpha = 0.5;
 
+  /// slice buffers of the separable passes
+  separable::Sweep sweep;
+
   void solve(emf::Tile<D>& tile) override;
 };
 
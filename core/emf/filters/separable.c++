@@ -0,0 +1,156 @@
+#include <cassert>
+#include <cstddef>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "core/emf/filters/separable.h"
+
+
+namespace {
+
+#ifndef _OPENMP
+// serial sweep when built without OpenMP threads (e.g. -fopenmp-simd)
+inline int omp_get_max_threads() { return 1; }
+inline int omp_get_num_threads() { return 1; }
+inline int omp_get_thread_num()  { return 0; }
+#endif
+
+/// 1D pass y[n] = wc x[n] + ws (x[n-d] + x[n+d]) for n in [a0, a1)
+inline void pass(
+    const float* __restrict x,
+    float* __restrict y,
+    int a0, int a1, std::ptrdiff_t d,
+    float wc, float ws)
+{
+  #pragma omp simd
+  for(int a=a0; a<a1; a++) y[a] = wc*x[a] + ws*(x[a-d] + x[a+d]);
+}
+
+/// combine three slices into y: y[n] = wi y[n] + wc m[n] + ws (lo[n] + hi[n])
+//  for n in [a0, a1)
+inline void combine(
+    const float* __restrict lo,
+    const float* __restrict m,
+    const float* __restrict hi,
+    float* __restrict y,
+    int a0, int a1,
+    float wi, float wc, float ws)
+{
+  #pragma omp simd
+  for(int a=a0; a<a1; a++) y[a] = wi*y[a] + wc*m[a] + ws*(lo[a] + hi[a]);
+}
+
+} // end of anonymous namespace
+
+
+template<size_t D>
+void emf::separable::Sweep::apply(
+    emf::Grids& gs,
+    Kernel w,
+    int R)
+{
+  static_assert(D == 2 || D == 3, "separable sweep needs a 2D or 3D grid");
+
+  const int H = 3; // halo of the tile meshes
+  assert(R >= 0 && w.s >= 1 && R + w.s <= H);
+
+  const int s = w.s;
+  const int Nx = gs.Nx;
+  const int Ny = gs.Ny;
+  const int No = D == 3 ? gs.Nz : gs.Ny; // cells along the streamed axis
+
+  // slices are x rows (2D) or xy planes (3D) including the halos
+  const std::ptrdiff_t Lx  = gs.jx.indx(0,1,0) - gs.jx.indx(0,0,0);
+  const std::ptrdiff_t len = D == 3 ? gs.jx.indx(0,0,1) - gs.jx.indx(0,0,0) : Lx;
+  const std::ptrdiff_t first = D == 3 ? gs.jx.indx(-H,-H,0) : gs.jx.indx(-H,0,0);
+
+  // filtered cells of a slice: x in [a0, a1) on rows [b0, b1)
+  const int a0 = H - R, a1 = H + Nx + R;
+  const int b0 = D == 3 ? H - R : 0;
+  const int b1 = D == 3 ? H + Ny + R : 1;
+
+  // ring of 2s+1 filtered slices and s slices above the own range per
+  // component, and one x-filtered plane in 3D
+  const int P = 2*s + 1;
+  const std::ptrdiff_t per_thread = (3*(P + s) + (D == 3 ? 1 : 0))*len;
+  const size_t need = per_thread*omp_get_max_threads();
+  if(buf.size() < need) buf.resize(need);
+
+  float* fs[3] = { gs.jx.data(), gs.jy.data(), gs.jz.data() };
+
+  const int kmin = -R - s; // lowest slice that is read
+  const int M = No + 2*R;  // slices that are written
+
+  #pragma omp parallel
+  {
+    const int t  = omp_get_thread_num();
+    const int nt = omp_get_num_threads();
+
+    // own slices [k0, k1) of the thread
+    const int k0 = -R + (M*t)/nt;
+    const int k1 = -R + (M*(t+1))/nt;
+
+    float* ring  = buf.data() + t*per_thread;
+    float* upper = ring  + 3*P*len;
+    float* xpass = upper + 3*s*len;
+
+    auto slot = [&](int c, int k) -> float* {
+      if(k < k1) return ring + (c*P + (k - kmin) % P)*len;
+      return upper + (c*s + k - k1)*len;
+    };
+
+    // filter slice k of every component along the lower axes
+    auto lower = [&](int k) {
+      for(int c=0; c<3; c++) {
+        const float* f = fs[c] + first + k*len;
+        float* out = slot(c, k);
+
+        if constexpr (D == 3) {
+          for(int b=b0-s; b<b1+s; b++) {
+            pass(f + b*Lx, xpass + b*Lx, a0, a1, s, w.wc, w.ws);
+          }
+          for(int b=b0; b<b1; b++) {
+            pass(xpass + b*Lx, out + b*Lx, a0, a1, s*Lx, w.wc, w.ws);
+          }
+        } else {
+          pass(f, out, a0, a1, s, w.wc, w.ws);
+        }
+      }
+    };
+
+    // the slices shared with the neighbouring ranges are filtered before
+    // any thread overwrites its own range
+    if(k0 < k1) {
+      for(int k=k0-s; k<k0;   k++) lower(k);
+      for(int k=k1;   k<k1+s; k++) lower(k);
+    }
+
+    #pragma omp barrier
+
+    for(int k=k0; k<k1+s; k++) {
+      if(k < k1) lower(k);
+
+      // slice o has both of its neighbours now
+      const int o = k - s;
+      if(o < k0) continue;
+
+      for(int c=0; c<3; c++) {
+        const float* lo = slot(c, o-s);
+        const float* m  = slot(c, o);
+        const float* hi = slot(c, o+s);
+        float* f = fs[c] + first + o*len;
+
+        for(int b=b0; b<b1; b++) {
+          const std::ptrdiff_t r = b*Lx;
+          combine(lo + r, m + r, hi + r, f + r, a0, a1, w.wi, w.g*w.wc, w.g*w.ws);
+        }
+      }
+    }
+  }
+}
+
+
+template void emf::separable::Sweep::apply<2>(emf::Grids&, Kernel, int);
+template void emf::separable::Sweep::apply<3>(emf::Grids&, Kernel, int);
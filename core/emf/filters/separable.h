@@ -0,0 +1,73 @@
+#pragma once
+
+#include <vector>
+
+#include "core/emf/tile.h"
+
+namespace emf {
+namespace separable {
+
+/// three-point weights of one axis: wc f[n] + ws (f[n-s] + f[n+s])
+//
+// The filtered value is wi f + g K f, where K is the product of the
+// one-axis kernels; wi = 0, g = 1 is the plain separable filter.
+struct Kernel {
+  float wc, ws;
+  int s;
+  float wi = 0.0f, g = 1.0f;
+};
+
+/// 3-point kernel with middle weight alpha and side weights (1-alpha)/2
+//
+// alpha = 1/2 is the 1-2-1 binomial; the D-dimensional outer product
+// of the kernel gives the weights of the General3p stencils.
+inline Kernel general3p(double alpha, int s = 1)
+{
+  return { float(alpha), float(0.5*(1.0 - alpha)), s };
+}
+
+/// Compensator2 weights: (1 + 3^D g) f minus g times the 3^D box sum of f
+//
+// In 2D g = 1/12, i.e., 20/12 in the middle and -1/12 at the sides and
+// corners; in 3D g = 1/36. The response 1 + k^2/4 cancels the k^2
+// damping of one Binomial2 pass.
+template<size_t D>
+inline Kernel compensator2()
+{
+  const float g = D == 3 ? 1.0f/36.0f : 1.0f/12.0f;
+  const float n = D == 3 ? 27.0f : 9.0f;
+  return { 1.0f, 1.0f, 1, 1.0f + n*g, -g };
+}
+
+
+/// Separable three-point filter of the currents
+//
+// The kernel is applied along each axis in turn, costing 3D instead of
+// 3^D multiply-adds per cell. The outermost axis (y in 2D, z in 3D) is
+// streamed: every thread filters its own range of slices along the lower
+// axes into a ring of slice buffers and writes the combination of three
+// of them back to the mesh as soon as they are ready. jx, jy, and jz are
+// filtered in the same sweep, in place.
+//
+// The filtered region is [-R, N+R) along every axis of the grid; the rest
+// of the mesh is left as is. Reads reach s cells beyond the region, so
+// R+s may not exceed the mesh halo. The slice buffers are kept between
+// calls and are not cleared.
+//
+// NOTE: the former full-stencil filters swapped in a cleared scratch mesh
+// and so zeroed the halo cells outside the filtered region. Here they
+// keep their pre-filter values; they are stale until the next
+// update_boundaries and must not be read as filtered currents.
+class Sweep
+{
+  std::vector<float> buf;
+
+  public:
+
+  /// filter gs.jx, gs.jy, gs.jz of a D = 2 or D = 3 grid
+  template<size_t D>
+  void apply(Grids& gs, Kernel w, int R);
+};
+
+} // end of namespace separable
+} // end of namespace emf
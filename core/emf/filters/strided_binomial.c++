@@ -6,6 +6,8 @@
 #include "external/iter/iter.h"
 #include "external/iter/allocator.h"
 
+#include "external/timer/tracer.h"
+
 
 #ifdef GPU
 #include <nvtx3/nvToolsExt.h> 
@@ -16,6 +18,20 @@ template<>
 void emf::General3pStrided<2>::solve(
     emf::Tile<2>& tile)
 {
+  // stencil offset; stride 1 has no neighbours to mix
+  const int istr = stride - 1;
+  if(istr < 1) return;
+
+#ifdef GPU
+  nvtxRangePush(__PRETTY_FUNCTION__);
+#endif
+
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
+#ifndef GPU
+  // separable passes of the strided 1D kernel over the tile interior
+  sweep.apply<2>(tile.get_grids(), separable::general3p(alpha, istr), 0);
+#else
   // 2D general coefficients
   const double winv=1./4.;                         //normalization
   const double wtm=winv * 4.0*alpha*alpha,         //middle
@@ -33,20 +49,18 @@ void emf::General3pStrided<2>::solve(
                    toolbox::Mesh<float, 3> &jj, 
                    toolbox::Mesh<float, 3> &tmp)
   {
-    for(int istr = 1; istr < stride; istr++){
-      tmp(i-H,j-H,k) = 
-          jj(i-istr-H, j-istr-H, k)*wtc + 
-          jj(i     -H, j-istr-H, k)*wts + 
-          jj(i+istr-H, j-istr-H, k)*wtc + 
-
-          jj(i-istr-H, j     -H, k)*wts + 
-          jj(i     -H, j     -H, k)*wtm + 
-          jj(i+istr-H, j     -H, k)*wts + 
-
-          jj(i-istr-H, j+istr-H, k)*wtc + 
-          jj(i     -H, j+istr-H, k)*wts + 
-          jj(i+istr-H, j+istr-H, k)*wtc;
-      }
+    tmp(i-H,j-H,k) = 
+        jj(i-istr-H, j-istr-H, k)*wtc + 
+        jj(i     -H, j-istr-H, k)*wts + 
+        jj(i+istr-H, j-istr-H, k)*wtc + 
+
+        jj(i-istr-H, j     -H, k)*wts + 
+        jj(i     -H, j     -H, k)*wtm + 
+        jj(i+istr-H, j     -H, k)*wts + 
+
+        jj(i-istr-H, j+istr-H, k)*wtc + 
+        jj(i     -H, j+istr-H, k)*wts + 
+        jj(i+istr-H, j+istr-H, k)*wtc;
   };
     
   //--------------------------------------------------
@@ -81,6 +95,7 @@ void emf::General3pStrided<2>::solve(
  
   UniIter::sync();
   std::swap(mesh.jz, tmp);
+#endif
 
   //--------------------------------------------------
 #ifdef GPU
@@ -89,6 +104,30 @@ void emf::General3pStrided<2>::solve(
 }
 
 
+/// 3D filter as separable passes of the strided 1D kernel over the tile interior
+//
+// NOTE: runs on the host also in GPU builds
+template<>
+void emf::General3pStrided<3>::solve(
+    emf::Tile<3>& tile)
+{
+  const int istr = stride - 1;
+  if(istr < 1) return;
+
+#ifdef GPU
+  nvtxRangePush(__PRETTY_FUNCTION__);
+#endif
+
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
+  sweep.apply<3>(tile.get_grids(), separable::general3p(alpha, istr), 0);
+
+#ifdef GPU
+  nvtxRangePop();
+#endif
+}
+
+
 
 /// outwinded 2-strided 3-point binomial
 //  Optimal for 3-point halo regions; 
@@ -217,7 +256,7 @@ void emf::Binomial2Strided2<2>::solve(
 
 //template class emf::General3pStrided<1>; // 1D
 template class emf::General3pStrided<2>; // 2D
-//template class emf::General3pStrided<3>; // 3D
+template class emf::General3pStrided<3>; // 3D
   
 //template class emf::Binomial2Strided2<1>; // 1D
 template class emf::Binomial2Strided2<2>; // 2D
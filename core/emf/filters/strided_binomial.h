@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/emf/filters/filter.h"
+#include "core/emf/filters/separable.h"
 
 namespace emf {
 
@@ -24,9 +25,15 @@ class General3pStrided :
   /// 3-point weight
   double alpha = 0.5;
 
-  /// stride parameter s; s=1 gives standard non-strided
+  /// stride parameter s; the stencil points are s-1 cells apart
+  //
+  // s=2 gives the standard non-strided filter and s=1 leaves the
+  // currents as is. The stencil reaches s-1 cells into the halo, so s <= 4.
   int stride = 1;
 
+  /// slice buffers of the separable passes
+  separable::Sweep sweep;
+
   void solve(emf::Tile<D>& tile) override;
 
 };
@@ -1,8 +1,14 @@
 #include <cmath>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <cassert>
 
 #include "core/emf/propagators/fdtd2.h"
 #include "external/iter/iter.h"
 
+#include "external/timer/tracer.h"
+
 #ifdef GPU
 #include <nvtx3/nvToolsExt.h> 
 #endif
@@ -22,6 +28,8 @@ void emf::FDTD2<1>::push_e(emf::Tile<1>& tile)
   nvtxRangePush(__PRETTY_FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
   Grids& mesh = tile.get_grids();
   const float C = 1.0 * tile.cfl * dt * corr;
 
@@ -52,6 +60,8 @@ void emf::FDTD2<2>::push_e(emf::Tile<2>& tile)
   nvtxRangePush(__PRETTY_FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
   Grids& mesh = tile.get_grids();
   const float C = 1.0 * tile.cfl * dt * corr;
 
@@ -87,6 +97,8 @@ void emf::FDTD2<3>::push_e(emf::Tile<3>& tile)
   nvtxRangePush(__PRETTY_FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
   Grids& mesh = tile.get_grids();
   const float C = 1.0 * tile.cfl * dt * corr;
 
@@ -126,6 +138,8 @@ void emf::FDTD2<1>::push_half_b(emf::Tile<1>& tile)
   nvtxRangePush(__PRETTY_FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
   Grids& mesh = tile.get_grids();
   const float C = 0.5 * tile.cfl * dt * corr;
 
@@ -155,6 +169,8 @@ void emf::FDTD2<2>::push_half_b(emf::Tile<2>& tile)
   nvtxRangePush(__PRETTY_FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
   Grids& mesh = tile.get_grids();
   const float C = 0.5 * tile.cfl * dt * corr;
 
@@ -188,6 +204,8 @@ void emf::FDTD2<3>::push_half_b(emf::Tile<3>& tile)
   nvtxRangePush(__PRETTY_FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
   Grids& mesh = tile.get_grids();
   const float C = 0.5 * tile.cfl * dt * corr;
 
@@ -215,6 +233,259 @@ void emf::FDTD2<3>::push_half_b(emf::Tile<3>& tile)
 
 
 
+//--------------------------------------------------
+// Temporally blocked steps
+
+namespace {
+
+/// flat-indexed E/B/J pointers of a Yee lattice; iy/iz are zero along collapsed dimensions
+struct YeeView {
+  float *ex, *ey, *ez, *bx, *by, *bz;
+  const float *jx, *jy, *jz;
+  size_t iy, iz;
+};
+
+/// B half-step at flat index n; same update as FDTD2::push_half_b
+template<size_t D>
+DEVCALLABLE inline void yee_b(const YeeView& m, float C, size_t n)
+{
+  const size_t iy = m.iy, iz = m.iz;
+
+  if constexpr (D == 1) {
+    m.by[n] += + C*( m.ez[n+1] - m.ez[n]);
+    m.bz[n] += + C*(-m.ey[n+1] + m.ey[n]);
+  } else if constexpr (D == 2) {
+    m.bx[n] += + C*(-m.ez[n+iy] + m.ez[n]);
+    m.by[n] += + C*( m.ez[n+1 ] - m.ez[n]);
+    m.bz[n] += + C*( m.ex[n+iy] - m.ex[n]
+                    -m.ey[n+1 ] + m.ey[n]);
+  } else {
+    m.bx[n] += + C*( m.ey[n+iz] - m.ey[n])
+               + C*(-m.ez[n+iy] + m.ez[n]);
+    m.by[n] += + C*( m.ez[n+1 ] - m.ez[n])
+               + C*(-m.ex[n+iz] + m.ex[n]);
+    m.bz[n] += + C*( m.ex[n+iy] - m.ex[n])
+               + C*(-m.ey[n+1 ] + m.ey[n]);
+  }
+}
+
+/// E step at flat index n; same update as FDTD2::push_e
+template<size_t D>
+DEVCALLABLE inline void yee_e(const YeeView& m, float C, size_t n)
+{
+  const size_t iy = m.iy, iz = m.iz;
+
+  if constexpr (D == 1) {
+    m.ey[n] += + C*( m.bz[n-1] - m.bz[n]);
+    m.ez[n] += + C*(-m.by[n-1] + m.by[n]);
+  } else if constexpr (D == 2) {
+    m.ex[n] += + C*(-m.bz[n-iy] + m.bz[n]);
+    m.ey[n] += + C*( m.bz[n-1 ] - m.bz[n]);
+    m.ez[n] += + C*( m.bx[n-iy] - m.bx[n]
+                    -m.by[n-1 ] + m.by[n]);
+  } else {
+    m.ex[n] += + C*( m.by[n-iz] - m.by[n])
+               + C*(-m.bz[n-iy] + m.bz[n]);
+    m.ey[n] += + C*( m.bz[n-1 ] - m.bz[n])
+               + C*(-m.bx[n-iz] + m.bx[n]);
+    m.ez[n] += + C*( m.bx[n-iy] - m.bx[n])
+               + C*(-m.by[n-1 ] + m.by[n]);
+  }
+}
+
+/// current at flat index n; same update as Tile::deposit_current
+DEVCALLABLE inline void yee_j(const YeeView& m, size_t n)
+{
+  m.ex[n] -= m.jx[n];
+  m.ey[n] -= m.jy[n];
+  m.ez[n] -= m.jz[n];
+}
+
+/// one half-step sweep over the cells [lo, hi] of the (halo-padded) tile
+struct Sweep {
+  bool e;     // E step, otherwise B half-step
+  bool j;     // E step subtracts the current
+  float C;    // coefficient
+  int lo[3], hi[3];
+  int delay;  // planes behind the wavefront
+};
+
+} // end of anonymous namespace
+
+
+template<size_t D>
+void emf::FDTD2<D>::push_steps(emf::Tile<D>& tile, int nsteps)
+{
+  if(nsteps < 0 || nsteps > max_steps)
+    throw std::invalid_argument("FDTD2::push_steps: more steps than the halo allows");
+  if(nsteps == 0) return;
+
+  advance(tile, nsteps, false, 0);
+}
+
+
+template<size_t D>
+void emf::FDTD2<D>::push_fused(emf::Tile<D>& tile)
+{
+  advance(tile, 1, true, 1);
+}
+
+
+template<size_t D>
+void emf::FDTD2<D>::advance(emf::Tile<D>& tile, int nsteps, bool current, int halo)
+{
+
+#ifdef GPU
+  nvtxRangePush(__PRETTY_FUNCTION__);
+#endif
+
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
+  Grids& gs = tile.get_grids();
+  const float Ce = 1.0 * tile.cfl * this->dt * corr;
+  const float Cb = 0.5 * tile.cfl * this->dt * corr;
+
+  const YeeView m = {
+    gs.ex.data(), gs.ey.data(), gs.ez.data(),
+    gs.bx.data(), gs.by.data(), gs.bz.data(),
+    gs.jx.data(), gs.jy.data(), gs.jz.data(),
+    D >= 2 ? gs.ex.indx(0,1,0) - gs.ex.indx(0,0,0) : 0,
+    D >= 3 ? gs.ex.indx(0,0,1) - gs.ex.indx(0,0,0) : 0 };
+
+  //--------------------------------------------------
+  // cells updated by each half-step: only those that the output region
+  // (interior plus halo cells) depends on after the last half-step, found
+  // backwards. A B half-step at cell i reads E at i+1 and an E step reads B
+  // (and J) at i-1.
+  const int H = 3; // halo of the tile meshes
+  const int nsweeps = 3*nsteps;
+
+  std::vector<Sweep> sweeps(nsweeps);
+  int el[3] = {0,0,0}, eh[3] = {0,0,0}, bl[3] = {0,0,0}, bh[3] = {0,0,0};
+  for(size_t d=0; d<D; d++) {
+    el[d] = bl[d] = -halo;
+    eh[d] = bh[d] = tile.mesh_lengths[d] - 1 + halo;
+  }
+
+  for(int q=nsweeps-1; q>=0; q--) {
+    Sweep& sw = sweeps[q];
+    sw.e = (q % 3 == 1);
+    sw.j = sw.e && current && gs.has_currents(); // as in deposit_current
+    sw.C = sw.e ? Ce : Cb;
+
+    for(size_t d=0; d<D; d++) {
+      if(sw.e) {
+        sw.lo[d] = el[d];
+        sw.hi[d] = eh[d];
+        bl[d] = std::min(bl[d], el[d] - 1);
+        bh[d] = std::max(bh[d], eh[d]);
+      } else {
+        sw.lo[d] = bl[d];
+        sw.hi[d] = bh[d];
+        el[d] = std::min(el[d], bl[d]);
+        eh[d] = std::max(eh[d], bh[d] + 1);
+      }
+    }
+    for(size_t d=D; d<3; d++) sw.lo[d] = sw.hi[d] = 0;
+  }
+
+  // the first half-step may read at most the halo
+  for(size_t d=0; d<D; d++) assert(std::min(el[d], bl[d]) >= -H && eh[d] <= tile.mesh_lengths[d] - 1 + H);
+
+  // a B half-step at plane p reads E at p+1, so it trails an E step by one plane
+  for(int q=1; q<nsweeps; q++) {
+    sweeps[q].delay = sweeps[q-1].delay + (sweeps[q-1].e && !sweeps[q].e ? 1 : 0);
+  }
+
+#ifdef GPU
+  //--------------------------------------------------
+  // one kernel per half-step over its whole region
+  for(const auto& sw : sweeps) {
+    const size_t base = gs.ex.indx(sw.lo[0], sw.lo[1], sw.lo[2]);
+
+    UniIter::iterate3D(
+    [=] DEVCALLABLE (int i, int j, int k, Grids& /*mesh*/)
+    {
+      const size_t n = base + i + j*m.iy + k*m.iz;
+      if(sw.e) {
+        yee_e<D>(m, sw.C, n);
+        if(sw.j) yee_j(m, n);
+      } else {
+        yee_b<D>(m, sw.C, n);
+      }
+    },
+      sw.hi[0] - sw.lo[0] + 1,
+      sw.hi[1] - sw.lo[1] + 1,
+      sw.hi[2] - sw.lo[2] + 1,
+      gs);
+
+    UniIter::sync();
+  }
+#else
+  //--------------------------------------------------
+  // wavefront of slabs of P planes along the slowest dimension A; at wave w
+  // half-step q updates the slab shifted back by its delay. The slabs hold
+  // ~16k cells so that the trailing half-steps find their input in cache.
+  // Rows along x within a slab are shared among the threads.
+  constexpr size_t A = D - 1;
+
+  int plane = 1; // cells per plane
+  for(size_t d=0; d<A; d++) plane *= tile.mesh_lengths[d] + 2*H;
+  const int P = std::max(1, 16384/plane);
+
+  // in 2D/3D all rows span the union of the regions along x; equal-length
+  // rows vectorize better than the few extra cells cost
+  int x0 = sweeps[0].lo[0], x1 = sweeps[0].hi[0];
+  for(const auto& sw : sweeps) { x0 = std::min(x0, sw.lo[0]); x1 = std::max(x1, sw.hi[0]); }
+
+  const int a0 = sweeps[0].lo[A];
+  int wmax = 0;
+  for(const auto& sw : sweeps) wmax = std::max(wmax, (sw.hi[A] + sw.delay - a0)/P);
+
+  #pragma omp parallel
+  for(int w=0; w<=wmax; w++) {
+    for(const auto& sw : sweeps) {
+
+      // planes of this half-step in the slab
+      const int p0 = std::max(a0 + w*P - sw.delay, sw.lo[A]);
+      const int p1 = std::min(a0 + w*P + P - 1 - sw.delay, sw.hi[A]);
+      if(p0 > p1) continue;
+
+      const int nj = sw.hi[1] - sw.lo[1] + 1;
+      const int nrows = D == 1 ? 1 : D == 2 ? p1 - p0 + 1 : (p1 - p0 + 1)*nj;
+
+      #pragma omp for
+      for(int t=0; t<nrows; t++) {
+        int i0 = x0, i1 = x1, j = 0, k = 0;
+        if constexpr (D == 1) { i0 = p0; i1 = p1; }
+        if constexpr (D == 2) { j = p0 + t; }
+        if constexpr (D == 3) { j = sw.lo[1] + t % nj; k = p0 + t / nj; }
+
+        const size_t n0 = gs.ex.indx(0, j, k);
+        if(sw.j) {
+          #pragma omp simd
+          for(int i=i0; i<=i1; i++) {
+            yee_e<D>(m, sw.C, n0 + i);
+            yee_j(m, n0 + i);
+          }
+        } else if(sw.e) {
+          #pragma omp simd
+          for(int i=i0; i<=i1; i++) yee_e<D>(m, sw.C, n0 + i);
+        } else {
+          #pragma omp simd
+          for(int i=i0; i<=i1; i++) yee_b<D>(m, sw.C, n0 + i);
+        }
+      }
+    }
+  }
+#endif
+
+#ifdef GPU
+  nvtxRangePop();
+#endif
+}
+
+
 template class emf::FDTD2<1>;
 template class emf::FDTD2<2>;
 template class emf::FDTD2<3>;
@@ -18,6 +18,43 @@ class FDTD2 :
   void push_e(Tile<D>& tile) override;
 
   void push_half_b(Tile<D>& tile) override;
+
+  /// full steps that fit in the halo without a boundary update
+  static constexpr int max_steps = 2;
+
+  /// advance nsteps full steps (push_half_b, push_e, push_half_b each) at once
+  //
+  // Equivalent to the three calls per step with update_boundaries in between
+  // when nothing else (currents, conductors, filters) acts on the fields
+  // between the steps. Instead of exchanging halos, the halo cells are
+  // advanced too, on a region that shrinks by one cell per step; the halo
+  // width H=3 therefore allows at most max_steps steps per call. The halos
+  // are stale afterwards and need an update_boundaries as usual.
+  //
+  // On the CPU the half-steps are time-skewed along the slowest dimension:
+  // each slab of planes is taken through all half-steps while it is still
+  // in cache, so the fields stream through memory once per call instead of
+  // three times per step. This pays off for tiles that do not fit in cache;
+  // for small tiles the extra halo cells cost more than is saved.
+  void push_steps(Tile<D>& tile, int nsteps);
+
+  /// fused push_half_b, push_e, deposit_current, and push_half_b in one pass
+  //
+  // Closes a lap that is shifted by half a B step: it starts from E^n and
+  // B^{n+1/2} (as read by the particle interpolation) and the current of
+  // the lap, and leaves E^{n+1} and B^{n+3/2} for the interpolation of the
+  // next lap. The first B half-step is done once before the first lap.
+  //
+  // Needs one update_boundaries of J, E, and B before the call. E and B
+  // are valid on the interior and one halo cell afterwards, which covers
+  // the first-order interpolation stencil without another exchange; wider
+  // interpolation stencils need an update_boundaries first.
+  void push_fused(Tile<D>& tile);
+
+  private:
+
+  /// nsteps B/E/B steps, valid on the interior and halo cells afterwards
+  void advance(Tile<D>& tile, int nsteps, bool current, int halo);
 };
 
 
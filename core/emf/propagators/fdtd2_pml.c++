@@ -1,8 +1,11 @@
 #include <cmath>
+#include <algorithm>
 
 #include "core/emf/propagators/fdtd2_pml.h"
 #include "external/iter/iter.h"
 
+#include "external/timer/tracer.h"
+
 #ifdef GPU
 #include <nvtx3/nvToolsExt.h> 
 #endif
@@ -60,26 +63,108 @@ DEVCALLABLE float emf::FDTD2_pml<D>::lambda(
 }
 
 
+/// Radial extent check of the damping profile
+template<size_t D>
+bool emf::FDTD2_pml<D>::absorbs(emf::Tile<D>& tile)
+{
+  // r is convex in the position so that its maximum over the staggered
+  // cell positions of the tile is at one of the corners
+  double rmax = 0.0;
+  for(int corner=0; corner<8; corner++) {
+    float s[3] = {0.0f, 0.0f, 0.0f};
+    for(size_t d=0; d<D; d++) {
+      s[d] = float( tile.mins[d] ) + ( (corner >> d) & 1 ? tile.mesh_lengths[d] - 0.5f : 0.0f );
+    }
+
+    auto drx = (s[0] - cenx)/radx;
+    auto dry = (s[1] - ceny)/rady;
+    auto drz = (s[2] - cenz)/radz;
+    rmax = std::max(rmax, std::sqrt( drx*drx + dry*dry + drz*drz ));
+  }
+
+  return rmax > rad_lim;
+}
+
+
+template<size_t D>
+std::array<double, 14> emf::FDTD2_pml<D>::layer_key(emf::Tile<D>& tile)
+{
+  std::array<double, 14> key = {{ cenx, ceny, cenz, radx, rady, radz, rad_lim, norm_abs }};
+  for(size_t d=0; d<D; d++) key[8 + d]  = tile.mins[d];
+  for(size_t d=0; d<3; d++) key[11 + d] = tile.mesh_lengths[d];
+
+  return key;
+}
+
+
+/// Tabulate the damped update coefficients of the tile
+//
+// E is damped with lambda/2 at the cell edges and B with lambda/4 at the
+// cell faces (per half step); the update (f (1+lam) + df)/(1-lam) is
+// stored as a = (1+lam)/(1-lam) and b = 1/(1-lam).
+template<size_t D>
+typename emf::FDTD2_pml<D>::Layer& emf::FDTD2_pml<D>::layer(emf::Tile<D>& tile)
+{
+  const auto key = layer_key(tile);
+
+  Layer& lay = layers[tile.cid];
+  if(lay.key == key) return lay;
+
+  const int Nx = tile.mesh_lengths[0];
+  const int Ny = tile.mesh_lengths[1];
+  const int Nz = tile.mesh_lengths[2];
+
+  lay.key = key;
+  for(int c=0; c<6; c++) {
+    lay.a[c] = toolbox::Mesh<float,0>(Nx, Ny, Nz);
+    lay.b[c] = toolbox::Mesh<float,0>(Nx, Ny, Nz);
+
+    const float w = c < 3 ? 0.5f : 0.25f;
+
+    for(int k=0; k<Nz; k++)
+    for(int j=0; j<Ny; j++)
+    for(int i=0; i<Nx; i++) {
+      const int ind[3] = {i, j, k};
+
+      // E is staggered along its own direction, B along the other two
+      float s[3] = {0.0f, 0.0f, 0.0f};
+      for(size_t d=0; d<D; d++) {
+        const bool shift = (c < 3) == (c % 3 == int(d));
+        s[d] = ind[d] + float( tile.mins[d] ) + (shift ? 0.5f : 0.0f);
+      }
+
+      const float lam = w*lambda(s[0], s[1], s[2]);
+      lay.a[c](i,j,k) = (1.0f + lam)/(1.0f - lam);
+      lay.b[c](i,j,k) =  1.0f/(1.0f - lam);
+    }
+  }
+
+  return lay;
+}
+
+
 /// 2D E pusher
 template<>
 void emf::FDTD2_pml<2>::push_e(emf::Tile<2>& tile)
 {
+  if(!absorbs(tile)) {
+    plain.push_e(tile);
+    return;
+  }
+
 #ifdef GPU
   nvtxRangePush(__PRETTY_FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
   Grids& mesh = tile.get_grids();
+  Layer& lay = layer(tile);
   const float C = tile.cfl;
-  const auto mins = tile.mins;
 
   UniIter::iterate2D(
-  [=] DEVCALLABLE (int i, int j, Grids &mesh)
+  [=] DEVCALLABLE (int i, int j, Grids &mesh, Layer &lay)
   {
-    //-----------
-    // global grid coordinates
-    float iglob = i + float( mins[0] );
-    float jglob = j + float( mins[1] );
-
     // dE = dt*curl B  (1/2)
 
     float dex = + C*(-mesh.bz(i,  j-1,0) + mesh.bz(i,j,0)); 
@@ -87,18 +172,14 @@ void emf::FDTD2_pml<2>::push_e(emf::Tile<2>& tile)
     float dez = + C*( mesh.bx(i,  j-1,0) - mesh.bx(i,j,0))
                   + C*(-mesh.by(i-1,j,  0) + mesh.by(i,j,0));
 
-	  float lamx = 0.5f*lambda(iglob+0.5f, jglob,      0);
-	  float lamy = 0.5f*lambda(iglob,      jglob+0.5f, 0);
-	  float lamz = 0.5f*lambda(iglob,      jglob,      0);
-
-    mesh.ex(i,j,0) = ( mesh.ex(i,j,0)*(1.0f+lamx) + dex )/(1.0f-lamx);
-    mesh.ey(i,j,0) = ( mesh.ey(i,j,0)*(1.0f+lamy) + dey )/(1.0f-lamy);
-    mesh.ez(i,j,0) = ( mesh.ez(i,j,0)*(1.0f+lamz) + dez )/(1.0f-lamz);
+    mesh.ex(i,j,0) = lay.a[0](i,j,0)*mesh.ex(i,j,0) + lay.b[0](i,j,0)*dex;
+    mesh.ey(i,j,0) = lay.a[1](i,j,0)*mesh.ey(i,j,0) + lay.b[1](i,j,0)*dey;
+    mesh.ez(i,j,0) = lay.a[2](i,j,0)*mesh.ez(i,j,0) + lay.b[2](i,j,0)*dez;
 
   }, 
     tile.mesh_lengths[0], 
     tile.mesh_lengths[1], 
-    mesh);
+    mesh, lay);
 
 
   UniIter::sync();
@@ -114,44 +195,25 @@ void emf::FDTD2_pml<2>::push_e(emf::Tile<2>& tile)
 template<>
 void emf::FDTD2_pml<3>::push_e(emf::Tile<3>& tile)
 {
+  if(!absorbs(tile)) {
+    plain.push_e(tile);
+    return;
+  }
+
 #ifdef GPU
   nvtxRangePush(__PRETTY_FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
   Grids& mesh = tile.get_grids();
-  //const float C = 1.0 * tile.cfl * dt * corr;
+  Layer& lay = layer(tile);
   const float C = tile.cfl;
-  const auto mins = tile.mins;
 
   UniIter::iterate3D(
-  [=] DEVCALLABLE (int i, int j, int k, Grids &mesh)
+  [=] DEVCALLABLE (int i, int j, int k, Grids &mesh, Layer &lay)
   {
-    //-----------
-    // global grid coordinates
-    float iglob = i + float( mins[0] );
-    float jglob = j + float( mins[1] );
-    float kglob = k + float( mins[2] );
-    //float lam;
-
     // dE = dt*curl B  (1/2)
-	  //lam = 0.5*lambda(iglob+0.5, jglob, kglob);
-    //mesh.ex(i,j,k) = (
-    //        mesh.ex(i,j,k)*(1+lam) + 
-    //        C*(mesh.by(i,j,k-1)-mesh.by(i,j,k)  - mesh.bz(i,j-1,k)+mesh.bz(i,j,k)) 
-    //        )/(1-lam);
-
-	  //lam = 0.5*lambda(iglob, jglob+0.5, kglob);
-    //mesh.ey(i,j,k) = (
-    //        mesh.ey(i,j,k)*(1+lam) + 
-    //        C*(mesh.bz(i-1,j,k)-mesh.bz(i,j,k)  - mesh.bx(i,j,k-1)+mesh.bx(i,j,k)) 
-    //        )/(1-lam);
-
-	  //lam = 0.5*lambda(iglob, jglob, kglob+0.5);
-    //mesh.ez(i,j,k) = (
-    //        mesh.ez(i,j,k)*(1+lam) + 
-    //        C*(mesh.bx(i,j-1,k)-mesh.bx(i,j,k)  - mesh.by(i-1,j,k)+mesh.by(i,j,k)) 
-    //        )/(1-lam);
-
     float dex = + C*( mesh.by(i,  j,  k-1) - mesh.by(i,j,k))
                   + C*(-mesh.bz(i,  j-1,k  ) + mesh.bz(i,j,k)); 
     float dey = + C*( mesh.bz(i-1,j,  k  ) - mesh.bz(i,j,k))
@@ -159,26 +221,15 @@ void emf::FDTD2_pml<3>::push_e(emf::Tile<3>& tile)
     float dez = + C*( mesh.bx(i,  j-1,k  ) - mesh.bx(i,j,k))
                   + C*(-mesh.by(i-1,j,  k  ) + mesh.by(i,j,k));
 
-	  float lamx = 0.5f*lambda(iglob+0.5f, jglob,      kglob);
-	  float lamy = 0.5f*lambda(iglob,      jglob+0.5f, kglob);
-	  float lamz = 0.5f*lambda(iglob,      jglob,      kglob+0.5f);
+    mesh.ex(i,j,k) = lay.a[0](i,j,k)*mesh.ex(i,j,k) + lay.b[0](i,j,k)*dex;
+    mesh.ey(i,j,k) = lay.a[1](i,j,k)*mesh.ey(i,j,k) + lay.b[1](i,j,k)*dey;
+    mesh.ez(i,j,k) = lay.a[2](i,j,k)*mesh.ez(i,j,k) + lay.b[2](i,j,k)*dez;
 
-    mesh.ex(i,j,k) = ( mesh.ex(i,j,k)*(1.0f+lamx) + dex )/(1.0f-lamx);
-    mesh.ey(i,j,k) = ( mesh.ey(i,j,k)*(1.0f+lamy) + dey )/(1.0f-lamy);
-    mesh.ez(i,j,k) = ( mesh.ez(i,j,k)*(1.0f+lamz) + dez )/(1.0f-lamz);
-
-
-    //mesh.ex(i,j,k) += + C*( mesh.by(i,  j,  k-1) - mesh.by(i,j,k))
-    //                  + C*(-mesh.bz(i,  j-1,k  ) + mesh.bz(i,j,k)); 
-    //mesh.ey(i,j,k) += + C*( mesh.bz(i-1,j,  k  ) - mesh.bz(i,j,k))
-    //                  + C*(-mesh.bx(i,  j,  k-1) + mesh.bx(i,j,k));
-    //mesh.ez(i,j,k) += + C*( mesh.bx(i,  j-1,k  ) - mesh.bx(i,j,k))
-    //                  + C*(-mesh.by(i-1,j,  k  ) + mesh.by(i,j,k));
   }, 
     tile.mesh_lengths[0], 
     tile.mesh_lengths[1], 
     tile.mesh_lengths[2], 
-    mesh);
+    mesh, lay);
 
 
   UniIter::sync();
@@ -197,39 +248,37 @@ void emf::FDTD2_pml<3>::push_e(emf::Tile<3>& tile)
 template<>
 void emf::FDTD2_pml<2>::push_half_b(emf::Tile<2>& tile)
 {
+  if(!absorbs(tile)) {
+    plain.push_half_b(tile);
+    return;
+  }
+
 #ifdef GPU
   nvtxRangePush(__PRETTY_FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
   Grids& mesh = tile.get_grids();
+  Layer& lay = layer(tile);
   const float C = 0.5*tile.cfl;
-  const auto mins = tile.mins;
 
   UniIter::iterate2D(
-  [=] DEVCALLABLE (int i, int j, Grids &mesh)
+  [=] DEVCALLABLE (int i, int j, Grids &mesh, Layer &lay)
   {
-
-    // global grid coordinates
-    float iglob = i + mins[0];
-    float jglob = j + mins[1];
-
-	  float lamx = 0.25f*lambda(iglob,      jglob+0.5f, 0);
-	  float lamy = 0.25f*lambda(iglob+0.5f, jglob,      0);
-	  float lamz = 0.25f*lambda(iglob+0.5f, jglob+0.5f, 0);
-      
     float dbx = + C*(-mesh.ez(i,  j+1,0) + mesh.ez(i,j,0));
     float dby = + C*( mesh.ez(i+1,j,  0) - mesh.ez(i,j,0));
     float dbz = + C*( mesh.ex(i,  j+1,0) - mesh.ex(i,j,0))
                   + C*(-mesh.ey(i+1,j,  0) + mesh.ey(i,j,0));
 
-	  mesh.bx(i,j,0) = ( mesh.bx(i,j,0)*(1.0f+lamx) + dbx )/(1.0f-lamx);
-	  mesh.by(i,j,0) = ( mesh.by(i,j,0)*(1.0f+lamy) + dby )/(1.0f-lamy);
-	  mesh.bz(i,j,0) = ( mesh.bz(i,j,0)*(1.0f+lamz) + dbz )/(1.0f-lamz);
+    mesh.bx(i,j,0) = lay.a[3](i,j,0)*mesh.bx(i,j,0) + lay.b[3](i,j,0)*dbx;
+    mesh.by(i,j,0) = lay.a[4](i,j,0)*mesh.by(i,j,0) + lay.b[4](i,j,0)*dby;
+    mesh.bz(i,j,0) = lay.a[5](i,j,0)*mesh.bz(i,j,0) + lay.b[5](i,j,0)*dbz;
 
   }, 
     tile.mesh_lengths[0], 
     tile.mesh_lengths[1], 
-    mesh);
+    mesh, lay);
 
 
   UniIter::sync();
@@ -244,49 +293,25 @@ void emf::FDTD2_pml<2>::push_half_b(emf::Tile<2>& tile)
 template<>
 void emf::FDTD2_pml<3>::push_half_b(emf::Tile<3>& tile)
 {
+  if(!absorbs(tile)) {
+    plain.push_half_b(tile);
+    return;
+  }
+
 #ifdef GPU
   nvtxRangePush(__PRETTY_FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
   Grids& mesh = tile.get_grids();
-  //const float C = 0.5 * tile.cfl * dt * corr;
+  Layer& lay = layer(tile);
   const float C = 0.5*tile.cfl;
-  const auto mins = tile.mins;
-
-  //for(int k=0; k<tile.mesh_lengths[2]; k++)
-  //for(int j=0; j<tile.mesh_lengths[1]; j++)
-  //for(int i=0; i<tile.mesh_lengths[0]; i++) {
 
   UniIter::iterate3D(
-  [=] DEVCALLABLE (int i, int j, int k, Grids &mesh)
+  [=] DEVCALLABLE (int i, int j, int k, Grids &mesh, Layer &lay)
   {
-
-    // global grid coordinates
-    float iglob = i + mins[0];
-    float jglob = j + mins[1];
-    float kglob = k + mins[2];
-    //float lam;
-
     // dB = -dt*curl E  (1/4)
-	  //lam = 0.25*lambda(iglob, jglob+0.5, kglob+0.5);
-	  //mesh.bx(i,j,k) = ( mesh.bx(i,j,k)*(1+lam)
-    //        + C*(mesh.ey(i,j,k+1)-mesh.ey(i,j,k)  - mesh.ez(i,j+1,k)+mesh.ez(i,j,k)) 
-    //        )/(1-lam);
-
-	  //lam = 0.25*lambda(iglob+0.5, jglob, kglob+0.5);
-	  //mesh.by(i,j,k) = ( mesh.by(i,j,k)*(1+lam)
-    //        + C*(mesh.ez(i+1,j,k)-mesh.ez(i,j,k)  - mesh.ex(i,j,k+1)+mesh.ex(i,j,k)) 
-    //        )/(1-lam);
-
-	  //lam = 0.25*lambda(iglob+0.5, jglob+0.5, kglob);
-	  //mesh.bz(i,j,k) = ( mesh.bz(i,j,k)*(1+lam)
-    //        + C*(mesh.ex(i,j+1,k)-mesh.ex(i,j,k)  - mesh.ey(i+1,j,k)+mesh.ey(i,j,k)) 
-    //        )/(1-lam);
-
-	  float lamx = 0.25f*lambda(iglob,      jglob+0.5f, kglob+0.5f);
-	  float lamy = 0.25f*lambda(iglob+0.5f, jglob,      kglob+0.5f);
-	  float lamz = 0.25f*lambda(iglob+0.5f, jglob+0.5f, kglob);
-      
     float dbx = + C*( mesh.ey(i,  j,  k+1) - mesh.ey(i,j,k))
                   + C*(-mesh.ez(i,  j+1,k  ) + mesh.ez(i,j,k));
     float dby = + C*( mesh.ez(i+1,j,  k  ) - mesh.ez(i,j,k))
@@ -294,21 +319,15 @@ void emf::FDTD2_pml<3>::push_half_b(emf::Tile<3>& tile)
     float dbz = + C*( mesh.ex(i,  j+1,k  ) - mesh.ex(i,j,k))
                   + C*(-mesh.ey(i+1,j,  k  ) + mesh.ey(i,j,k));
 
-	  mesh.bx(i,j,k) = ( mesh.bx(i,j,k)*(1.0f+lamx) + dbx )/(1.0f-lamx);
-	  mesh.by(i,j,k) = ( mesh.by(i,j,k)*(1.0f+lamy) + dby )/(1.0f-lamy);
-	  mesh.bz(i,j,k) = ( mesh.bz(i,j,k)*(1.0f+lamz) + dbz )/(1.0f-lamz);
+    mesh.bx(i,j,k) = lay.a[3](i,j,k)*mesh.bx(i,j,k) + lay.b[3](i,j,k)*dbx;
+    mesh.by(i,j,k) = lay.a[4](i,j,k)*mesh.by(i,j,k) + lay.b[4](i,j,k)*dby;
+    mesh.bz(i,j,k) = lay.a[5](i,j,k)*mesh.bz(i,j,k) + lay.b[5](i,j,k)*dbz;
 
-    //mesh.bx(i,j,k) += + C*( mesh.ey(i,  j,  k+1) - mesh.ey(i,j,k))
-    //                  + C*(-mesh.ez(i,  j+1,k  ) + mesh.ez(i,j,k));
-    //mesh.by(i,j,k) += + C*( mesh.ez(i+1,j,  k  ) - mesh.ez(i,j,k))
-    //                  + C*(-mesh.ex(i,  j,  k+1) + mesh.ex(i,j,k));
-    //mesh.bz(i,j,k) += + C*( mesh.ex(i,  j+1,k  ) - mesh.ex(i,j,k))
-    //                  + C*(-mesh.ey(i+1,j,  k  ) + mesh.ey(i,j,k));
   }, 
     tile.mesh_lengths[0], 
     tile.mesh_lengths[1], 
     tile.mesh_lengths[2], 
-    mesh);
+    mesh, lay);
 
 
   UniIter::sync();
@@ -327,6 +346,8 @@ void emf::FDTD2_pml<3>::push_eb(::ffe::Tile<3>& tile)
   nvtxRangePush(__PRETTY_FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
   // refs to storages
   emf::Grids&     m = tile.get_grids();
   ffe::SlimGrids& dm = tile.dF; 
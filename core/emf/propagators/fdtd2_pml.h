@@ -1,18 +1,47 @@
 #pragma once
 
+#include <array>
+#include <map>
+
 #include "core/emf/propagators/propagator.h"
+#include "core/emf/propagators/fdtd2.h"
 #include "core/emf/tile.h"
 #include "core/ffe/tile.h"
+#include "tools/mesh.h"
 
 namespace emf {
 
 /// Second order staggered finite difference time domain 
 // Maxwell's field equation solver with spherical PML damping 
 // boundaries
+//
+// Only tiles that intersect the absorbing layer (see absorbs) pay for the
+// damping: their update coefficients are tabulated per cell on the first
+// visit and kept until the layer parameters or the tile change. All other
+// tiles are advanced with the plain FDTD2 update.
 template<size_t D>
 class FDTD2_pml :
   public virtual Propagator<D>
 {
+  /// damped update f = a f + b df per cell of each staggered component
+  //  (ex, ey, ez, bx, by, bz)
+  struct Layer {
+    std::array<double, 14> key;
+    std::array<toolbox::Mesh<float,0>, 6> a, b;
+  };
+
+  /// tabulated coefficients of the absorbing tiles per tile id
+  std::map<int, Layer> layers;
+
+  /// undamped update of the tiles outside of the layer
+  FDTD2<D> plain;
+
+  /// profile parameters and tile geometry that the coefficients depend on
+  std::array<double, 14> layer_key(Tile<D>& tile);
+
+  /// coefficients of tile, tabulated if missing or stale
+  Layer& layer(Tile<D>& tile);
+
   public:
 
   /// numerical correction factor to speed of light
@@ -36,6 +65,12 @@ class FDTD2_pml :
   /// damping function
   virtual float lambda(float sx, float sy, float sz);
 
+  /// does the tile reach into the absorbing layer (lambda != 0)
+  //
+  // Assumes the radial profile of lambda; classes that change the profile
+  // need to override this too.
+  virtual bool absorbs(Tile<D>& tile);
+
   void push_e(Tile<D>& tile) override;
 
   void push_half_b(Tile<D>& tile) override;
@@ -1,8 +1,11 @@
 #include <cmath>
 
 #include "core/emf/propagators/fdtd4.h"
+#include "core/emf/propagators/fdtd_stencil.h"
 #include "external/iter/iter.h"
 
+#include "external/timer/tracer.h"
+
 #ifdef GPU
 #include <nvtx3/nvToolsExt.h> 
 #endif
@@ -15,12 +18,14 @@
 
 /// 2D E pusher
 template<>
-void emf::FDTD4<2>::push_e(emf::Tile<2>& tile)
+void emf::FDTD4<2>::push_e_runtime(emf::Tile<2>& tile)
 {
 #ifdef GPU
   nvtxRangePush(__PRETTY_FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
   Grids& mesh = tile.get_grids();
 
   const float C1 = coeff1*corr*tile.cfl;
@@ -55,13 +60,15 @@ void emf::FDTD4<2>::push_e(emf::Tile<2>& tile)
 
 /// 3D E pusher
 template<>
-void emf::FDTD4<3>::push_e(emf::Tile<3>& tile)
+void emf::FDTD4<3>::push_e_runtime(emf::Tile<3>& tile)
 {
 
 #ifdef GPU
   nvtxRangePush(__PRETTY_FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
   Grids& mesh = tile.get_grids();
   const float C1 = coeff1*corr*tile.cfl;
   const float C2 = coeff2*corr*tile.cfl;
@@ -104,12 +111,14 @@ void emf::FDTD4<3>::push_e(emf::Tile<3>& tile)
 
 /// 2D B pusher
 template<>
-void emf::FDTD4<2>::push_half_b(emf::Tile<2>& tile)
+void emf::FDTD4<2>::push_half_b_runtime(emf::Tile<2>& tile)
 {
 #ifdef GPU
   nvtxRangePush(__PRETTY_FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
   Grids& mesh = tile.get_grids();
   const float C1 = 0.5*coeff1*corr*tile.cfl;
   const float C2 = 0.5*coeff2*corr*tile.cfl;
@@ -142,13 +151,15 @@ void emf::FDTD4<2>::push_half_b(emf::Tile<2>& tile)
 
 /// 3D B pusher
 template<>
-void emf::FDTD4<3>::push_half_b(emf::Tile<3>& tile)
+void emf::FDTD4<3>::push_half_b_runtime(emf::Tile<3>& tile)
 {
 
 #ifdef GPU
   nvtxRangePush(__PRETTY_FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
   Grids& mesh = tile.get_grids();
   const float C1 = 0.5*coeff1*corr*tile.cfl;
   const float C2 = 0.5*coeff2*corr*tile.cfl;
@@ -187,6 +198,32 @@ void emf::FDTD4<3>::push_half_b(emf::Tile<3>& tile)
 
 
 
+//--------------------------------------------------
+
+template<size_t D>
+void emf::FDTD4<D>::push_e(emf::Tile<D>& tile)
+{
+  if(coeff1 == 9./8. && coeff2 == -1./24.) {
+    trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+    stencil::push_e<D, stencil::Fourth>(tile, corr*tile.cfl);
+  } else {
+    push_e_runtime(tile);
+  }
+}
+
+
+template<size_t D>
+void emf::FDTD4<D>::push_half_b(emf::Tile<D>& tile)
+{
+  if(coeff1 == 9./8. && coeff2 == -1./24.) {
+    trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+    stencil::push_b<D, stencil::Fourth>(tile, 0.5*corr*tile.cfl);
+  } else {
+    push_half_b_runtime(tile);
+  }
+}
+
+
 //template class emf::FDTD4<1>;
 template class emf::FDTD4<2>;
 template class emf::FDTD4<3>;
@@ -22,6 +22,14 @@ class FDTD4 :
   void push_e(Tile<D>& tile) override;
 
   void push_half_b(Tile<D>& tile) override;
+
+  private:
+
+  /// curl with the coefficients read at runtime; the defaults use the
+  //  compiled emf::stencil::Fourth loop instead
+  void push_e_runtime(Tile<D>& tile);
+
+  void push_half_b_runtime(Tile<D>& tile);
 };
 
 
@@ -3,6 +3,8 @@
 #include "core/emf/propagators/fdtd_general.h"
 #include "external/iter/iter.h"
 
+#include "external/timer/tracer.h"
+
 #ifdef GPU
 #include <nvtx3/nvToolsExt.h> 
 #endif
@@ -48,6 +50,8 @@ void emf::FDTDGen<3>::push_e(emf::Tile<3>& tile)
   nvtxRangePush(__PRETTY_FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
   Grids& mesh = tile.get_grids();
 
   UniIter::iterate3D(
@@ -126,6 +130,8 @@ void emf::FDTDGen<3>::push_half_b(emf::Tile<3>& tile)
   nvtxRangePush(__PRETTY_FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
   Grids& mesh = tile.get_grids();
 
   UniIter::iterate3D(
@@ -0,0 +1,16 @@
+#include "core/emf/propagators/fdtd_stencil.h"
+
+
+//--------------------------------------------------
+// explicit template instantiation
+
+template void emf::stencil::push_e<2, emf::stencil::Fourth>(emf::Tile<2>&, float);
+template void emf::stencil::push_e<3, emf::stencil::Fourth>(emf::Tile<3>&, float);
+template void emf::stencil::push_b<2, emf::stencil::Fourth>(emf::Tile<2>&, float);
+template void emf::stencil::push_b<3, emf::stencil::Fourth>(emf::Tile<3>&, float);
+
+template class emf::FDTDStencil<2, emf::stencil::Pukhov<2>>;
+template class emf::FDTDStencil<3, emf::stencil::Pukhov<3>>;
+
+template class emf::FDTDPukhov<2>;
+template class emf::FDTDPukhov<3>;
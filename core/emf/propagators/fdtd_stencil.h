@@ -0,0 +1,230 @@
+#pragma once
+
+#include "core/emf/propagators/propagator.h"
+#include "external/iter/iter.h"
+
+#include "external/timer/tracer.h"
+
+#ifdef GPU
+#include <nvtx3/nvToolsExt.h>
+#endif
+
+namespace emf {
+namespace stencil {
+
+// Compile-time curl coefficient sets
+//
+// The derivative along a direction is the sum over legs a=1..3 of
+// alpha[a-1] times the difference across 2a-1 cells (a=1 is the Yee
+// difference), plus the Blinne-type transverse terms: the same legs
+// shifted by +-b cells (b=1..3) along each transverse direction of the
+// grid, with weight beta[a-1][b-1]. The coefficients are the same along
+// x, y, and z (cubic cells). Zero coefficients are compiled out.
+
+/// fourth order (Yee-like) stencil; same coefficients as the FDTD4 defaults
+struct Fourth {
+  static constexpr float alpha[3] = { 9.0f/8.0f, -1.0f/24.0f, 0.0f };
+  static constexpr float beta[3][3] = {};
+};
+
+/// Pukhov's transverse stencil with beta = 1/8 for the Yee leg
+//
+// The simplest Blinne-type stencil; the transverse legs reduce the
+// numerical dispersion along the axes.
+template<size_t D>
+struct Pukhov {
+  static constexpr float alpha[3] = { 1.0f - 2.0f*(D-1)/8.0f, 0.0f, 0.0f };
+  static constexpr float beta[3][3] = { {1.0f/8.0f, 0.0f, 0.0f} };
+};
+
+
+/// flat view of the E and B meshes; strides are zero along collapsed dimensions
+struct View {
+  float *ex, *ey, *ez, *bx, *by, *bz;
+  size_t base;
+  size_t st[3];
+
+  DEVCALLABLE inline size_t indx(int i, int j, int k) const
+  {
+    return base + i + j*st[1] + k*st[2];
+  }
+};
+
+inline View view(Grids& gs)
+{
+  const size_t n = gs.ex.indx(0,0,0);
+  return { gs.ex.data(), gs.ey.data(), gs.ez.data(),
+           gs.bx.data(), gs.by.data(), gs.bz.data(),
+           n,
+           { 1,
+             gs.Ny > 1 ? gs.ex.indx(0,1,0) - n : 0,
+             gs.Nz > 1 ? gs.ex.indx(0,0,1) - n : 0 } };
+}
+
+
+/// stride of the flat index along dir; unit along x so that x rows are contiguous
+template<size_t dir>
+DEVCALLABLE inline size_t stride(const size_t* st)
+{
+  if constexpr (dir == 0) { return 1; } else { return st[dir]; }
+}
+
+
+/// transverse legs of leg a, shifted along t
+template<typename S, size_t D, size_t t, size_t a>
+DEVCALLABLE inline float shifted(const float* f, size_t lo, size_t hi, const size_t* st)
+{
+  if constexpr (t >= D) {
+    return 0.0f;
+  } else {
+    const size_t s = stride<t>(st);
+    float sum = 0.0f;
+    if constexpr (S::beta[a-1][0] != 0.0f) sum += S::beta[a-1][0]*(f[hi+s]   - f[lo+s]   + f[hi-s]   - f[lo-s]);
+    if constexpr (S::beta[a-1][1] != 0.0f) sum += S::beta[a-1][1]*(f[hi+2*s] - f[lo+2*s] + f[hi-2*s] - f[lo-2*s]);
+    if constexpr (S::beta[a-1][2] != 0.0f) sum += S::beta[a-1][2]*(f[hi+3*s] - f[lo+3*s] + f[hi-3*s] - f[lo-3*s]);
+    return sum;
+  }
+}
+
+
+/// leg a (difference across 2a-1 cells) of the derivative along dir
+template<typename S, size_t D, size_t dir, bool Back, size_t a>
+DEVCALLABLE inline float leg(const float* f, size_t n, const size_t* st)
+{
+  const size_t s  = stride<dir>(st);
+  const size_t lo = Back ? n - a*s : n - (a-1)*s;
+  const size_t hi = Back ? n + (a-1)*s : n + a*s;
+
+  float sum = 0.0f;
+  if constexpr (S::alpha[a-1] != 0.0f) sum += S::alpha[a-1]*(f[hi] - f[lo]);
+
+  return sum
+    + shifted<S,D,(dir+1)%3,a>(f, lo, hi, st)
+    + shifted<S,D,(dir+2)%3,a>(f, lo, hi, st);
+}
+
+
+/// derivative of f along dir at flat index n
+//
+// Back is the backward difference of the E update (B to E nodes);
+// otherwise the forward difference of the B update (E to B nodes).
+// Directions beyond the grid dimension D have zero derivative.
+template<typename S, size_t D, size_t dir, bool Back>
+DEVCALLABLE inline float diff(const float* f, size_t n, const size_t* st)
+{
+  if constexpr (dir >= D) {
+    return 0.0f;
+  } else {
+    return leg<S,D,dir,Back,1>(f, n, st)
+         + leg<S,D,dir,Back,2>(f, n, st)
+         + leg<S,D,dir,Back,3>(f, n, st);
+  }
+}
+
+
+/// E += C curl B with stencil S
+template<size_t D, typename S>
+void push_e(Tile<D>& tile, float C)
+{
+  const View v = view(tile.get_grids());
+
+  UniIter::iterate3D(
+  [=] DEVCALLABLE (int i, int j, int k)
+  {
+    const size_t n = v.indx(i,j,k);
+    v.ex[n] += C*( diff<S,D,1,true>(v.bz,n,v.st) - diff<S,D,2,true>(v.by,n,v.st) );
+    v.ey[n] += C*( diff<S,D,2,true>(v.bx,n,v.st) - diff<S,D,0,true>(v.bz,n,v.st) );
+    v.ez[n] += C*( diff<S,D,0,true>(v.by,n,v.st) - diff<S,D,1,true>(v.bx,n,v.st) );
+  },
+    tile.mesh_lengths[0],
+    tile.mesh_lengths[1],
+    tile.mesh_lengths[2]);
+
+  UniIter::sync();
+}
+
+
+/// B -= C curl E with stencil S
+template<size_t D, typename S>
+void push_b(Tile<D>& tile, float C)
+{
+  const View v = view(tile.get_grids());
+
+  UniIter::iterate3D(
+  [=] DEVCALLABLE (int i, int j, int k)
+  {
+    const size_t n = v.indx(i,j,k);
+    v.bx[n] -= C*( diff<S,D,1,false>(v.ez,n,v.st) - diff<S,D,2,false>(v.ey,n,v.st) );
+    v.by[n] -= C*( diff<S,D,2,false>(v.ex,n,v.st) - diff<S,D,0,false>(v.ez,n,v.st) );
+    v.bz[n] -= C*( diff<S,D,0,false>(v.ey,n,v.st) - diff<S,D,1,false>(v.ex,n,v.st) );
+  },
+    tile.mesh_lengths[0],
+    tile.mesh_lengths[1],
+    tile.mesh_lengths[2]);
+
+  UniIter::sync();
+}
+
+} // end of namespace stencil
+
+
+/// Staggered finite difference time domain Maxwell's field equation
+//  solver with a compile-time coefficient set S (see emf::stencil)
+//
+// The coefficients are constants of the compiled curl, so that the leg
+// loops unroll into a fixed stencil and the inner loop over x vectorizes;
+// FDTDGen is the runtime-coefficient counterpart for experiments.
+template<size_t D, typename S>
+class FDTDStencil :
+  public Propagator<D>
+{
+  public:
+
+  /// numerical correction factor to speed of light
+  double corr = 1.0;
+
+  void push_e(Tile<D>& tile) override
+  {
+#ifdef GPU
+    nvtxRangePush(__PRETTY_FUNCTION__);
+#endif
+    trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
+    stencil::push_e<D,S>(tile, tile.cfl*this->dt*corr);
+
+#ifdef GPU
+    nvtxRangePop();
+#endif
+  }
+
+  void push_half_b(Tile<D>& tile) override
+  {
+#ifdef GPU
+    nvtxRangePush(__PRETTY_FUNCTION__);
+#endif
+    trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
+    stencil::push_b<D,S>(tile, 0.5*tile.cfl*this->dt*corr);
+
+#ifdef GPU
+    nvtxRangePop();
+#endif
+  }
+};
+
+
+/// Pukhov's transverse (Blinne-type) stencil solver
+template<size_t D>
+class FDTDPukhov :
+  public FDTDStencil<D, stencil::Pukhov<D>>
+{ };
+
+// curl loops are compiled once in fdtd_stencil.c++
+extern template void stencil::push_e<2, stencil::Fourth>(Tile<2>&, float);
+extern template void stencil::push_e<3, stencil::Fourth>(Tile<3>&, float);
+extern template void stencil::push_b<2, stencil::Fourth>(Tile<2>&, float);
+extern template void stencil::push_b<3, stencil::Fourth>(Tile<3>&, float);
+extern template class FDTDStencil<2, stencil::Pukhov<2>>;
+extern template class FDTDStencil<3, stencil::Pukhov<3>>;
+
+} // end of namespace emf
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <cmath>
+#include <algorithm>
 
 #include "core/emf/tile.h"
 
@@ -7,6 +8,8 @@
 #include "external/iter/iter.h"
 #include "external/iter/allocator.h"
 
+#include "external/timer/tracer.h"
+
 #ifdef GPU
 #include <nvtx3/nvToolsExt.h> 
 #endif
@@ -31,11 +34,15 @@ namespace emf {
 template<std::size_t D>
 void Tile<D>::deposit_current() 
 {
+  // nothing to deposit from released currents
+  if(!get_grids().has_currents()) return;
 
 #ifdef GPU
   nvtxRangePush(__PRETTY_FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
   auto& mesh = get_grids();
 
   UniIter::iterate3D(
@@ -64,6 +71,8 @@ void Tile<1>::update_boundaries(
         std::vector<int> iarr
         ) 
 {
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
   using Tile_t  = Tile<1>;
   using Tileptr = std::shared_ptr<Tile_t>;
 
@@ -74,6 +83,9 @@ void Tile<1>::update_boundaries(
   // target
   auto& lhs = get_grids();
 
+  // released currents have no halos to update
+  if(!lhs.has_currents()) iarr.erase(std::remove(iarr.begin(), iarr.end(), 0), iarr.end());
+
   const int Nx = lhs.Nx;
 
 
@@ -85,6 +97,9 @@ void Tile<1>::update_boundaries(
     if (tpr) {
       auto& rhs = tpr->get_grids();
 
+      // released neighbour currents have nothing to copy
+      const bool copy_j = has_elem(iarr, 0) && rhs.has_currents();
+
       // copy from right side to left
       //copy_vert_grids(mesh, mleft, iarr, -1, mleft.Nx-1); 
         
@@ -94,7 +109,7 @@ void Tile<1>::update_boundaries(
       if (in == +1) { ito = Nx; ifro = 0; }
       if (in == -1) { ito = -1; ifro = Nx-1; }
 
-      if(has_elem(iarr, 0)) {
+      if(copy_j) {
         UniIter::iterate([=] DEVCALLABLE (int h, Grids &lhs_in, Grids &rhs_in){
           lhs_in.jx(ito+in*h, 0, 0) = rhs_in.jx(ifro+in*h, 0, 0);
           lhs_in.jy(ito+in*h, 0, 0) = rhs_in.jy(ifro+in*h, 0, 0);
@@ -130,6 +145,8 @@ void Tile<2>::update_boundaries(
         std::vector<int> iarr
         ) 
 {
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
   using Tile_t  = Tile<2>;
   using Tileptr = std::shared_ptr<Tile_t>;
 
@@ -138,6 +155,9 @@ void Tile<2>::update_boundaries(
 
   auto& lhs = get_grids(); // target as a reference to update into
 
+  // released currents have no halos to update
+  if(!lhs.has_currents()) iarr.erase(std::remove(iarr.begin(), iarr.end(), 0), iarr.end());
+
   const int Nx = lhs.Nx;
   const int Ny = lhs.Ny;
   //const int Nz = lhs.Nz;
@@ -152,6 +172,9 @@ void Tile<2>::update_boundaries(
       if (tpr) {
         auto& rhs = tpr->get_grids();
 
+        // released neighbour currents have nothing to copy
+        const bool copy_j = has_elem(iarr, 0) && rhs.has_currents();
+
         /* diagonal rules are:
         if + then to   n
         if + then from 0
@@ -175,7 +198,7 @@ void Tile<2>::update_boundaries(
         if (jn == 0) { // vertical
           //for(int h=0; h<halo; h++) copy_vert_grids(mesh, mpr, iarr, ito+in*h, ifro+in*h);   
 
-          if(has_elem(iarr, 0)) {
+          if(copy_j) {
 
             #ifdef VEC_FLD2D
             UniIter::iterate2D([=] DEVCALLABLE (int j, int h, Grids &lhs_in, Grids &rhs_in){
@@ -230,7 +253,7 @@ void Tile<2>::update_boundaries(
         } else if (in == 0) { // horizontal
           //for(int g=0; g<halo; g++) copy_horz_grids(mesh, mpr, iarr, jto+jn*g, jfro+jn*g);   
 
-          if(has_elem(iarr, 0)) {
+          if(copy_j) {
             #ifdef VEC_FLD2D
             UniIter::iterate2D([=] DEVCALLABLE (int i, int g, Grids &lhs_in, Grids &rhs_in){
               lhs_in.jx(i, jto+jn*g, 0) = rhs_in.jx(i, jfro+jn*g, 0);
@@ -288,7 +311,7 @@ void Tile<2>::update_boundaries(
           //  }
           //}
 
-          if(has_elem(iarr, 0)) {
+          if(copy_j) {
             #ifdef VEC_FLD2D
             UniIter::iterate2D([=] DEVCALLABLE (int g ,int h, Grids &lhs_in, Grids &rhs_in){
               lhs_in.jx(ito+in*h, jto+jn*g, 0) = rhs_in.jx(ifro+in*h, jfro+jn*g, 0);
@@ -358,6 +381,8 @@ void Tile<3>::update_boundaries(
   nvtxRangePush(__FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
   using Tile_t  = Tile<3>;
   using Tileptr = std::shared_ptr<Tile_t>;
 
@@ -367,6 +392,9 @@ void Tile<3>::update_boundaries(
   auto& lhs = get_grids(); // target as a reference to update into
   const int halo = 3; // halo region size for fields
 
+  // released currents have no halos to update
+  if(!lhs.has_currents()) iarr.erase(std::remove(iarr.begin(), iarr.end(), 0), iarr.end());
+
   const int Nx = lhs.Nx;
   const int Ny = lhs.Ny;
   const int Nz = lhs.Nz;
@@ -382,6 +410,9 @@ void Tile<3>::update_boundaries(
         if (tpr) {
           auto& rhs = tpr->get_grids();
 
+          // released neighbour currents have nothing to copy
+          const bool copy_j = has_elem(iarr, 0) && rhs.has_currents();
+
           /* diagonal rules are:
           if + then to   n
           if + then from 0
@@ -407,7 +438,7 @@ void Tile<3>::update_boundaries(
               //for(int h=0; h<halo; h++) copy_vert_grids(mesh, mpr, iarr, ito+in*h, ifro+in*h);   
               //copy_vert_grids_halo(mesh, mpr, mesh.ex.Ny, mesh.ex.Nz, halo, ito, ifro, in, ind);
 
-              if(has_elem(iarr, 0)) {
+              if(copy_j) {
                 #ifdef VEC_FLD3D
                 UniIter::iterate3D([=] DEVCALLABLE (int j, int k ,int h, Grids &lhs_in, Grids &rhs_in){
                   lhs_in.jx(ito+in*h, j, k) = rhs_in.jx(ifro+in*h, j, k);
@@ -463,7 +494,7 @@ void Tile<3>::update_boundaries(
               //for(int g=0; g<halo; g++) copy_horz_grids(mesh, mpr,iarr, jto+jn*g, jfro+jn*g);   
               //copy_horz_grids_halo(mesh, mpr, mesh.ex.Nx, mesh.ex.Nz, halo, jto, jfro, jn, ind);
 
-              if(has_elem(iarr, 0)) {
+              if(copy_j) {
                 #ifdef VEC_FLD3D
                 UniIter::iterate3D([=] DEVCALLABLE (int i, int k ,int g, Grids &lhs_in, Grids &rhs_in){
                   lhs_in.jx(i, jto+jn*g, k) = rhs_in.jx(i, jfro+jn*g, k);
@@ -522,7 +553,7 @@ void Tile<3>::update_boundaries(
               //} }
              //copy_z_pencil_grids_halo(mesh, mpr, mesh.ex.Nz, halo, ito, ifro, jto, jfro, in, jn, ind);
 
-              if(has_elem(iarr, 0)) {
+              if(copy_j) {
                 #ifdef VEC_FLD3D
                 UniIter::iterate3D([=] DEVCALLABLE (int k, int g ,int h, Grids &lhs_in, Grids &rhs_in){
                   lhs_in.jx(ito+in*h, jto+jn*g, k) = rhs_in.jx(ifro+in*h, jfro+jn*g, k);
@@ -583,7 +614,7 @@ void Tile<3>::update_boundaries(
               //for(int g=0; g<halo; g++) copy_face_grids(mesh, mpr, iarr, kto+kn*g, kfro+kn*g);   
               //copy_face_grids_halo(mesh, mpr, mesh.ex.Nx, mesh.ex.Ny, halo, kto, kfro, kn, ind);
 
-              if(has_elem(iarr, 0)) {
+              if(copy_j) {
                 #ifdef VEC_FLD3D
                 UniIter::iterate3D([=] DEVCALLABLE (int i, int j ,int f, Grids &lhs_in, Grids &rhs_in){
                   lhs_in.jx(i, j, kto +kn*f) =  rhs_in.jx(i, j, kfro+kn*f);
@@ -649,7 +680,7 @@ void Tile<3>::update_boundaries(
               //}}
               //copy_y_pencil_grids_halo(mesh, mpr, mesh.ex.Ny, halo, ito, ifro, kto, kfro, in, kn, ind);
 
-              if(has_elem(iarr, 0)) {
+              if(copy_j) {
                 #ifdef VEC_FLD3D
                 UniIter::iterate3D([=] DEVCALLABLE (int j, int g ,int h, Grids &lhs_in, Grids &rhs_in){
                   lhs_in.jx(ito+in*h, j, kto+kn*g) = rhs_in.jx(ifro+in*h, j, kfro+kn*g);
@@ -711,7 +742,7 @@ void Tile<3>::update_boundaries(
               //}}
               //copy_x_pencil_grids_halo(mesh, mpr, mesh.ex.Nx, halo, jto, jfro, kto, kfro, jn, kn, ind);
 
-              if(has_elem(iarr, 0)) {
+              if(copy_j) {
                 #ifdef VEC_FLD3D
                 UniIter::iterate3D([=] DEVCALLABLE (int i, int g ,int h, Grids &lhs_in, Grids &rhs_in){
                   lhs_in.jx(i, jto+jn*h, kto+kn*g) = rhs_in.jx(i, jfro+jn*h, kfro+kn*g);
@@ -775,7 +806,7 @@ void Tile<3>::update_boundaries(
               //}}}
               //copy_point_grids_halo(mesh, mpr, halo, ito, ifro, jto, jfro, kto, kfro, in, jn, kn, ind);
 
-              if(has_elem(iarr, 0)) {
+              if(copy_j) {
                 #ifdef VEC_FLD3D
                 UniIter::iterate3D([=] DEVCALLABLE (int f, int g ,int h, Grids &lhs_in, Grids &rhs_in){
                   lhs_in.jx(ito +in*h, jto +jn*g, kto +kn*f) =  rhs_in.jx(ifro+in*h, jfro+jn*g, kfro+kn*f);
@@ -847,6 +878,9 @@ void Tile<3>::update_boundaries(
 template<>
 void Tile<1>::exchange_currents(corgi::Grid<1>& grid) 
 {
+  if(!get_grids().has_currents()) return; // released currents
+
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
 
   using Tile_t  = Tile<1>;
   using Tileptr = std::shared_ptr<Tile_t>;
@@ -868,7 +902,7 @@ void Tile<1>::exchange_currents(corgi::Grid<1>& grid)
     if (in == 0) continue;
     tpr = std::dynamic_pointer_cast<Tile_t>(grid.get_tileptr( neighs(in) ));
 
-    if (tpr) {
+    if (tpr && tpr->get_grids().has_currents()) { // released neighbour currents add nothing
       auto& rhs = tpr->get_grids();
 
       //shifted neg's from vals with -1
@@ -922,6 +956,9 @@ void Tile<1>::exchange_currents(corgi::Grid<1>& grid)
 template<>
 void Tile<2>::exchange_currents(corgi::Grid<2>& grid) 
 {
+  if(!get_grids().has_currents()) return; // released currents
+
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
 
   using Tile_t  = Tile<2>;
   using Tileptr = std::shared_ptr<Tile_t>;
@@ -942,7 +979,7 @@ void Tile<2>::exchange_currents(corgi::Grid<2>& grid)
       if (in == 0 && jn == 0) continue;
 
       tpr = std::dynamic_pointer_cast<Tile_t>(grid.get_tileptr( neighs(in, jn) ));
-      if (tpr) {
+      if (tpr && tpr->get_grids().has_currents()) { // released neighbour currents add nothing
         auto& rhs = tpr->get_grids();
 
         /* diagonal rules are:
@@ -1023,11 +1060,14 @@ void Tile<2>::exchange_currents(corgi::Grid<2>& grid)
 template<>
 void Tile<3>::exchange_currents(corgi::Grid<3>& grid) 
 {
+  if(!get_grids().has_currents()) return; // released currents
 
 #ifdef GPU
   nvtxRangePush(__PRETTY_FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
   using Tile_t  = Tile<3>;
   using Tileptr = std::shared_ptr<Tile_t>;
 
@@ -1048,7 +1088,7 @@ void Tile<3>::exchange_currents(corgi::Grid<3>& grid)
         if (in == 0 && jn == 0 && kn == 0) continue;
 
         tpr = std::dynamic_pointer_cast<Tile_t>(grid.get_tileptr( neighs(in, jn, kn) ));
-        if (tpr) {
+        if (tpr && tpr->get_grids().has_currents()) { // released neighbour currents add nothing
           auto& rhs = tpr->get_grids();
 
           /* diagonal rules are:
@@ -1256,7 +1296,10 @@ void Tile<D>::clear_current()
   nvtxRangePush(__PRETTY_FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "emf");
+
   auto& gs = this->get_grids();
+  gs.alloc_currents();
   gs.jx.clear();
   gs.jy.clear();
   gs.jz.clear();
@@ -1294,12 +1337,15 @@ std::vector<mpi::request> Tile<D>::send_data(
   nvtxRangePush(__FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "mpi");
+
   auto& gs = get_grids(); 
   std::vector<mpi::request> reqs;
 
   UniIter::sync();
 
   if (mode == 0) {
+    gs.alloc_currents();
     reqs.emplace_back( comm.isend(dest, get_tag(tag, 0), gs.jx.data(), gs.jx.size()) );
     reqs.emplace_back( comm.isend(dest, get_tag(tag, 1), gs.jy.data(), gs.jy.size()) );
     reqs.emplace_back( comm.isend(dest, get_tag(tag, 2), gs.jz.data(), gs.jz.size()) );
@@ -1333,6 +1379,8 @@ std::vector<mpi::request> Tile<D>::recv_data(
   nvtxRangePush(__FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "mpi");
+
   auto& gs = get_grids(); 
 
   std::vector<mpi::request> reqs;
@@ -1340,6 +1388,7 @@ std::vector<mpi::request> Tile<D>::recv_data(
   UniIter::sync();
 
   if (mode == 0) {
+    gs.alloc_currents();
     reqs.emplace_back( comm.irecv(orig, get_tag(tag, 0), gs.jx.data(), gs.jx.size()) );
     reqs.emplace_back( comm.irecv(orig, get_tag(tag, 1), gs.jy.data(), gs.jy.size()) );
     reqs.emplace_back( comm.irecv(orig, get_tag(tag, 2), gs.jz.data(), gs.jz.size()) );
@@ -13,6 +13,12 @@ namespace emf {
   namespace mpi = mpi4cpp::mpi;
 
 /// Yee lattice of plasma quantities
+//
+// E, B, and J are allocated with the lattice. The charge density is
+// only needed for output and is allocated on first use (alloc_rho) and
+// can be released again afterwards (free_rho). Runs that only propagate
+// fields can release the currents (free_currents); the tile routines
+// that deposit, clear, or communicate currents re-allocate them.
 class Grids
 {
 
@@ -54,7 +60,6 @@ class Grids
     bx{Nx, Ny, Nz},
     by{Nx, Ny, Nz},
     bz{Nx, Ny, Nz},
-    rho{Nx, Ny, Nz},
     jx{Nx, Ny, Nz},
     jy{Nx, Ny, Nz},
     jz{Nx, Ny, Nz}
@@ -62,6 +67,38 @@ class Grids
     //DEV_REGISTER
   }
 
+  /// is the charge density allocated
+  bool has_rho() const { return rho.size() > 0; }
+
+  /// are the currents allocated
+  bool has_currents() const { return jx.size() > 0; }
+
+  /// allocate a zero charge density unless already done
+  void alloc_rho() 
+  { 
+    if(!has_rho()) rho = toolbox::Mesh<float, 3>(Nx, Ny, Nz);
+  }
+
+  /// release the charge density
+  void free_rho() { rho = toolbox::Mesh<float, 3>(); }
+
+  /// allocate zero currents unless already done
+  void alloc_currents() 
+  {
+    if(has_currents()) return;
+    jx = toolbox::Mesh<float, 3>(Nx, Ny, Nz);
+    jy = toolbox::Mesh<float, 3>(Nx, Ny, Nz);
+    jz = toolbox::Mesh<float, 3>(Nx, Ny, Nz);
+  }
+
+  /// release the currents
+  void free_currents() 
+  {
+    jx = toolbox::Mesh<float, 3>();
+    jy = toolbox::Mesh<float, 3>();
+    jz = toolbox::Mesh<float, 3>();
+  }
+
   // copy ctor
   Grids(Grids& other) = default;
 
@@ -112,6 +149,62 @@ class Grids
 };
 
 
+/// Tabulated background (external) field on the Yee lattice
+//
+// Analytic external fields are evaluated once on the staggered grid points
+// of a tile (halos included) and re-tabulated only when the parameters they
+// depend on change, e.g., when the rotation phase of a dipole is advanced.
+// The owner of the field stores its parameters in `key` to detect this.
+class BackgroundGrids
+{
+
+  public:
+
+  /// Electric field 
+  toolbox::Mesh<float, 3> ex;
+  toolbox::Mesh<float, 3> ey;
+  toolbox::Mesh<float, 3> ez;
+  
+  /// Magnetic field 
+  toolbox::Mesh<float, 3> bx;
+  toolbox::Mesh<float, 3> by;
+  toolbox::Mesh<float, 3> bz;
+
+  /// parameters the current tabulation was made with
+  std::vector<float> key;
+
+  BackgroundGrids() = default;
+
+  /// allocate meshes; resets the tabulation
+  void resize(int Nx, int Ny, int Nz)
+  {
+    ex = toolbox::Mesh<float,3>(Nx, Ny, Nz);
+    ey = toolbox::Mesh<float,3>(Nx, Ny, Nz);
+    ez = toolbox::Mesh<float,3>(Nx, Ny, Nz);
+    bx = toolbox::Mesh<float,3>(Nx, Ny, Nz);
+    by = toolbox::Mesh<float,3>(Nx, Ny, Nz);
+    bz = toolbox::Mesh<float,3>(Nx, Ny, Nz);
+    key.clear();
+  }
+
+  /// free the meshes; allocated again by the next resize
+  void release()
+  {
+    ex = toolbox::Mesh<float,3>();
+    ey = toolbox::Mesh<float,3>();
+    ez = toolbox::Mesh<float,3>();
+    bx = toolbox::Mesh<float,3>();
+    by = toolbox::Mesh<float,3>();
+    bz = toolbox::Mesh<float,3>();
+    key.clear();
+  }
+
+  /// true if the meshes hold a tabulation made with parameters `k`
+  bool is_valid(const std::vector<float>& k) const { return !key.empty() && key == k; }
+
+};
+
+
 
 /*! \brief General Plasma tile for solving Maxwell's equations
  *
@@ -132,6 +225,9 @@ class Tile :
   /// Yee lattice of plasma quantities (with 1 timestep)
   Grids grids;
 
+  /// tabulated background field; allocated on first use
+  BackgroundGrids background;
+
   /// explicitly show that we import tile limits from base class 
   using corgi::Tile<D>::mins;
   using corgi::Tile<D>::maxs;
@@ -182,6 +278,20 @@ class Tile :
 
   virtual void clear_current();
 
+  /// Get background field tabulation; allocated to the tile size on first call
+  BackgroundGrids& get_background()
+  {
+    if(background.ex.Nx != mesh_lengths[0]) 
+      background.resize(mesh_lengths[0], mesh_lengths[1], mesh_lengths[2]);
+    return background;
+  }
+
+  /// true if the tile carries a valid background field tabulation
+  bool has_background() const { return !background.key.empty(); }
+
+  /// Free the background field tabulation
+  void release_background() { background.release(); }
+
   std::vector<mpi::request> 
   send_data( mpi::communicator& /*comm*/, int dest, int mode, int tag) override;
 
@@ -124,6 +124,7 @@ template<>
 void ffe::FFE2<3>::comp_rho(ffe::Tile<3>& tile)
 {
   emf::Grids& mesh = tile.get_grids();
+  mesh.alloc_rho();
   auto& rho = mesh.rho;
   auto& ex  = mesh.ex;
   auto& ey  = mesh.ey;
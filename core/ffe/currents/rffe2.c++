@@ -73,6 +73,7 @@ void ffe::rFFE2<3>::comp_rho(ffe::Tile<3>& tile)
   //nvtxRangePush(__FUNCTION__);
   
   emf::Grids& mesh = tile.get_grids();
+  mesh.alloc_rho();
 
   // NOTE: compute rho from -1 to +1 because later on we re-stagger it 
   // and need the guard zones for interpolation
@@ -82,6 +82,7 @@ template<>
 void ffe::rFFE4<3>::comp_rho(ffe::Tile<3>& tile)
 {
   emf::Grids& mesh = tile.get_grids();
+  mesh.alloc_rho();
   auto& rho = mesh.rho;
   auto& ex  = mesh.ex;
   auto& ey  = mesh.ey;
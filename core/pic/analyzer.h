@@ -32,6 +32,7 @@ class Analyzator {
 
     // Yee lattice reference
     auto& gs = tile.get_grids();
+    gs.alloc_rho();
     gs.rho.clear();
 
     // tile limits
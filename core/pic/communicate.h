@@ -116,3 +116,14 @@ inline MPI_Datatype get_mpi_datatype<::pic::Particle>(
 
 } } // ns mpi4cpp::mpi
 
+
+namespace pic {
+
+/// MPI tag of the first particle message of species extra_param
+int get_tag(int tag, int extra_param);
+
+/// MPI tag of the extra particle message of species extra_param
+int get_extra_tag(int tag, int extra_param);
+
+} // ns pic
+
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <algorithm>
+
+#include "core/emf/tile.h"
+#include "core/pic/particle.h"
+#include "core/pic/interpolators/block_gather.h"
+#include "external/iter/devcall.h"
+#include "external/iter/iter.h"
+
+namespace pic {
+
+/// writable view of the three current components with flat (i,j,k) indexing
+//
+// Shared views (the tile meshes) add atomically; private views (a
+// BlockCurrent accumulator owned by one thread) add plainly. The strides iy
+// and iz are zero along collapsed dimensions.
+template<bool Shared>
+struct CurrentView {
+  float *jx, *jy, *jz;
+  size_t base, iy, iz;
+
+  DEVCALLABLE inline size_t indx(int i, int j, int k) const { return base + i + j*iy + k*iz; }
+
+  DEVCALLABLE inline void add(float* f, size_t ind, double val) const
+  {
+    if constexpr (Shared) {
+      atomic_add(f[ind], val);
+    } else {
+      f[ind] += val;
+    }
+  }
+};
+
+using MeshCurrent  = CurrentView<true>;
+using LocalCurrent = CurrentView<false>;
+
+
+/// view of the tile current meshes themselves
+inline MeshCurrent mesh_current(emf::Grids& gs, size_t iy, size_t iz)
+{
+  return { gs.jx.data(), gs.jy.data(), gs.jz.data(), gs.jx.indx(0,0,0), iy, iz };
+}
+
+
+/// private current accumulator of one cell-block of a sorted container
+//
+// Covers the nodes [c0-lo, c1-1+hi] per dimension (clipped to the mesh
+// halo), where [c0, c1) are the cells of the block and lo/hi the reach of
+// the deposit stencil below/above the current cell of a particle. The sums
+// are added to the tile mesh once per block with flush(). Particles whose
+// cell is outside the block must deposit to the mesh view directly.
+template<size_t D>
+class BlockCurrent
+{
+  std::vector<float> buf;
+
+  std::array<int,3> n0 = {{0,0,0}}, nn = {{1,1,1}}; // first node and node count
+
+  public:
+
+  /// cells of the block along each dimension
+  std::array<int,3> c0 = {{0,0,0}}, c1 = {{1,1,1}};
+
+  /// zero the accumulator of cell-block b; returns a view of it
+  LocalCurrent open(const emf::Grids& gs, const ParticleContainer<D>& con, int b, int lo, int hi)
+  {
+    const int H = 3; // halo of the tile meshes
+    const std::array<int,3> N = {{ gs.Nx, gs.Ny, gs.Nz }};
+    block_cells<D>(con, N, b, c0, c1);
+
+    for(size_t i=0; i<D; i++) {
+      n0[i] = std::max(c0[i] - lo, -H);
+      nn[i] = std::min(c1[i] - 1 + hi, N[i] - 1 + H) - n0[i] + 1;
+    }
+
+    const size_t sy  = nn[0];
+    const size_t sz  = nn[0]*nn[1];
+    const size_t vol = sz*nn[2];
+    buf.assign(3*vol, 0.0f);
+
+    // shift the flat index so that indx(i,j,k) addresses tile-local (i,j,k)
+    const size_t vy = D >= 2 ? sy : 0;
+    const size_t vz = D >= 3 ? sz : 0;
+    const size_t base = size_t(0) - n0[0] - n0[1]*vy - n0[2]*vz;
+
+    float* p = buf.data();
+    return { p, p+vol, p+2*vol, base, vy, vz };
+  }
+
+  /// cell (i,j,k) belongs to the opened block
+  inline bool contains(int i, int j, int k) const
+  {
+    return (D < 1 || (i >= c0[0] && i < c1[0])) &&
+           (D < 2 || (j >= c0[1] && j < c1[1])) &&
+           (D < 3 || (k >= c0[2] && k < c1[2]));
+  }
+
+  /// add the accumulated block currents to the tile mesh
+  //
+  // Neighbouring blocks overlap in their halos and may be flushed by other
+  // threads, so the nodes are added atomically; untouched nodes are skipped.
+  void flush(emf::Grids& gs) const
+  {
+    const size_t sy  = nn[0];
+    const size_t sz  = nn[0]*nn[1];
+    const size_t vol = sz*nn[2];
+
+    toolbox::Mesh<float,3>* ms[3] = {&gs.jx, &gs.jy, &gs.jz};
+    for(int c=0; c<3; c++) {
+      float* f = ms[c]->data();
+      const float* src = buf.data() + c*vol;
+
+      for(int k=0; k<nn[2]; k++)
+      for(int j=0; j<nn[1]; j++) {
+        const size_t dst = ms[c]->indx(n0[0], n0[1]+j, n0[2]+k);
+        for(int i=0; i<nn[0]; i++) {
+          const float val = src[i + j*sy + k*sz];
+          if(val != 0.0f) atomic_add(f[dst + i], val);
+        }
+      }
+    }
+  }
+};
+
+
+} // end of namespace pic
@@ -1,11 +1,25 @@
 #pragma once
 
+#include <string>
+#include <stdexcept>
+
 #include "core/pic/tile.h"
 #include "definitions.h"
 
 
 namespace pic {
 
+/// reject sub-cycled pushes longer than a cell
+//
+// A sub-cycled species moves up to subcycle*cfl cells per push, but the
+// current splits of the depositers assume moves of less than one cell.
+inline void check_subcycle_span(int subcycle, double cfl, const std::string& name)
+{
+  if(subcycle > 1 && subcycle*cfl >= 1.0)
+    throw std::invalid_argument(name + ": subcycle*cfl >= 1; a sub-cycled species" 
+        " can move a full cell or more per push");
+}
+
 /// General interface for current depositer
 template<size_t D, size_t V>
 class Depositer
@@ -1,21 +1,16 @@
 #pragma once
 
-#include "core/pic/depositers/depositer.h"
+#include "core/pic/depositers/shape_depositer.h"
 
 namespace pic {
 
 /// Second order current depositer applying the Esikerpo method
 template<size_t D, size_t V>
 class Esikerpov_2nd :
-  public virtual Depositer<D,V>
-{
-public:
-  void solve(pic::Tile<D>& tile) override;
+  public ShapeDepositer<D,V, shape::Esirkepov<2>>
+{ };
 
-};
+// particle loop is compiled once in esikerpov_2nd.c++
+extern template class ShapeDepositer<3,3, shape::Esirkepov<2>>;
 
 } // end of namespace pic
-
-
-
-
@@ -1,21 +1,16 @@
 #pragma once
 
-#include "core/pic/depositers/depositer.h"
+#include "core/pic/depositers/shape_depositer.h"
 
 namespace pic {
 
 /// Fourth order current depositer applying the Esikerpo method
 template<size_t D, size_t V>
 class Esikerpov_4th :
-  public virtual Depositer<D,V>
-{
-public:
-  void solve(pic::Tile<D>& tile) override;
+  public ShapeDepositer<D,V, shape::Esirkepov<4>>
+{ };
 
-};
+// particle loop is compiled once in esikerpov_4th.c++
+extern template class ShapeDepositer<3,3, shape::Esirkepov<4>>;
 
 } // end of namespace pic
-
-
-
-
@@ -7,6 +7,8 @@
 #include "external/iter/iter.h"
 
 
+#include "external/timer/tracer.h"
+
 #ifdef GPU
 #include <nvtx3/nvToolsExt.h> 
 #endif
@@ -38,6 +40,8 @@ void pic::Esikerpov_4th<D,V>::solve( pic::Tile<D>& tile )
   nvtxRangePush(__PRETTY_FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "pic");
+
   auto& gs = tile.get_grids();
   const auto mins = tile.mins;
 
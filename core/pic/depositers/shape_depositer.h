@@ -0,0 +1,452 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <type_traits>
+
+#include "core/pic/depositers/depositer.h"
+#include "core/pic/depositers/block_scatter.h"
+#include "core/pic/shapes.h"
+#include "external/iter/iter.h"
+
+#include "external/timer/tracer.h"
+
+#ifdef GPU
+#include <nvtx3/nvToolsExt.h>
+#endif
+
+namespace pic {
+namespace shape {
+
+/// nodes of S that a move from x1 to x2 of less than a cell touches
+//
+// Fills s1 and s2 with the weights of x1 and x2 on the nodes i0 ... i0+L-1
+// and returns i0; L is the shape width, plus one if the move changes the
+// reference node.
+template<typename S>
+DEVCALLABLE inline int spread(double x1, double x2, double* s1, double* s2, int& L)
+{
+  const int i1 = S::index(x1);
+  const int i2 = S::index(x2);
+  assert(std::abs(i2 - i1) <= 1);
+
+  const int i0 = std::min(i1, i2);
+  L = S::width + std::abs(i2 - i1);
+
+  for(int l=0; l<L; l++) s1[l] = s2[l] = 0.0;
+  S::weights(x1 - i1, s1 + i1 - i0);
+  S::weights(x2 - i2, s2 + i2 - i0);
+
+  return i0 + S::lo;
+}
+
+
+/// ZigZag current split with B-spline shapes of order O
+//
+// The move x1 -> x2 is split at the relay point (see relay()) into two
+// segments that stay inside one cell of BSpline<O>. A segment deposits q
+// times its length at its midpoint, with BSpline<O-1> on the dual grid
+// along the current component and BSpline<O> across it. O = 1 is the
+// scheme of Umeda et al. (2003). Charge is conserved exactly in 1D up to
+// O = 2 and in 2D for O = 1; otherwise up to the midpoint rule.
+template<int O>
+struct ZigZagSplit
+{
+  /// shape of the charge; its cells bound the deposit stencil
+  using Shape = BSpline<O>;
+
+  template<size_t D, typename View>
+  DEVCALLABLE static inline void deposit(
+      double x1, double y1, double z1,
+      double x2, double y2, double z2,
+      double q,
+      const View& J);
+
+  /// current of the segment x1 -> x2 inside one cell
+  template<size_t D, typename View>
+  DEVCALLABLE static inline void segment(
+      double x1, double y1, double z1,
+      double x2, double y2, double z2,
+      double q,
+      const View& J);
+};
+
+
+template<int O>
+template<size_t D, typename View>
+inline void ZigZagSplit<O>::deposit(
+    double x1, double y1, double z1,
+    double x2, double y2, double z2,
+    double q,
+    const View& J)
+{
+  // relay point; +1 is equal to +\Delta x
+  const double xr = relay<Along<D,0,Shape>>(x1, x2);
+  const double yr = relay<Along<D,1,Shape>>(y1, y2);
+  const double zr = relay<Along<D,2,Shape>>(z1, z2);
+
+  segment<D>(x1, y1, z1, xr, yr, zr, q, J);
+  segment<D>(xr, yr, zr, x2, y2, z2, q, J);
+}
+
+
+template<int O>
+template<size_t D, typename View>
+inline void ZigZagSplit<O>::segment(
+    double x1, double y1, double z1,
+    double x2, double y2, double z2,
+    double q,
+    const View& J)
+{
+  // primary (p) shapes across and dual (d) shapes along the current
+  using Xp = Along<D,0,BSpline<O>>;
+  using Yp = Along<D,1,BSpline<O>>;
+  using Zp = Along<D,2,BSpline<O>>;
+  using Xd = Along<D,0,BSpline<O-1>>;
+  using Yd = Along<D,1,BSpline<O-1>>;
+  using Zd = Along<D,2,BSpline<O-1>>;
+
+  //--------------------------------------------------
+  // +q since - sign is already included in the Ampere's equation
+  const double Fx = +q*(x2 - x1);
+  const double Fy = +q*(y2 - y1);
+  const double Fz = +q*(z2 - z1);
+
+  // segment midpoint
+  const double xm = 0.5*(x1 + x2);
+  const double ym = 0.5*(y1 + y2);
+  const double zm = 0.5*(z1 + z2);
+
+  double wxp[Xp::width], wyp[Yp::width], wzp[Zp::width];
+  double wxd[Xd::width], wyd[Yd::width], wzd[Zd::width];
+
+  const int ip = stencil<Xp>(xm, 0.0, wxp);
+  const int jp = stencil<Yp>(ym, 0.0, wyp);
+  const int kp = stencil<Zp>(zm, 0.0, wzp);
+  const int id = stencil<Xd>(xm, 0.5, wxd);
+  const int jd = stencil<Yd>(ym, 0.5, wyd);
+  const int kd = stencil<Zd>(zm, 0.5, wzd);
+
+  // jx(d,p,p)
+  for(int kl=0; kl<Zp::width; kl++)
+  for(int jl=0; jl<Yp::width; jl++)
+  for(int il=0; il<Xd::width; il++)
+    J.add( J.jx, J.indx(id+Xd::lo+il, jp+Yp::lo+jl, kp+Zp::lo+kl), Fx*wxd[il]*wyp[jl]*wzp[kl] );
+
+  // jy(p,d,p)
+  for(int kl=0; kl<Zp::width; kl++)
+  for(int jl=0; jl<Yd::width; jl++)
+  for(int il=0; il<Xp::width; il++)
+    J.add( J.jy, J.indx(ip+Xp::lo+il, jd+Yd::lo+jl, kp+Zp::lo+kl), Fy*wxp[il]*wyd[jl]*wzp[kl] );
+
+  // jz(p,p,d)
+  for(int kl=0; kl<Zd::width; kl++)
+  for(int jl=0; jl<Yp::width; jl++)
+  for(int il=0; il<Xp::width; il++)
+    J.add( J.jz, J.indx(ip+Xp::lo+il, jp+Yp::lo+jl, kd+Zd::lo+kl), Fz*wxp[il]*wyp[jl]*wzd[kl] );
+}
+
+
+/// Esirkepov (2001) current of B-spline shape order O
+//
+// The current along a simulated dimension is the prefix sum of the change
+// of the particle shape; along a collapsed one it is the velocity times the
+// time-averaged shape. Charge-conserving for every order.
+template<int O>
+struct Esirkepov
+{
+  /// shape of the charge; its cells bound the deposit stencil
+  using Shape = BSpline<O>;
+
+  template<size_t D, typename View>
+  DEVCALLABLE static inline void deposit(
+      double x1, double y1, double z1,
+      double x2, double y2, double z2,
+      double q,
+      const View& J);
+};
+
+
+template<int O>
+template<size_t D, typename View>
+inline void Esirkepov<O>::deposit(
+    double x1, double y1, double z1,
+    double x2, double y2, double z2,
+    double q,
+    const View& J)
+{
+  using X = Along<D,0,Shape>;
+  using Y = Along<D,1,Shape>;
+  using Z = Along<D,2,Shape>;
+
+  // shape of the old and new location on the nodes of the move
+  double sx1[X::width+1], sx2[X::width+1], dsx[X::width+1];
+  double sy1[Y::width+1], sy2[Y::width+1], dsy[Y::width+1];
+  double sz1[Z::width+1], sz2[Z::width+1], dsz[Z::width+1];
+
+  int Lx, Ly, Lz;
+  const int i0 = spread<X>(x1, x2, sx1, sx2, Lx);
+  const int j0 = spread<Y>(y1, y2, sy1, sy2, Ly);
+  const int k0 = spread<Z>(z1, z2, sz1, sz2, Lz);
+
+  for(int l=0; l<Lx; l++) dsx[l] = sx2[l] - sx1[l];
+  for(int l=0; l<Ly; l++) dsy[l] = sy2[l] - sy1[l];
+  for(int l=0; l<Lz; l++) dsz[l] = sz2[l] - sz1[l];
+
+  // time-averaged weight of the two transverse shapes
+  auto weight = [](double s1a, double dsa, double s1b, double dsb) {
+    return s1a*s1b + 0.5*dsa*s1b + 0.5*s1a*dsb + dsa*dsb/3.0;
+  };
+
+  // jx; the current of the last node vanishes since the shape is normalized
+  for(int k=0; k<Lz; k++)
+  for(int j=0; j<Ly; j++) {
+    const double w = weight(sy1[j], dsy[j], sz1[k], dsz[k]);
+
+    double jl = 0.0;
+    for(int i=0; i<Lx-1; i++) {
+      jl -= q*dsx[i]*w;
+      J.add( J.jx, J.indx(i0+i, j0+j, k0+k), jl );
+    }
+  }
+
+  // jy
+  for(int k=0; k<Lz; k++)
+  for(int i=0; i<Lx; i++) {
+    const double w = weight(sz1[k], dsz[k], sx1[i], dsx[i]);
+
+    if constexpr (D >= 2) {
+      double jl = 0.0;
+      for(int j=0; j<Ly-1; j++) {
+        jl -= q*dsy[j]*w;
+        J.add( J.jy, J.indx(i0+i, j0+j, k0+k), jl );
+      }
+    } else {
+      J.add( J.jy, J.indx(i0+i, j0, k0+k), q*(y2 - y1)*w );
+    }
+  }
+
+  // jz
+  for(int j=0; j<Ly; j++)
+  for(int i=0; i<Lx; i++) {
+    const double w = weight(sx1[i], dsx[i], sy1[j], dsy[j]);
+
+    if constexpr (D >= 3) {
+      double jl = 0.0;
+      for(int k=0; k<Lz-1; k++) {
+        jl -= q*dsz[k]*w;
+        J.add( J.jz, J.indx(i0+i, j0+j, k0+k), jl );
+      }
+    } else {
+      J.add( J.jz, J.indx(i0+i, j0+j, k0), q*(z2 - z1)*w );
+    }
+  }
+}
+
+} // end of namespace shape
+
+
+/// Current depositer of compile-time shape order
+//
+// Scheme (shape::ZigZagSplit<O> or shape::Esirkepov<O>) deposits the
+// current of one particle moving from x1 to x2; the particle loop, the
+// cell-block scatter and the sub-cycling are shared here.
+//
+// The named depositers (ZigZag_2nd, Esikerpov_4th, ...) are thin
+// subclasses of pre-selected schemes; the particle loop is defined here and
+// explicitly instantiated in their translation units.
+//
+// Cell-block sorted containers (see pic::Tile::sort_in_cell_blocks) are
+// deposited block by block into a private BlockCurrent accumulator.
+template<size_t D, size_t V, typename Scheme>
+class ShapeDepositer :
+  public virtual Depositer<D,V>
+{
+  public:
+
+  void solve(pic::Tile<D>& tile) override;
+
+  private:
+
+  using S = typename Scheme::Shape;
+
+  /// stencil reach below/above the cell of a particle; even orders are centered on the upper node
+  static constexpr int reach_lo = -S::lo;
+  static constexpr int reach_hi =  S::hi + (S::edge < 0.0 ? 1 : 0);
+
+  /// deposit the current of particle n to view J
+  template<typename View>
+  DEVCALLABLE static inline void deposit_particle(
+      size_t n,
+      pic::ParticleContainer<D>& con,
+      const std::array<double,D>& mins,
+      const std::array<int,3>& N,
+      double c, double dt, double q,
+      const View& J);
+};
+
+
+template<size_t D, size_t V, typename Scheme>
+template<typename View>
+inline void ShapeDepositer<D,V,Scheme>::deposit_particle(
+    size_t n,
+    pic::ParticleContainer<D>& con,
+    const std::array<double,D>& mins,
+    const std::array<int,3>& N,
+    double c, double dt, double q,
+    const View& J)
+{
+  //--------------------------------------------------
+  // NOTE: performing velocity calculations via doubles to retain accuracy
+  double u = con.vel(0,n);
+  double v = con.vel(1,n);
+  double w = con.vel(2,n);
+
+  double invgam = 1.0/sqrt(1.0 + u*u + v*v + w*w);
+
+  //--------------------------------------------------
+  // new (normalized) location, x_{n+1}
+  double x2 = D >= 1 ? con.loc(0,n) - mins[0] : con.loc(0,n);
+  double y2 = D >= 2 ? con.loc(1,n) - mins[1] : con.loc(1,n);
+  double z2 = D >= 3 ? con.loc(2,n) - mins[2] : con.loc(2,n);
+
+  // previos location, x_n
+  double x1 = x2 - u*invgam*c*dt;
+  double y1 = y2 - v*invgam*c*dt;
+  double z1 = z2 - w*invgam*c*dt;
+
+  //--------------------------------------------------
+  // debug guard; the stencil nodes must be inside the mesh halo
+  const int H = 3;
+  const double xs1[3] = {x1, y1, z1}, xs2[3] = {x2, y2, z2};
+  for(size_t d=0; d<D; d++) {
+    const int i1 = S::index(xs1[d]);
+    const int i2 = S::index(xs2[d]);
+
+    if(std::min(i1,i2) + S::lo < -H || std::max(i1,i2) + S::hi > N[d] - 1 + H) {
+      std::cerr << "ERROR DEPOSIT:" << std::endl;
+      std::cerr << " x1 " << x1 << " x2 " << x2;
+      std::cerr << " y1 " << y1 << " y2 " << y2;
+      std::cerr << " z1 " << z1 << " z2 " << z2 << std::endl;
+
+      // do not deposit anything
+      assert(false);
+      return;
+    }
+  }
+
+  Scheme::template deposit<D>(x1, y1, z1, x2, y2, z2, q, J);
+}
+
+
+template<size_t D, size_t V, typename Scheme>
+void ShapeDepositer<D,V,Scheme>::solve( pic::Tile<D>& tile )
+{
+
+#ifdef GPU
+  nvtxRangePush(__PRETTY_FUNCTION__);
+#endif
+
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "pic");
+
+  auto& gs = tile.get_grids();
+  const auto mins = tile.mins;
+
+  //clear arrays before new update
+  gs.jx.clear();
+  gs.jy.clear();
+  gs.jz.clear();
+
+  for(auto&& con : tile.containers) {
+
+    // sub-cycled species deposit only on their push laps
+    if(!con.is_active()) continue;
+
+    // sub-cycled pushes must stay within one cell
+    pic::check_subcycle_span(con.subcycle, tile.cfl, "pic::ShapeDepositer::solve");
+
+    // tile current, or the mean current buffer of a sub-cycled species
+    auto& gs = tile.deposit_grids(con);
+
+    const double c  = tile.cfl;     // speed of light
+    const double dt = con.subcycle; // time steps covered by the push
+    const double q  = con.q/dt;     // charge; gives the mean current over dt
+
+    // skip particle species if zero charge
+    if (q == 0.0) continue;
+
+    const std::array<int,3> N = {{ gs.Nx, gs.Ny, gs.Nz }};
+
+    const size_t iy = D >= 2 ? gs.jx.indx(0,1,0) - gs.jx.indx(0,0,0) : 0;
+    const size_t iz = D >= 3 ? gs.jx.indx(0,0,1) - gs.jx.indx(0,0,0) : 0;
+
+    const pic::MeshCurrent mesh = pic::mesh_current(gs, iy, iz);
+
+#ifndef GPU
+    //--------------------------------------------------
+    // cell-block sorted particles into a private accumulator per block
+    if(con.is_cell_sorted()) {
+      const int nblocks = con.block_offsets.size() - 1;
+
+      // cells a particle can cross during the push; widens the block reach
+      const int m = ceil(c*dt);
+
+      #pragma omp parallel
+      {
+        pic::BlockCurrent<D> acc;
+
+        #pragma omp for schedule(dynamic)
+        for(int b=0; b<nblocks; b++) {
+          const int n0 = con.block_offsets[b];
+          const int n1 = con.block_offsets[b+1];
+          if(n0 == n1) continue;
+
+          // stencil of the current cell, from the previous cell up to m away
+          const pic::LocalCurrent local = acc.open(gs, con, b, m + reach_lo, m + reach_hi);
+
+          for(int n=n0; n<n1; n++) {
+            const int i = D >= 1 ? floor(con.loc(0,n) - mins[0]) : 0;
+            const int j = D >= 2 ? floor(con.loc(1,n) - mins[1]) : 0;
+            const int k = D >= 3 ? floor(con.loc(2,n) - mins[2]) : 0;
+
+            // particles that have left their block since the sort use the mesh
+            if(acc.contains(i,j,k)) {
+              deposit_particle(n, con, mins, N, c, dt, q, local);
+            } else {
+              deposit_particle(n, con, mins, N, c, dt, q, mesh);
+            }
+          }
+
+          acc.flush(gs);
+        }
+      }
+
+      continue;
+    }
+#endif
+
+    UniIter::iterate([=] DEVCALLABLE (
+                size_t n,
+                pic::ParticleContainer<D>& con
+                ){
+      deposit_particle(n, con, mins, N, c, dt, q, mesh);
+    }, con.size(), con);
+
+    UniIter::sync();
+  }//end of loop over species
+
+  // add mean currents of sub-cycled species (also between their pushes)
+  tile.add_subcycle_currents();
+
+
+#ifdef GPU
+  nvtxRangePop();
+#endif
+
+}
+
+} // end of namespace pic
@@ -1,6 +1,13 @@
 #pragma once
 
-#include "core/pic/depositers/depositer.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+
+#include "core/pic/depositers/shape_depositer.h"
+#include "external/iter/devcall.h"
 
 namespace pic {
 
@@ -8,15 +15,72 @@ namespace pic {
 // Uses Cloud-in-cell shape (CIC)
 template<size_t D, size_t V>
 class ZigZag :
-  public virtual Depositer<D,V>
+  public ShapeDepositer<D,V, shape::ZigZagSplit<1>>
 {
 public:
-  void solve(pic::Tile<D>& tile) override;
+
+  /// deposit the current of charge q moving from x1 to x2 (tile units) to view J
+  //
+  // Shared with the fused pusher-depositers (see pic::PushZigZag) that
+  // know the previous location without reconstructing it.
+  template<typename View>
+  DEVCALLABLE static inline void deposit(
+      double x1, double y1, double z1,
+      double x2, double y2, double z2,
+      double q,
+      const std::array<double,D>& maxs,
+      const View& J);
 
 };
 
-} // end of namespace pic
 
+template<size_t D, size_t V>
+template<typename View>
+inline void ZigZag<D,V>::deposit(
+    double x1, double y1, double z1,
+    double x2, double y2, double z2,
+    double q,
+    const std::array<double,D>& maxs,
+    const View& J)
+{
+  //--------------------------------------------------
+  int i1  = D >= 1 ? floor(x1) : 0;
+  int i2  = D >= 1 ? floor(x2) : 0;
+  int j1  = D >= 2 ? floor(y1) : 0;
+  int j2  = D >= 2 ? floor(y2) : 0;
+  int k1  = D >= 3 ? floor(z1) : 0;
+  int k2  = D >= 3 ? floor(z2) : 0;
+
+ //-------------------------------------------------- 
+ // check outflow
+
+  // debug guard
+  if( i1 < -3 || i1 + 1 > maxs[0] + 2 ||
+      i2 < -3 || i2 + 1 > maxs[0] + 2 ||
+      j1 < -3 || j1 + 1 > maxs[1] + 2 ||
+      j2 < -3 || j2 + 1 > maxs[1] + 2 ||
+      k1 < -3 || k1 + 1 > maxs[2] + 2 ||
+      k2 < -3 || k2 + 1 > maxs[2] + 2) {
+
+    std::cerr << "ERROR ZIGZAG:" << std::endl;
+    std::cerr << " i1 " << i1 << " i2 " << i2;
+    std::cerr << " j1 " << j1 << " j2 " << j2;
+    std::cerr << " k1 " << k1 << " k2 " << k2;
+    std::cerr << " x1 " << x1 << " x2 " << x2;
+    std::cerr << " y1 " << y1 << " y2 " << y2;
+    std::cerr << " z1 " << z1 << " z2 " << z2 << std::endl;
 
+    // do not deposit anything
+    assert(false);
+    return;
+  }
 
+  shape::ZigZagSplit<1>::deposit<D>(x1, y1, z1, x2, y2, z2, q, J);
+}
 
+// particle loop is compiled once in zigzag.c++
+extern template class ShapeDepositer<1,3, shape::ZigZagSplit<1>>;
+extern template class ShapeDepositer<2,3, shape::ZigZagSplit<1>>;
+extern template class ShapeDepositer<3,3, shape::ZigZagSplit<1>>;
+
+} // end of namespace pic
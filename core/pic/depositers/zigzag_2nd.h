@@ -1,21 +1,18 @@
 #pragma once
 
-#include "core/pic/depositers/depositer.h"
+#include "core/pic/depositers/shape_depositer.h"
 
 namespace pic {
 
-/// Fourth order current depositer applying the ZigZag method
+/// Quadratic (2nd order) current depositer applying the ZigZag method
 template<size_t D, size_t V>
 class ZigZag_2nd :
-  public virtual Depositer<D,V>
-{
-public:
-  void solve(pic::Tile<D>& tile) override;
+  public ShapeDepositer<D,V, shape::ZigZagSplit<2>>
+{ };
 
-};
+// particle loop is compiled once in zigzag_2nd.c++
+extern template class ShapeDepositer<1,3, shape::ZigZagSplit<2>>;
+extern template class ShapeDepositer<2,3, shape::ZigZagSplit<2>>;
+extern template class ShapeDepositer<3,3, shape::ZigZagSplit<2>>;
 
 } // end of namespace pic
-
-
-
-
@@ -1,22 +1,18 @@
 #pragma once
 
-#include "core/pic/depositers/depositer.h"
+#include "core/pic/depositers/shape_depositer.h"
 
 namespace pic {
 
-/// Third order current depositer applying the ZigZag method
-// Uses quadratic particle shape for deposition.
+/// Cubic (3rd order) current depositer applying the ZigZag method
 template<size_t D, size_t V>
 class ZigZag_3rd :
-  public virtual Depositer<D,V>
-{
-public:
-  void solve(pic::Tile<D>& tile) override;
+  public ShapeDepositer<D,V, shape::ZigZagSplit<3>>
+{ };
 
-};
+// particle loop is compiled once in zigzag_3rd.c++
+extern template class ShapeDepositer<1,3, shape::ZigZagSplit<3>>;
+extern template class ShapeDepositer<2,3, shape::ZigZagSplit<3>>;
+extern template class ShapeDepositer<3,3, shape::ZigZagSplit<3>>;
 
 } // end of namespace pic
-
-
-
-
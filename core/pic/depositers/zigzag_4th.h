@@ -1,22 +1,18 @@
 #pragma once
 
-#include "core/pic/depositers/depositer.h"
+#include "core/pic/depositers/shape_depositer.h"
 
 namespace pic {
 
-/// Second order current depositer applying the ZigZag method
-// Uses triangle particle shape for deposition.
+/// Quartic (4th order) current depositer applying the ZigZag method
 template<size_t D, size_t V>
 class ZigZag_4th :
-  public virtual Depositer<D,V>
-{
-public:
-  void solve(pic::Tile<D>& tile) override;
+  public ShapeDepositer<D,V, shape::ZigZagSplit<4>>
+{ };
 
-};
+// particle loop is compiled once in zigzag_4th.c++
+extern template class ShapeDepositer<1,3, shape::ZigZagSplit<4>>;
+extern template class ShapeDepositer<2,3, shape::ZigZagSplit<4>>;
+extern template class ShapeDepositer<3,3, shape::ZigZagSplit<4>>;
 
 } // end of namespace pic
-
-
-
-
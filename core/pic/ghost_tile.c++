@@ -0,0 +1,234 @@
+#include <cmath>
+#include <cassert>
+
+#include "core/pic/ghost_tile.h"
+#include "core/pic/communicate.h"
+
+#include "external/timer/tracer.h"
+
+#ifdef GPU
+#include <nvtx3/nvToolsExt.h>
+#endif
+
+
+namespace pic {
+
+using namespace mpi4cpp;
+
+
+template<std::size_t D>
+std::vector<mpi::request> GhostTile<D>::send_data(
+    mpi::communicator& comm,
+    int dest,
+    int mode,
+    int tag)
+{
+  if(mode == 0) return emf::Tile<D>::send_data(comm, dest, mode, tag);
+  if(mode == 1) return emf::Tile<D>::send_data(comm, dest, mode, tag);
+  if(mode == 2) return emf::Tile<D>::send_data(comm, dest, mode, tag);
+
+  // ghost tiles are never boundary tiles; nothing to send
+  if(mode == 3) return {};
+  if(mode == 4) return {};
+
+  assert(false);
+  return {};
+}
+
+
+template<std::size_t D>
+std::vector<mpi::request> GhostTile<D>::recv_data(
+    mpi::communicator& comm,
+    int orig,
+    int mode,
+    int tag)
+{
+  if(mode == 0) return emf::Tile<D>::recv_data(comm, orig, mode, tag);
+  if(mode == 1) return emf::Tile<D>::recv_data(comm, orig, mode, tag);
+  if(mode == 2) return emf::Tile<D>::recv_data(comm, orig, mode, tag);
+
+  if(mode == 3) return recv_particle_data(comm,orig,tag);
+  if(mode == 4) return recv_particle_extra_data(comm,orig,tag);
+
+  assert(false);
+  return {};
+}
+
+
+template<std::size_t D>
+std::vector<mpi::request> GhostTile<D>::recv_particle_data(
+    mpi::communicator& comm,
+    int orig,
+    int tag)
+{
+
+#ifdef GPU
+  nvtxRangePush(__PRETTY_FUNCTION__);
+#endif
+
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "mpi");
+
+  const int first_message_size = ParticleContainer<D>::first_message_size;
+
+  std::vector<mpi::request> reqs;
+  for (int ispc=0; ispc<Nspecies(); ispc++) {
+    auto& msg = messages[ispc];
+    msg.incoming_particles.resize( first_message_size );
+
+    reqs.emplace_back(
+        comm.irecv(orig, get_tag(tag, ispc),
+          msg.incoming_particles.data(),
+          first_message_size)
+        );
+  }
+
+#ifdef GPU
+  nvtxRangePop();
+#endif
+
+  return reqs;
+}
+
+
+template<std::size_t D>
+std::vector<mpi::request> GhostTile<D>::recv_particle_extra_data(
+    mpi::communicator& comm,
+    int orig,
+    int tag)
+{
+
+#ifdef GPU
+  nvtxRangePush(__PRETTY_FUNCTION__);
+#endif
+
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "mpi");
+
+  const int first_message_size = ParticleContainer<D>::first_message_size;
+
+  // this assumes that wait for the first message is already called
+  // and passed.
+  std::vector<mpi::request> reqs;
+  for (int ispc=0; ispc<Nspecies(); ispc++) {
+    auto& msg = messages[ispc];
+
+    // NOTE number of particles stored in id slot
+    int extra_size = msg.incoming_particles[0].id - first_message_size;
+
+    if(extra_size > 0) {
+      msg.incoming_extra_particles.resize(extra_size);
+
+      reqs.emplace_back(
+          comm.irecv(orig, get_extra_tag(tag, ispc),
+            msg.incoming_extra_particles.data(),
+            extra_size)
+          );
+    } else {
+      msg.incoming_extra_particles.clear();
+    }
+  }
+
+#ifdef GPU
+  nvtxRangePop();
+#endif
+
+  return reqs;
+}
+
+
+template<std::size_t D>
+void GhostTile<D>::unpack_incoming_particles()
+{
+  const int first_message_size = ParticleContainer<D>::first_message_size;
+
+  for(auto&& msg : messages) {
+    if(msg.incoming_particles.size() == 0) continue;
+
+    // drop the unused tail of the first message
+    int np = msg.incoming_particles[0].id;
+    msg.incoming_particles.resize( np > first_message_size ? first_message_size : np );
+
+    // and append the extra message
+    msg.incoming_particles.reserve(np);
+    for(size_t i=0; i<msg.incoming_extra_particles.size(); i++)
+      msg.incoming_particles.push_back( msg.incoming_extra_particles[i] );
+
+    msg.incoming_extra_particles.clear();
+  }
+}
+
+
+template<std::size_t D>
+void GhostTile<D>::check_outgoing_particles()
+{
+
+#ifdef GPU
+  nvtxRangePush(__PRETTY_FUNCTION__);
+#endif
+
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "pic");
+
+  for(auto&& msg : messages) {
+    msg.to_other_tiles.clear();
+
+    // skipping 1st info particle
+    for(size_t n=1; n<msg.incoming_particles.size(); n++) {
+      const Particle& p = msg.incoming_particles[n];
+      const float loc[3] = {p.x, p.y, p.z};
+
+      std::array<int,3> dirs = {{0,0,0}}; // relative indices
+      for(size_t d=0; d<D; d++) {
+        if( loc[d] - float( mins[d] ) <  0.0 ) dirs[d]--; // left wrap
+        if( loc[d] - float( maxs[d] ) >= 0.0 ) dirs[d]++; // right wrap
+      }
+
+      if( (dirs[0] != 0) || (dirs[1] != 0) || (dirs[2] != 0) )
+        msg.to_other_tiles.push_back( {dirs[0], dirs[1], dirs[2], n} );
+    }
+  }
+
+#ifdef GPU
+  nvtxRangePop();
+#endif
+}
+
+
+template<std::size_t D>
+void GhostTile<D>::delete_all_particles()
+{
+  for(auto&& msg : messages) {
+    msg.incoming_particles.clear();
+    msg.incoming_extra_particles.clear();
+    msg.to_other_tiles.clear();
+  }
+}
+
+
+template<std::size_t D>
+void GhostTile<D>::shrink_to_fit_all_particles()
+{
+  const int first_message_size = ParticleContainer<D>::first_message_size;
+
+  for(auto&& msg : messages) {
+
+    // emptied first message buffer returns to its fixed size
+    if(msg.incoming_particles.size() == 0) {
+      msg.incoming_particles.resize(first_message_size);
+      msg.incoming_particles.shrink_to_fit();
+      msg.incoming_particles.clear();
+    }
+
+    msg.incoming_extra_particles.shrink_to_fit();
+    msg.to_other_tiles.shrink_to_fit();
+  }
+}
+
+
+} // end of namespace pic
+
+
+//--------------------------------------------------
+// explicit template instantiation
+
+template class pic::GhostTile<1>;
+template class pic::GhostTile<2>;
+template class pic::GhostTile<3>;
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <mpi4cpp/mpi.h>
+
+#include "definitions.h"
+#include "external/corgi/tile.h"
+#include "external/corgi/corgi.h"
+#include "core/emf/tile.h"
+#include "core/pic/particle.h"
+#include "external/iter/allocator.h"
+
+
+namespace pic {
+
+using namespace mpi4cpp;
+
+
+/// Particle messages of one species received by a ghost tile
+//
+// The first message starts with the info particle that stores the total
+// number of particles (+1) in its id slot; the extra message is appended
+// to it on unpacking. Elements of to_other_tiles index incoming_particles.
+struct GhostMessages {
+
+  /// first (fixed-size) and extra particle messages
+  ManVec<Particle> incoming_particles;
+  ManVec<Particle> incoming_extra_particles;
+
+  /// message particles leaving the ghost tile
+  ManVec<to_other_tiles_struct> to_other_tiles;
+
+  /// number of received particles (info particle excluded)
+  int size() const {
+    return incoming_particles.size() == 0 ? 0 : incoming_particles[0].id - 1;
+  }
+};
+
+
+/*! \brief Slim stand-in for a remote PiC tile
+ *
+ * Virtual tiles only hold the halos read by update_boundaries and
+ * exchange_currents and the particles that flow out of them into the
+ * local tiles. A ghost tile therefore keeps the Yee lattice of emf::Tile
+ * (without the lazily allocated charge density; E, B, and J are exchanged
+ * as whole meshes) but no particle containers: per species it only
+ * stores the received particle messages.
+ *
+ * It answers the same MPI modes as pic::Tile but never sends particles.
+ * pic::Tile::get_incoming_particles reads the outflowing particles
+ * directly from the messages.
+*/
+template<std::size_t D>
+class GhostTile :
+  virtual public emf::Tile<D>,
+  virtual public  corgi::Tile<D>,
+  virtual public ManagedParent
+{
+
+public:
+
+  using corgi::Tile<D>::mins;
+  using corgi::Tile<D>::maxs;
+
+  using emf::Tile<D>::cfl;
+
+  /// per species particle messages
+  std::vector<GhostMessages> messages;
+
+  /// get i:th species messages
+  GhostMessages& get_messages(int i) { return messages[i]; }
+
+  int Nspecies() const { return messages.size(); };
+
+  /// constructor
+  GhostTile(int nx, int ny, int nz, int nspecies) :
+     corgi::Tile<D>(),
+    emf::Tile<D>{nx,ny,nz},
+    messages(nspecies)
+  { }
+
+
+  //--------------------------------------------------
+  // MPI send; ghost tiles only forward the fields
+  std::vector<mpi::request>
+  send_data( mpi::communicator& /*comm*/, int dest, int mode, int tag) override;
+
+  //--------------------------------------------------
+  // MPI recv
+  std::vector<mpi::request>
+  recv_data(mpi::communicator& /*comm*/, int orig, int mode, int tag) override;
+
+  /// actual tag=0 recv
+  std::vector<mpi::request>
+  recv_particle_data(mpi::communicator& /*comm*/, int orig, int tag);
+
+  /// actual tag=1 recv
+  std::vector<mpi::request>
+  recv_particle_extra_data(mpi::communicator& /*comm*/, int orig, int tag);
+  //--------------------------------------------------
+
+  /// append the extra messages to the first ones
+  void unpack_incoming_particles();
+
+  /// mark received particles exceeding the tile limits
+  void check_outgoing_particles();
+
+  /// drop all received particles
+  void delete_all_particles();
+
+  /// release the extra message buffers and grown first message buffers
+  void shrink_to_fit_all_particles();
+
+  /// no-op; ghost tiles do not advance species
+  void set_subcycle_lap(int /*lap*/) { }
+
+};
+
+
+} // end of namespace pic
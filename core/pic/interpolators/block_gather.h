@@ -0,0 +1,119 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <algorithm>
+
+#include "core/emf/tile.h"
+#include "core/pic/particle.h"
+#include "external/iter/devcall.h"
+
+namespace pic {
+
+/// read-only view of the six E/B components with flat (i,j,k) indexing
+//
+// Points either to the tile meshes or to a BlockStencil copy; the strides
+// iy and iz are zero along collapsed dimensions.
+struct FieldView {
+  const float *ex, *ey, *ez, *bx, *by, *bz;
+  size_t base, iy, iz;
+
+  DEVCALLABLE inline size_t indx(int i, int j, int k) const { return base + i + j*iy + k*iz; }
+};
+
+
+/// view of the tile meshes themselves
+inline FieldView mesh_view(const emf::Grids& gs, size_t iy, size_t iz)
+{
+  return { gs.ex.data(), gs.ey.data(), gs.ez.data(),
+           gs.bx.data(), gs.by.data(), gs.bz.data(),
+           gs.ex.indx(0,0,0), iy, iz };
+}
+
+
+/// cells [c0, c1) of cell-block b of a sorted container on a mesh of N cells
+template<size_t D>
+inline void block_cells(
+    const ParticleContainer<D>& con,
+    const std::array<int,3>& N,
+    int b,
+    std::array<int,3>& c0,
+    std::array<int,3>& c1)
+{
+  const int bs = con.block_size;
+  const std::array<int,3> bn = {{
+    b % con.block_counts[0],
+    (b / con.block_counts[0]) % con.block_counts[1],
+    b / (con.block_counts[0]*con.block_counts[1]) }};
+
+  for(size_t i=0; i<D; i++) {
+    c0[i] = bn[i]*bs;
+    c1[i] = std::min(c0[i] + bs, N[i]);
+  }
+}
+
+
+/// local copy of the E/B stencil of one cell-block of a sorted container
+//
+// Holds the nodes [c0-lo, c1-1+hi] per dimension, where [c0, c1) are the
+// cells of the block and lo/hi the reach of the interpolation stencil
+// below/above the cell of a particle. Particles whose cell is outside the
+// block (e.g., they have moved since the sort) must use the mesh view.
+template<size_t D>
+class BlockStencil
+{
+  std::vector<float> buf;
+
+  public:
+
+  /// cells of the block along each dimension
+  std::array<int,3> c0 = {{0,0,0}}, c1 = {{1,1,1}};
+
+  /// copy the stencil of cell-block b; returns a view of the copy
+  FieldView load(const emf::Grids& gs, const ParticleContainer<D>& con, int b, int lo, int hi)
+  {
+    block_cells<D>(con, {{ gs.Nx, gs.Ny, gs.Nz }}, b, c0, c1);
+
+    std::array<int,3> n0 = {{0,0,0}}, nn = {{1,1,1}}; // first node and node count
+    for(size_t i=0; i<D; i++) {
+      n0[i] = c0[i] - lo;
+      nn[i] = c1[i] - c0[i] + lo + hi;
+    }
+
+    const size_t sy = nn[0];
+    const size_t sz = nn[0]*nn[1];
+    const size_t vol = sz*nn[2];
+    buf.resize(6*vol);
+
+    const toolbox::Mesh<float,3>* ms[6] = {&gs.ex, &gs.ey, &gs.ez, &gs.bx, &gs.by, &gs.bz};
+    for(int c=0; c<6; c++) {
+      const float* f = ms[c]->data();
+      float* dst = buf.data() + c*vol;
+
+      for(int k=0; k<nn[2]; k++)
+      for(int j=0; j<nn[1]; j++) {
+        const size_t src = ms[c]->indx(n0[0], n0[1]+j, n0[2]+k);
+        for(int i=0; i<nn[0]; i++) dst[i + j*sy + k*sz] = f[src + i];
+      }
+    }
+
+    // shift the flat index so that indx(i,j,k) addresses tile-local (i,j,k)
+    const size_t vy = D >= 2 ? sy : 0;
+    const size_t vz = D >= 3 ? sz : 0;
+    const size_t base = size_t(0) - n0[0] - n0[1]*vy - n0[2]*vz;
+
+    const float* p = buf.data();
+    return { p, p+vol, p+2*vol, p+3*vol, p+4*vol, p+5*vol, base, vy, vz };
+  }
+
+  /// cell (i,j,k) belongs to the loaded block
+  inline bool contains(int i, int j, int k) const
+  {
+    return (D < 1 || (i >= c0[0] && i < c1[0])) &&
+           (D < 2 || (j >= c0[1] && j < c1[1])) &&
+           (D < 3 || (k >= c0[2] && k < c1[2]));
+  }
+};
+
+
+} // end of namespace pic
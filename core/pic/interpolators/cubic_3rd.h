@@ -1,27 +1,21 @@
 #pragma once
 
-#include "core/pic/interpolators/interpolator.h"
+#include "core/pic/interpolators/shape_interpolator.h"
 
 
 namespace pic {
 
 /// Cubic (3rd order) particle shape interpolator
+//
+// Energy-conserving alternating scheme of Sokolov: quadratic shape on the
+// primary grid and cubic shape on the dual grid.
 template<size_t D>
 class CubicInterpolator :
-  public virtual Interpolator<D,3>
-{
-public: // needs to be public, why is it not public to begin with ?
-  void solve(pic::Tile<D>& tile) override;
+  public ShapeInterpolator<D, 2, 3>
+{ };
 
-  double compute( 
-        double* /*cx*/, double* /*cy*/, double* /*cz*/, 
-        const toolbox::Mesh<float, 3>& /*f*/, 
-        const size_t /*iy*/, const size_t /*iz*/,
-        int /*i*/, int /*j*/, int /*k*/);
-};
+// particle loop is compiled once in cubic_3rd.c++
+extern template class ShapeInterpolator<2, 2, 3>;
+extern template class ShapeInterpolator<3, 2, 3>;
 
 } // end of namespace pic
-
-
-
-
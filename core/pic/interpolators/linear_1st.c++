@@ -2,27 +2,80 @@
 #include <cassert>
 
 #include "core/pic/interpolators/linear_1st.h"
+#include "core/pic/interpolators/block_gather.h"
+#include "core/pic/interpolators/shape_interpolator.h"
+#include "core/pic/shapes.h"
 #include "external/iter/iter.h"
 
+#include "external/timer/tracer.h"
+
 #ifdef GPU
 #include <nvtx3/nvToolsExt.h> 
 #endif
 
 
 
-DEVCALLABLE inline double _lerp(
-      double c000, double c100, double c010, double c110,
-      double c001, double c101, double c011, double c111,
-      double dx, double dy, double dz) 
+/// linear shape on the primary grid; staggered values are averaged to the primary nodes
+using _Primary = pic::shape::BSpline<1>;
+using _Dual    = pic::shape::Averaged<pic::shape::BSpline<1>>;
+
+
+/// interpolate E/B to particle n from the node records of mesh m (see pic::Tile::collocate_fields)
+template<size_t D, typename M>
+DEVCALLABLE inline void _interpolate_nodes(
+      size_t n,
+      pic::ParticleContainer<D>& con,
+      const std::array<double,D>& mins,
+      const M& m)
+{
+  using X = pic::shape::Along<D,0,_Primary>;
+  using Y = pic::shape::Along<D,1,_Primary>;
+  using Z = pic::shape::Along<D,2,_Primary>;
+
+  // normalize to tile units
+  double loc0n = D >= 1 ? con.loc(0,n) - mins[0] : con.loc(0,n);
+  double loc1n = D >= 2 ? con.loc(1,n) - mins[1] : con.loc(1,n);
+  double loc2n = D >= 3 ? con.loc(2,n) - mins[2] : con.loc(2,n);
+
+  // particle location in the grid
+  double wx[X::width], wy[Y::width], wz[Z::width];
+  const int i = pic::shape::stencil<X>(loc0n, 0.0, wx);
+  const int j = pic::shape::stencil<Y>(loc1n, 0.0, wy);
+  const int k = pic::shape::stencil<Z>(loc2n, 0.0, wz);
+
+  // node records of the stencil corners; steps depend on the record layout
+  const size_t ind = m.indx(i,j,k);
+  const size_t sx = m.step(0,i);
+  const size_t sy = D >= 2 ? m.step(1,j) : 0;
+  const size_t sz = D >= 3 ? m.step(2,k) : 0;
+
+  double f[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+  for(int kl=0; kl<Z::width; kl++)
+  for(int jl=0; jl<Y::width; jl++)
+  for(int il=0; il<X::width; il++) {
+    const float* r = m(ind + il*sx + jl*sy + kl*sz).data();
+    const double w = wx[il]*wy[jl]*wz[kl];
+    for(int c=0; c<6; c++) f[c] += w*r[c];
+  }
+
+  con.ex(n) = f[0];
+  con.ey(n) = f[1];
+  con.ez(n) = f[2];
+  con.bx(n) = f[3];
+  con.by(n) = f[4];
+  con.bz(n) = f[5];
+}
+
+
+/// interpolate E/B of view f to particle n; staggered values are averaged to the cell corners
+template<size_t D>
+DEVCALLABLE inline void _interpolate(
+      size_t n,
+      pic::ParticleContainer<D>& con,
+      const std::array<double,D>& mins,
+      const pic::FieldView& f)
 {
-      double c00 = c000 * (1.0-dx) + c100 * dx;
-      double c10 = c010 * (1.0-dx) + c110 * dx;
-      double c0  = c00  * (1.0-dy) + c10  * dy;
-      double c01 = c001 * (1.0-dx) + c101 * dx;
-      double c11 = c011 * (1.0-dx) + c111 * dx;
-      double c1  = c01  * (1.0-dy) + c11  * dy;
-      double c   = c0   * (1.0-dz) + c1   * dz;
-      return c;
+  pic::interpolate_shape<D, _Primary, _Dual>(n, con, mins, f);
 }
 
 
@@ -36,11 +89,19 @@ void pic::LinearInterpolator<D,V>::solve(
   nvtxRangePush(__PRETTY_FUNCTION__);
 #endif
 
-  // get reference to the Yee grid 
-  auto& gs = tile.get_grids();
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "pic");
+
+  // grids the node records were last built from
+  const emf::Grids* collocated_gs = nullptr;
 
   for(auto&& con : tile.containers) {
 
+    // sub-cycled species are interpolated only on their push laps
+    if(!con.is_active()) continue;
+
+    // get reference to the Yee grid; time-averaged for sub-cycled species
+    auto& gs = tile.gather_grids(con);
+
     /// resize internal arrays
     con.Epart.resize(3*con.size());
     con.Bpart.resize(3*con.size());
@@ -51,103 +112,75 @@ void pic::LinearInterpolator<D,V>::solve(
     const size_t iy = D >= 2 ? gs.ex.indx(0,1,0) - gs.ex.indx(0,0,0) : 0;
     const size_t iz = D >= 3 ? gs.ex.indx(0,0,1) - gs.ex.indx(0,0,0) : 0;
 
+    //--------------------------------------------------
+    // node-centered pre-pass; shared by all species gathering from the same grids
+    if(collocated) {
+      if(collocated_gs != &gs) {
+        tile.collocate_fields(gs, bricked);
+        collocated_gs = &gs;
+      }
+
+      // one gather for either node record layout
+      auto gather = [=] DEVCALLABLE(
+                  size_t n,
+                  const auto& nodes,
+                  pic::ParticleContainer<D>& con){
+        _interpolate_nodes<D>(n, con, mins, nodes);
+      };
+
+      if(bricked) {
+        UniIter::iterate(gather, con.size(), tile.bricked_gather_cache, con);
+      } else {
+        UniIter::iterate(gather, con.size(), tile.node_fields, con);
+      }
+
+      UniIter::sync();
+      continue;
+    }
+
+
+    const pic::FieldView mesh = pic::mesh_view(gs, iy, iz);
+
+#ifndef GPU
+    //--------------------------------------------------
+    // cell-block sorted particles against a local copy of the block stencil
+    if(con.is_cell_sorted()) {
+      const int nblocks = con.block_offsets.size() - 1;
+
+      #pragma omp parallel
+      {
+        pic::BlockStencil<D> stencil;
+
+        #pragma omp for schedule(dynamic)
+        for(int b=0; b<nblocks; b++) {
+          const int n0 = con.block_offsets[b];
+          const int n1 = con.block_offsets[b+1];
+          if(n0 == n1) continue;
+
+          // corners of a cell average their neighbors one node away
+          const pic::FieldView local = stencil.load(gs, con, b, 1, 1);
+
+          for(int n=n0; n<n1; n++) {
+            const int i = D >= 1 ? floor(con.loc(0,n) - mins[0]) : 0;
+            const int j = D >= 2 ? floor(con.loc(1,n) - mins[1]) : 0;
+            const int k = D >= 3 ? floor(con.loc(2,n) - mins[2]) : 0;
+
+            // particles that have left their block since the sort use the mesh
+            _interpolate<D>(n, con, mins, stencil.contains(i,j,k) ? local : mesh);
+          }
+        }
+      }
+
+      continue;
+    }
+#endif
 
     // loop over particles
     UniIter::iterate([=] DEVCALLABLE( 
                 size_t n, 
-                emf::Grids& gs,
                 pic::ParticleContainer<D>& con){
-
-      int i=0, j=0, k=0;
-      double dx=0.0, dy=0.0, dz=0.0;
-    
-      // normalize to tile units
-      double loc0n = D >= 1 ? con.loc(0,n) - mins[0] : con.loc(0,n);
-      double loc1n = D >= 2 ? con.loc(1,n) - mins[1] : con.loc(1,n);
-      double loc2n = D >= 3 ? con.loc(2,n) - mins[2] : con.loc(2,n);
-
-      // particle location in the grid
-      if(D >= 1) i = floor(loc0n);
-      if(D >= 2) j = floor(loc1n);
-      if(D >= 3) k = floor(loc2n);
-
-      if(D >= 1) dx = loc0n - i;
-      if(D >= 2) dy = loc1n - j;
-      if(D >= 3) dz = loc2n - k;
-
-      // one-dimensional index
-      const size_t ind = gs.ex.indx(i,j,k);
-      double c000, c100, c010, c110, c001, c101, c011, c111;
-
-      //ex
-      c000 = 0.5*(gs.ex(ind       ) +gs.ex(ind-1      ));
-      c100 = 0.5*(gs.ex(ind       ) +gs.ex(ind+1      ));
-      c010 = 0.5*(gs.ex(ind+iy    ) +gs.ex(ind-1+iy   ));
-      c110 = 0.5*(gs.ex(ind+iy    ) +gs.ex(ind+1+iy   ));
-      c001 = 0.5*(gs.ex(ind+iz    ) +gs.ex(ind-1+iz   ));
-      c101 = 0.5*(gs.ex(ind+iz    ) +gs.ex(ind+1+iz   ));
-      c011 = 0.5*(gs.ex(ind+iy+iz ) +gs.ex(ind-1+iy+iz));
-      c111 = 0.5*(gs.ex(ind+iy+iz ) +gs.ex(ind+1+iy+iz));
-      con.ex(n) = _lerp(c000, c100, c010, c110, c001, c101, c011, c111, dx, dy, dz);
-
-      //ey
-      c000 = 0.5*(gs.ey(ind       ) +gs.ey(ind-iy     ));
-      c100 = 0.5*(gs.ey(ind+1     ) +gs.ey(ind+1-iy   ));
-      c010 = 0.5*(gs.ey(ind       ) +gs.ey(ind+iy     ));
-      c110 = 0.5*(gs.ey(ind+1     ) +gs.ey(ind+1+iy   ));
-      c001 = 0.5*(gs.ey(ind+iz    ) +gs.ey(ind-iy+iz  ));
-      c101 = 0.5*(gs.ey(ind+1+iz  ) +gs.ey(ind+1-iy+iz));
-      c011 = 0.5*(gs.ey(ind+iz    ) +gs.ey(ind+iy+iz  ));
-      c111 = 0.5*(gs.ey(ind+1+iz  ) +gs.ey(ind+1+iy+iz));
-      con.ey(n) = _lerp(c000, c100, c010, c110, c001, c101, c011, c111, dx, dy, dz);
-
-      //ez
-      c000 = 0.5*(gs.ez(ind       ) + gs.ez(ind-iz     ));
-      c100 = 0.5*(gs.ez(ind+1     ) + gs.ez(ind+1-iz   ));
-      c010 = 0.5*(gs.ez(ind+iy    ) + gs.ez(ind+iy-iz  ));
-      c110 = 0.5*(gs.ez(ind+1+iy  ) + gs.ez(ind+1+iy-iz));
-      c001 = 0.5*(gs.ez(ind       ) + gs.ez(ind+iz     ));
-      c101 = 0.5*(gs.ez(ind+1     ) + gs.ez(ind+1+iz   ));
-      c011 = 0.5*(gs.ez(ind+iy    ) + gs.ez(ind+iy+iz  ));
-      c111 = 0.5*(gs.ez(ind+1+iy  ) + gs.ez(ind+1+iy+iz));
-      con.ez(n) = _lerp(c000, c100, c010, c110, c001, c101, c011, c111, dx, dy, dz);
-
-
-      //-------------------------------------------------- 
-      // bx
-      c000 = 0.25*( gs.bx(ind)+   gs.bx(ind-iy)+   gs.bx(ind-iz)+      gs.bx(ind-iy-iz));
-      c100 = 0.25*( gs.bx(ind+1)+ gs.bx(ind+1-iy)+ gs.bx(ind+1-iz)+    gs.bx(ind+1-iy-iz));
-      c001 = 0.25*( gs.bx(ind)+   gs.bx(ind+iz)+   gs.bx(ind-iy)+      gs.bx(ind-iy+iz));
-      c101 = 0.25*( gs.bx(ind+1)+ gs.bx(ind+1+iz)+ gs.bx(ind+1-iy)+    gs.bx(ind+1-iy+iz));
-      c010 = 0.25*( gs.bx(ind)+   gs.bx(ind+iy)+   gs.bx(ind-iz)+      gs.bx(ind+iy-iz));
-      c110 = 0.25*( gs.bx(ind+1)+ gs.bx(ind+1-iz)+ gs.bx(ind+1+iy-iz)+ gs.bx(ind+1+iy));
-      c011 = 0.25*( gs.bx(ind)+   gs.bx(ind+iy)+   gs.bx(ind+iy+iz)+   gs.bx(ind+iz));
-      c111 = 0.25*( gs.bx(ind+1)+ gs.bx(ind+1+iy)+ gs.bx(ind+1+iy+iz)+ gs.bx(ind+1+iz));
-      con.bx(n) = _lerp(c000, c100, c010, c110, c001, c101, c011, c111, dx, dy, dz);
-
-      // by
-      c000 = 0.25*( gs.by(ind-1-iz)+    gs.by(ind-1)+       gs.by(ind-iz)+      gs.by(ind));
-      c100 = 0.25*( gs.by(ind-iz)+      gs.by(ind)+         gs.by(ind+1-iz)+    gs.by(ind+1));
-      c001 = 0.25*( gs.by(ind-1)+       gs.by(ind-1+iz)+    gs.by(ind)+         gs.by(ind+iz));
-      c101 = 0.25*( gs.by(ind)+         gs.by(ind+iz)+      gs.by(ind+1)+       gs.by(ind+1+iz));
-      c010 = 0.25*( gs.by(ind-1+iy-iz)+ gs.by(ind-1+iy)+    gs.by(ind+iy-iz)+   gs.by(ind+iy));
-      c110 = 0.25*( gs.by(ind+iy-iz)+   gs.by(ind+iy)+      gs.by(ind+1+iy-iz)+ gs.by(ind+1+iy));
-      c011 = 0.25*( gs.by(ind-1+iy)+    gs.by(ind-1+iy+iz)+ gs.by(ind+iy)+      gs.by(ind+iy+iz));
-      c111 = 0.25*( gs.by(ind+iy)+      gs.by(ind+iy+iz)+   gs.by(ind+1+iy)+    gs.by(ind+1+iy+iz));
-      con.by(n) = _lerp(c000, c100, c010, c110, c001, c101, c011, c111, dx, dy, dz);
-
-      // bz
-      c000 = 0.25*( gs.bz(ind-1-iy)+    gs.bz(ind-1)+       gs.bz(ind-iy)+      gs.bz(ind));
-      c100 = 0.25*( gs.bz(ind-iy)+      gs.bz(ind)+         gs.bz(ind+1-iy)+    gs.bz(ind+1));
-      c001 = 0.25*( gs.bz(ind-1-iy+iz)+ gs.bz(ind-1+iz)+    gs.bz(ind-iy+iz)+   gs.bz(ind+iz));
-      c101 = 0.25*( gs.bz(ind-iy+iz)+   gs.bz(ind+iz)+      gs.bz(ind+1-iy+iz)+ gs.bz(ind+1+iz));
-      c010 = 0.25*( gs.bz(ind-1)+       gs.bz(ind-1+iy)+    gs.bz(ind)+         gs.bz(ind+iy));
-      c110 = 0.25*( gs.bz(ind)+         gs.bz(ind+iy)+      gs.bz(ind+1)+       gs.bz(ind+1+iy));
-      c011 = 0.25*( gs.bz(ind-1+iz)+    gs.bz(ind-1+iy+iz)+ gs.bz(ind+iz)+      gs.bz(ind+iy+iz));
-      c111 = 0.25*( gs.bz(ind+iz)+      gs.bz(ind+iy+iz)+   gs.bz(ind+1+iz)+    gs.bz(ind+1+iy+iz));
-      con.bz(n) = _lerp(c000, c100, c010, c110, c001, c101, c011, c111, dx, dy, dz);
-
-    }, con.size(), gs, con);
+      _interpolate<D>(n, con, mins, mesh);
+    }, con.size(), con);
 
     UniIter::sync();
   } // end of loop over species
@@ -6,11 +6,34 @@
 namespace pic {
 
 /// Linear (1st order) particle shape interpolator
+//
+// Staggered components are read as if averaged to the grid nodes, i.e.
+// with shape::BSpline<1> on the primary and shape::Averaged<BSpline<1>> on
+// the dual grid (see pic::interpolate_shape).
+//
+// With collocated = true the staggered fields are first averaged to the
+// grid nodes (see pic::Tile::collocate_fields) and particles read a plain
+// trilinear stencil of interleaved 6-component node records. Results agree
+// with the default path up to float round-off of the node averages. With
+// bricked = true as well, the records are gathered from a bricked cache
+// (4^D bricks); same results, better locality for large tiles of
+// unsorted particles.
+//
+// Cell-block sorted containers (see pic::Tile::sort_in_cell_blocks) are
+// interpolated block by block against a local BlockStencil copy; results
+// are identical to the unsorted path.
 template<size_t D, size_t V>
 class LinearInterpolator :
   public virtual Interpolator<D,V>
 {
 public: // needs to be public, why is it not public to begin with ?
+
+  /// interpolate from node-centered field records built once per tile
+  bool collocated = false;
+
+  /// gather from the bricked cache (see pic::Tile::bricked_gather_cache); needs collocated
+  bool bricked = false;
+
   void solve(pic::Tile<D>& tile) override;
 
 };
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "core/pic/interpolators/interpolator.h"
+#include "core/pic/interpolators/shape_interpolator.h"
 
 
 namespace pic {
@@ -8,21 +8,11 @@ namespace pic {
 /// Quadratic (2nd order) particle shape interpolator
 template<size_t D>
 class QuadraticInterpolator :
-  public virtual Interpolator<D,3>
-{
-public: // needs to be public, why is it not public to begin with ?
-  void solve(pic::Tile<D>& tile) override;
+  public ShapeInterpolator<D, 2>
+{ };
 
-  double compute( 
-        double* /*cx*/, double* /*cy*/, double* /*cz*/, 
-        const toolbox::Mesh<float, 3>& /*f*/, 
-        const size_t /*iy*/, const size_t /*iz*/,
-        int /*i*/, int /*j*/, int /*k*/);
-
-};
+// particle loop is compiled once in quadratic_2nd.c++
+extern template class ShapeInterpolator<2, 2>;
+extern template class ShapeInterpolator<3, 2>;
 
 } // end of namespace pic
-
-
-
-
@@ -1,29 +1,18 @@
 #pragma once
 
-#include "core/pic/interpolators/interpolator.h"
+#include "core/pic/interpolators/shape_interpolator.h"
 
 
 namespace pic {
 
-/// 4th order quartic particle shape interpolator
+/// Quartic (4th order) particle shape interpolator
 template<size_t D>
 class QuarticInterpolator :
-  public virtual Interpolator<D,3>
-{
-  public: 
-  void solve(pic::Tile<D>& tile) override;
-
-  double compute( 
-        double* /*cx*/, double* /*cy*/, double* /*cz*/, 
-        const toolbox::Mesh<float, 3>& /*f*/, 
-        const size_t /*iy*/, const size_t /*iz*/,
-        int /*i*/, int /*j*/, int /*k*/);
-  
-};
+  public ShapeInterpolator<D, 4>
+{ };
 
+// particle loop is compiled once in quartic_4th.c++
+extern template class ShapeInterpolator<2, 4>;
+extern template class ShapeInterpolator<3, 4>;
 
 } // end of namespace pic
-
-
-
-
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <cmath>
+#include <algorithm>
+
+#include "core/pic/interpolators/interpolator.h"
+#include "core/pic/interpolators/block_gather.h"
+#include "core/pic/shapes.h"
+#include "external/iter/iter.h"
+
+#include "external/timer/tracer.h"
+
+#ifdef GPU
+#include <nvtx3/nvToolsExt.h>
+#endif
+
+namespace pic {
+
+/// interpolate E/B of view f to particle n with shape P on the primary and Q on the dual grid
+template<size_t D, typename P, typename Q>
+DEVCALLABLE inline void interpolate_shape(
+    size_t n,
+    pic::ParticleContainer<D>& con,
+    const std::array<double,D>& mins,
+    const FieldView& f)
+{
+  // per-dimension shapes on the primary (p) and dual (d) grids
+  using Xp = shape::Along<D,0,P>;
+  using Yp = shape::Along<D,1,P>;
+  using Zp = shape::Along<D,2,P>;
+  using Xd = shape::Along<D,0,Q>;
+  using Yd = shape::Along<D,1,Q>;
+  using Zd = shape::Along<D,2,Q>;
+
+  //--------------------------------------------------
+  // indices & locs to grid
+  double xpn = D >= 1 ? con.loc(0,n) - mins[0] : con.loc(0,n);
+  double ypn = D >= 2 ? con.loc(1,n) - mins[1] : con.loc(1,n);
+  double zpn = D >= 3 ? con.loc(2,n) - mins[2] : con.loc(2,n);
+
+  //--------------------------------------------------
+  // reference nodes and weights on the primary and dual (+1/2) grids
+  double cxp[Xp::width], cyp[Yp::width], czp[Zp::width];
+  double cxd[Xd::width], cyd[Yd::width], czd[Zd::width];
+
+  const int ip = shape::stencil<Xp>(xpn, 0.0, cxp);
+  const int jp = shape::stencil<Yp>(ypn, 0.0, cyp);
+  const int kp = shape::stencil<Zp>(zpn, 0.0, czp);
+  const int id = shape::stencil<Xd>(xpn, 0.5, cxd);
+  const int jd = shape::stencil<Yd>(ypn, 0.5, cyd);
+  const int kd = shape::stencil<Zd>(zpn, 0.5, czd);
+
+  //--------------------------------------------------
+  // integrate over shape function, i.e. interpolate
+  const size_t iy = f.iy, iz = f.iz;
+  con.ex(n) = shape::gather<Xd,Yp,Zp>(f.ex, f.indx(id,jp,kp), iy,iz, cxd,cyp,czp); // Ex(d,p,p)
+  con.ey(n) = shape::gather<Xp,Yd,Zp>(f.ey, f.indx(ip,jd,kp), iy,iz, cxp,cyd,czp); // Ey(p,d,p)
+  con.ez(n) = shape::gather<Xp,Yp,Zd>(f.ez, f.indx(ip,jp,kd), iy,iz, cxp,cyp,czd); // Ez(p,p,d)
+  con.bx(n) = shape::gather<Xp,Yd,Zd>(f.bx, f.indx(ip,jd,kd), iy,iz, cxp,cyd,czd); // Bx(p,d,d)
+  con.by(n) = shape::gather<Xd,Yp,Zd>(f.by, f.indx(id,jp,kd), iy,iz, cxd,cyp,czd); // By(d,p,d)
+  con.bz(n) = shape::gather<Xd,Yd,Zp>(f.bz, f.indx(id,jd,kp), iy,iz, cxd,cyd,czp); // Bz(d,d,p)
+}
+
+
+/// Particle shape interpolator of compile-time shape order
+//
+// Op is the B-spline order on the primary grid and Od on the dual
+// (staggered +1/2) grid. Equal orders give the standard scheme; unequal
+// orders the energy-conserving alternating scheme of Sokolov.
+//
+// The named interpolators (QuadraticInterpolator, ...) are thin subclasses
+// of pre-selected orders; the particle loop is defined here and explicitly
+// instantiated in their translation units.
+//
+// Cell-block sorted containers (see pic::Tile::sort_in_cell_blocks) are
+// interpolated block by block against a local BlockStencil copy.
+template<size_t D, int Op, int Od=Op>
+class ShapeInterpolator :
+  public virtual Interpolator<D,3>
+{
+  public:
+
+  void solve(pic::Tile<D>& tile) override;
+
+  private:
+
+  /// stencil reach below/above the cell of a particle; reference nodes are within one cell
+  static constexpr int reach_lo = 1 - std::min(shape::BSpline<Op>::lo, shape::BSpline<Od>::lo);
+  static constexpr int reach_hi = 1 + std::max(shape::BSpline<Op>::hi, shape::BSpline<Od>::hi);
+
+  /// interpolate E/B of view f to particle n
+  DEVCALLABLE static inline void interpolate(
+      size_t n,
+      pic::ParticleContainer<D>& con,
+      const std::array<double,D>& mins,
+      const FieldView& f);
+};
+
+
+template<size_t D, int Op, int Od>
+inline void ShapeInterpolator<D,Op,Od>::interpolate(
+    size_t n,
+    pic::ParticleContainer<D>& con,
+    const std::array<double,D>& mins,
+    const FieldView& f)
+{
+  interpolate_shape<D, shape::BSpline<Op>, shape::BSpline<Od>>(n, con, mins, f);
+}
+
+
+template<size_t D, int Op, int Od>
+void ShapeInterpolator<D,Op,Od>::solve(
+    pic::Tile<D>& tile)
+{
+
+#ifdef GPU
+  nvtxRangePush(__PRETTY_FUNCTION__);
+#endif
+
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "pic");
+
+  for(auto&& con : tile.containers) {
+
+    // sub-cycled species are interpolated only on their push laps
+    if(!con.is_active()) continue;
+
+    // get reference to the Yee grid; time-averaged for sub-cycled species
+    auto& gs = tile.gather_grids(con);
+
+    /// resize internal arrays
+    con.Epart.resize(3*con.size());
+    con.Bpart.resize(3*con.size());
+
+    auto mins = tile.mins;
+
+    // mesh sizes for 1D indexing
+    const size_t iy = D >= 2 ? gs.ex.indx(0,1,0) - gs.ex.indx(0,0,0) : 0;
+    const size_t iz = D >= 3 ? gs.ex.indx(0,0,1) - gs.ex.indx(0,0,0) : 0;
+
+    const FieldView mesh = mesh_view(gs, iy, iz);
+
+#ifndef GPU
+    //--------------------------------------------------
+    // cell-block sorted particles against a local copy of the block stencil
+    if(con.is_cell_sorted()) {
+      const int nblocks = con.block_offsets.size() - 1;
+
+      #pragma omp parallel
+      {
+        BlockStencil<D> stencil;
+
+        #pragma omp for schedule(dynamic)
+        for(int b=0; b<nblocks; b++) {
+          const int n0 = con.block_offsets[b];
+          const int n1 = con.block_offsets[b+1];
+          if(n0 == n1) continue;
+
+          const FieldView local = stencil.load(gs, con, b, reach_lo, reach_hi);
+
+          for(int n=n0; n<n1; n++) {
+            const int i = D >= 1 ? floor(con.loc(0,n) - mins[0]) : 0;
+            const int j = D >= 2 ? floor(con.loc(1,n) - mins[1]) : 0;
+            const int k = D >= 3 ? floor(con.loc(2,n) - mins[2]) : 0;
+
+            // particles that have left their block since the sort use the mesh
+            interpolate(n, con, mins, stencil.contains(i,j,k) ? local : mesh);
+          }
+        }
+      }
+
+      continue;
+    }
+#endif
+
+    // loop over particles
+    UniIter::iterate([=] DEVCALLABLE(
+                size_t n,
+                pic::ParticleContainer<D>& con){
+      interpolate(n, con, mins, mesh);
+    }, con.size(), con);
+
+    UniIter::sync();
+  } // end of loop over species
+
+
+#ifdef GPU
+  nvtxRangePop();
+#endif
+
+}
+
+} // end of namespace pic
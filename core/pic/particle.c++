@@ -585,6 +585,9 @@ void ParticleContainer<D>::delete_particles(std::vector<int> to_be_deleted)
 #endif
 
   std::sort(to_be_deleted.begin(), to_be_deleted.end(), std::greater<int>() );
+
+  // holes are filled from the end; any cell-block grouping is lost
+  block_offsets.clear();
   
   float* locn[3];
   for(int i=0; i<3; i++) locn[i] = &( loc(i,0) );
@@ -644,6 +647,9 @@ void ParticleContainer<D>::delete_transferred_particles()
 
   // do nothing if empty
   if(to_other_tiles.size() == 0) return;
+
+  // holes are filled from the end; any cell-block grouping is lost
+  block_offsets.clear();
     
   // reverse sort so that following algo works
   std::sort(to_other_tiles.begin(), to_other_tiles.end(), [](const auto& a, const auto& b){return a.n > b.n;} );
@@ -892,6 +898,58 @@ void ParticleContainer<3>::transfer_and_wrap_particles(
 #endif
 }
 
+// --- received messages; all dimensions ---
+template<std::size_t D>
+void ParticleContainer<D>::transfer_and_wrap_particles( 
+    const ManVec<Particle>&              prtcls,
+    const ManVec<to_other_tiles_struct>& dirs_of,
+    std::array<int,3>                    dirs, 
+    std::array<double,3>&                global_mins, 
+    std::array<double,3>&                global_maxs
+    )
+{
+
+#ifdef GPU
+  nvtxRangePush(__PRETTY_FUNCTION__);
+#endif
+
+  float locx, locy, locz;
+
+  // NOTE: collapsed dimensions have zero directions on both sides
+  for (size_t ii = 0; ii < dirs_of.size(); ii++)
+  {
+    const auto &elem = dirs_of[ii];
+
+    if(elem.i == 0 && 
+       elem.j == 0 &&
+       elem.k == 0) continue; 
+
+    // NOTE: directions are flipped (- sign) so that they are
+    // in directions in respect to the current tile
+    if (elem.i == -dirs[0] &&
+        elem.j == -dirs[1] &&
+        elem.k == -dirs[2] ) {
+
+      const Particle& p = prtcls[elem.n];
+
+      locx = wrap( p.x, static_cast<float>(global_mins[0]), static_cast<float>(global_maxs[0]) );
+      locy = wrap( p.y, static_cast<float>(global_mins[1]), static_cast<float>(global_maxs[1]) );
+      locz = wrap( p.z, static_cast<float>(global_mins[2]), static_cast<float>(global_maxs[2]) );
+
+      add_identified_particle(
+          {locx, locy, locz}, 
+          {p.ux, p.uy, p.uz},
+          p.w,
+          p.id, p.proc
+          );
+    }
+  }
+
+#ifdef GPU
+  nvtxRangePop();
+#endif
+}
+
 //--------------------------------------------------
 
 template<std::size_t D>
@@ -1095,6 +1153,9 @@ void ParticleContainer<D>::apply_permutation( ManVec<size_t>& indices )
   // check that sizes match
   assert( indices.size() == size() );
 
+  // any previous cell-block grouping is lost
+  block_offsets.clear();
+
   // https://stackoverflow.com/questions/67751784/how-to-do-in-place-sorting-a-list-according-to-a-given-index-in-c
   // and
   // https://devblogs.microsoft.com/oldnewthing/20170102-00/?p=95095
@@ -1141,6 +1202,60 @@ void ParticleContainer<D>::apply_permutation( ManVec<size_t>& indices )
 }
 
 
+template<size_t D>
+void ParticleContainer<D>::sort_in_cell_blocks(
+    const std::array<double,D>& mins, 
+    const std::array<int,3>& lens, 
+    int bs)
+{
+
+#ifdef GPU
+  nvtxRangePush(__PRETTY_FUNCTION__);
+#endif
+
+  assert(bs > 0);
+
+  block_size = bs;
+  for(size_t i=0; i<3; i++) block_counts[i] = i < D ? (lens[i] + bs - 1)/bs : 1;
+  const int nblocks = block_counts[0]*block_counts[1]*block_counts[2];
+
+  //--------------------------------------------------
+  // block of every particle
+  ManVec<int> keys;
+  keys.resize(size());
+
+  for(size_t n=0; n<size(); n++) {
+    int b[3] = {0,0,0};
+    for(size_t i=0; i<D; i++) {
+      int c = floor(loc(i,n) - mins[i]);
+      b[i] = std::min( std::max(c, 0)/bs, block_counts[i]-1 );
+    }
+    keys[n] = b[0] + block_counts[0]*(b[1] + block_counts[1]*b[2]);
+  }
+
+  //--------------------------------------------------
+  // counting sort
+  std::vector<int> offsets(nblocks+1, 0);
+  for(size_t n=0; n<size(); n++) offsets[keys[n]+1]++;
+  for(int b=0; b<nblocks; b++) offsets[b+1] += offsets[b];
+
+  std::vector<int> next(offsets.begin(), offsets.end()-1);
+  ManVec<size_t> indices;
+  indices.resize(size());
+  for(size_t n=0; n<size(); n++) indices[ next[keys[n]]++ ] = n;
+
+  eneArr.resize( size() ); // swapped along by apply_permutation
+  apply_permutation(indices);
+
+  block_offsets.resize(nblocks+1);
+  for(int b=0; b<=nblocks; b++) block_offsets[b] = offsets[b];
+
+#ifdef GPU
+  nvtxRangePop();
+#endif
+}
+
+
 template<size_t D>
 void ParticleContainer<D>::update_cumulative_arrays()
 {
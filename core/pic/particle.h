@@ -124,7 +124,7 @@ class ParticleContainer{
   void unpack_incoming_particles();
 
   // size of MPI particle buffers
-  const int first_message_size = 4096; 
+  static constexpr int first_message_size = 4096; 
   // NOTE maximum prtcl size during first iteration is 2*first_msg; then resized
 
   //! particle specific electric field components
@@ -146,6 +146,16 @@ class ParticleContainer{
   // type identifier; default generic type
   std::string type = "gen";
 
+  /// sub-cycling: species is advanced only every `subcycle` laps with a
+  // `subcycle` times longer time step (see pic::Tile::set_subcycle_lap)
+  int subcycle = 1;
+
+  /// laps since the start of the current sub-cycle; in [0, subcycle)
+  int substep = 0;
+
+  /// species is interpolated, pushed, deposited, and exchanged this lap
+  DEVCALLABLE bool is_active() const { return substep == subcycle - 1; }
+
   /// Constructor 
   ParticleContainer();
 
@@ -385,6 +395,15 @@ class ParticleContainer{
       std::array<double,3>&,
       std::array<double,3>&);
 
+  /// transfer particles from received messages (see pic::GhostTile);
+  // elements of the direction list index the message particles
+  void transfer_and_wrap_particles(
+      const ManVec<Particle>&, 
+      const ManVec<to_other_tiles_struct>&, 
+      std::array<int,3>,
+      std::array<double,3>&,
+      std::array<double,3>&);
+
 
   /// set keygenerator state
   void set_keygen_state(int __key, int __rank);
@@ -400,6 +419,33 @@ class ParticleContainer{
 
   // update internal cumulative weight arrays of particles
   void update_cumulative_arrays();
+
+  //--------------------------------------------------
+  // cell-block sorting
+
+  /// cells per side of a cell-block of the last sort
+  int block_size = 0;
+
+  /// number of cell-blocks per dimension of the last sort
+  std::array<int,3> block_counts = {{1,1,1}};
+
+  /// particles of cell-block b are [block_offsets[b], block_offsets[b+1]); empty if unsorted
+  ManVec<int> block_offsets;
+
+  /// group particles by cell-blocks of bs^D cells of a lens-sized grid starting at mins
+  //
+  // Counting sort; stable within a block. Particles outside the grid are
+  // placed in the nearest block. The grouping is dropped by any later
+  // re-ordering of the container; it is not updated when particles move.
+  void sort_in_cell_blocks(
+      const std::array<double,D>& mins, 
+      const std::array<int,3>& lens, 
+      int bs);
+
+  /// particle order matches block_offsets
+  bool is_cell_sorted() const { 
+    return block_offsets.size() > 0 && block_offsets[block_offsets.size()-1] == Nprtcls; 
+  }
 };
 
 
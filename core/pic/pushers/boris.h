@@ -1,19 +1,30 @@
 #pragma once
 
-#include "core/pic/pushers/pusher.h"
+#include "core/pic/pushers/policy_pusher.h"
 
 namespace pic {
 
 /// Boris pusher
 template<size_t D, size_t V>
 class BorisPusher :
-  public Pusher<D,V>
-{
-  public: // again why is this not public ?
-  void push_container(
-          pic::ParticleContainer<D>& container, 
-          pic::Tile<D>& tile) override;
+  public PolicyPusher<D,V, policy::Boris, policy::ConstExtField, policy::NoForce>
+{ };
 
-};
+/// Boris pusher in single precision
+//
+// Same update as BorisPusher but computed in float; roughly twice the SIMD
+// throughput; errors accumulate at single precision round-off level.
+template<size_t D, size_t V>
+class BorisPusherFloat :
+  public PolicyPusher<D,V, policy::Boris, policy::ConstExtField, policy::NoForce, float>
+{ };
+
+// particle loop is compiled once in boris.c++
+extern template class PolicyPusher<1,3, policy::Boris, policy::ConstExtField, policy::NoForce>;
+extern template class PolicyPusher<2,3, policy::Boris, policy::ConstExtField, policy::NoForce>;
+extern template class PolicyPusher<3,3, policy::Boris, policy::ConstExtField, policy::NoForce>;
+extern template class PolicyPusher<1,3, policy::Boris, policy::ConstExtField, policy::NoForce, float>;
+extern template class PolicyPusher<2,3, policy::Boris, policy::ConstExtField, policy::NoForce, float>;
+extern template class PolicyPusher<3,3, policy::Boris, policy::ConstExtField, policy::NoForce, float>;
 
 } // end of namespace pic
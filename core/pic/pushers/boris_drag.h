@@ -1,28 +1,18 @@
 #pragma once
 
-#include "core/pic/pushers/pusher.h"
+#include "core/pic/pushers/policy_pusher.h"
 
 namespace pic {
 
 /// Boris pusher with drag force
 template<size_t D, size_t V>
 class BorisPusherDrag :
-  public Pusher<D,V>
-{
+  public PolicyPusher<D,V, policy::Boris, policy::ConstExtField, policy::Drag>
+{ };
 
-  /// amount of drag asserted on particles
-  public:
-  double drag; // = gamma_rad^-2
-  double temp; // = 3\Theta
-
-  double freezing_factor = 1.0; // [0,1] parameter to define how much particles move
-
-  // Klein-Nishina cross-section
-  double kn(double x);
-
-  void push_container(
-          pic::ParticleContainer<D>& container, 
-          pic::Tile<D>& tile) override;
-};
+// particle loop is compiled once in boris_drag.c++
+extern template class PolicyPusher<1,3, policy::Boris, policy::ConstExtField, policy::Drag>;
+extern template class PolicyPusher<2,3, policy::Boris, policy::ConstExtField, policy::Drag>;
+extern template class PolicyPusher<3,3, policy::Boris, policy::ConstExtField, policy::Drag>;
 
 } // end of namespace pic
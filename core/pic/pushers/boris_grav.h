@@ -1,24 +1,18 @@
 #pragma once
 
-#include "core/pic/pushers/pusher.h"
+#include "core/pic/pushers/policy_pusher.h"
 
 namespace pic {
 
-/// Boris pusher with radiative pressure force
+/// Boris pusher with gravity toward x = cenx
 template<size_t D, size_t V>
 class BorisPusherGrav :
-  public Pusher<D,V>
-{
+  public PolicyPusher<D,V, policy::Boris, policy::ConstExtField, policy::Gravity>
+{ };
 
-  /// amount of drag asserted on particles
-  public:
-  double g0; // radiation pressure strength
-
-  double cenx; // x location of the gravity null point 
-
-  void push_container(
-          pic::ParticleContainer<D>& container, 
-          pic::Tile<D>& tile) override;
-};
+// particle loop is compiled once in boris_grav.c++
+extern template class PolicyPusher<1,3, policy::Boris, policy::ConstExtField, policy::Gravity>;
+extern template class PolicyPusher<2,3, policy::Boris, policy::ConstExtField, policy::Gravity>;
+extern template class PolicyPusher<3,3, policy::Boris, policy::ConstExtField, policy::Gravity>;
 
 } // end of namespace pic
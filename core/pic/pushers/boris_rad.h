@@ -1,24 +1,18 @@
 #pragma once
 
-#include "core/pic/pushers/pusher.h"
+#include "core/pic/pushers/policy_pusher.h"
 
 namespace pic {
 
 /// Boris pusher with radiative pressure force
 template<size_t D, size_t V>
 class BorisPusherRad :
-  public Pusher<D,V>
-{
+  public PolicyPusher<D,V, policy::Boris, policy::ConstExtField, policy::RadPressure>
+{ };
 
-  /// amount of drag asserted on particles
-  public:
-  double drag; // radiation pressure strength
-
-  double beam_locx; // x location of the beam front 
-
-  void push_container(
-          pic::ParticleContainer<D>& container, 
-          pic::Tile<D>& tile) override;
-};
+// particle loop is compiled once in boris_rad.c++
+extern template class PolicyPusher<1,3, policy::Boris, policy::ConstExtField, policy::RadPressure>;
+extern template class PolicyPusher<2,3, policy::Boris, policy::ConstExtField, policy::RadPressure>;
+extern template class PolicyPusher<3,3, policy::Boris, policy::ConstExtField, policy::RadPressure>;
 
 } // end of namespace pic
@@ -4,6 +4,8 @@
 #include "tools/signum.h"
 #include "external/iter/iter.h"
 
+#include "external/timer/tracer.h"
+
 #ifdef GPU
 #include <nvtx3/nvToolsExt.h> 
 #endif
@@ -21,7 +23,10 @@ void pic::PhotonPusher<D,V>::push_container(
   nvtxRangePush(__PRETTY_FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "pic");
+
   const double c  = tile.cfl;
+  const double dt = con.subcycle; // number of time steps per push
 
   // loop over particles
   UniIter::iterate([=] DEVCALLABLE (size_t n, pic::ParticleContainer<D>& con){
@@ -43,9 +48,9 @@ void pic::PhotonPusher<D,V>::push_container(
     //<< con.loc(0,n) << " " << con.loc(1,n) << " " << con.loc(2,n) << "\n";
 
     // position advance
-    if(D >= 1) con.loc(0,n) += u0*c;
-    if(D >= 2) con.loc(1,n) += v0*c;
-    if(D >= 3) con.loc(2,n) += w0*c;
+    if(D >= 1) con.loc(0,n) += u0*c*dt;
+    if(D >= 2) con.loc(1,n) += v0*c*dt;
+    if(D >= 3) con.loc(2,n) += w0*c*dt;
 
   }, con.size(), con);
 
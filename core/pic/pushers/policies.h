@@ -0,0 +1,416 @@
+#pragma once
+
+#include <cmath>
+#include <type_traits>
+
+#include "definitions.h"
+#include "external/iter/devcall.h"
+#include "tools/signum.h"
+
+
+namespace pic {
+
+/// Compile-time building blocks of the Boris-family particle pushers.
+//
+// A pusher is composed of
+//  - an integrator that advances the four-velocity with the Lorentz force,
+//  - an external field policy that adds fields on top of the interpolated ones,
+//  - a force policy that adds non-electromagnetic forces after the Lorentz update.
+//
+// All policy calls are non-virtual and inlined into the particle loop of
+// pic::PolicyPusher so the compiler sees the full kernel.
+//
+// Integrators, uniform external fields, and NoForce are templated on the
+// arithmetic type T so the same code runs with double, float, and with
+// std::experimental::simd vectors of either.
+namespace policy {
+
+/// underlying scalar type of T (T itself for arithmetic types)
+template<typename T, typename = void>
+struct scalar_of { using type = T; };
+
+template<typename T>
+struct scalar_of<T, std::void_t<typename T::value_type>> { using type = typename T::value_type; };
+
+/// broadcast scalar s to T; simd types only accept their own value type
+template<typename T, typename S>
+DEVCALLABLE inline T splat(S s) { return T( static_cast<typename scalar_of<T>::type>(s) ); }
+
+
+//--------------------------------------------------
+// integrators
+//
+// Input:  normalized four-velocity u/c at t_n-1/2 (vel0n, ...), c, and the
+//         half-step E and B fields (0.5*q/m*E, 0.5*q/m*B; no 1/c applied).
+// Output: four-velocity times c at t_n+1/2 (u0, v0, w0).
+
+/// Boris algorithm
+struct Boris {
+  template<typename T>
+  DEVCALLABLE static inline void kick(
+      T c,
+      T vel0n, T vel1n, T vel2n,
+      T ex0, T ey0, T ez0,
+      T bx0, T by0, T bz0,
+      T& u0, T& v0, T& w0)
+  {
+    using std::sqrt;
+
+    bx0 /= c;
+    by0 /= c;
+    bz0 /= c;
+
+    // first half electric acceleration
+    u0 = vel0n*c + ex0;
+    v0 = vel1n*c + ey0;
+    w0 = vel2n*c + ez0;
+
+    // first half magnetic rotation
+    T ginv = c/sqrt(c*c + u0*u0 + v0*v0 + w0*w0);
+    bx0 *= ginv;
+    by0 *= ginv;
+    bz0 *= ginv;
+
+    T f = splat<T>(2.0)/(splat<T>(1.0) + bx0*bx0 + by0*by0 + bz0*bz0);
+    T u1 = (u0 + v0*bz0 - w0*by0)*f;
+    T v1 = (v0 + w0*bx0 - u0*bz0)*f;
+    T w1 = (w0 + u0*by0 - v0*bx0)*f;
+
+    // second half of magnetic rotation & electric acceleration
+    u0 = u0 + v1*bz0 - w1*by0 + ex0;
+    v0 = v0 + w1*bx0 - u1*bz0 + ey0;
+    w0 = w0 + u1*by0 - v1*bx0 + ez0;
+  }
+};
+
+
+/// Vay algorithm
+struct Vay {
+  template<typename T>
+  DEVCALLABLE static inline void kick(
+      T c,
+      T vel0n, T vel1n, T vel2n,
+      T ex0, T ey0, T ez0,
+      T bx0, T by0, T bz0,
+      T& u0, T& v0, T& w0)
+  {
+    using std::sqrt;
+
+    const T cinv = splat<T>(1.0)/c;
+    bx0 /= c;
+    by0 /= c;
+    bz0 /= c;
+
+    // gamma^-1
+    T g = splat<T>(1.0)/sqrt(splat<T>(1.0) + vel0n*vel0n + vel1n*vel1n + vel2n*vel2n);
+    T vx0 = c*vel0n*g;
+    T vy0 = c*vel1n*g;
+    T vz0 = c*vel2n*g;
+
+    // u' (cinv is already multiplied into B)
+    T u1 = c*vel0n + splat<T>(2.0)*ex0 + vy0*bz0 - vz0*by0;
+    T v1 = c*vel1n + splat<T>(2.0)*ey0 + vz0*bx0 - vx0*bz0;
+    T w1 = c*vel2n + splat<T>(2.0)*ez0 + vx0*by0 - vy0*bx0;
+
+    // gamma(u')
+    T ustar = cinv*(u1*bx0+v1*by0+w1*bz0);
+    T sig = cinv*cinv*( c*c + u1*u1+ v1*v1+ w1*w1) - (bx0*bx0+ by0*by0+ bz0*bz0);
+    g = splat<T>(1.0)/sqrt( splat<T>(0.5)*(sig + sqrt(sig*sig + splat<T>(4.0)*(bx0*bx0 + by0*by0 + bz0*bz0 + ustar*ustar))));
+
+    T tx = bx0*g;
+    T ty = by0*g;
+    T tz = bz0*g;
+    T f = splat<T>(1.0)/(splat<T>(1.0)+ tx*tx+ ty*ty+ tz*tz);
+
+    // final step
+    u0 = f*(u1 + (u1*tx + v1*ty + w1*tz)*tx + v1*tz - w1*ty);
+    v0 = f*(v1 + (u1*tx + v1*ty + w1*tz)*ty + w1*tx - u1*tz);
+    w0 = f*(w1 + (u1*tx + v1*ty + w1*tz)*tz + u1*ty - v1*tx);
+  }
+};
+
+
+/// Higuera-Cary algorithm (https://arxiv.org/pdf/1701.05605.pdf)
+struct HigueraCary {
+  template<typename T>
+  DEVCALLABLE static inline void kick(
+      T c,
+      T vel0n, T vel1n, T vel2n,
+      T ex0, T ey0, T ez0,
+      T bx0, T by0, T bz0,
+      T& u0, T& v0, T& w0)
+  {
+    using std::sqrt;
+
+    // first half electric acceleration
+    u0 = c*vel0n + ex0;
+    v0 = c*vel1n + ey0;
+    w0 = c*vel2n + ez0;
+
+    // intermediate gamma
+    T g2 = (c*c + u0*u0 + v0*v0 + w0*w0)/(c*c);
+    T b2 = bx0*bx0 + by0*by0 + bz0*bz0;
+    T ginv = splat<T>(1.0)/sqrt( splat<T>(0.5)*(g2-b2 + sqrt( (g2-b2)*(g2-b2) + splat<T>(4.0)*(b2 + (bx0*u0 + by0*v0 + bz0*w0)*(bx0*u0 + by0*v0 + bz0*w0)))));
+
+    // first half magnetic rotation; cinv is multiplied to B field only here
+    bx0 *= ginv/c;
+    by0 *= ginv/c;
+    bz0 *= ginv/c;
+
+    T f = splat<T>(2.0)/(splat<T>(1.0) + bx0*bx0 + by0*by0 + bz0*bz0);
+    T u1 = (u0 + v0*bz0 - w0*by0)*f;
+    T v1 = (v0 + w0*bx0 - u0*bz0)*f;
+    T w1 = (w0 + u0*by0 - v0*bx0)*f;
+
+    // second half of magnetic rotation & electric acceleration
+    u0 = u0 + v1*bz0 - w1*by0 + ex0;
+    v0 = v0 + w1*bx0 - u1*bz0 + ey0;
+    w0 = w0 + u1*by0 - v1*bx0 + ez0;
+  }
+};
+
+
+//--------------------------------------------------
+// external field policies
+//
+// Constructed once per push_container call from the pusher so that the
+// particle loop only sees plain values. add() adds the external field at
+// particle location (x,y,z) to the interpolated fields.
+
+/// no external fields; compiles away completely
+struct NoExtField {
+  static constexpr bool uniform = true;
+
+  template<typename P>
+  explicit NoExtField(const P& /*pusher*/) {}
+
+  template<typename T>
+  DEVCALLABLE inline void add(
+      T /*x*/, T /*y*/, T /*z*/,
+      T& /*ex*/, T& /*ey*/, T& /*ez*/,
+      T& /*bx*/, T& /*by*/, T& /*bz*/) const
+  { }
+};
+
+
+/// spatially uniform external fields given by Pusher::{e,b}{x,y,z}_ext
+struct ConstExtField {
+  static constexpr bool uniform = true;
+
+  double ex_ext, ey_ext, ez_ext;
+  double bx_ext, by_ext, bz_ext;
+
+  template<typename P>
+  explicit ConstExtField(const P& p) :
+    ex_ext(p.ex_ext), ey_ext(p.ey_ext), ez_ext(p.ez_ext),
+    bx_ext(p.bx_ext), by_ext(p.by_ext), bz_ext(p.bz_ext)
+  { }
+
+  template<typename T>
+  DEVCALLABLE inline void add(
+      T /*x*/, T /*y*/, T /*z*/,
+      T& ex, T& ey, T& ez,
+      T& bx, T& by, T& bz) const
+  {
+    ex += splat<T>(ex_ext);
+    ey += splat<T>(ey_ext);
+    ez += splat<T>(ez_ext);
+    bx += splat<T>(bx_ext);
+    by += splat<T>(by_ext);
+    bz += splat<T>(bz_ext);
+  }
+};
+
+
+/// uniform external fields plus an analytic, position-dependent part.
+//
+// F is constructed from the pusher (so it can read its parameters) and
+// provides
+//   DEVCALLABLE void operator()(T x, T y, T z,
+//                               T& ex, T& ey, T& ez,
+//                               T& bx, T& by, T& bz) const
+// that adds its field values at location (x,y,z); T is the pusher real type.
+template<typename F>
+struct AnalyticExtField :
+  public ConstExtField
+{
+  static constexpr bool uniform = false;
+
+  F field;
+
+  template<typename P>
+  explicit AnalyticExtField(const P& p) :
+    ConstExtField(p),
+    field(p)
+  { }
+
+  template<typename T>
+  DEVCALLABLE inline void add(
+      T x, T y, T z,
+      T& ex, T& ey, T& ez,
+      T& bx, T& by, T& bz) const
+  {
+    ConstExtField::add(x, y, z, ex, ey, ez, bx, by, bz);
+    field(x, y, z, ex, ey, ez, bx, by, bz);
+  }
+};
+
+
+//--------------------------------------------------
+// extra force policies
+//
+// Force policies are base classes of the pusher so that their parameters
+// are members of the final pusher class (and visible to python).
+//
+// force() receives the particle x location, mass m, the normalized
+// four-velocity at t_n-1/2 (vel0n, ...), and the Lorentz-updated
+// four-velocity times c (u0, ...). It returns the velocity change that is
+// added to the normalized four-velocity. move_factor() scales the position
+// advance. Only `vectorizable` forces are used in the explicit SIMD path and
+// in single precision pushers.
+
+/// no extra forces
+struct NoForce {
+  static constexpr bool vectorizable = true;
+
+  template<typename T>
+  DEVCALLABLE inline void force(
+      T /*c*/, T /*m*/, T /*x*/,
+      T /*vel0n*/, T /*vel1n*/, T /*vel2n*/,
+      T /*u0*/, T /*v0*/, T /*w0*/,
+      T& fx, T& fy, T& fz) const
+  {
+    fx = splat<T>(0.0);
+    fy = splat<T>(0.0);
+    fz = splat<T>(0.0);
+  }
+
+  DEVCALLABLE inline double move_factor() const { return 1.0; }
+};
+
+
+/// radiative drag force with Klein-Nishina reduction
+struct Drag {
+  static constexpr bool vectorizable = false;
+
+
+  /// amount of drag asserted on particles
+  double drag; // = gamma_rad^-2
+  double temp; // = 3\Theta
+
+  double freezing_factor = 1.0; // [0,1] parameter to define how much particles move
+
+  // Klein-Nishina cross-section
+  DEVCALLABLE inline double kn(double x) const
+  {
+    if (temp == 0.0) return 1.0; // Thomson scattering limit
+
+    double sig;
+    sig = (1.0 - 4.0/x - 8.0/x/x)*log(1.+x) + 0.5 + 8.0/x - 1.0/(2.0*(1. + x)*(1. + x));
+    return (3.0/4.0)*sig/x;
+  }
+
+  DEVCALLABLE inline void force(
+      double c, double /*m*/, double /*x*/,
+      double vel0n, double vel1n, double vel2n,
+      double u0, double v0, double w0,
+      double& fx, double& fy, double& fz) const
+  {
+    // maximum drag force experienced by particle
+    const double dragthr = 0.8;
+
+    // u at t + dt/2
+    double uxt  = (u0/c + vel0n)*0.5;
+    double uyt  = (v0/c + vel1n)*0.5;
+    double uzt  = (w0/c + vel2n)*0.5;
+    double ut   = sqrt(uxt*uxt + uyt*uyt + uzt*uzt);
+    double gamt = sqrt(1.0 + ut*ut);
+
+    // subtract drag with Klein-Nishina reduction
+    // A g^2 beta = A g^2 u/g = A g u
+    double kncorr = kn(3.0*gamt*temp);
+
+    // drag components
+    double dragx = c*drag*kncorr*gamt*gamt*(uxt/gamt);
+    double dragy = c*drag*kncorr*gamt*gamt*(uyt/gamt);
+    double dragz = c*drag*kncorr*gamt*gamt*(uzt/gamt);
+
+    // vector component limit; prevents change of direction
+    // (=causes trouble in current deposition since particle "cell" can be erraneously calculated)
+    if( fabs(dragx*c/u0) > dragthr ) dragx = dragthr*u0/c;
+    if( fabs(dragy*c/v0) > dragthr ) dragy = dragthr*v0/c;
+    if( fabs(dragz*c/w0) > dragthr ) dragz = dragthr*w0/c;
+
+    fx = -dragx;
+    fy = -dragy;
+    fz = -dragz;
+  }
+
+  DEVCALLABLE inline double move_factor() const { return freezing_factor; }
+};
+
+
+/// radiation pressure along +x applied behind the beam front
+struct RadPressure {
+  static constexpr bool vectorizable = false;
+
+
+  double drag; // radiation pressure strength
+
+  double beam_locx; // x location of the beam front
+
+  DEVCALLABLE inline void force(
+      double c, double /*m*/, double x,
+      double vel0n, double /*vel1n*/, double /*vel2n*/,
+      double u0, double /*v0*/, double /*w0*/,
+      double& fx, double& fy, double& fz) const
+  {
+    fx = 0.0;
+    fy = 0.0;
+    fz = 0.0;
+
+    // apply pressure only to particles behind the rad beam front
+    if(x <= beam_locx){
+      // u at t + dt/2
+      double uxt  = (u0/c + vel0n)*0.5;
+      double gamx = sqrt(1.0 + uxt*uxt);
+      fx = c*drag/gamx/gamx;
+    }
+  }
+
+  DEVCALLABLE inline double move_factor() const { return 1.0; }
+};
+
+
+/// constant gravity pulling particles toward x = cenx
+struct Gravity {
+  static constexpr bool vectorizable = false;
+
+
+  double g0; // gravity strength
+
+  double cenx; // x location of the gravity null point
+
+  DEVCALLABLE inline void force(
+      double c, double m, double x,
+      double vel0n, double vel1n, double vel2n,
+      double u0, double v0, double w0,
+      double& fx, double& fy, double& fz) const
+  {
+    // gamma at half time step
+    double uxt  = (u0/c + vel0n)*0.5;
+    double uyt  = (v0/c + vel1n)*0.5;
+    double uzt  = (w0/c + vel2n)*0.5;
+    double gamt = sqrt(1.0 + uxt*uxt + uyt*uyt + uzt*uzt);
+
+    fx = c*g0*m*gamt*toolbox::sign(cenx - x);
+    fy = 0.0;
+    fz = 0.0;
+  }
+
+  DEVCALLABLE inline double move_factor() const { return 1.0; }
+};
+
+
+} // end of namespace policy
+} // end of namespace pic
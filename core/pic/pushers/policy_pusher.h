@@ -0,0 +1,268 @@
+#pragma once
+
+#include <cmath>
+#include <type_traits>
+
+#include "core/pic/pushers/pusher.h"
+#include "core/pic/pushers/policies.h"
+#include "tools/signum.h"
+#include "external/iter/iter.h"
+
+#include "external/timer/tracer.h"
+
+#ifdef GPU
+#include <nvtx3/nvToolsExt.h>
+#endif
+
+// explicit SIMD particle loop on the host; disable with -DRUNKO_NO_SIMD
+#if !defined(GPU) && !defined(RUNKO_NO_SIMD) && defined(__has_include)
+#if __has_include(<experimental/simd>)
+#include <experimental/simd>
+#define RUNKO_SIMD
+#endif
+#endif
+
+namespace pic {
+
+/// Boris-family pusher composed of compile-time policies
+//
+// Integrator: policy::Boris, policy::Vay, policy::HigueraCary
+// ExtField:   policy::NoExtField, policy::ConstExtField, policy::AnalyticExtField<F>
+// Force:      policy::NoForce, policy::Drag, policy::RadPressure, policy::Gravity
+// Real:       double, float
+//
+// The named pushers (BorisPusher, BorisPusherDrag, ...) are thin subclasses
+// of pre-selected combinations; the particle loop is defined here and
+// explicitly instantiated in their translation units.
+//
+// Real is the arithmetic type of the particle update. double (default)
+// reproduces the reference pushers; float trades accuracy for twice the
+// SIMD width and is only available without extra forces.
+//
+// With a uniform ExtField and a vectorizable Force the host loop is
+// explicitly vectorized with std::experimental::native_simd<Real>; the
+// vector width (SSE/AVX2/AVX-512) follows the target the file is compiled
+// for. Other combinations, and GPU builds, use the scalar UniIter loop.
+template<size_t D, size_t V, typename Integrator, typename ExtField, typename Force, typename Real=double>
+class PolicyPusher :
+  public Pusher<D,V>,
+  public Force
+{
+  static_assert(std::is_same<Real, double>::value || Force::vectorizable,
+      "single precision pushers support only vectorizable force policies");
+
+  public:
+
+  void push_container(
+          pic::ParticleContainer<D>& container,
+          pic::Tile<D>& tile) override;
+
+  protected:
+
+#ifdef RUNKO_SIMD
+  /// explicitly vectorized loop is available for this policy combination
+  static constexpr bool vectorized = ExtField::uniform && Force::vectorizable;
+
+  using Vec = std::experimental::native_simd<Real>;
+
+  /// particles per simd vector
+  static constexpr size_t simd_width = vectorized ? Vec::size() : 1;
+#else
+  static constexpr bool vectorized = false;
+  static constexpr size_t simd_width = 1;
+#endif
+
+  /// push particle n
+  DEVCALLABLE static inline void push_scalar(
+      size_t n,
+      pic::ParticleContainer<D>& con,
+      Real c, Real qm, Real m, Real dt, Real move,
+      const ExtField& ext,
+      const Force& frc);
+
+  /// push particles n, ..., n+simd_width-1 (one simd vector)
+  static inline void push_vector(
+      size_t n,
+      pic::ParticleContainer<D>& con,
+      Real c, Real qm, Real m, Real dt, Real move,
+      const ExtField& ext,
+      const Force& frc);
+
+  /// velocity update of one particle (or one simd vector of particles)
+  //
+  // Returns the inverse Lorentz factor used for the position advance.
+  template<typename T>
+  DEVCALLABLE static inline T push_particle(
+      T c, T qm, T m, T dt,
+      const ExtField& ext,
+      const Force& frc,
+      T loc0n, T loc1n, T loc2n,
+      T& vel0n, T& vel1n, T& vel2n,
+      T ex0, T ey0, T ez0,
+      T bx0, T by0, T bz0);
+};
+
+
+template<size_t D, size_t V, typename Integrator, typename ExtField, typename Force, typename Real>
+template<typename T>
+inline T PolicyPusher<D,V,Integrator,ExtField,Force,Real>::push_particle(
+    T c, T qm, T m, T dt,
+    const ExtField& ext,
+    const Force& frc,
+    T loc0n, T loc1n, T loc2n,
+    T& vel0n, T& vel1n, T& vel2n,
+    T ex0, T ey0, T ez0,
+    T bx0, T by0, T bz0)
+{
+  using std::sqrt;
+
+  ext.add(loc0n, loc1n, loc2n, ex0, ey0, ez0, bx0, by0, bz0);
+
+  ex0 = ex0*policy::splat<T>(0.5)*qm;
+  ey0 = ey0*policy::splat<T>(0.5)*qm;
+  ez0 = ez0*policy::splat<T>(0.5)*qm;
+
+  bx0 = bx0*policy::splat<T>(0.5)*qm;
+  by0 = by0*policy::splat<T>(0.5)*qm;
+  bz0 = bz0*policy::splat<T>(0.5)*qm;
+
+  //--------------------------------------------------
+  // Lorentz force
+  T u0, v0, w0;
+  Integrator::kick(c, vel0n, vel1n, vel2n, ex0, ey0, ez0, bx0, by0, bz0, u0, v0, w0);
+
+  //--------------------------------------------------
+  // extra forces
+  T fx, fy, fz;
+  frc.force(c, m, loc0n, vel0n, vel1n, vel2n, u0, v0, w0, fx, fy, fz);
+
+  //--------------------------------------------------
+  // normalized 4-velocity advance
+  vel0n = u0/c + fx*dt;
+  vel1n = v0/c + fy*dt;
+  vel2n = w0/c + fz*dt;
+
+  return c / sqrt(c*c + u0*u0 + v0*v0 + w0*w0);
+}
+
+
+template<size_t D, size_t V, typename Integrator, typename ExtField, typename Force, typename Real>
+inline void PolicyPusher<D,V,Integrator,ExtField,Force,Real>::push_vector(
+    size_t n,
+    pic::ParticleContainer<D>& con,
+    Real c, Real qm, Real m, Real dt, Real move,
+    const ExtField& ext,
+    const Force& frc)
+{
+#ifdef RUNKO_SIMD
+  if constexpr (vectorized) {
+    namespace stdx = std::experimental;
+
+    // particle arrays are float; loads and stores convert to/from Real
+    auto load = [](const float* p) { return Vec(p, stdx::element_aligned); };
+
+    Vec vel0n = load(&con.vel(0,n));
+    Vec vel1n = load(&con.vel(1,n));
+    Vec vel2n = load(&con.vel(2,n));
+
+    Vec ginv = push_particle<Vec>(Vec(c), Vec(qm), Vec(m), Vec(dt), ext, frc,
+        load(&con.loc(0,n)), load(&con.loc(1,n)), load(&con.loc(2,n)),
+        vel0n, vel1n, vel2n,
+        load(&con.ex(n)), load(&con.ey(n)), load(&con.ez(n)),
+        load(&con.bx(n)), load(&con.by(n)), load(&con.bz(n)));
+
+    // store velocities and reload them rounded to float like the scalar loop
+    float* vel[3] = {&con.vel(0,n), &con.vel(1,n), &con.vel(2,n)};
+    vel0n.copy_to(vel[0], stdx::element_aligned);
+    vel1n.copy_to(vel[1], stdx::element_aligned);
+    vel2n.copy_to(vel[2], stdx::element_aligned);
+
+    for(size_t i=0; i<D; i++) {
+      float* loc = &con.loc(i,n);
+      Vec x = load(loc) + load(vel[i])*ginv*c*move;
+      x.copy_to(loc, stdx::element_aligned);
+    }
+    return;
+  }
+#endif
+
+  // simd_width is 1
+  push_scalar(n, con, c, qm, m, dt, move, ext, frc);
+}
+
+
+template<size_t D, size_t V, typename Integrator, typename ExtField, typename Force, typename Real>
+inline void PolicyPusher<D,V,Integrator,ExtField,Force,Real>::push_scalar(
+    size_t n,
+    pic::ParticleContainer<D>& con,
+    Real c, Real qm, Real m, Real dt, Real move,
+    const ExtField& ext,
+    const Force& frc)
+{
+  Real vel0n = con.vel(0,n);
+  Real vel1n = con.vel(1,n);
+  Real vel2n = con.vel(2,n);
+
+  Real ginv = push_particle<Real>(c, qm, m, dt, ext, frc,
+      con.loc(0,n), con.loc(1,n), con.loc(2,n),
+      vel0n, vel1n, vel2n,
+      con.ex(n), con.ey(n), con.ez(n),
+      con.bx(n), con.by(n), con.bz(n));
+
+  con.vel(0,n) = vel0n;
+  con.vel(1,n) = vel1n;
+  con.vel(2,n) = vel2n;
+
+  // position advance
+  // NOTE: no mixed-precision calc here. Can be problematic.
+  for(size_t i=0; i<D; i++) con.loc(i,n) += con.vel(i,n)*ginv*c*move;
+}
+
+
+template<size_t D, size_t V, typename Integrator, typename ExtField, typename Force, typename Real>
+void PolicyPusher<D,V,Integrator,ExtField,Force,Real>::push_container(
+    pic::ParticleContainer<D>& con,
+    pic::Tile<D>& tile)
+{
+
+#ifdef GPU
+  nvtxRangePush(__PRETTY_FUNCTION__);
+#endif
+
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "pic");
+
+  const Real dt = con.subcycle; // number of time steps per push (species sub-cycling)
+  const Real c  = tile.cfl;
+  const Real qm = toolbox::sign(con.q)/con.m*dt; // q_s/m_s (sign only because emf are in units of q)
+  const Real m  = con.m; // mass
+
+  // plain copies of the policy state; nothing in the loop is virtual
+  const ExtField ext(*this);
+  const Force frc(*this);
+  const Real move = frc.move_factor()*dt;
+
+  size_t n0 = 0; // first particle left for the scalar loop
+
+  if constexpr (vectorized) {
+    const size_t W = simd_width;
+    const size_t nchunks = con.size()/W;
+    n0 = nchunks*W;
+
+    #pragma omp parallel for
+    for(size_t ic=0; ic<nchunks; ic++) push_vector(ic*W, con, c, qm, m, dt, move, ext, frc);
+  }
+
+  // loop over (remaining) particles
+  UniIter::iterate([=] DEVCALLABLE (size_t n, pic::ParticleContainer<D>& con){
+    push_scalar(n0 + n, con, c, qm, m, dt, move, ext, frc);
+  }, con.size() - n0, con);
+
+  UniIter::sync();
+
+
+#ifdef GPU
+  nvtxRangePop();
+#endif
+}
+
+} // end of namespace pic
@@ -5,6 +5,8 @@
 #include "external/iter/iter.h"
 #include "tools/lerp.h"
 
+#include "external/timer/tracer.h"
+
 #ifdef GPU
 #include <nvtx3/nvToolsExt.h> 
 #endif
@@ -181,19 +183,17 @@ void pic::PulsarPusher<D,V>::push_container(
   nvtxRangePush(__PRETTY_FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "pic");
+
+  // species sub-cycling is not supported by the guiding center scheme
+  assert(con.subcycle == 1);
+
   const double c  = tile.cfl;
   const double qm = sign(con.q)/con.m; // q_s/m_s (sign only because emf are in units of q)
   const double m  = con.m; //mass
 
   // emf at the grid
   auto& gs = tile.get_grids(); 
-  auto& exM = gs.ex;
-  auto& eyM = gs.ey;
-  auto& ezM = gs.ez;
-
-  auto& bxM = gs.bx;
-  auto& byM = gs.by;
-  auto& bzM = gs.bz;
 
   //const int Nx = tile.mesh_lengths[0];
   //const int Ny = tile.mesh_lengths[1];
@@ -206,6 +206,29 @@ void pic::PulsarPusher<D,V>::push_container(
   auto mins = tile.mins;
   //auto maxs = tile.maxs;
 
+  // tabulated background field is interpolated with the same stencil
+  const emf::Grids* fld = &gs;
+  const emf::BackgroundGrids* bg = 
+    add_background && tile.has_background() ? &tile.background : nullptr;
+
+  // captures by value (mesh pointers and strides) like the device kernels
+  auto interpolate = [=](size_t ind, double dx, double dy, double dz)
+  {
+    auto flds = interpolate_fields(
+        fld->ex, fld->ey, fld->ez, fld->bx, fld->by, fld->bz, ind, dx, dy, dz, iy, iz);
+    if(bg != nullptr) {
+      auto [exb, eyb, ezb, bxb, byb, bzb] = interpolate_fields(
+          bg->ex, bg->ey, bg->ez, bg->bx, bg->by, bg->bz, ind, dx, dy, dz, iy, iz);
+      std::get<0>(flds) += exb;
+      std::get<1>(flds) += eyb;
+      std::get<2>(flds) += ezb;
+      std::get<3>(flds) += bxb;
+      std::get<4>(flds) += byb;
+      std::get<5>(flds) += bzb;
+    }
+    return flds;
+  };
+
   double ii=0.0, jj=0.0, kk=0.0;
   double dx=0.0, dy=0.0, dz=0.0;
 
@@ -249,19 +272,16 @@ void pic::PulsarPusher<D,V>::push_container(
     // 1D reference index
     const size_t ind0 = gs.ex.indx(ii,jj,kk);
 
-    auto [ex0, ey0, ez0, bx0, by0, bz0] = interpolate_fields(
-                                      exM, eyM, ezM, bxM, byM, bzM, 
-                                      ind0, dx, dy, dz, 
-                                      iy, iz);
+    auto [ex0, ey0, ez0, bx0, by0, bz0] = interpolate(ind0, dx, dy, dz);
 
     // add external field component from pusher
     //TODO: why cinv here in E?
-    ex0 += this->get_ex_ext(0,0,0); 
-    ey0 += this->get_ey_ext(0,0,0);
-    ez0 += this->get_ez_ext(0,0,0);
-    bx0 += this->get_bx_ext(0,0,0);
-    by0 += this->get_by_ext(0,0,0);
-    bz0 += this->get_bz_ext(0,0,0);
+    ex0 += this->ex_ext; 
+    ey0 += this->ey_ext;
+    ez0 += this->ez_ext;
+    bx0 += this->bx_ext;
+    by0 += this->by_ext;
+    bz0 += this->bz_ext;
 
     // normalize units to be ready for the internal scheme
     ex0 *= 1.0/c;
@@ -340,19 +360,16 @@ void pic::PulsarPusher<D,V>::push_container(
       
       const size_t ind1 = gs.ex.indx(ii,jj,kk); // 1D reference index
 
-      auto [ex1, ey1, ez1, bx1, by1, bz1] = interpolate_fields(
-                                      exM, eyM, ezM, bxM, byM, bzM, 
-                                      ind1, dx, dy, dz, 
-                                      iy, iz);
+      auto [ex1, ey1, ez1, bx1, by1, bz1] = interpolate(ind1, dx, dy, dz);
 
       // add external field component from pusher
       //TODO: why cinv here in E?
-      ex1 += this->get_ex_ext(0,0,0); 
-      ey1 += this->get_ey_ext(0,0,0);
-      ez1 += this->get_ez_ext(0,0,0);
-      bx1 += this->get_bx_ext(0,0,0);
-      by1 += this->get_by_ext(0,0,0);
-      bz1 += this->get_bz_ext(0,0,0);
+      ex1 += this->ex_ext; 
+      ey1 += this->ey_ext;
+      ez1 += this->ez_ext;
+      bx1 += this->bx_ext;
+      by1 += this->by_ext;
+      bz1 += this->bz_ext;
 
       // normalize units to be ready for the internal scheme
       ex1 *= 1.0/c;
@@ -31,6 +31,11 @@ class PulsarPusher :
 
   double gravity_const = 1.0; // g_0 surface gravity constant controlling strength at the acceleration eq
 
+  // add the tile's tabulated background field (see emf::Tile::background)
+  // to the interpolated fields; off when the background is already part 
+  // of the dynamic fields
+  bool add_background = false;
+
   // pusher
   void push_container(
           pic::ParticleContainer<D>& container, 
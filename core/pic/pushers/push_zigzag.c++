@@ -0,0 +1,14 @@
+#include "core/pic/pushers/push_zigzag.h"
+#include "core/pic/pushers/boris.h"
+
+
+//--------------------------------------------------
+// explicit template instantiation
+
+template class pic::PushZigZag<1,3, pic::policy::Boris, pic::policy::ConstExtField, pic::policy::NoForce>;
+template class pic::PushZigZag<2,3, pic::policy::Boris, pic::policy::ConstExtField, pic::policy::NoForce>;
+template class pic::PushZigZag<3,3, pic::policy::Boris, pic::policy::ConstExtField, pic::policy::NoForce>;
+
+template class pic::BorisZigZag<1,3>; // 1D3V
+template class pic::BorisZigZag<2,3>; // 2D3V
+template class pic::BorisZigZag<3,3>; // 3D3V
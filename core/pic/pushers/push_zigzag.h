@@ -0,0 +1,269 @@
+#pragma once
+
+#include <cmath>
+
+#include "core/pic/pushers/policy_pusher.h"
+#include "core/pic/depositers/zigzag.h"
+#include "core/pic/depositers/block_scatter.h"
+#include "tools/signum.h"
+#include "external/iter/iter.h"
+
+#include "external/timer/tracer.h"
+
+#ifdef GPU
+#include <nvtx3/nvToolsExt.h>
+#endif
+
+namespace pic {
+
+/// Boris-family pusher fused with the ZigZag current depositer
+//
+// solve() replaces the separate pusher and pic::ZigZag sweeps of a lap:
+// every particle is pushed and its current deposited right away from the
+// old and new locations, instead of re-reading the pushed particles and
+// reconstructing the old location from the velocity. The fields at the
+// particles must be interpolated beforehand, as for the plain pushers.
+//
+// Sub-cycled species, cell-block sorted containers, and the current
+// buffers are handled as in pic::ZigZag. push_container() alone is the
+// plain PolicyPusher update.
+template<size_t D, size_t V, typename Integrator, typename ExtField, typename Force>
+class PushZigZag :
+  public PolicyPusher<D,V,Integrator,ExtField,Force>
+{
+  using Base = PolicyPusher<D,V,Integrator,ExtField,Force>;
+
+  public:
+
+  /// push all active containers in tile and deposit their currents
+  void solve(pic::Tile<D>& tile);
+
+  private:
+
+  /// deposit the current of particle n that was pushed from x1
+  //
+  // Collapsed dimensions are not advanced; their previous location is
+  // reconstructed from the velocity so that the out-of-plane current is
+  // deposited as in pic::ZigZag.
+  template<typename View>
+  DEVCALLABLE static inline void deposit(
+      size_t n,
+      pic::ParticleContainer<D>& con,
+      const float* x1,
+      const std::array<double,D>& mins,
+      const std::array<double,D>& maxs,
+      double c, double move, double q,
+      const View& J);
+
+  /// push particles [n0, n1) one simd vector at a time; each vector is
+  //  deposited with dep(n, x1) while it is still in cache
+  template<typename Dep>
+  static inline void sweep(
+      size_t n0, size_t n1,
+      pic::ParticleContainer<D>& con,
+      double c, double qm, double m, double dt, double move,
+      const ExtField& ext,
+      const Force& frc,
+      const Dep& dep);
+};
+
+
+template<size_t D, size_t V, typename Integrator, typename ExtField, typename Force>
+template<typename View>
+inline void PushZigZag<D,V,Integrator,ExtField,Force>::deposit(
+    size_t n,
+    pic::ParticleContainer<D>& con,
+    const float* x1,
+    const std::array<double,D>& mins,
+    const std::array<double,D>& maxs,
+    double c, double move, double q,
+    const View& J)
+{
+  double xa[3], xb[3];
+  for(size_t i=0; i<D; i++) {
+    xa[i] = x1[i] - mins[i];
+    xb[i] = con.loc(i,n) - mins[i];
+  }
+
+  if constexpr (D < 3) {
+    double u = con.vel(0,n);
+    double v = con.vel(1,n);
+    double w = con.vel(2,n);
+    double invgam = 1.0/sqrt(1.0 + u*u + v*v + w*w);
+
+    for(size_t i=D; i<3; i++) {
+      xb[i] = con.loc(i,n);
+      xa[i] = xb[i] - con.vel(i,n)*invgam*c*move;
+    }
+  }
+
+  pic::ZigZag<D,V>::deposit(xa[0], xa[1], xa[2], xb[0], xb[1], xb[2], q, maxs, J);
+}
+
+
+template<size_t D, size_t V, typename Integrator, typename ExtField, typename Force>
+template<typename Dep>
+inline void PushZigZag<D,V,Integrator,ExtField,Force>::sweep(
+    size_t n0, size_t n1,
+    pic::ParticleContainer<D>& con,
+    double c, double qm, double m, double dt, double move,
+    const ExtField& ext,
+    const Force& frc,
+    const Dep& dep)
+{
+  constexpr size_t W = Base::simd_width;
+  float x1[W][3]; // previous locations of the vector
+
+  size_t n = n0;
+  for(; n + W <= n1; n += W) {
+    for(size_t l=0; l<W; l++)
+      for(size_t i=0; i<3; i++) x1[l][i] = con.loc(i,n+l);
+
+    Base::push_vector(n, con, c, qm, m, dt, move, ext, frc);
+
+    for(size_t l=0; l<W; l++) dep(n+l, x1[l]);
+  }
+
+  // remaining particles
+  for(; n < n1; n++) {
+    for(size_t i=0; i<3; i++) x1[0][i] = con.loc(i,n);
+    Base::push_scalar(n, con, c, qm, m, dt, move, ext, frc);
+    dep(n, x1[0]);
+  }
+}
+
+
+template<size_t D, size_t V, typename Integrator, typename ExtField, typename Force>
+void PushZigZag<D,V,Integrator,ExtField,Force>::solve(
+    pic::Tile<D>& tile)
+{
+
+#ifdef GPU
+  nvtxRangePush(__PRETTY_FUNCTION__);
+#endif
+
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "pic");
+
+  auto& gs = tile.get_grids();
+  const auto mins = tile.mins;
+  const auto maxs = tile.maxs;
+
+  //clear arrays before new update
+  gs.jx.clear();
+  gs.jy.clear();
+  gs.jz.clear();
+
+  // plain copies of the policy state; nothing in the loop is virtual
+  const ExtField ext(*this);
+  const Force frc(*this);
+
+  for(auto&& con : tile.containers) {
+
+    // sub-cycled species are pushed and deposit only on their active laps
+    if(!con.is_active()) continue;
+
+    // tile current, or the mean current buffer of a sub-cycled species
+    auto& gs = tile.deposit_grids(con);
+
+    const double c    = tile.cfl;     // speed of light
+    const double dt   = con.subcycle; // time steps per push (species sub-cycling)
+    const double qm   = toolbox::sign(con.q)/con.m*dt; // q_s/m_s (sign only because emf are in units of q)
+    const double m    = con.m;        // mass
+    const double move = frc.move_factor()*dt;
+    const double q    = con.q/dt;     // charge; gives the mean current over dt
+
+    const size_t iy = D >= 2 ? gs.jx.indx(0,1,0) - gs.jx.indx(0,0,0) : 0;
+    const size_t iz = D >= 3 ? gs.jx.indx(0,0,1) - gs.jx.indx(0,0,0) : 0;
+
+    const pic::MeshCurrent mesh = pic::mesh_current(gs, iy, iz);
+
+#ifndef GPU
+    //--------------------------------------------------
+    // cell-block sorted particles into a private accumulator per block
+    if(con.is_cell_sorted() && q != 0.0) {
+      const int nblocks = con.block_offsets.size() - 1;
+
+      // cells a particle can cross during the push; widens the block reach
+      const int mc = ceil(c*move);
+
+      #pragma omp parallel
+      {
+        pic::BlockCurrent<D> acc;
+
+        #pragma omp for schedule(dynamic)
+        for(int b=0; b<nblocks; b++) {
+          const int n0 = con.block_offsets[b];
+          const int n1 = con.block_offsets[b+1];
+          if(n0 == n1) continue;
+
+          // current cell and its upper neighbour, from the previous cell up to mc away
+          const pic::LocalCurrent local = acc.open(gs, con, b, mc, mc+1);
+
+          sweep(n0, n1, con, c, qm, m, dt, move, ext, frc, [&](size_t n, const float* x1){
+            const int i = D >= 1 ? floor(con.loc(0,n) - mins[0]) : 0;
+            const int j = D >= 2 ? floor(con.loc(1,n) - mins[1]) : 0;
+            const int k = D >= 3 ? floor(con.loc(2,n) - mins[2]) : 0;
+
+            // particles that have left their block since the sort use the mesh
+            if(acc.contains(i,j,k)) {
+              deposit(n, con, x1, mins, maxs, c, move, q, local);
+            } else {
+              deposit(n, con, x1, mins, maxs, c, move, q, mesh);
+            }
+          });
+
+          acc.flush(gs);
+        }
+      }
+
+      continue;
+    }
+
+    //--------------------------------------------------
+    // unsorted particles in chunks of consecutive simd vectors
+    const size_t chunk = 64*Base::simd_width;
+    const size_t nchunks = (con.size() + chunk - 1)/chunk;
+
+    #pragma omp parallel for
+    for(size_t ic=0; ic<nchunks; ic++) {
+      const size_t n0 = ic*chunk;
+      const size_t n1 = std::min(n0 + chunk, con.size());
+
+      sweep(n0, n1, con, c, qm, m, dt, move, ext, frc, [&](size_t n, const float* x1){
+        if(q != 0.0) deposit(n, con, x1, mins, maxs, c, move, q, mesh);
+      });
+    }
+#else
+    // loop over particles
+    UniIter::iterate([=] DEVCALLABLE (size_t n, pic::ParticleContainer<D>& con){
+      float x1[3] = {con.loc(0,n), con.loc(1,n), con.loc(2,n)};
+      Base::push_scalar(n, con, c, qm, m, dt, move, ext, frc);
+      if(q != 0.0) deposit(n, con, x1, mins, maxs, c, move, q, mesh);
+    }, con.size(), con);
+
+    UniIter::sync();
+#endif
+  } // end of loop over species
+
+  // add mean currents of sub-cycled species (also between their pushes)
+  tile.add_subcycle_currents();
+
+
+#ifdef GPU
+  nvtxRangePop();
+#endif
+}
+
+
+/// Boris pusher fused with the ZigZag depositer
+template<size_t D, size_t V>
+class BorisZigZag :
+  public PushZigZag<D,V, policy::Boris, policy::ConstExtField, policy::NoForce>
+{ };
+
+// particle loop is compiled once in push_zigzag.c++
+extern template class PushZigZag<1,3, policy::Boris, policy::ConstExtField, policy::NoForce>;
+extern template class PushZigZag<2,3, policy::Boris, policy::ConstExtField, policy::NoForce>;
+extern template class PushZigZag<3,3, policy::Boris, policy::ConstExtField, policy::NoForce>;
+
+} // end of namespace pic
@@ -26,14 +26,8 @@ class Pusher
   double ey_ext = 0.0;
   double ez_ext = 0.0;
 
-  // external field getter functions; can be overridden in derived pusher classes to depend on position
-  DEVCALLABLE virtual double get_bx_ext(double /*x*/, double /*y*/, double /*z*/) { return bx_ext; };
-  DEVCALLABLE virtual double get_by_ext(double /*x*/, double /*y*/, double /*z*/) { return by_ext; };
-  DEVCALLABLE virtual double get_bz_ext(double /*x*/, double /*y*/, double /*z*/) { return bz_ext; };
-
-  DEVCALLABLE virtual double get_ex_ext(double /*x*/, double /*y*/, double /*z*/) { return ex_ext; };
-  DEVCALLABLE virtual double get_ey_ext(double /*x*/, double /*y*/, double /*z*/) { return ey_ext; };
-  DEVCALLABLE virtual double get_ez_ext(double /*x*/, double /*y*/, double /*z*/) { return ez_ext; };
+  // position-dependent external fields are given by the ExtField policy
+  // of pic::PolicyPusher (see core/pic/pushers/policies.h)
 
 
   virtual void push_container(
@@ -59,17 +53,20 @@ class Pusher
   }
 
   /// push all containers in tile
+  //
+  // sub-cycled species are pushed only on their active laps;
+  // push_container then advances them by container.subcycle time steps.
   void solve(pic::Tile<D>& tile)
   {
     for(auto&& container : tile.containers)
-      push_container(container, tile);
+      if(container.is_active()) push_container(container, tile);
   }
 
 
   /// push spesific containers in tile
   void solve(pic::Tile<D>& tile, int ispc)
   {
-    push_container(tile.containers[ispc], tile);
+    if(tile.containers[ispc].is_active()) push_container(tile.containers[ispc], tile);
   }
 
 };
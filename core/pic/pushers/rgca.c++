@@ -1,10 +1,15 @@
 #include <cmath> 
+#include <vector>
+#include <algorithm>
 
 #include "core/pic/pushers/rgca.h"
+#include "core/pic/pushers/policy_pusher.h"
 #include "tools/signum.h"
 #include "external/iter/iter.h"
 #include "tools/lerp.h"
 
+#include "external/timer/tracer.h"
+
 #ifdef GPU
 #include <nvtx3/nvToolsExt.h> 
 #endif
@@ -13,6 +18,56 @@ using toolbox::sign;
 using toolbox::lerp;
 
 
+namespace {
+
+/// dst = val where mask m is set; T is a scalar or a simd vector
+template<typename M, typename T>
+inline void masked(const M& m, T& dst, const T& val)
+{
+  if constexpr (std::is_arithmetic<T>::value) {
+    dst = m ? val : dst;
+  } else {
+#ifdef RUNKO_SIMD
+    std::experimental::where(m, dst) = val;
+#endif
+  }
+}
+
+/// Boris sub-step is of a gathered full-orbit particle (or one simd vector
+/// of them) taking ns sub-steps; fields are 0.5 q/m E, B per sub-step.
+/// Particles with ns <= is are left unchanged.
+template<typename T>
+inline void orbit_substep(
+    T c, T is, T ns,
+    T& ux, T& uy, T& uz,
+    T& x0, T& x1, T& x2,
+    T ex, T ey, T ez, 
+    T bx, T by, T bz)
+{
+  using std::sqrt;
+
+  T u0, v0, w0;
+  pic::policy::Boris::kick<T>(c, ux, uy, uz, ex, ey, ez, bx, by, bz, u0, v0, w0);
+
+  const T ginv = c/sqrt(c*c + u0*u0 + v0*v0 + w0*w0);
+  const T cs   = c/ns; // displacement per sub-step
+
+  const T uxn = u0/c;
+  const T uyn = v0/c;
+  const T uzn = w0/c;
+
+  const auto active = is < ns;
+  masked(active, ux, uxn);
+  masked(active, uy, uyn);
+  masked(active, uz, uzn);
+  masked(active, x0, T(x0 + uxn*ginv*cs));
+  masked(active, x1, T(x1 + uyn*ginv*cs));
+  masked(active, x2, T(x2 + uzn*ginv*cs));
+}
+
+} // end of anonymous namespace
+
+
 //-------------------------------------------------- 
 inline auto ExB_drift( 
             double  ex,  double  ey,  double  ez,
@@ -194,6 +249,11 @@ void pic::rGCAPusher<D,V>::push_container(
   nvtxRangePush(__PRETTY_FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "pic");
+
+  // species sub-cycling is not supported by the guiding center scheme
+  assert(con.subcycle == 1);
+
   const double c    = tile.cfl;
   const double qm   = sign(con.q)/con.m; // q_s/m_s (sign only because emf are in units of q)
   const double m    = con.m; //mass
@@ -218,9 +278,9 @@ void pic::rGCAPusher<D,V>::push_container(
   auto mins = tile.mins;
 
 
-  // loop over particles
-  //UniIter::iterate([=] DEVCALLABLE (size_t n, pic::ParticleContainer<D>& con){
-  for(size_t n=0; n<con.size(); n++){
+  //--------------------------------------------------
+  // reduced guiding center update of particle n
+  auto push_gca = [&](size_t n){
 
     // local tmp variables that carry over post iteration
     double G0, G1;
@@ -239,12 +299,12 @@ void pic::rGCAPusher<D,V>::push_container(
     double vel2n = con.vel(2,n);
 
     // read particle-specific emf
-    double ex0 = ( con.ex(n) + this->get_ex_ext(0,0,0) )/c; //TODO: why cinv here in E?
-    double ey0 = ( con.ey(n) + this->get_ey_ext(0,0,0) )/c;
-    double ez0 = ( con.ez(n) + this->get_ez_ext(0,0,0) )/c;
-    double bx0 = ( con.bx(n) + this->get_bx_ext(0,0,0) )/c;
-    double by0 = ( con.by(n) + this->get_by_ext(0,0,0) )/c;
-    double bz0 = ( con.bz(n) + this->get_bz_ext(0,0,0) )/c;
+    double ex0 = ( con.ex(n) + this->ex_ext )/c; //TODO: why cinv here in E?
+    double ey0 = ( con.ey(n) + this->ey_ext )/c;
+    double ez0 = ( con.ez(n) + this->ez_ext )/c;
+    double bx0 = ( con.bx(n) + this->bx_ext )/c;
+    double by0 = ( con.by(n) + this->by_ext )/c;
+    double bz0 = ( con.bz(n) + this->bz_ext )/c;
 
     //-------------------------------------------------- 
     // iterate: step0
@@ -360,7 +420,7 @@ void pic::rGCAPusher<D,V>::push_container(
         c011 = 0.5*(exM(ind+iy+iz ) +exM(ind-1+iy+iz));
         c111 = 0.5*(exM(ind+iy+iz ) +exM(ind+1+iy+iz));
         ex1 = lerp(c000, c100, c010, c110, c001, c101, c011, c111, dx, dy, dz);
-        ex1 += this->get_ex_ext(0,0,0);
+        ex1 += this->ex_ext;
 
         //ey
         c000 = 0.5*(eyM(ind      ) +eyM(ind-iy     ));
@@ -372,7 +432,7 @@ void pic::rGCAPusher<D,V>::push_container(
         c011 = 0.5*(eyM(ind+iz   ) +eyM(ind+iy+iz  ));
         c111 = 0.5*(eyM(ind+1+iz ) +eyM(ind+1+iy+iz));
         ey1 = lerp(c000, c100, c010, c110, c001, c101, c011, c111, dx, dy, dz);
-        ey1 += this->get_ey_ext(0,0,0);
+        ey1 += this->ey_ext;
 
         //ez
         c000 = 0.5*(ezM(ind      ) + ezM(ind-iz     ));
@@ -384,7 +444,7 @@ void pic::rGCAPusher<D,V>::push_container(
         c011 = 0.5*(ezM(ind+iy   ) + ezM(ind+iy+iz  ));
         c111 = 0.5*(ezM(ind+1+iy ) + ezM(ind+1+iy+iz));
         ez1 = lerp(c000, c100, c010, c110, c001, c101, c011, c111, dx, dy, dz);
-        ez1 += this->get_ez_ext(0,0,0);
+        ez1 += this->ez_ext;
 
         //-------------------------------------------------- 
         // bx
@@ -397,7 +457,7 @@ void pic::rGCAPusher<D,V>::push_container(
         c011 = 0.25*( bxM(ind)+   bxM(ind+iy)+   bxM(ind+iy+iz)+   bxM(ind+iz));
         c111 = 0.25*( bxM(ind+1)+ bxM(ind+1+iy)+ bxM(ind+1+iy+iz)+ bxM(ind+1+iz));
         bx1 = lerp(c000, c100, c010, c110, c001, c101, c011, c111, dx, dy, dz);
-        bx1 += this->get_bx_ext(0,0,0);
+        bx1 += this->bx_ext;
 
         // by
         c000 = 0.25*( byM(ind-1-iz)+    byM(ind-1)+       byM(ind-iz)+      byM(ind));
@@ -409,7 +469,7 @@ void pic::rGCAPusher<D,V>::push_container(
         c011 = 0.25*( byM(ind-1+iy)+    byM(ind-1+iy+iz)+ byM(ind+iy)+      byM(ind+iy+iz));
         c111 = 0.25*( byM(ind+iy)+      byM(ind+iy+iz)+   byM(ind+1+iy)+    byM(ind+1+iy+iz));
         by1 = lerp(c000, c100, c010, c110, c001, c101, c011, c111, dx, dy, dz);
-        by1 += this->get_by_ext(0,0,0);
+        by1 += this->by_ext;
 
         // bz
         c000 = 0.25*( bzM(ind-1-iy)+    bzM(ind-1)+       bzM(ind-iy)+      bzM(ind));
@@ -421,7 +481,7 @@ void pic::rGCAPusher<D,V>::push_container(
         c011 = 0.25*( bzM(ind-1+iz)+    bzM(ind-1+iy+iz)+ bzM(ind+iz)+      bzM(ind+iy+iz));
         c111 = 0.25*( bzM(ind+iz)+      bzM(ind+iy+iz)+   bzM(ind+1+iz)+    bzM(ind+1+iy+iz));
         bz1 = lerp(c000, c100, c010, c110, c001, c101, c011, c111, dx, dy, dz);
-        bz1 += this->get_bz_ext(0,0,0);
+        bz1 += this->bz_ext;
 
         ex1 *= 1.0/c;
         ey1 *= 1.0/c;
@@ -621,7 +681,162 @@ void pic::rGCAPusher<D,V>::push_container(
     }
 #endif
 
-  //}, con.size(), con);
+  };
+
+
+  //--------------------------------------------------
+  // full-orbit bin: particles are gathered into contiguous SoA scratch,
+  // advanced by a Boris kernel vectorized like pic::PolicyPusher, and
+  // scattered back. Sub-steps beyond a particle's own nsteps are masked
+  // out so that all lanes of a vector run the same instructions.
+  auto push_orbits = [&](const std::vector<size_t>& ind){
+
+    const size_t M = ind.size();
+    if(M == 0) return;
+
+    orbit.resize(13*M);
+    double* ux = orbit.data();
+    double* uy = ux + M;
+    double* uz = uy + M;
+    double* x0 = uz + M;
+    double* x1 = x0 + M;
+    double* x2 = x1 + M;
+    double* ex = x2 + M;
+    double* ey = ex + M;
+    double* ez = ey + M;
+    double* bx = ez + M;
+    double* by = bx + M;
+    double* bz = by + M;
+    double* ns = bz + M;
+
+    int nsmax = 1;
+    for(size_t p=0; p<M; p++) {
+      const size_t n = ind[p];
+      const double qms = 0.5*qm/nsteps[n]; // half of q/m per sub-step
+
+      ux[p] = con.vel(0,n);
+      uy[p] = con.vel(1,n);
+      uz[p] = con.vel(2,n);
+      x0[p] = con.loc(0,n);
+      x1[p] = con.loc(1,n);
+      x2[p] = con.loc(2,n);
+
+      ex[p] = ( con.ex(n) + this->ex_ext )*qms;
+      ey[p] = ( con.ey(n) + this->ey_ext )*qms;
+      ez[p] = ( con.ez(n) + this->ez_ext )*qms;
+      bx[p] = ( con.bx(n) + this->bx_ext )*qms;
+      by[p] = ( con.by(n) + this->by_ext )*qms;
+      bz[p] = ( con.bz(n) + this->bz_ext )*qms;
+
+      ns[p] = nsteps[n];
+      nsmax = std::max(nsmax, nsteps[n]);
+    }
+
+#ifdef RUNKO_SIMD
+    namespace stdx = std::experimental;
+    using Vec = stdx::native_simd<double>;
+    const size_t W = Vec::size();
+    const size_t p0 = (M/W)*W; // first particle left for the scalar loop
+#else
+    const size_t p0 = 0;
+#endif
+
+    for(int is=0; is<nsmax; is++) {
+
+#ifdef RUNKO_SIMD
+      for(size_t p=0; p<p0; p+=W) {
+        auto load = [p](const double* a) { return Vec(a + p, stdx::element_aligned); };
+
+        Vec vux = load(ux), vuy = load(uy), vuz = load(uz);
+        Vec vx0 = load(x0), vx1 = load(x1), vx2 = load(x2);
+
+        orbit_substep<Vec>(Vec(c), Vec(is), load(ns),
+            vux, vuy, vuz, vx0, vx1, vx2,
+            load(ex), load(ey), load(ez), load(bx), load(by), load(bz));
+
+        vux.copy_to(ux + p, stdx::element_aligned);
+        vuy.copy_to(uy + p, stdx::element_aligned);
+        vuz.copy_to(uz + p, stdx::element_aligned);
+        vx0.copy_to(x0 + p, stdx::element_aligned);
+        vx1.copy_to(x1 + p, stdx::element_aligned);
+        vx2.copy_to(x2 + p, stdx::element_aligned);
+      }
+#endif
+
+      // remaining particles
+      for(size_t p=p0; p<M; p++) {
+        orbit_substep<double>(c, is, ns[p],
+            ux[p], uy[p], uz[p], x0[p], x1[p], x2[p],
+            ex[p], ey[p], ez[p], bx[p], by[p], bz[p]);
+      }
+    }
+
+    for(size_t p=0; p<M; p++) {
+      const size_t n = ind[p];
+      con.vel(0,n) = ux[p];
+      con.vel(1,n) = uy[p];
+      con.vel(2,n) = uz[p];
+      if(D>=1) con.loc(0,n) = x0[p];
+      if(D>=2) con.loc(1,n) = x1[p];
+      if(D>=3) con.loc(2,n) = x2[p];
+    }
+  };
+
+
+  //--------------------------------------------------
+  // all particles follow the GCA
+  if(!full_orbit) {
+    for(size_t n=0; n<con.size(); n++) push_gca(n);
+  } else {
+
+    //--------------------------------------------------
+    // phase 1: classify; nsteps = 0 for GCA, otherwise number of Boris sub-steps
+    const size_t N = con.size();
+    const double eb2 = gca_max_eb*gca_max_eb;
+    nsteps.resize(N);
+
+    #pragma omp simd
+    for(size_t n=0; n<N; n++) {
+      const double ex0 = con.ex(n) + this->ex_ext;
+      const double ey0 = con.ey(n) + this->ey_ext;
+      const double ez0 = con.ez(n) + this->ez_ext;
+      const double bx0 = con.bx(n) + this->bx_ext;
+      const double by0 = con.by(n) + this->by_ext;
+      const double bz0 = con.bz(n) + this->bz_ext;
+
+      const double b2 = bx0*bx0 + by0*by0 + bz0*bz0;
+      const double e2 = ex0*ex0 + ey0*ey0 + ez0*ez0;
+
+      const double u2 = con.vel(0,n)*con.vel(0,n) + con.vel(1,n)*con.vel(1,n) + con.vel(2,n)*con.vel(2,n);
+
+      // gyration angle per time step
+      const double phase = std::abs(qm)*sqrt(b2)/(c*sqrt(1.0 + u2));
+
+      const bool gca = (e2 < eb2*b2) && (phase > gca_min_phase);
+      const double nsub = std::min<double>(max_substeps, std::ceil(phase/max_phase));
+      const int ns = std::max(1, static_cast<int>(nsub));
+
+      nsteps[n] = gca ? 0 : ns;
+    }
+
+    // stream compaction into bins
+    gca_ind.clear();
+    orbit_ind.clear();
+    substep_ind.clear();
+    for(size_t n=0; n<N; n++) {
+      if(     nsteps[n] == 0) gca_ind.push_back(n);
+      else if(nsteps[n] == 1) orbit_ind.push_back(n);
+      else                    substep_ind.push_back(n);
+    }
+
+    //--------------------------------------------------
+    // phase 2: push bins
+    for(size_t n : gca_ind) push_gca(n);
+
+    push_orbits(orbit_ind);
+
+    // adaptive sub-step batch
+    push_orbits(substep_ind);
   }
 
 
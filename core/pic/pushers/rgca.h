@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "core/pic/pushers/pusher.h"
 
 namespace pic {
@@ -8,13 +10,49 @@ namespace pic {
 //
 // https://arxiv.org/abs/1701.05605
 //
+// With full_orbit = true particles are pushed in two phases. First, they
+// are classified by the validity of the guiding center approximation and
+// compacted into index bins; then every bin is advanced separately:
+//  - GCA bin: reduced guiding center scheme, one particle at a time
+//  - full-orbit bin: Boris scheme
+//  - sub-step bin: Boris scheme with n sub-steps for particles whose 
+//    gyration angle per step exceeds max_phase
+// The full-orbit bins are gathered into contiguous SoA scratch and
+// advanced by a vectorized Boris kernel.
+//
+// With full_orbit = false (default) classification is skipped and all
+// particles follow the GCA.
 template<size_t D, size_t V>
 class rGCAPusher :
   public Pusher<D,V>
 {
+  public:
+
+  /// switch particles to full-orbit integration where GCA is not valid
+  bool full_orbit = false;
+
+  /// GCA requires |E| < gca_max_eb |B| ...
+  double gca_max_eb = 0.9;
+
+  /// ... and gyration angle per step omega_B dt > gca_min_phase
+  double gca_min_phase = 1.0;
+
+  /// maximum gyration angle per full-orbit (sub-)step
+  double max_phase = 0.3;
+
+  /// upper limit for number of full-orbit sub-steps
+  int max_substeps = 16;
+
   void push_container(
           pic::ParticleContainer<D>& container, 
           pic::Tile<D>& tile) override;
+
+  private:
+
+  // scratch kept across push_container calls
+  std::vector<int> nsteps; // 0 for GCA, otherwise number of Boris sub-steps
+  std::vector<size_t> gca_ind, orbit_ind, substep_ind; // bins
+  std::vector<double> orbit; // gathered full-orbit particles (SoA)
 };
 
 } // end of namespace pic
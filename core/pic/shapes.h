@@ -1,86 +1,173 @@
 #pragma once
 
-// Particle weight functions
-
-
-// 1st order cloud-in-cell shape (CIC)
-inline void W1st(double d, double* coeff){
-  coeff[0] = 0.0;   // W1_im1
-  coeff[1] = 1.0-d; // W1_i
-  coeff[2] = d;     // W1_ip1
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+#include "external/iter/devcall.h"
+
+namespace pic {
+namespace shape {
+
+/// B-spline particle shape of order O on a unit-spaced grid
+//
+// index(x) is the reference node i of a particle at x; the shape covers
+// nodes i+lo ... i+hi and weights(d, w) fills w[0 ... width-1] for d = x-i.
+// Even orders are centered on the nearest node, odd orders on the node below;
+// the cell of node i then starts at i+edge.
+template<int O> struct BSpline;
+
+template<>
+struct BSpline<0> {
+  static constexpr int lo = 0, hi = 0, width = 1;
+  static constexpr double edge = -0.5;
+
+  DEVCALLABLE static inline int index(double x) { return round(x); }
+
+  DEVCALLABLE static inline void weights(double, double* w) { w[0] = 1.0; }
+};
+
+template<>
+struct BSpline<1> {
+  static constexpr int lo = 0, hi = 1, width = 2;
+  static constexpr double edge = 0.0;
+
+  DEVCALLABLE static inline int index(double x) { return floor(x); }
+
+  DEVCALLABLE static inline void weights(double d, double* w) {
+    w[0] = 1.0-d;
+    w[1] = d;
+  }
+};
+
+template<>
+struct BSpline<2> {
+  static constexpr int lo = -1, hi = 1, width = 3;
+  static constexpr double edge = -0.5;
+
+  DEVCALLABLE static inline int index(double x) { return round(x); }
+
+  DEVCALLABLE static inline void weights(double d, double* w) {
+    w[0] = 0.50*(0.5 - d)*(0.5 - d);
+    w[1] = 0.75 - d*d;
+    w[2] = 0.50*(0.5 + d)*(0.5 + d);
+  }
+};
+
+template<>
+struct BSpline<3> {
+  static constexpr int lo = -1, hi = 2, width = 4;
+  static constexpr double edge = 0.0;
+
+  DEVCALLABLE static inline int index(double x) { return floor(x); }
+
+  DEVCALLABLE static inline void weights(double d, double* w) {
+    double d2 = d*d;
+    double d3 = d*d*d;
+    w[0] = ( 1.0 - d3 )/6.0 - 0.5*( d-d2 );
+    w[1] = 2.0/3.0 - d2 + 0.5*d3;
+    w[2] = 1.0/6.0 + 0.5*( d+d2-d3 );
+    w[3] = d3/6.0;
+  }
+};
+
+template<>
+struct BSpline<4> {
+  static constexpr int lo = -2, hi = 2, width = 5;
+  static constexpr double edge = -0.5;
+
+  DEVCALLABLE static inline int index(double x) { return round(x); }
+
+  DEVCALLABLE static inline void weights(double d, double* w) {
+    double d2 = d*d;
+    double d3 = d*d*d;
+    double d4 = d*d*d*d;
+    w[0] = 1.0/384.0   - d/48.0       + d2/16.0    - d3/12.0 + d4/24.0;
+    w[1] = 19.0/96.0   - d*11.0/24.0  + d2/4.0     + d3/6.0  - d4/6.0;
+    w[2] = 115.0/192.0                - d2*5.0/8.0           + d4/4.0;
+    w[3] = 19.0/96.0   + d*11.0/24.0  + d2/4.0     - d3/6.0  - d4/6.0;
+    w[4] = 1.0/384.0   + d/48.0       + d2/16.0    + d3/12.0 + d4/24.0;
+  }
+};
+
+/// shape along a collapsed (non-simulated) dimension; a single node of weight 1
+struct Flat {
+  static constexpr int lo = 0, hi = 0, width = 1;
+  static constexpr double edge = 0.0;
+
+  DEVCALLABLE static inline int index(double) { return 0; }
+
+  DEVCALLABLE static inline void weights(double, double* w) { w[0] = 1.0; }
+};
+
+/// shape S averaged over the two dual nodes next to each primary node
+//
+// Used on the dual (+1/2) grid, this gathers a staggered component as if it
+// were first averaged to the primary nodes and then interpolated with S.
+template<typename S>
+struct Averaged {
+  static constexpr int lo = S::lo - 1, hi = S::hi, width = S::width + 1;
+  static constexpr double edge = S::edge - 0.5;
+
+  DEVCALLABLE static inline int index(double x) { return S::index(x + 0.5); }
+
+  DEVCALLABLE static inline void weights(double d, double* w) {
+    double v[S::width];
+    S::weights(d + 0.5, v);
+
+    w[0] = 0.5*v[0];
+    for(int l=1; l<S::width; l++) w[l] = 0.5*(v[l-1] + v[l]);
+    w[S::width] = 0.5*v[S::width-1];
+  }
+};
+
+/// shape S along dimension `dim` of a D-dimensional grid
+template<size_t D, size_t dim, typename S>
+using Along = std::conditional_t<(dim < D), S, Flat>;
+
+
+/// reference node and weights of a particle at x on a grid staggered by s
+template<typename S>
+DEVCALLABLE inline int stencil(double x, double s, double* w)
+{
+  const int i = S::index(x - s);
+  S::weights(x - i - s, w);
+  return i;
 }
 
 
-// Triangular shaped cloud;
-// 2nd order quadratic spline
-/*      -
-*       |  3/4 - x^2                  if |x|<1/2
-* W(x)=<   1/2*(3/2 - |x|)^2          if 1/2<=|x|<3/2
-*       |  0                          otherwise
-*       -
-*/
-// TODO: c0 and c2 appear wrong; should be 1/8 (3-2x)^2 ?
-inline void W2nd(double d, double* coeff){
-
-  // Sokolov higher
-  // 0.5*(1-d)^2 ok
-  // 3/4 - (0.5 - d)^2
-  // d^2
-
-  //NOTE: d at wings includes +-1 so W2_mp1 -> 0.5*(3/2 +- d)^2
-  coeff[0] = 0.50*(0.5 - d)*(0.5 - d); //W2_im1 
-  coeff[1] = 0.75 - d*d;               //W2_i   
-  coeff[2] = 0.50*(0.5 + d)*(0.5 + d); //W2_ip1 
+/// relay point of a move from x1 to x2 (Umeda et al. 2003)
+//
+// Splits the move into two segments that each stay inside the cell of S
+// of their end point.
+template<typename S>
+DEVCALLABLE inline double relay(double x1, double x2)
+{
+  const double e1 = S::index(x1) + S::edge;
+  const double e2 = S::index(x2) + S::edge;
+  return std::min(std::min(e1,e2) + 1.0, std::max(std::max(e1,e2), 0.5*(x1+x2)));
 }
 
 
-// 3rd oder cubic piewce spline  
-inline void W3rd(double d, double* coeff){
-  double d2 = d*d;
-  double d3 = d*d*d;
-
-  // OLD version
-  ///coeff[0] = ( 1.0f - d3 )*1.0f/6.0f - 0.5f*( d-d2 );
-  ///coeff[1] = 2.0f/3.0f - xi2 + 0.5f*d3;
-  ///coeff[2] = 1.0f/6.0f + 0.5f*( d+d2-d3 );
-  ///coeff[3] = d3*1.0f/6.0f;
-
-
-  // Sokolov weights
-  //(1-d)**3/6  == 1/6 - d/2 + d^2/2 - d^3/6        ok
-  //(2-d)**3/6 - 2(1-d)**3/3 == 0.5*d^3 - d^2 + 2/3 ok
-  //(1+d)**3/6 - 2d**3/3 == 1/6 - (d + d^2 - d^3)/2 ok
-  //d**3/6                                          ok
-
-  // 1/6*(4 - 6*x^2 + 3*|x|^3)   if 0<=|x|<1
-  // 1/6*(2 - |x|)^3             if 1<=|x|<2
-  // 0                           otherwise
-
-  coeff[0] = 0.0;                             // W3_im2
-  coeff[1] = ( 1.0 - d3 )/6.0 - 0.5*( d-d2 ); // W3_im1  (1-d^3)/6 - (d-d^3)/2
-  coeff[2] = 2.0/3.0 - d2 + 0.5*d3;           // W3_i    2/3 - d^2 + d^3/2
-  coeff[3] = 1.0/6.0 + 0.5*( d+d2-d3 );       // W3_ip1  1/6 - (d + d^2 - d^3)/2
-  coeff[4] = d3/6.0;                          // W3_ip2  d^3/6
-
-}
-
-// 4th order quartic piewce spline  
-// TODO: not tested
-inline void W4th(double d, double* coeff){
-  double d2 = d*d;
-  double d3 = d*d*d;
-  double d4 = d*d*d*d;
-
-  // 115/192 + x^2 * (-5/8 + 1/4 * x^2)                          if -1/2 < x < 1/2
-  // 1/96 * (55 + 4 * x * (5 - 2 * x * (15 + 2 * x * (-5 + x)))) if 1/2 <= |x| < 3/2
-  // 1/384 * (5 - 2 * x)^4                                       if 3/2 <= |x| < 5/2
-
-  coeff[0] = 1.0/384.0   - d/48.0       + d2/16.0    - d3/12.0 + d4/24.0; // W4_im2
-  coeff[1] = 19.0/96.0   - d*11.0/24.0  + d2/4.0     + d3/6.0  - d4/6.0; // W4_im1
-  coeff[2] = 115.0/192.0                - d2*5.0/8.0           + d4/4.0; // W4_i  //ok
-  coeff[3] = 19.0/96.0   + d*11.0/24.0  + d2/4.0     - d3/6.0  - d4/6.0; // W4_ip1
-  coeff[4] = 1.0/384.0   + d/48.0       + d2/16.0    + d3/12.0 + d4/24.0; // W4_ip2
-
+/// tensor-product sum over the Sx x Sy x Sz stencil of f around node ind
+//
+// wx, wy, wz are the weights from stencil(); iy and iz are the flat index
+// strides of f. Loop bounds are compile-time constants so the stencil is
+// unrolled completely; the accumulation order is z-outer, x-inner.
+template<typename Sx, typename Sy, typename Sz>
+DEVCALLABLE inline double gather(
+    const float* f, size_t ind, size_t iy, size_t iz,
+    const double* wx, const double* wy, const double* wz)
+{
+  double res = 0.0;
+  for(int kl=Sz::lo; kl<=Sz::hi; kl++) {
+  for(int jl=Sy::lo; jl<=Sy::hi; jl++) {
+  for(int il=Sx::lo; il<=Sx::hi; il++) {
+    res += wx[il-Sx::lo]*wy[jl-Sy::lo]*wz[kl-Sz::lo] * f[ind + il + jl*iy + kl*iz];
+  }}}
+  return res;
 }
 
+} // end of namespace shape
+} // end of namespace pic
 
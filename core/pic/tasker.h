@@ -43,9 +43,12 @@ inline void read_particles(
   h5io::Reader reader(dir, lap, grid.comm.rank());
 
   for(auto cid : grid.get_tile_ids() ){
-    auto& tile 
-      = dynamic_cast<pic::Tile<D>&>(grid.get_tile( cid ));
-    reader.read(tile);
+    // ghost tiles keep no particles to restore
+    auto* tile 
+      = dynamic_cast<pic::Tile<D>*>(&grid.get_tile( cid ));
+    if(tile == nullptr) continue;
+
+    reader.read(*tile);
   }
 }
 
@@ -1,8 +1,13 @@
 #include <cmath>
+#include <algorithm>
+#include <stdexcept>
 
 #include "core/pic/tile.h"
+#include "core/pic/ghost_tile.h"
 #include "core/pic/communicate.h"
 
+#include "external/timer/tracer.h"
+
 #ifdef GPU
 #include <nvtx3/nvToolsExt.h> 
 #endif
@@ -47,8 +52,16 @@ void Tile<D>::check_outgoing_particles()
   for(size_t i=0; i<D; i++) tile_mins[i] = corgi::Tile<D>::mins[i];
   for(size_t i=0; i<D; i++) tile_maxs[i] = corgi::Tile<D>::maxs[i];
 
-  for(auto&& container : containers)
+  for(auto&& container : containers) {
+
+    // sub-cycled species do not move between their pushes
+    if(!container.is_active()) {
+      container.to_other_tiles.clear();
+      continue;
+    }
+
     container.check_outgoing_particles(tile_mins, tile_maxs);
+  }
 }
 
 template<std::size_t D>
@@ -60,6 +73,47 @@ void Tile<D>::delete_transferred_particles()
 
 //--------------------------------------------------
 
+template<std::size_t D>
+void Tile<D>::transfer_incoming_particles(
+    corgi::Tile<D>& external_tile,
+    std::array<int,3> dirs,
+    std::array<double,3>& global_mins,
+    std::array<double,3>& global_maxs)
+{
+  // virtual neighbour that only carries the received messages
+  if(auto* ghost = dynamic_cast<GhostTile<D>*>(&external_tile)) {
+    assert(ghost->Nspecies() == Nspecies());
+
+    for(int ispc=0; ispc<Nspecies(); ispc++) {
+      auto& container = get_container(ispc);
+      auto& msg = ghost->get_messages(ispc);
+
+      // sub-cycled species are exchanged only on their push laps
+      if(!container.is_active()) continue;
+
+      container.transfer_and_wrap_particles(
+          msg.incoming_particles, msg.to_other_tiles, dirs, global_mins, global_maxs);
+    }
+    return;
+  }
+
+  auto& tile = dynamic_cast<Tile&>(external_tile);
+
+  // loop over all containers
+  for(int ispc=0; ispc<Nspecies(); ispc++) {
+    auto& container = get_container(ispc);
+    auto& neigh = tile.get_container(ispc);
+
+    // sub-cycled species are exchanged only on their push laps
+    if(!container.is_active()) continue;
+
+    container.transfer_and_wrap_particles(
+        neigh, dirs, global_mins, global_maxs);
+  }
+}
+
+//--------------------------------------------------
+
 template<>
 void Tile<1>::get_incoming_particles(
     corgi::Grid<1>& grid)
@@ -69,6 +123,8 @@ void Tile<1>::get_incoming_particles(
   nvtxRangePush(__PRETTY_FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "pic");
+
   std::array<double,3> global_mins = {
     static_cast<double>( grid.get_xmin() ),
     static_cast<double>( 0.0 ),
@@ -88,16 +144,9 @@ void Tile<1>::get_incoming_particles(
         // get neighboring tile
         auto ind = this->neighs(i); 
         uint64_t cid = grid.id( std::get<0>(ind));
-        Tile& external_tile = dynamic_cast<Tile&>( grid.get_tile(cid) );
-
-        // loop over all containers
-        for(int ispc=0; ispc<Nspecies(); ispc++) {
-          auto& container = get_container(ispc);
-          auto& neigh = external_tile.get_container(ispc);
 
-          container.transfer_and_wrap_particles(
-              neigh, {i,j,k}, global_mins, global_maxs);
-        }
+        transfer_incoming_particles(
+            grid.get_tile(cid), {i,j,k}, global_mins, global_maxs);
 
   }
 
@@ -132,18 +181,9 @@ void Tile<2>::get_incoming_particles(
       // get neighboring tile
       auto ind = this->neighs(i, j); 
       uint64_t cid = grid.id( std::get<0>(ind), std::get<1>(ind) );
-      Tile& external_tile = 
-        dynamic_cast<Tile&>( grid.get_tile(cid) );
-
-      // loop over all containers
-        
-      for(int ispc=0; ispc<Nspecies(); ispc++) {
-        auto& container = get_container(ispc);
-        auto& neigh = external_tile.get_container(ispc);
-
-        container.transfer_and_wrap_particles(
-            neigh, {i,j,k}, global_mins, global_maxs);
-      }
+
+      transfer_incoming_particles(
+          grid.get_tile(cid), {i,j,k}, global_mins, global_maxs);
     }
   }
 }
@@ -158,6 +198,8 @@ void Tile<3>::get_incoming_particles(
   nvtxRangePush(__PRETTY_FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "pic");
+
   std::array<double,3> global_mins = {
     static_cast<double>( grid.get_xmin() ),
     static_cast<double>( grid.get_ymin() ),
@@ -180,17 +222,9 @@ void Tile<3>::get_incoming_particles(
         // get neighboring tile
         auto ind = this->neighs(i, j, k); 
         uint64_t cid = grid.id( std::get<0>(ind), std::get<1>(ind), std::get<2>(ind) );
-        Tile& external_tile = dynamic_cast<Tile&>( grid.get_tile(cid) );
-
-        // loop over all containers
-        for(int ispc=0; ispc<Nspecies(); ispc++) {
-          auto& container = get_container(ispc);
-          auto& neigh = external_tile.get_container(ispc);
-
-          container.transfer_and_wrap_particles(
-              neigh, {i,j,k}, global_mins, global_maxs);
-        }
 
+        transfer_incoming_particles(
+            grid.get_tile(cid), {i,j,k}, global_mins, global_maxs);
         }
     }
   }
@@ -230,6 +264,8 @@ std::vector<mpi::request> Tile<D>::send_particle_data(
   nvtxRangePush(__PRETTY_FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "mpi");
+
   std::vector<mpi::request> reqs;
   for(int ispc=0; ispc<Nspecies(); ispc++) {
     auto& container = get_container(ispc);
@@ -260,6 +296,8 @@ std::vector<mpi::request> Tile<D>::send_particle_extra_data(
   nvtxRangePush(__PRETTY_FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "mpi");
+
   std::vector<mpi::request> reqs;
   for(int ispc=0; ispc<Nspecies(); ispc++) {
     auto& container = get_container(ispc);
@@ -312,6 +350,8 @@ std::vector<mpi::request> Tile<D>::recv_particle_data(
   nvtxRangePush(__PRETTY_FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "mpi");
+
   std::vector<mpi::request> reqs;
   for (int ispc=0; ispc<Nspecies(); ispc++) {
     auto& container = get_container(ispc);
@@ -343,6 +383,8 @@ std::vector<mpi::request> Tile<D>::recv_particle_extra_data(
   nvtxRangePush(__PRETTY_FUNCTION__);
 #endif
 
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "mpi");
+
   std::vector<mpi::request> reqs;
 
   // this assumes that wait for the first message is already called
@@ -449,6 +491,180 @@ void Tile<D>::shrink_to_fit_all_particles()
 }
 
 
+//--------------------------------------------------
+// species sub-cycling
+
+template<std::size_t D>
+void Tile<D>::set_subcycle_lap(int lap)
+{
+  for(auto&& container : containers) {
+    assert(container.subcycle >= 1);
+    container.substep = lap % container.subcycle;
+  }
+}
+
+
+template<std::size_t D>
+void Tile<D>::accumulate_subcycle_fields()
+{
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "pic");
+
+  for(int ispc=0; ispc<Nspecies(); ispc++) {
+    auto& con = containers[ispc];
+    if(con.subcycle == 1) continue;
+
+    auto it = subcycle_grids.find(ispc);
+    if(it == subcycle_grids.end())
+      it = subcycle_grids.emplace(ispc, emf::Grids{mesh_lengths[0], mesh_lengths[1], mesh_lengths[2]}).first;
+    auto& avg = it->second;
+    int& laps = subcycle_laps[ispc];
+
+    // first lap of the sub-cycle starts a new average; so does the first
+    // lap after a restart, wherever it falls in the sub-cycle
+    if(con.substep == 0 || laps == 0) {
+      avg.ex = grids.ex; avg.ey = grids.ey; avg.ez = grids.ez;
+      avg.bx = grids.bx; avg.by = grids.by; avg.bz = grids.bz;
+      laps = 1;
+    } else {
+      avg.ex += grids.ex; avg.ey += grids.ey; avg.ez += grids.ez;
+      avg.bx += grids.bx; avg.by += grids.by; avg.bz += grids.bz;
+      laps++;
+    }
+
+    // normalize on the push lap by the laps actually accumulated
+    if(con.is_active()) {
+      const float norm = 1.0f/laps;
+      avg.ex *= norm; avg.ey *= norm; avg.ez *= norm;
+      avg.bx *= norm; avg.by *= norm; avg.bz *= norm;
+    }
+  }
+}
+
+
+template<std::size_t D>
+emf::Grids& Tile<D>::gather_grids(const ParticleContainer<D>& con)
+{
+  if(con.subcycle == 1) return grids;
+
+  // accumulate_subcycle_fields() has to be called every lap before interpolation
+  const int ispc = &con - containers.data();
+  auto it = subcycle_grids.find(ispc);
+  if(it == subcycle_grids.end())
+    throw std::runtime_error("pic::Tile::gather_grids: no averaged fields for sub-cycled species " 
+        + std::to_string(ispc) + "; call accumulate_subcycle_fields() before interpolation");
+
+  return it->second;
+}
+
+
+template<std::size_t D>
+emf::Grids& Tile<D>::deposit_grids(const ParticleContainer<D>& con)
+{
+  if(con.subcycle == 1) return grids;
+
+  const int ispc = &con - containers.data();
+  auto it = subcycle_grids.find(ispc);
+  if(it == subcycle_grids.end())
+    it = subcycle_grids.emplace(ispc, emf::Grids{mesh_lengths[0], mesh_lengths[1], mesh_lengths[2]}).first;
+
+  auto& gs = it->second;
+  gs.jx.clear();
+  gs.jy.clear();
+  gs.jz.clear();
+
+  return gs;
+}
+
+
+template<std::size_t D>
+void Tile<D>::add_subcycle_currents()
+{
+  for(int ispc=0; ispc<Nspecies(); ispc++) {
+    if(containers[ispc].subcycle == 1) continue;
+
+    auto it = subcycle_grids.find(ispc);
+    if(it == subcycle_grids.end()) continue; // not pushed yet
+
+    grids.jx += it->second.jx;
+    grids.jy += it->second.jy;
+    grids.jz += it->second.jz;
+  }
+}
+
+
+
+
+//--------------------------------------------------
+// collocated fields
+
+/// average the staggered E/B of gs to the nodes of mesh m
+template<std::size_t D, typename M>
+void collocate(const emf::Grids& gs, M& m)
+{
+  const int H = 3; // halo of the tile meshes
+  if(m.Nx != gs.Nx || m.Ny != gs.Ny || m.Nz != gs.Nz) m = M(gs.Nx, gs.Ny, gs.Nz);
+
+  // mesh sizes for 1D indexing; zero in the collapsed dimensions
+  const size_t iy = D >= 2 ? gs.ex.indx(0,1,0) - gs.ex.indx(0,0,0) : 0;
+  const size_t iz = D >= 3 ? gs.ex.indx(0,0,1) - gs.ex.indx(0,0,0) : 0;
+
+  const float* ex = gs.ex.data();
+  const float* ey = gs.ey.data();
+  const float* ez = gs.ez.data();
+  const float* bx = gs.bx.data();
+  const float* by = gs.by.data();
+  const float* bz = gs.bz.data();
+
+  // first nodes with all lower neighbors inside the halo; the records
+  // below them stay zero
+  const int j0 = D >= 2 ? 1-H : -H;
+  const int k0 = D >= 3 ? 1-H : -H;
+
+  #pragma omp parallel for collapse(2)
+  for(int k=k0; k<gs.Nz+H; k++)
+  for(int j=j0; j<gs.Ny+H; j++) {
+    const size_t row = gs.ex.indx(0,j,k);
+
+    for(int i=1-H; i<gs.Nx+H; i++) {
+      const size_t n = row + i;
+      auto& r = m(i,j,k);
+
+      // E is staggered by half a cell along its own component
+      r[0] = 0.5*(ex[n] + ex[n-1 ]);
+      r[1] = 0.5*(ey[n] + ey[n-iy]);
+      r[2] = 0.5*(ez[n] + ez[n-iz]);
+
+      // B is staggered by half a cell along the two other directions
+      r[3] = 0.25*(bx[n] + bx[n-iy] + bx[n-iz] + bx[n-iy-iz]);
+      r[4] = 0.25*(by[n] + by[n-1 ] + by[n-iz] + by[n-1 -iz]);
+      r[5] = 0.25*(bz[n] + bz[n-1 ] + bz[n-iy] + bz[n-1 -iy]);
+    }
+  }
+}
+
+
+template<std::size_t D>
+void Tile<D>::collocate_fields(const emf::Grids& gs, bool bricked)
+{
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "pic");
+
+  if(bricked) {
+    collocate<D>(gs, bricked_gather_cache);
+  } else {
+    collocate<D>(gs, node_fields);
+  }
+}
+
+
+//--------------------------------------------------
+// cell-block sorting
+
+template<std::size_t D>
+void Tile<D>::sort_in_cell_blocks(int bs)
+{
+  for(auto&& con : containers) con.sort_in_cell_blocks(mins, mesh_lengths, bs);
+}
+
 
 } // end of ns pic
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <map>
 #include <mpi4cpp/mpi.h>
 
 #include "definitions.h"
@@ -108,7 +109,7 @@ public:
   // the boundaries
   void delete_transferred_particles();
 
-  /// get particles flowing into this tile
+  /// get particles flowing into this tile; virtual neighbours can be ghost tiles
   void get_incoming_particles(corgi::Grid<D>& grid);
 
   /// pack all particles for MPI message
@@ -127,8 +128,94 @@ public:
   void shrink_to_fit_all_particles();
 
 
+  //--------------------------------------------------
+  // species sub-cycling
+  //
+  // A species with container.subcycle = N > 1 is interpolated, pushed,
+  // deposited, and exchanged only on every N:th lap, with an N times
+  // longer time step. Between its pushes the fields are accumulated into a
+  // time average that the species gathers from, and the mean current of its
+  // last push is added to the tile current on every lap.
+  //
+  // NOTE: the push happens on the last lap of the sub-cycle and its mean
+  // current is applied on that lap and the N-1 laps that follow, whereas the
+  // motion it represents spans the sub-cycle that just ended. The current
+  // therefore lags the fields by N-1 laps (one sub-cycle) instead of being
+  // centred on the push interval; the time-integrated current still matches
+  // the displacement of the push.
+
+  /// time-averaged E/B and mean current (j) of sub-cycled species
+  std::map<int, emf::Grids> subcycle_grids;
+
+  /// laps summed into the running E/B average of sub-cycled species
+  //
+  // The average is not part of the restart files; after a restart in the
+  // middle of a sub-cycle it starts fresh and is normalized by the laps
+  // actually accumulated.
+  std::map<int, int> subcycle_laps;
+
+  /// set the sub-cycle phase of all species from the global lap counter
+  void set_subcycle_lap(int lap);
+
+  /// add current E/B to the running average of sub-cycled species;
+  // normalized on the push lap
+  void accumulate_subcycle_fields();
+
+  /// grids that container `con` interpolates its fields from;
+  // throws std::runtime_error if the fields of a sub-cycled species were
+  // never accumulated
+  emf::Grids& gather_grids(const ParticleContainer<D>& con);
+
+  /// grids that container `con` deposits its current into;
+  // the mean current of a sub-cycled species is cleared for the new deposit
+  emf::Grids& deposit_grids(const ParticleContainer<D>& con);
+
+  /// add the mean current of sub-cycled species to the tile current
+  void add_subcycle_currents();
+
+
+  //--------------------------------------------------
+  // collocated fields
+  //
+  // Staggered Yee components averaged to the grid nodes once per 
+  // interpolation instead of once per particle and stencil corner.
+
+  /// interleaved (ex,ey,ez,bx,by,bz) record of a grid node
+  using NodeRecord = std::array<float,6>;
+
+  /// node records in the x-fastest order of the tile meshes
+  toolbox::Mesh<NodeRecord, 3> node_fields;
+
+  /// bricked collocated gather cache: the node records in 4^D bricks
+  //
+  // A read-only copy for the particle gather (see toolbox::BrickLayout);
+  // the 2^D records of a stencil then mostly fall into one brick. The
+  // emf::Grids field and current meshes themselves stay linear.
+  toolbox::Mesh<NodeRecord, 3, toolbox::BrickLayout<4>> bricked_gather_cache;
+
+  /// average E/B of `gs` to the grid nodes into node_fields (or the bricked cache)
+  void collocate_fields(const emf::Grids& gs, bool bricked = false);
+
+  //--------------------------------------------------
+  // cell-block sorting
+
+  /// group the particles of every container by cell-blocks of bs^D cells
+  //
+  // Sorted containers are interpolated block by block against a small
+  // local copy of the block's field stencil (see pic::BlockStencil).
+  void sort_in_cell_blocks(int bs);
+
+
 private:
   std::size_t dim = D;
+
+  /// get particles flowing in from neighbour `external_tile` at relative index dirs;
+  // the neighbour is either a full pic::Tile or a pic::GhostTile
+  void transfer_incoming_particles(
+      corgi::Tile<D>& external_tile,
+      std::array<int,3> dirs,
+      std::array<double,3>& global_mins,
+      std::array<double,3>& global_maxs);
 };
 
 
@@ -47,6 +47,7 @@ class Analyzator {
 
     // Yee lattice reference
     auto& gs = tile.get_grids();
+    gs.alloc_rho();
     gs.rho.clear();
     //gs.ekin.clear();
     //gs.jx1.clear();
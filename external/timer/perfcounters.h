@@ -0,0 +1,282 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+// Hardware performance counters per kernel.
+//
+// One perf_event_open counter group is opened for every OpenMP worker
+// thread (pid = thread id) so that counts of the parallel UniIter loops are
+// included even though kernels are launched from a single thread. Kernel
+// regions (trace::Scope in tracer.h) read the summed group values before
+// and after the launch and accumulate the difference under the kernel name.
+//
+// Default group: cycles, instructions, cache references, and cache misses.
+// Floating point operations have no portable event; add the raw event
+// codes of the machine (see `perf list` on the target) with add_raw_event(),
+// e.g. on Intel Skylake:
+//   add_raw_event("fp_scalar_double", 0x01c7)
+//   add_raw_event("fp_256b_packed_double", 0x10c7)
+//
+// Counting is off by default; enable() returns false if the kernel refuses
+// to open the counters (check /proc/sys/kernel/perf_event_paranoid).
+
+namespace perf {
+
+/// description of one counter in the group
+struct CounterSpec {
+  std::string name;
+  uint32_t type;
+  uint64_t config;
+};
+
+/// accumulated counts of one kernel
+struct Stats {
+  size_t calls = 0;
+  double time = 0.0;           // wall time (s)
+  std::vector<double> counts;  // one entry per CounterSpec
+};
+
+
+class Counters {
+
+  using clock = std::chrono::steady_clock;
+
+  std::atomic<bool> enabled{false};
+
+  std::mutex mtx;
+
+  // file descriptors [thread][counter]; first one is the group leader
+  std::vector<std::vector<int>> fds;
+
+  Counters() :
+    specs{
+#if defined(__linux__)
+      {"cycles",           PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+      {"instructions",     PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+      {"cache_references", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES},
+      {"cache_misses",     PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+#endif
+    }
+  { }
+
+  public:
+
+  std::vector<CounterSpec> specs;
+
+  // accumulated statistics keyed by kernel name (static strings)
+  std::map<const char*, Stats> stats;
+
+  Counters(const Counters&) = delete;
+  Counters& operator=(const Counters&) = delete;
+
+  ~Counters() { disable(); }
+
+  static Counters& get()
+  {
+    static Counters counters;
+    return counters;
+  }
+
+  inline bool is_enabled() const
+  {
+    return enabled.load(std::memory_order_relaxed);
+  }
+
+  /// append a raw (PERF_TYPE_RAW) event to the group; call before enable()
+  void add_raw_event(const std::string& name, uint64_t config)
+  {
+#if defined(__linux__)
+    std::lock_guard<std::mutex> lock(mtx);
+    if(!fds.empty()) return;
+    specs.push_back( {name, PERF_TYPE_RAW, config} );
+#endif
+  }
+
+  /// open counter groups for all OpenMP threads
+  bool enable()
+  {
+#if defined(__linux__)
+    std::lock_guard<std::mutex> lock(mtx);
+    if(!fds.empty()) return true;
+
+    int nthreads = 1;
+#ifdef _OPENMP
+    nthreads = omp_get_max_threads();
+#endif
+
+    // collect kernel thread ids of the (persistent) OpenMP thread pool
+    std::vector<pid_t> tids(nthreads, 0);
+#ifdef _OPENMP
+    #pragma omp parallel num_threads(nthreads)
+    tids[omp_get_thread_num()] = static_cast<pid_t>( syscall(SYS_gettid) );
+#else
+    tids[0] = static_cast<pid_t>( syscall(SYS_gettid) );
+#endif
+
+    for(auto tid : tids) {
+      std::vector<int> group;
+
+      for(size_t i=0; i<specs.size(); i++) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size           = sizeof(attr);
+        attr.type           = specs[i].type;
+        attr.config         = specs[i].config;
+        attr.disabled       = (i == 0) ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+        attr.read_format    = PERF_FORMAT_GROUP
+                            | PERF_FORMAT_TOTAL_TIME_ENABLED
+                            | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        const int leader = group.empty() ? -1 : group[0];
+        const int fd = static_cast<int>( syscall(SYS_perf_event_open, &attr, tid, -1, leader, 0) );
+
+        if(fd < 0) {
+          for(auto& g : fds) for(int f : g) close(f);
+          for(int f : group) close(f);
+          fds.clear();
+          return false;
+        }
+        group.push_back(fd);
+      }
+
+      ioctl(group[0], PERF_EVENT_IOC_RESET,  PERF_IOC_FLAG_GROUP);
+      ioctl(group[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+      fds.push_back(group);
+    }
+
+    enabled.store(true, std::memory_order_relaxed);
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  void disable()
+  {
+    enabled.store(false, std::memory_order_relaxed);
+
+#if defined(__linux__)
+    std::lock_guard<std::mutex> lock(mtx);
+    for(auto& group : fds) for(int fd : group) close(fd);
+    fds.clear();
+#endif
+  }
+
+  /// current counter values summed over all threads
+  //
+  // values are scaled by enabled/running time in case the kernel multiplexes
+  // the group with other events. Reading is serialized with enable() and
+  // disable(); an empty vector is returned when the counters are closed.
+  std::vector<double> read()
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    if(fds.empty()) return {};
+
+    const size_t n = specs.size();
+    std::vector<double> vals(n, 0.0);
+
+#if defined(__linux__)
+    std::vector<uint64_t> buf(3 + n);
+
+    for(auto& group : fds) {
+      const ssize_t len = ::read(group[0], buf.data(), buf.size()*sizeof(uint64_t));
+      if(len < static_cast<ssize_t>( buf.size()*sizeof(uint64_t) )) continue;
+
+      // layout: nr, time_enabled, time_running, values[nr]
+      const double scale = buf[2] > 0 ? static_cast<double>(buf[1])/buf[2] : 1.0;
+      for(size_t i=0; i<n; i++) vals[i] += scale*buf[3+i];
+    }
+#endif
+
+    return vals;
+  }
+
+  inline double now() const
+  {
+    return std::chrono::duration<double>(clock::now().time_since_epoch()).count();
+  }
+
+  void accumulate(
+      const char* name,
+      const std::vector<double>& c0,
+      const std::vector<double>& c1,
+      double dt)
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto& s = stats[name];
+    if(s.counts.empty()) s.counts.assign(specs.size(), 0.0);
+
+    s.calls++;
+    s.time += dt;
+    // counts of a region that outlived disable() are dropped
+    if(c0.size() == s.counts.size() && c1.size() == s.counts.size()) {
+      for(size_t i=0; i<s.counts.size(); i++) s.counts[i] += c1[i] - c0[i];
+    }
+  }
+
+  void clear()
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    stats.clear();
+  }
+
+};
+
+
+//--------------------------------------------------
+/// RAII counter region; accumulates counts under `name`
+class Region {
+
+  const char* name;
+  bool active;
+  double t0 = 0.0;
+  std::vector<double> c0;
+
+  public:
+
+  explicit Region(const char* name) :
+    name(name),
+    active(Counters::get().is_enabled())
+  {
+    if(active) {
+      auto& counters = Counters::get();
+      c0 = counters.read();
+      t0 = counters.now();
+    }
+  }
+
+  ~Region()
+  {
+    if(active) {
+      auto& counters = Counters::get();
+      const double t1 = counters.now();
+      counters.accumulate(name, c0, counters.read(), t1 - t0);
+    }
+  }
+
+  Region(const Region&) = delete;
+  Region& operator=(const Region&) = delete;
+};
+
+} // end of namespace perf
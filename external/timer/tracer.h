@@ -0,0 +1,352 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "perfcounters.h"
+
+// Timeline tracer for simulation steps.
+//
+// Records complete events (begin timestamp + duration) into per-thread ring
+// buffers and dumps them as Chrome trace-event JSON, one file per MPI rank.
+// Files can be merged with pytools.trace.merge_traces() and opened in
+// Perfetto (ui.perfetto.dev) or chrome://tracing.
+//
+// Tracing is switched off by default and is toggled at runtime; a disabled
+// trace::Scope costs one relaxed atomic load. The same scope doubles as a
+// hardware counter region (see perfcounters.h) when counting is enabled.
+//
+// Usage:
+//
+//   trace::Scope trace_scope(__PRETTY_FUNCTION__, "pic");
+//
+// records an event spanning from the construction to the end of the
+// enclosing C++ scope. Names must outlive the tracer (string literals or
+// function names); dynamic names are interned with Tracer::intern().
+
+namespace trace {
+
+// split a __PRETTY_FUNCTION__ string into a short qualified name and its
+// template parameters, e.g.,
+//  "void pic::BorisPusher<D, V>::push_container(...) [with long unsigned int D = 3; ...]"
+//  -> {"pic::BorisPusher<D, V>::push_container", "long unsigned int D = 3; ..."}
+inline std::pair<std::string, std::string> split_signature(const std::string& sig)
+{
+  std::string tparams;
+  auto w = sig.find(" [with ");
+  if(w != std::string::npos) tparams = sig.substr(w+7, sig.size() - w - 8);
+
+  auto p = sig.find('(');
+  if(p == std::string::npos) return {sig, tparams};
+
+  // walk backwards to the first space outside of template brackets
+  int depth = 0;
+  size_t beg = 0;
+  for(size_t i=p; i-- > 0; ) {
+    if(sig[i] == '>') depth++;
+    if(sig[i] == '<') depth--;
+    if(sig[i] == ' ' && depth == 0) { beg = i+1; break; }
+  }
+
+  return {sig.substr(beg, p - beg), tparams};
+}
+
+
+/// single complete ("ph":"X") event
+struct Event {
+  const char* name = nullptr;
+  const char* cat  = nullptr;
+  int64_t ts  = 0; // begin time (ns since tracer epoch)
+  int64_t dur = 0; // duration (ns)
+};
+
+
+/// fixed-size ring buffer owned by one thread; oldest events are overwritten
+class RingBuffer {
+
+  public:
+
+  std::vector<Event> events;
+  size_t head  = 0; // next write position
+  size_t count = 0; // number of valid events
+  int tid;
+
+  RingBuffer(size_t capacity, int tid) :
+    events(capacity),
+    tid(tid)
+  { }
+
+  inline void push(const Event& e)
+  {
+    events[head] = e;
+    head = (head + 1) % events.size();
+    if(count < events.size()) count++;
+  }
+
+  // loop over events from oldest to newest
+  template<typename F>
+  inline void for_each(F&& fun) const
+  {
+    const size_t cap = events.size();
+    const size_t beg = (head + cap - count) % cap;
+    for(size_t i=0; i<count; i++) fun( events[(beg + i) % cap] );
+  }
+
+  void resize(size_t capacity)
+  {
+    events.assign(capacity, Event());
+    head  = 0;
+    count = 0;
+  }
+
+  void clear()
+  {
+    head  = 0;
+    count = 0;
+  }
+
+};
+
+
+//--------------------------------------------------
+class Tracer {
+
+  using clock = std::chrono::steady_clock;
+
+  // an open begin()/end() pair issued outside of a C++ scope (e.g., from python)
+  struct OpenEvent {
+    const char* name;
+    const char* cat;
+    int64_t ts;
+  };
+
+  std::atomic<bool> enabled{false};
+
+  // guards buffers and interned names
+  std::mutex mtx;
+
+  // buffers are never freed while the tracer lives since threads keep
+  // a thread_local pointer to them
+  std::vector<std::unique_ptr<RingBuffer>> buffers;
+
+  // node-based storage keeps c_str() pointers stable
+  std::unordered_set<std::string> names;
+
+  clock::time_point epoch = clock::now();
+
+  Tracer() = default;
+
+  public:
+
+  /// number of events stored per thread before the oldest are overwritten
+  size_t capacity = 1 << 16;
+
+  Tracer(const Tracer&) = delete;
+  Tracer& operator=(const Tracer&) = delete;
+
+  static Tracer& get()
+  {
+    static Tracer tracer;
+    return tracer;
+  }
+
+  inline bool is_enabled() const
+  {
+    return enabled.load(std::memory_order_relaxed);
+  }
+
+  void enable()  { enabled.store(true,  std::memory_order_relaxed); }
+  void disable() { enabled.store(false, std::memory_order_relaxed); }
+
+  /// reset time origin; call right after an MPI barrier to align ranks
+  void reset_epoch() { epoch = clock::now(); }
+
+  inline int64_t now() const
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - epoch).count();
+  }
+
+  /// get (and create on first call) the ring buffer of the calling thread
+  RingBuffer& local_buffer()
+  {
+    thread_local RingBuffer* buf = nullptr;
+    if(buf == nullptr) {
+      std::lock_guard<std::mutex> lock(mtx);
+      buffers.push_back( std::make_unique<RingBuffer>(capacity, buffers.size()) );
+      buf = buffers.back().get();
+    }
+    return *buf;
+  }
+
+  inline void record(const char* name, const char* cat, int64_t ts, int64_t dur)
+  {
+    local_buffer().push( {name, cat, ts, dur} );
+  }
+
+  /// return a pointer to a persistent copy of the string
+  const char* intern(const std::string& str)
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    return names.insert(str).first->c_str();
+  }
+
+  //--------------------------------------------------
+  // begin/end interface for events that do not map to a C++ scope
+
+  void begin(const std::string& name, const std::string& cat)
+  {
+    if(!is_enabled()) return;
+    open_events().push_back( {intern(name), intern(cat), now()} );
+  }
+
+  void end()
+  {
+    auto& stack = open_events();
+    if(stack.empty()) return;
+
+    const auto e = stack.back();
+    stack.pop_back();
+
+    if(is_enabled()) record(e.name, e.cat, e.ts, now() - e.ts);
+  }
+
+  //--------------------------------------------------
+  void set_capacity(size_t cap)
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    capacity = cap;
+    for(auto& buf : buffers) buf->resize(cap);
+  }
+
+  void clear()
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    for(auto& buf : buffers) buf->clear();
+  }
+
+  size_t size()
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    size_t n = 0;
+    for(auto& buf : buffers) n += buf->count;
+    return n;
+  }
+
+  /// write events as Chrome trace-event JSON; pid is set to MPI rank
+  //
+  // NOTE: not thread safe against concurrent recording; call between steps
+  void dump(const std::string& fname, int rank)
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    std::ofstream out(fname);
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+
+    // process and thread labels
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << rank
+        << ",\"tid\":0,\"args\":{\"name\":\"rank " << rank << "\"}}";
+
+    for(auto& buf : buffers) {
+      out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << rank
+          << ",\"tid\":" << buf->tid
+          << ",\"args\":{\"name\":\"thread " << buf->tid << "\"}}";
+    }
+
+    // cache of shortened names
+    std::unordered_map<const char*, std::pair<std::string, std::string>> labels;
+
+    out.precision(3);
+    out << std::fixed;
+
+    for(auto& buf : buffers) {
+      buf->for_each([&](const Event& e){
+
+        auto it = labels.find(e.name);
+        if(it == labels.end()) it = labels.emplace(e.name, split_signature(e.name)).first;
+
+        // timestamps are in microseconds
+        out << ",\n{\"name\":\"" << escape(it->second.first)
+            << "\",\"cat\":\""   << escape(e.cat)
+            << "\",\"ph\":\"X\",\"pid\":" << rank
+            << ",\"tid\":"  << buf->tid
+            << ",\"ts\":"   << 1.0e-3*e.ts
+            << ",\"dur\":"  << 1.0e-3*e.dur;
+
+        if(!it->second.second.empty())
+          out << ",\"args\":{\"tparams\":\"" << escape(it->second.second) << "\"}";
+
+        out << "}";
+      });
+    }
+
+    out << "\n]}\n";
+  }
+
+  private:
+
+  std::vector<OpenEvent>& open_events()
+  {
+    thread_local std::vector<OpenEvent> stack;
+    return stack;
+  }
+
+  static std::string escape(const std::string& str)
+  {
+    std::string ret;
+    ret.reserve(str.size());
+    for(char c : str) {
+      if(c == '"' || c == '\\') ret += '\\';
+      ret += c;
+    }
+    return ret;
+  }
+
+};
+
+
+//--------------------------------------------------
+/// RAII event spanning the lifetime of the object
+class Scope {
+
+  const char* name;
+  const char* cat;
+  int64_t t0 = 0;
+  bool active;
+
+  // engaged only while hardware counting is enabled
+  std::optional<perf::Region> region;
+
+  public:
+
+  Scope(const char* name, const char* cat = "kernel") :
+    name(name),
+    cat(cat),
+    active(Tracer::get().is_enabled())
+  {
+    if(perf::Counters::get().is_enabled()) region.emplace(name);
+    if(active) t0 = Tracer::get().now();
+  }
+
+  ~Scope()
+  {
+    if(active) {
+      auto& tracer = Tracer::get();
+      tracer.record(name, cat, t0, tracer.now() - t0);
+    }
+  }
+
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+};
+
+} // end of namespace trace
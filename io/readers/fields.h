@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+
 #include "io/namer.h"
 #include "core/emf/tile.h"
 
@@ -71,16 +73,24 @@ h5io::Reader::read(
   arr9  << gr["bz"];
   arr10 << gr["rho"];
 
-  gs.jx.unserialize(arr1,   Nx, Ny, Nz);
-  gs.jy.unserialize(arr2,   Nx, Ny, Nz);
-  gs.jz.unserialize(arr3,   Nx, Ny, Nz);
+  // released components are written as zeros; they stay released unless
+  // the tile already carries them or the file has non-zero values
+  auto nonzero = [](const std::vector<float>& a) { 
+    return std::any_of(a.begin(), a.end(), [](float v){ return v != 0.0f; }); 
+  };
+
+  if(gs.has_currents() || nonzero(arr1) || nonzero(arr2) || nonzero(arr3)) {
+    gs.jx.unserialize(arr1,   Nx, Ny, Nz);
+    gs.jy.unserialize(arr2,   Nx, Ny, Nz);
+    gs.jz.unserialize(arr3,   Nx, Ny, Nz);
+  }
   gs.ex.unserialize(arr4,   Nx, Ny, Nz);
   gs.ey.unserialize(arr5,   Nx, Ny, Nz);
   gs.ez.unserialize(arr6,   Nx, Ny, Nz);
   gs.bx.unserialize(arr7,   Nx, Ny, Nz);
   gs.by.unserialize(arr8,   Nx, Ny, Nz);
   gs.bz.unserialize(arr9,   Nx, Ny, Nz);
-  gs.rho.unserialize(arr10, Nx, Ny, Nz);
+  if(gs.has_rho() || nonzero(arr10)) gs.rho.unserialize(arr10, Nx, Ny, Nz);
 
   return true;
 }
@@ -2,6 +2,7 @@
 
 #include "io/snapshots/field_slices.h"
 #include "external/ezh5/src/ezh5.hpp"
+#include "external/timer/tracer.h"
 #include "core/emf/tile.h"
 
 
@@ -32,6 +33,7 @@ void h5io::FieldSliceWriter::read_tiles(
   for(auto cid : grid.get_local_tiles() ){
     auto& tile = dynamic_cast<emf::Tile<3>&>(grid.get_tile( cid ));
     auto& gs = tile.get_grids();
+    const bool has_j = gs.has_currents(), has_rho = gs.has_rho(); // released ones read as zeros
 
     // get arrays
     auto index = expand_indices( &tile );
@@ -80,10 +82,10 @@ void h5io::FieldSliceWriter::read_tiles(
       for(int jstride=0; jstride < stride; jstride++) 
       for(int is=0; is<nxt; is++) 
       for(int istride=0; istride < stride; istride++) {
-        jx(i0+is, j0+js, 0) += gs.jx( is*stride+istride, js*stride+jstride, I);
-        jy(i0+is, j0+js, 0) += gs.jy( is*stride+istride, js*stride+jstride, I);
-        jz(i0+is, j0+js, 0) += gs.jz( is*stride+istride, js*stride+jstride, I);
-        rh(i0+is, j0+js, 0) += gs.rho(is*stride+istride, js*stride+jstride, I);
+        if(has_j) jx(i0+is, j0+js, 0) += gs.jx( is*stride+istride, js*stride+jstride, I);
+        if(has_j) jy(i0+is, j0+js, 0) += gs.jy( is*stride+istride, js*stride+jstride, I);
+        if(has_j) jz(i0+is, j0+js, 0) += gs.jz( is*stride+istride, js*stride+jstride, I);
+        if(has_rho) rh(i0+is, j0+js, 0) += gs.rho(is*stride+istride, js*stride+jstride, I);
       }
 
 
@@ -112,10 +114,10 @@ void h5io::FieldSliceWriter::read_tiles(
       for(int kstride=0; kstride < stride; kstride++) 
       for(int is=0; is<nxt; is++) 
       for(int istride=0; istride < stride; istride++) {
-        jx(i0+is, k0+ks, 0) += gs.jx( is*stride+istride, I, ks*stride+kstride);
-        jy(i0+is, k0+ks, 0) += gs.jy( is*stride+istride, I, ks*stride+kstride);
-        jz(i0+is, k0+ks, 0) += gs.jz( is*stride+istride, I, ks*stride+kstride);
-        rh(i0+is, k0+ks, 0) += gs.rho(is*stride+istride, I, ks*stride+kstride);
+        if(has_j) jx(i0+is, k0+ks, 0) += gs.jx( is*stride+istride, I, ks*stride+kstride);
+        if(has_j) jy(i0+is, k0+ks, 0) += gs.jy( is*stride+istride, I, ks*stride+kstride);
+        if(has_j) jz(i0+is, k0+ks, 0) += gs.jz( is*stride+istride, I, ks*stride+kstride);
+        if(has_rho) rh(i0+is, k0+ks, 0) += gs.rho(is*stride+istride, I, ks*stride+kstride);
       }
 
     // y-z plane, x = 0
@@ -143,10 +145,10 @@ void h5io::FieldSliceWriter::read_tiles(
       for(int kstride=0; kstride < stride; kstride++) 
       for(int js=0; js<nyt; js++) 
       for(int jstride=0; jstride < stride; jstride++) {
-        jx(j0+js, k0+ks, 0) += gs.jx( I, js*stride+jstride, ks*stride+kstride);
-        jy(j0+js, k0+ks, 0) += gs.jy( I, js*stride+jstride, ks*stride+kstride);
-        jz(j0+js, k0+ks, 0) += gs.jz( I, js*stride+jstride, ks*stride+kstride);
-        rh(j0+js, k0+ks, 0) += gs.rho(I, js*stride+jstride, ks*stride+kstride);
+        if(has_j) jx(j0+js, k0+ks, 0) += gs.jx( I, js*stride+jstride, ks*stride+kstride);
+        if(has_j) jy(j0+js, k0+ks, 0) += gs.jy( I, js*stride+jstride, ks*stride+kstride);
+        if(has_j) jz(j0+js, k0+ks, 0) += gs.jz( I, js*stride+jstride, ks*stride+kstride);
+        if(has_rho) rh(j0+js, k0+ks, 0) += gs.rho(I, js*stride+jstride, ks*stride+kstride);
       }
     }
   } // tiles
@@ -155,6 +157,8 @@ void h5io::FieldSliceWriter::read_tiles(
 bool h5io::FieldSliceWriter::write(
     corgi::Grid<3>& grid, int lap)
 {
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "io");
+
   read_tiles(grid);
   mpi_reduce_snapshots(grid);
 
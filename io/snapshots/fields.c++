@@ -2,6 +2,7 @@
 
 #include "io/snapshots/fields.h"
 #include "external/ezh5/src/ezh5.hpp"
+#include "external/timer/tracer.h"
 #include "core/emf/tile.h"
 
 
@@ -34,6 +35,7 @@ inline void h5io::FieldsWriter<1>::read_tiles(
   for(auto cid : grid.get_local_tiles() ){
     auto& tile = dynamic_cast<emf::Tile<1>&>(grid.get_tile( cid ));
     auto& gs = tile.get_grids();
+    const bool has_j = gs.has_currents(), has_rho = gs.has_rho(); // released ones read as zeros
 
     // get arrays
     auto index = expand_indices( &tile );
@@ -69,10 +71,10 @@ inline void h5io::FieldsWriter<1>::read_tiles(
     // densities; these quantities we average over the volume
     for(int is=0; is<nxt; is++) 
     for(int istride=0; istride < stride; istride++) {
-      jx(i0+is, j0+js, k0+ks) += gs.jx( is*stride+istride, js*stride+jstride, ks*stride+kstride);
-      jy(i0+is, j0+js, k0+ks) += gs.jy( is*stride+istride, js*stride+jstride, ks*stride+kstride);
-      jz(i0+is, j0+js, k0+ks) += gs.jz( is*stride+istride, js*stride+jstride, ks*stride+kstride);
-      rh(i0+is, j0+js, k0+ks) += gs.rho(is*stride+istride, js*stride+jstride, ks*stride+kstride);
+      if(has_j) jx(i0+is, j0+js, k0+ks) += gs.jx( is*stride+istride, js*stride+jstride, ks*stride+kstride);
+      if(has_j) jy(i0+is, j0+js, k0+ks) += gs.jy( is*stride+istride, js*stride+jstride, ks*stride+kstride);
+      if(has_j) jz(i0+is, j0+js, k0+ks) += gs.jz( is*stride+istride, js*stride+jstride, ks*stride+kstride);
+      if(has_rho) rh(i0+is, j0+js, k0+ks) += gs.rho(is*stride+istride, js*stride+jstride, ks*stride+kstride);
     }
 
   } // tiles
@@ -104,6 +106,7 @@ inline void h5io::FieldsWriter<2>::read_tiles(
   for(auto cid : grid.get_local_tiles() ){
     auto& tile = dynamic_cast<emf::Tile<2>&>(grid.get_tile( cid ));
     auto& gs = tile.get_grids();
+    const bool has_j = gs.has_currents(), has_rho = gs.has_rho(); // released ones read as zeros
 
     // get arrays
     auto index = expand_indices( &tile );
@@ -142,10 +145,10 @@ inline void h5io::FieldsWriter<2>::read_tiles(
 
           // densities; these quantities we need to integrate over stride
           for(int istride=0; istride < stride; istride++) {
-            jx(i0+is, j0+js, k0+ks) += gs.jx( is*stride+istride, js*stride+jstride, ks*stride+kstride);
-            jy(i0+is, j0+js, k0+ks) += gs.jy( is*stride+istride, js*stride+jstride, ks*stride+kstride);
-            jz(i0+is, j0+js, k0+ks) += gs.jz( is*stride+istride, js*stride+jstride, ks*stride+kstride);
-            rh(i0+is, j0+js, k0+ks) += gs.rho(is*stride+istride, js*stride+jstride, ks*stride+kstride);
+            if(has_j) jx(i0+is, j0+js, k0+ks) += gs.jx( is*stride+istride, js*stride+jstride, ks*stride+kstride);
+            if(has_j) jy(i0+is, j0+js, k0+ks) += gs.jy( is*stride+istride, js*stride+jstride, ks*stride+kstride);
+            if(has_j) jz(i0+is, j0+js, k0+ks) += gs.jz( is*stride+istride, js*stride+jstride, ks*stride+kstride);
+            if(has_rho) rh(i0+is, j0+js, k0+ks) += gs.rho(is*stride+istride, js*stride+jstride, ks*stride+kstride);
           }
 
         }
@@ -181,6 +184,7 @@ inline void h5io::FieldsWriter<3>::read_tiles(
   for(auto cid : grid.get_local_tiles() ){
     auto& tile = dynamic_cast<emf::Tile<3>&>(grid.get_tile( cid ));
     auto& gs = tile.get_grids();
+    const bool has_j = gs.has_currents(), has_rho = gs.has_rho(); // released ones read as zeros
 
     // get arrays
     auto index = expand_indices( &tile );
@@ -222,10 +226,10 @@ inline void h5io::FieldsWriter<3>::read_tiles(
     for(int jstride=0; jstride < stride; jstride++) 
     for(int is=0; is<nxt; is++) 
     for(int istride=0; istride < stride; istride++) {
-      jx(i0+is, j0+js, k0+ks) += gs.jx( is*stride+istride, js*stride+jstride, ks*stride+kstride);
-      jy(i0+is, j0+js, k0+ks) += gs.jy( is*stride+istride, js*stride+jstride, ks*stride+kstride);
-      jz(i0+is, j0+js, k0+ks) += gs.jz( is*stride+istride, js*stride+jstride, ks*stride+kstride);
-      rh(i0+is, j0+js, k0+ks) += gs.rho(is*stride+istride, js*stride+jstride, ks*stride+kstride);
+      if(has_j) jx(i0+is, j0+js, k0+ks) += gs.jx( is*stride+istride, js*stride+jstride, ks*stride+kstride);
+      if(has_j) jy(i0+is, j0+js, k0+ks) += gs.jy( is*stride+istride, js*stride+jstride, ks*stride+kstride);
+      if(has_j) jz(i0+is, j0+js, k0+ks) += gs.jz( is*stride+istride, js*stride+jstride, ks*stride+kstride);
+      if(has_rho) rh(i0+is, j0+js, k0+ks) += gs.rho(is*stride+istride, js*stride+jstride, ks*stride+kstride);
     }
 
   } // tiles
@@ -235,6 +239,8 @@ template<size_t D>
 inline bool h5io::FieldsWriter<D>::write(
     corgi::Grid<D>& grid, int lap)
 {
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "io");
+
   read_tiles(grid);
   mpi_reduce_snapshots(grid);
 
@@ -2,6 +2,7 @@
 
 #include "io/snapshots/master_only_fields.h"
 #include "external/ezh5/src/ezh5.hpp"
+#include "external/timer/tracer.h"
 #include "core/emf/tile.h"
 
 
@@ -27,6 +28,7 @@ inline void h5io::MasterFieldsWriter<3>::read_tile_feature(
 {
   auto& tile = dynamic_cast<emf::Tile<3>&>(grid.get_tile( cid ));
   auto& gs = tile.get_grids();
+  const bool has_j = gs.has_currents(), has_rho = gs.has_rho(); // released ones read as zeros
     
   // clear buffer before additive variables
   sbuf[0].clear();
@@ -55,10 +57,10 @@ inline void h5io::MasterFieldsWriter<3>::read_tile_feature(
     for(int jstride=0; jstride < stride; jstride++) 
     for(int is=0; is<nxM; is++) 
     for(int istride=0; istride < stride; istride++) {
-      if(ifea == 6) sbuf[0](is, js, ks) += gs.jx( is*stride+istride, js*stride+jstride, ks*stride+kstride);
-      if(ifea == 7) sbuf[0](is, js, ks) += gs.jy( is*stride+istride, js*stride+jstride, ks*stride+kstride);
-      if(ifea == 8) sbuf[0](is, js, ks) += gs.jz( is*stride+istride, js*stride+jstride, ks*stride+kstride);
-      if(ifea == 9) sbuf[0](is, js, ks) += gs.rho(is*stride+istride, js*stride+jstride, ks*stride+kstride);
+      if(ifea == 6 && has_j) sbuf[0](is, js, ks) += gs.jx( is*stride+istride, js*stride+jstride, ks*stride+kstride);
+      if(ifea == 7 && has_j) sbuf[0](is, js, ks) += gs.jy( is*stride+istride, js*stride+jstride, ks*stride+kstride);
+      if(ifea == 8 && has_j) sbuf[0](is, js, ks) += gs.jz( is*stride+istride, js*stride+jstride, ks*stride+kstride);
+      if(ifea == 9 && has_rho) sbuf[0](is, js, ks) += gs.rho(is*stride+istride, js*stride+jstride, ks*stride+kstride);
     }
 
   }
@@ -166,6 +168,7 @@ template<>
 inline bool h5io::MasterFieldsWriter<3>::write(
     corgi::Grid<3>& grid, int lap)
 {
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "io");
 
   //--------------------------------------------------
   // allocate full array for master
@@ -2,6 +2,7 @@
 
 #include "io/snapshots/master_only_moments.h"
 #include "external/ezh5/src/ezh5.hpp"
+#include "external/timer/tracer.h"
 #include "core/pic/particle.h"
 #include "core/pic/tile.h"
 #include "tools/signum.h"
@@ -37,7 +38,10 @@ inline void h5io::MasterPicMomentsWriter<D>::read_tile_feature(
 
   // clear buffer before additive variables
   sbuf[0].clear();
-  if(ifea==0) gs.rho.clear();
+  if(ifea==0) {
+    gs.alloc_rho();
+    gs.rho.clear();
+  }
 
 
   // local variables
@@ -291,6 +295,7 @@ template<>
 inline bool h5io::MasterPicMomentsWriter<3>::write(
     corgi::Grid<3>& grid, int lap)
 {
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "io");
 
   //--------------------------------------------------
   // allocate full array for master
@@ -2,6 +2,7 @@
 
 #include "io/snapshots/pic_moments.h"
 #include "external/ezh5/src/ezh5.hpp"
+#include "external/timer/tracer.h"
 #include "core/pic/particle.h"
 #include "core/pic/tile.h"
 #include "tools/signum.h"
@@ -62,6 +63,7 @@ inline void h5io::PicMomentsWriter<D>::read_tiles(
 
     // update also gs
     auto& gs = tile.get_grids();
+    gs.alloc_rho();
     gs.rho.clear();
 
     // loop over species
@@ -215,6 +217,8 @@ template<size_t D>
 inline bool h5io::PicMomentsWriter<D>::write(
     corgi::Grid<D>& grid, int lap)
 {
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "io");
+
   read_tiles(grid);
   mpi_reduce_snapshots(grid);
 
@@ -2,6 +2,7 @@
 
 #include "io/snapshots/test_prtcls.h"
 #include "external/ezh5/src/ezh5.hpp"
+#include "external/timer/tracer.h"
 #include "core/pic/particle.h"
 #include "core/pic/tile.h"
 
@@ -303,6 +304,8 @@ template<size_t D>
 inline bool h5io::TestPrtclWriter<D>::write(
     corgi::Grid<D>& grid, int lap)
 {
+  trace::Scope trace_scope(__PRETTY_FUNCTION__, "io");
+
   read_tiles(grid);
   mpi_reduce_snapshots(grid);
 
@@ -47,9 +47,12 @@ inline void read_mesh(
   ezh5::File file(reader.fname.name, H5F_ACC_RDONLY);
 
   for(auto cid : grid.get_tile_ids() ){
-    auto& tile 
-      = dynamic_cast<vlv::Tile<D>&>(grid.get_tile( cid ));
-    reader.read(tile, file);
+    // skip tiles of other kinds (e.g., pic::GhostTile)
+    auto* tile 
+      = dynamic_cast<vlv::Tile<D>*>(&grid.get_tile( cid ));
+    if(tile == nullptr) continue;
+
+    reader.read(*tile, file);
   }
 }
 
@@ -173,9 +176,12 @@ inline void read_particles(
   ezh5::File file(reader.fname.name, H5F_ACC_RDONLY);
 
   for(auto cid : grid.get_tile_ids() ){
-    auto& tile 
-      = dynamic_cast<pic::Tile<D>&>(grid.get_tile( cid ));
-    reader.read(tile, file);
+    // ghost tiles keep no particles to restore
+    auto* tile 
+      = dynamic_cast<pic::Tile<D>*>(&grid.get_tile( cid ));
+    if(tile == nullptr) continue;
+
+    reader.read(*tile, file);
   }
 }
 
@@ -32,11 +32,14 @@ h5io::Writer::write(
   gr["Nz"] = static_cast<int>( gs.Nz );
 
   //--------------------------------------------------
-  // Yee lattice quantities
+  // Yee lattice quantities; released currents and charge density are
+  // written as zeros so that the file layout stays the same
 
-  gr["jx"] = gs.jx.serialize();
-  gr["jy"] = gs.jy.serialize();
-  gr["jz"] = gs.jz.serialize();
+  const std::vector<float> zeros(gs.Nx*gs.Ny*gs.Nz, 0.0f);
+
+  gr["jx"] = gs.has_currents() ? gs.jx.serialize() : zeros;
+  gr["jy"] = gs.has_currents() ? gs.jy.serialize() : zeros;
+  gr["jz"] = gs.has_currents() ? gs.jz.serialize() : zeros;
 
   gr["ex"] = gs.ex.serialize();
   gr["ey"] = gs.ey.serialize();
@@ -46,7 +49,7 @@ h5io::Writer::write(
   gr["by"] = gs.by.serialize();
   gr["bz"] = gs.bz.serialize();
 
-  gr["rho"] = gs.rho.serialize();
+  gr["rho"] = gs.has_rho() ? gs.rho.serialize() : zeros;
 
 
   return true;
@@ -547,6 +547,12 @@ if __name__ == "__main__":
         # --------------------------------------------------
         # move particles (only locals tiles)
 
+        # species sub-cycling; species s is pushed only every conf.subcycle[s] laps
+        # using the fields averaged over the laps in between
+        if hasattr(conf, "subcycle"):
+            sch.operate( dict(name='subcycle', solver='tile', method='set_subcycle_lap', args=[lap,], nhood='all', ) )
+            sch.operate( dict(name='subcycle', solver='tile', method='accumulate_subcycle_fields', nhood='local', ) )
+
         # interpolate fields and push particles in x and u
         sch.operate( dict(name='interp_em', solver='fintp',  method='solve', nhood='local', ) )
         sch.operate( dict(name='push',      solver='pusher', method='solve', nhood='local', args=[0]) ) # e^-
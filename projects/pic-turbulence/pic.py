@@ -275,7 +275,8 @@ if __name__ == "__main__":
 
     # --------------------------------------------------
     #filter
-    sch.flt = pyfld.Binomial2(conf.NxMesh, conf.NyMesh, conf.NzMesh)
+    sch.flt = pyfld.MultiBinomial2(conf.NxMesh, conf.NyMesh, conf.NzMesh)
+    sch.flt.npasses = conf.npasses
 
 
     # --------------------------------------------------
@@ -436,14 +437,12 @@ if __name__ == "__main__":
 
         # --------------------------------------------------
         # filter
-        for fj in range(conf.npasses):
-
-            # flt uses halo=2 padding so only every 3rd (0,1,2) pass needs update
-            if fj % 2 == 0:
-                sch.operate( dict(name='mpi_cur_flt', solver='mpi', method='j', ) )
-                sch.operate( dict(name='upd_bc',      solver='tile',method='update_boundaries',args=[grid, [0,] ], nhood='local', ) )
-                MPI.COMM_WORLD.barrier()
-            sch.operate( dict(name='filter', solver='flt', method='solve', nhood='local', ) )
+        # one current halo update per group of (up to three) passes
+        for fg in range(sch.flt.groups()):
+            sch.operate( dict(name='mpi_cur_flt', solver='mpi', method='j', ) )
+            sch.operate( dict(name='upd_bc',      solver='tile',method='update_boundaries',args=[grid, [0,] ], nhood='local', ) )
+            MPI.COMM_WORLD.barrier()
+            sch.operate( dict(name='filter', solver='flt', method='solve', args=[fg], nhood='local', ) )
 
 
         # --------------------------------------------------
@@ -17,6 +17,9 @@ from .scheduler import Scheduler
 from .terminal_plot import TerminalPlot
 from .string_manipulation import simplify_string, simplify_large_num
 from .banner import print_banner
+from . import trace
+from . import perfcounters
+from . import perfregress
 
 
 # physics modules
@@ -0,0 +1,83 @@
+# -*- coding: utf-8 -*-
+
+# Per-kernel hardware counter summary on top of pyrunko.tools.perf.
+#
+# usage:
+#   import pyrunko
+#   pyrunko.tools.perf.add_raw_event("fp_256b_packed_double", 0x10c7) # optional; arch specific
+#   pyrunko.tools.perf.enable()
+#   ... run some laps ...
+#   pytools.perfcounters.print_counters()
+#
+# Raw events whose name starts with "fp_" are summed into a FLOP estimate;
+# their multiplicity (flops per retired instruction) is given by `flops_per_event`.
+# Bytes moved are estimated from last-level cache misses x cache line size.
+
+import numpy as np
+
+
+# flops per retired instruction for the Intel FP_ARITH_INST_RETIRED family
+flops_per_event = {
+    "fp_scalar_single": 1,
+    "fp_scalar_double": 1,
+    "fp_128b_packed_double": 2,
+    "fp_128b_packed_single": 4,
+    "fp_256b_packed_double": 4,
+    "fp_256b_packed_single": 8,
+    "fp_512b_packed_double": 8,
+    "fp_512b_packed_single": 16,
+}
+
+
+def _perf():
+    import pyrunko
+    return pyrunko.tools.perf
+
+
+# derived roofline metrics of one kernel entry
+def derived_metrics(r, cache_line=64):
+    m = {}
+    m["calls"] = r["calls"]
+    m["time"] = r["time"]
+
+    cyc = r.get("cycles", 0.0)
+    ins = r.get("instructions", 0.0)
+    m["ipc"] = ins / cyc if cyc > 0 else np.nan
+
+    refs = r.get("cache_references", 0.0)
+    miss = r.get("cache_misses", 0.0)
+    m["miss_rate"] = miss / refs if refs > 0 else np.nan
+    m["bytes"] = miss * cache_line
+
+    flops = 0.0
+    has_flops = False
+    for key, val in r.items():
+        if key.startswith("fp_"):
+            flops += flops_per_event.get(key, 1) * val
+            has_flops = True
+
+    m["flops"] = flops if has_flops else np.nan
+    m["gflops"] = 1.0e-9 * flops / r["time"] if (has_flops and r["time"] > 0) else np.nan
+    m["intensity"] = flops / m["bytes"] if (has_flops and m["bytes"] > 0) else np.nan
+
+    return m
+
+
+def counters_report(cache_line=64):
+    rep = _perf().report()
+    return {name: derived_metrics(r, cache_line) for name, r in rep.items()}
+
+
+def print_counters(cache_line=64):
+    rep = counters_report(cache_line)
+
+    print("--------------------------------------------------------------------------------")
+    print("{:<50} {:>8} {:>10} {:>6} {:>6} {:>9} {:>8}".format(
+        "kernel", "calls", "time/call", "ipc", "miss%", "GFLOP/s", "AI"))
+
+    for name, m in sorted(rep.items(), key=lambda x: -x[1]["time"]):
+        tcall = m["time"] / m["calls"] if m["calls"] > 0 else 0.0
+        print("{:<50.50} {:>8d} {:>8.3f}ms {:>6.2f} {:>6.1f} {:>9.3f} {:>8.3f}".format(
+            name, int(m["calls"]), 1.0e3 * tcall, m["ipc"],
+            100.0 * m["miss_rate"], m["gflops"], m["intensity"]))
+    print("--------------------------------------------------------------------------------")
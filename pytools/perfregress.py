@@ -0,0 +1,244 @@
+# -*- coding: utf-8 -*-
+
+# Performance regression tracking on top of bin/bench-kernels.
+#
+# Every check runs the kernel benchmarks, compares each kernel against the
+# median of the last `window` entries of a json history file, and appends
+# the new results to the history. A kernel is flagged as a regression only
+# if it is slower than the baseline by more than its threshold *and* by more
+# than `nsigma` times the combined run-to-run scatter. Suspicious kernels are
+# re-measured up to `max_repeats` times before they are flagged so that a
+# single noisy sample does not fail the check.
+#
+# usage:
+#   python3 -m pytools.perfregress --exe bin/bench-kernels --history perf_history.json \
+#       --threshold 0.05 --kernel-threshold BorisPusher=0.03 --dim 3 --nx 32 --ppc 16
+#
+# The exit code is 1 if any kernel regressed. Use --no-update to compare
+# without appending to the history (e.g., on development branches).
+
+import os
+import sys
+import json
+import time
+import argparse
+import subprocess
+import statistics
+
+
+def git_commit(path="."):
+    try:
+        out = subprocess.check_output(["git", "rev-parse", "--short", "HEAD"],
+                                      cwd=path, stderr=subprocess.DEVNULL)
+        return out.decode().strip()
+    except (OSError, subprocess.CalledProcessError):
+        return "unknown"
+
+
+#--------------------------------------------------
+# running the benchmarks
+
+def run_benchmarks(exe, bench_args=(), only=None):
+    cmd = [exe] + list(bench_args)
+    if only is not None:
+        cmd += ["--only", only]
+
+    out = subprocess.check_output(cmd, stderr=subprocess.DEVNULL)
+    return json.loads(out.decode())
+
+
+# collect t_min samples per kernel from `repeats` independent executions
+def measure(exe, bench_args=(), repeats=3):
+    samples = {}
+    config = None
+
+    for r in range(repeats):
+        data = run_benchmarks(exe, bench_args)
+        config = data["config"]
+        for res in data["results"]:
+            samples.setdefault(res["name"], []).append(res["t_min"])
+
+    return config, samples
+
+
+def remeasure(exe, name, bench_args=()):
+    data = run_benchmarks(exe, bench_args, only=name)
+
+    # --only is a substring match; pick the exact kernel
+    for res in data["results"]:
+        if res["name"] == name:
+            return res["t_min"]
+    return None
+
+
+#--------------------------------------------------
+# history
+
+def load_history(fname):
+    if not os.path.exists(fname):
+        return {"runs": []}
+
+    with open(fname, "r") as f:
+        return json.load(f)
+
+
+def save_history(hist, fname):
+    with open(fname, "w") as f:
+        json.dump(hist, f, indent=1)
+
+
+def summarize(samples):
+    m = statistics.median(samples)
+    s = statistics.stdev(samples) if len(samples) > 1 else 0.0
+    return {"median": m, "std": s, "samples": samples}
+
+
+def add_run(hist, config, samples, commit=None):
+    hist["runs"].append({
+        "commit": commit if commit is not None else git_commit(),
+        "date": time.strftime("%Y-%m-%d %H:%M:%S"),
+        "config": config,
+        "kernels": {name: summarize(s) for name, s in samples.items()},
+    })
+
+
+# per-kernel baseline from the last `window` runs with an identical config
+def baseline(hist, config, window=5):
+    runs = [r for r in hist["runs"] if r["config"] == config][-window:]
+
+    base = {}
+    for run in runs:
+        for name, k in run["kernels"].items():
+            base.setdefault(name, {"medians": [], "stds": []})
+            base[name]["medians"].append(k["median"])
+            base[name]["stds"].append(k["std"])
+
+    out = {}
+    for name, b in base.items():
+        meds = b["medians"]
+
+        # scatter between runs and within runs; whichever is larger
+        s_between = statistics.stdev(meds) if len(meds) > 1 else 0.0
+        s_within = statistics.median(b["stds"])
+        out[name] = {"median": statistics.median(meds), "std": max(s_between, s_within)}
+
+    return out
+
+
+#--------------------------------------------------
+# comparison
+
+def is_regression(cur, base, threshold, nsigma=2.0):
+    diff = cur["median"] - base["median"]
+    noise = nsigma * (cur["std"]**2 + base["std"]**2)**0.5
+    return diff > threshold * base["median"] and diff > noise
+
+
+def compare(samples, base, thresholds=None, default_threshold=0.05, nsigma=2.0):
+    thresholds = thresholds if thresholds is not None else {}
+
+    report = {}
+    for name, s in samples.items():
+        if name not in base:
+            continue
+
+        cur = summarize(s)
+        b = base[name]
+        thr = thresholds.get(name, default_threshold)
+
+        report[name] = {
+            "baseline": b["median"],
+            "current": cur["median"],
+            "change": cur["median"] / b["median"] - 1.0 if b["median"] > 0 else 0.0,
+            "threshold": thr,
+            "regression": is_regression(cur, b, thr, nsigma),
+        }
+
+    return report
+
+
+def check(exe, history, bench_args=(), repeats=3, max_repeats=9, window=5,
+          thresholds=None, default_threshold=0.05, nsigma=2.0, update=True):
+
+    hist = load_history(history)
+    config, samples = measure(exe, bench_args, repeats)
+    base = baseline(hist, config, window)
+
+    report = compare(samples, base, thresholds, default_threshold, nsigma)
+
+    # variance-aware repeats: collect more samples of flagged kernels only
+    for name in [n for n, r in report.items() if r["regression"]]:
+        while len(samples[name]) < max_repeats:
+            t = remeasure(exe, name, bench_args)
+            if t is None:
+                break
+            samples[name].append(t)
+
+            r = compare({name: samples[name]}, base, thresholds, default_threshold, nsigma)
+            report[name] = r[name]
+            if not report[name]["regression"]:
+                break
+
+    if update:
+        add_run(hist, config, samples)
+        save_history(hist, history)
+
+    return report
+
+
+def print_report(report):
+    print("--------------------------------------------------------------------------------")
+    print("{:<30} {:>12} {:>12} {:>8} {:>8}".format(
+        "kernel", "base (ms)", "now (ms)", "change", "limit"))
+
+    for name, r in report.items():
+        flag = "  REGRESSION" if r["regression"] else ""
+        print("{:<30.30} {:>12.4f} {:>12.4f} {:>+7.1f}% {:>7.1f}%{}".format(
+            name, 1.0e3 * r["baseline"], 1.0e3 * r["current"],
+            100.0 * r["change"], 100.0 * r["threshold"], flag))
+    print("--------------------------------------------------------------------------------")
+
+
+#--------------------------------------------------
+def parse_thresholds(items):
+    thr = {}
+    for item in items:
+        name, val = item.split("=")
+        thr[name] = float(val)
+    return thr
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="runko kernel performance regression check")
+    parser.add_argument("--exe", default="bin/bench-kernels")
+    parser.add_argument("--history", default="perf_history.json")
+    parser.add_argument("--threshold", type=float, default=0.05,
+                        help="default allowed slowdown (fraction)")
+    parser.add_argument("--kernel-threshold", action="append", default=[],
+                        help="per-kernel limit as name=fraction; can be repeated")
+    parser.add_argument("--repeats", type=int, default=3)
+    parser.add_argument("--max-repeats", type=int, default=9)
+    parser.add_argument("--window", type=int, default=5)
+    parser.add_argument("--nsigma", type=float, default=2.0)
+    parser.add_argument("--no-update", action="store_true")
+    args, bench_args = parser.parse_known_args()
+
+    report = check(args.exe, args.history, bench_args,
+                   repeats=args.repeats,
+                   max_repeats=args.max_repeats,
+                   window=args.window,
+                   thresholds=parse_thresholds(args.kernel_threshold),
+                   default_threshold=args.threshold,
+                   nsigma=args.nsigma,
+                   update=not args.no_update)
+
+    if len(report) == 0:
+        print("perfregress: no baseline for this configuration yet; results stored in {}".format(args.history))
+        sys.exit(0)
+
+    print_report(report)
+
+    nreg = sum(r["regression"] for r in report.values())
+    if nreg > 0:
+        print("perfregress: {} kernel(s) regressed".format(nreg))
+        sys.exit(1)
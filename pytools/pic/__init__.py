@@ -1,6 +1,7 @@
 # -*- coding: utf-8 -*- 
 
 from .tile_initialization import initialize_tile
+from .tile_initialization import initialize_ghost_tile
 from .tile_initialization import load_tiles
 from .tile_initialization import load_virtual_tiles
 
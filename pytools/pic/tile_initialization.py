@@ -62,6 +62,10 @@ def initialize_tile(tile, indx, n, conf):
             container.q = -conf.qp
             container.m = np.abs(conf.mp)
 
+        # species sub-cycling; species is pushed every subcycle[sps] laps
+        if hasattr(conf, "subcycle"):
+            container.subcycle = conf.subcycle[sps]
+
         # reserve memory for particles
         Nprtcls = conf.NxMesh * conf.NyMesh * conf.NzMesh * conf.ppc
         container.reserve(Nprtcls)
@@ -69,6 +73,13 @@ def initialize_tile(tile, indx, n, conf):
         tile.set_container(container)
 
     # set bounding box of the tile
+    set_tile_bounds(tile, indx, conf)
+
+    return
+
+
+def set_tile_bounds(tile, indx, conf):
+
     mins = ind2loc(indx, (0, 0, 0), conf)
     maxs = ind2loc(indx, (conf.NxMesh, conf.NyMesh, conf.NzMesh), conf)
 
@@ -87,8 +98,21 @@ def initialize_tile(tile, indx, n, conf):
     return
 
 
+# ghost tiles carry no particle containers; only fields and particle messages
+def initialize_ghost_tile(tile, indx, n, conf):
+    tile.cfl = conf.cfl
+    set_tile_bounds(tile, indx, conf)
+
+    return
+
+
 # load virtual tiles
-def load_virtual_tiles(n, conf):
+#
+# With ghost=True the virtual tiles are GhostTile objects that only keep the
+# fields and the received particle messages; tile routines that need full
+# particle containers (e.g., setting container.type) must then loop over
+# the local tiles only.
+def load_virtual_tiles(n, conf, ghost=False):
 
     for cid in n.get_virtual_tiles():
         tile_orig = n.get_tile(cid)
@@ -100,27 +124,35 @@ def load_virtual_tiles(n, conf):
 
         if conf.threeD:
             i,j,k = ind
-            tile = pypic.threeD.Tile(conf.NxMesh, conf.NyMesh, conf.NzMesh)
-
-            n.add_tile(tile, ind) 
-            tile.load_metainfo(tile_orig.communication)
-            initialize_tile(tile, (i,j,k), n, conf)
+            if ghost:
+                tile = pypic.threeD.GhostTile(conf.NxMesh, conf.NyMesh, conf.NzMesh, conf.Nspecies)
+            else:
+                tile = pypic.threeD.Tile(conf.NxMesh, conf.NyMesh, conf.NzMesh)
+            indx = (i,j,k)
 
         elif conf.twoD:
             i,j = ind
-            tile = pypic.twoD.Tile(conf.NxMesh, conf.NyMesh, conf.NzMesh)
-
-            n.add_tile(tile, ind) 
-            tile.load_metainfo(tile_orig.communication)
-            initialize_tile(tile, (i,j,0), n, conf)
+            if ghost:
+                tile = pypic.twoD.GhostTile(conf.NxMesh, conf.NyMesh, conf.NzMesh, conf.Nspecies)
+            else:
+                tile = pypic.twoD.Tile(conf.NxMesh, conf.NyMesh, conf.NzMesh)
+            indx = (i,j,0)
         
         elif conf.oneD:
             i, = ind
-            tile = pypic.oneD.Tile(conf.NxMesh, conf.NyMesh, conf.NzMesh)
-
-            n.add_tile(tile, ind) 
-            tile.load_metainfo(tile_orig.communication)
-            initialize_tile(tile, (i,0,0), n, conf)
+            if ghost:
+                tile = pypic.oneD.GhostTile(conf.NxMesh, conf.NyMesh, conf.NzMesh, conf.Nspecies)
+            else:
+                tile = pypic.oneD.Tile(conf.NxMesh, conf.NyMesh, conf.NzMesh)
+            indx = (i,0,0)
+
+        n.add_tile(tile, ind) 
+        tile.load_metainfo(tile_orig.communication)
+
+        if ghost:
+            initialize_ghost_tile(tile, indx, n, conf)
+        else:
+            initialize_tile(tile, indx, n, conf)
 
     return 
 
@@ -30,6 +30,20 @@ class Scheduler:
 
         self.debug = False # debug mode
 
+        # record stage timeline into pyrunko.tools.trace; see pytools/trace.py
+        self.trace = False
+        self.tracer = None
+
+    # start timeline tracing of all operations
+    def enable_tracing(self, capacity=None):
+        pytools.trace.start_tracing(MPI.COMM_WORLD, capacity)
+        self.tracer = pytools.trace._tracer()
+        self.trace = True
+
+    # write per-rank trace-event json file
+    def dump_trace(self, prefix):
+        return pytools.trace.dump_trace(prefix, self.rank)
+
     # swithc from all-in mode to task mode
     def switch_to_task_mode(self,):
         self.mpi_task_mode = True
@@ -94,6 +108,8 @@ class Scheduler:
     
             # actual loop
             t1 = self.timer.start_comp(op['name'])
+            if self.trace: self.tracer.begin(op['name'], 'stage')
+
             for tile in tile_iterator(self.grid):
     
                 # skip-non active non-boundary tiles
@@ -105,6 +121,7 @@ class Scheduler:
                 method = getattr(tile, op['method'])
                 method(*op['args'])
     
+            if self.trace: self.tracer.end()
             self.timer.stop_comp(t1)
     
         #-------------------------------------------------- 
@@ -119,9 +136,26 @@ class Scheduler:
     
             t1 = self.timer.start_comp(op['name'])
     
-            self.grid.send_data(mpid)
-            self.grid.recv_data(mpid)
-            self.grid.wait_data(mpid)
+            if self.trace:
+                self.tracer.begin(op['name'], 'stage')
+
+                self.tracer.begin('send_data', 'mpi')
+                self.grid.send_data(mpid)
+                self.tracer.end()
+
+                self.tracer.begin('recv_data', 'mpi')
+                self.grid.recv_data(mpid)
+                self.tracer.end()
+
+                self.tracer.begin('wait_data', 'mpi')
+                self.grid.wait_data(mpid)
+                self.tracer.end()
+
+                self.tracer.end()
+            else:
+                self.grid.send_data(mpid)
+                self.grid.recv_data(mpid)
+                self.grid.wait_data(mpid)
     
             self.timer.stop_comp(t1)
     
@@ -134,6 +168,7 @@ class Scheduler:
     
             # actual loop
             t1 = self.timer.start_comp(op['name'])
+            if self.trace: self.tracer.begin(op['name'], 'stage')
     
             for tile in tile_iterator(self.grid):
     
@@ -146,5 +181,6 @@ class Scheduler:
                 single_args = [tile] + op['args']
                 method(*single_args)
     
+            if self.trace: self.tracer.end()
             self.timer.stop_comp(t1)
     
@@ -0,0 +1,73 @@
+# -*- coding: utf-8 -*-
+
+# Timeline tracing helpers on top of pyrunko.tools.trace.
+#
+# Each rank records begin/end events of scheduler stages, tile kernels, MPI
+# communication, and I/O into per-thread ring buffers. Traces are dumped
+# per rank as Chrome trace-event json files that are merged into one file
+# and viewed in Perfetto (ui.perfetto.dev) or chrome://tracing.
+#
+# usage:
+#   pytools.trace.start_tracing(comm)          # before the main loop
+#   ...
+#   pytools.trace.dump_trace(conf.outdir, rank) # e.g., at the end of the run
+#
+# merging (offline):
+#   python3 -m pytools.trace merged.json outdir/trace_*.json
+
+import os
+import sys
+import json
+
+
+def _tracer():
+    import pyrunko
+    return pyrunko.tools.trace
+
+
+def start_tracing(comm=None, capacity=None):
+    tr = _tracer()
+
+    if capacity is not None:
+        tr.set_capacity(capacity)
+
+    # align time origins of all ranks
+    if comm is not None:
+        comm.Barrier()
+    tr.reset_epoch()
+    tr.enable()
+
+
+def stop_tracing():
+    _tracer().disable()
+
+
+def trace_filename(prefix, rank):
+    return os.path.join(prefix, "trace_{}.json".format(rank))
+
+
+def dump_trace(prefix, rank):
+    fname = trace_filename(prefix, rank)
+    _tracer().dump(fname, rank)
+    return fname
+
+
+def merge_traces(fnames, out):
+    events = []
+    for fname in fnames:
+        with open(fname, "r") as f:
+            events += json.load(f)["traceEvents"]
+
+    with open(out, "w") as f:
+        json.dump({"displayTimeUnit": "ns", "traceEvents": events}, f)
+
+    return len(events)
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 3:
+        print("usage: python3 -m pytools.trace merged.json trace_0.json trace_1.json ...")
+        sys.exit(1)
+
+    n = merge_traces(sys.argv[2:], sys.argv[1])
+    print("trace: merged {} events from {} files into {}".format(n, len(sys.argv) - 2, sys.argv[1]))
@@ -15,6 +15,9 @@ import pyrunko.pic as pypic
 import pyrunko.tools as pytools
 import pyrunko.emf as pyfields
 
+# spectral filter is only built with fftw (cmake -DRUNKO_FFTW=ON)
+has_fourier = hasattr(pyfields.twoD, "Fourier")
+
 
 def const_field(x, y, z):
     return 1.0, 2.0, 3.0
@@ -40,6 +43,89 @@ def insert_em_tile(tile, conf, ffunc):
                 gs.jz[l, m, n] = valz
 
 
+def rough_field(x, y, z):
+    return (
+        np.sin(0.3 * x * x + 0.7 * y + 1.3 * z),
+        np.cos(0.5 * x + 0.2 * y * y - z),
+        np.sin(x * y + 0.4 * z * z),
+    )
+
+
+# periodic grid of tiles with rough currents in global cell coordinates
+def periodic_grid(conf):
+    if conf.threeD:
+        grid = pycorgi.threeD.Grid(conf.Nx, conf.Ny, conf.Nz)
+        grid.set_grid_lims(
+            0.0, conf.Nx * conf.NxMesh,
+            0.0, conf.Ny * conf.NyMesh,
+            0.0, conf.Nz * conf.NzMesh)
+    else:
+        grid = pycorgi.twoD.Grid(conf.Nx, conf.Ny)
+        grid.set_grid_lims(0.0, conf.Nx * conf.NxMesh, 0.0, conf.Ny * conf.NyMesh)
+
+    for i in range(conf.Nx):
+        for j in range(conf.Ny):
+            for k in range(conf.Nz if conf.threeD else 1):
+                if conf.threeD:
+                    tile = pyfields.threeD.Tile(conf.NxMesh, conf.NyMesh, conf.NzMesh)
+                    grid.add_tile(tile, (i, j, k))
+                else:
+                    tile = pyfields.twoD.Tile(conf.NxMesh, conf.NyMesh, conf.NzMesh)
+                    grid.add_tile(tile, (i, j))
+
+                insert_em_tile(tile, conf, lambda l, m, n: rough_field(
+                    i * conf.NxMesh + l, j * conf.NyMesh + m, k * conf.NzMesh + n))
+    return grid
+
+
+def tiles(grid):
+    return [grid.get_tile(cid) for cid in grid.get_tile_ids()]
+
+
+# update the current halos of all tiles
+def update_currents(grid):
+    for tile in tiles(grid):
+        tile.update_boundaries(grid, [0])
+
+
+# currents of all tiles as global arrays
+def global_js(grid, conf):
+    nz = conf.Nz if conf.threeD else 1
+    shape = (conf.Nx * conf.NxMesh, conf.Ny * conf.NyMesh, nz * conf.NzMesh)
+    js = [np.zeros(shape), np.zeros(shape), np.zeros(shape)]
+
+    for tile in tiles(grid):
+        ind = list(tile.index) + [0] * (3 - len(tile.index))
+        x0, y0, z0 = ind[0] * conf.NxMesh, ind[1] * conf.NyMesh, ind[2] * conf.NzMesh
+        for c, j in enumerate(get_js(tile, conf)):
+            js[c][x0:x0 + conf.NxMesh, y0:y0 + conf.NyMesh, z0:z0 + conf.NzMesh] = j
+    return js
+
+
+# reference passes of a tile filter with halo updates in between
+def repeat_filter(flt, grid, npasses):
+    for fj in range(npasses):
+        update_currents(grid)
+        for tile in tiles(grid):
+            flt.solve(tile)
+
+
+# MultiBinomial2 with a halo update before each pass group
+def multipass_filter(flt, grid):
+    for g in range(flt.groups()):
+        update_currents(grid)
+        for tile in tiles(grid):
+            flt.solve(tile, g)
+
+
+# spectral filter padded with the neighbour tiles
+def fourier_filter(flt, grid):
+    for tile in tiles(grid):
+        flt.solve(tile, grid)
+    for tile in tiles(grid):
+        flt.commit(tile)
+
+
 # basic Conf file/class for PiC simulation testing
 class Conf:
 
@@ -153,6 +239,9 @@ class FilterTests(unittest.TestCase):
         flts.append( pyfields.twoD.General3pStrided(conf.NxMesh, conf.NyMesh, conf.NzMesh) )
         flts.append( pyfields.twoD.Binomial2Strided2(conf.NxMesh, conf.NyMesh, conf.NzMesh) )
         flts.append( pyfields.twoD.Compensator2(conf.NxMesh, conf.NyMesh, conf.NzMesh) )
+        flts.append( pyfields.twoD.MultiBinomial2(conf.NxMesh, conf.NyMesh, conf.NzMesh) )
+        if has_fourier:
+            flts.append( pyfields.twoD.Fourier(conf.NxMesh, conf.NyMesh, conf.NzMesh) )
 
 
         tile = pyfields.twoD.Tile(conf.NxMesh, conf.NyMesh, conf.NzMesh)
@@ -214,10 +303,13 @@ class FilterTests(unittest.TestCase):
 
         flts = []
         flts.append( pyfields.threeD.Binomial2(conf.NxMesh, conf.NyMesh, conf.NzMesh) )
-        #flts.append( pyfields.threeD.General3p(conf.NxMesh, conf.NyMesh, conf.NzMesh) )
-        #flts.append( pyfields.threeD.General3pStrided(conf.NxMesh, conf.NyMesh, conf.NzMesh) )
+        flts.append( pyfields.threeD.General3p(conf.NxMesh, conf.NyMesh, conf.NzMesh) )
+        flts.append( pyfields.threeD.General3pStrided(conf.NxMesh, conf.NyMesh, conf.NzMesh) )
         #flts.append( pyfields.threeD.Binomial2Strided2(conf.NxMesh, conf.NyMesh, conf.NzMesh) )
-        #flts.append( pyfields.threeD.Compensator2(conf.NxMesh, conf.NyMesh, conf.NzMesh) )
+        flts.append( pyfields.threeD.Compensator2(conf.NxMesh, conf.NyMesh, conf.NzMesh) )
+        flts.append( pyfields.threeD.MultiBinomial2(conf.NxMesh, conf.NyMesh, conf.NzMesh) )
+        if has_fourier:
+            flts.append( pyfields.threeD.Fourier(conf.NxMesh, conf.NyMesh, conf.NzMesh) )
 
 
         tile = pyfields.threeD.Tile(conf.NxMesh, conf.NyMesh, conf.NzMesh)
@@ -270,3 +362,344 @@ class FilterTests(unittest.TestCase):
         self.assertAlmostEqual(sumx, sumx1, places=5)
         self.assertAlmostEqual(sumy, sumy1, places=5)
         self.assertAlmostEqual(sumz, sumz1, places=5)
+
+    def test_separable3D(self):
+
+        conf = Conf()
+        conf.threeD = True
+        conf.NxMesh = 5
+        conf.NyMesh = 5
+        conf.NzMesh = 5
+
+        # direct [1,2,1] x [1,2,1] x [1,2,1]/64 stencil
+        w = np.array([1.0, 2.0, 1.0])
+        C3 = np.einsum("i,j,k->ijk", w, w, w) / 64.0
+
+        for flt in [
+            pyfields.threeD.Binomial2(conf.NxMesh, conf.NyMesh, conf.NzMesh),
+            pyfields.threeD.General3p(conf.NxMesh, conf.NyMesh, conf.NzMesh),
+        ]:
+            if hasattr(flt, "alpha"):
+                flt.alpha = 0.5
+
+            # impulse response gives the 27 weights around the delta
+            tile = pyfields.threeD.Tile(conf.NxMesh, conf.NyMesh, conf.NzMesh)
+            gs = tile.get_grids()
+            gs.jx[2, 2, 2] = 1.0
+            gs.jy[1, 3, 2] = 1.0
+            flt.solve(tile)
+
+            jx, jy, jz = get_js(tile, conf)
+            refx = np.zeros_like(jx)
+            refy = np.zeros_like(jy)
+            refx[1:4, 1:4, 1:4] = C3
+            refy[0:3, 2:5, 1:4] = C3
+            np.testing.assert_allclose(jx, refx, atol=1e-7)
+            np.testing.assert_allclose(jy, refy, atol=1e-7)
+            np.testing.assert_allclose(jz, 0.0, atol=1e-7)
+
+        # result of the former 27-point Binomial2<3> (times 64) on a 3^3
+        # tile with empty halos
+        conf.NxMesh = 3
+        conf.NyMesh = 3
+        conf.NzMesh = 3
+        tile = pyfields.threeD.Tile(conf.NxMesh, conf.NyMesh, conf.NzMesh)
+        insert_em_tile(tile, conf, lambda x, y, z: ((x + 2 * y + 5 * z) % 7, x * y - z, 0.0))
+
+        flt = pyfields.threeD.Binomial2(conf.NxMesh, conf.NyMesh, conf.NzMesh)
+        flt.solve(tile)
+
+        refx = np.array([
+            [[51, 111, 105], [81, 121, 111], [81, 81, 51]],
+            [[78, 145, 136], [133, 176, 145], [132, 133, 78]],
+            [[59, 89, 85], [115, 129, 89], [117, 115, 59]],
+        ]) / 64.0
+        refy = np.array([
+            [[-6, -32, -42], [0, -32, -48], [6, -16, -30]],
+            [[0, -32, -48], [32, 0, -32], [48, 32, 0]],
+            [[6, -16, -30], [48, 32, 0], [66, 64, 30]],
+        ]) / 64.0
+
+        jx, jy, jz = get_js(tile, conf)
+        np.testing.assert_allclose(jx, refx, rtol=1e-6)
+        np.testing.assert_allclose(jy, refy, rtol=1e-6, atol=1e-7)
+
+    def test_strided(self):
+
+        conf = Conf()
+        conf.twoD = True
+        conf.NxMesh = 9
+        conf.NyMesh = 9
+        conf.NzMesh = 1
+
+        # stencil points are stride-1 cells apart; stride 2 is the
+        # plain 3-point filter and stride 1 leaves the currents as is
+        alpha = 0.6
+        w = np.array([0.5 * (1.0 - alpha), alpha, 0.5 * (1.0 - alpha)])
+
+        for stride in [1, 2, 3, 4]:
+            tile = pyfields.twoD.Tile(conf.NxMesh, conf.NyMesh, conf.NzMesh)
+            gs = tile.get_grids()
+            gs.jz[4, 4, 0] = 1.0
+
+            flt = pyfields.twoD.General3pStrided(conf.NxMesh, conf.NyMesh, conf.NzMesh)
+            flt.alpha = alpha
+            flt.stride = stride
+            flt.solve(tile)
+
+            ref = np.zeros((conf.NxMesh, conf.NyMesh, conf.NzMesh))
+            s = stride - 1
+            if s == 0:
+                ref[4, 4, 0] = 1.0
+            else:
+                for a in range(3):
+                    for b in range(3):
+                        ref[4 + (a - 1) * s, 4 + (b - 1) * s, 0] = w[a] * w[b]
+
+            jx, jy, jz = get_js(tile, conf)
+            np.testing.assert_allclose(jz, ref, atol=1e-7)
+            np.testing.assert_allclose(jx, 0.0, atol=1e-7)
+
+    def test_multipass(self):
+
+        conf = Conf()
+        conf.twoD = True
+        conf.NxMesh = 12
+        conf.NyMesh = 9
+
+        tile1 = pyfields.twoD.Tile(conf.NxMesh, conf.NyMesh, conf.NzMesh)
+        tile2 = pyfields.twoD.Tile(conf.NxMesh, conf.NyMesh, conf.NzMesh)
+        insert_em_tile(tile1, conf, linear_ramp)
+        insert_em_tile(tile2, conf, linear_ramp)
+
+        flt = pyfields.twoD.MultiBinomial2(conf.NxMesh, conf.NyMesh, conf.NzMesh)
+        flt.npasses = 3
+        self.assertEqual(flt.groups(), 1)
+
+        # three passes fit into the halo of one update
+        flt.solve(tile1, 0)
+
+        flt1 = pyfields.twoD.Binomial2(conf.NxMesh, conf.NyMesh, conf.NzMesh)
+        for fj in range(3):
+            flt1.solve(tile2)
+
+        jx0, jy0, jz0 = get_js(tile1, conf)
+        jx1, jy1, jz1 = get_js(tile2, conf)
+        np.testing.assert_allclose(jx0, jx1, rtol=1e-6)
+        np.testing.assert_allclose(jy0, jy1, rtol=1e-6)
+        np.testing.assert_allclose(jz0, jz1, rtol=1e-6)
+
+        # compensator counts as a pass
+        flt.npasses = 8
+        flt.compensate = True
+        self.assertEqual(flt.groups(), 3)
+
+        # several pass groups with halo updates in between, with and without
+        # the compensator; reference is repeated Binomial2 (+ Compensator2)
+        conf = Conf()
+        conf.twoD = True
+        conf.Nx = 3
+        conf.Ny = 3
+        conf.NxMesh = 6
+        conf.NyMesh = 6
+        conf.NzMesh = 1
+        Nx, Ny, Nz = conf.NxMesh, conf.NyMesh, conf.NzMesh
+
+        for npasses, compensate, groups in [(5, False, 2), (2, True, 1), (5, True, 2)]:
+            grid0 = periodic_grid(conf)
+            grid1 = periodic_grid(conf)
+
+            repeat_filter(pyfields.twoD.Binomial2(Nx, Ny, Nz), grid0, npasses)
+            if compensate:
+                repeat_filter(pyfields.twoD.Compensator2(Nx, Ny, Nz), grid0, 1)
+
+            flt = pyfields.twoD.MultiBinomial2(Nx, Ny, Nz)
+            flt.npasses = npasses
+            flt.compensate = compensate
+            self.assertEqual(flt.groups(), groups)
+            multipass_filter(flt, grid1)
+
+            for j0, j1 in zip(global_js(grid0, conf), global_js(grid1, conf)):
+                np.testing.assert_allclose(j1, j0, atol=1e-6)
+
+    def test_multipass3D(self):
+
+        # the 3D pass groups include the compensator2<3> kernel
+        conf = Conf()
+        conf.threeD = True
+        conf.Nx = 3
+        conf.Ny = 3
+        conf.Nz = 3
+        conf.NxMesh = 4
+        conf.NyMesh = 4
+        conf.NzMesh = 4
+        Nx, Ny, Nz = conf.NxMesh, conf.NyMesh, conf.NzMesh
+
+        for npasses, compensate, groups in [(4, False, 2), (4, True, 2), (2, True, 1)]:
+            grid0 = periodic_grid(conf)
+            grid1 = periodic_grid(conf)
+
+            repeat_filter(pyfields.threeD.Binomial2(Nx, Ny, Nz), grid0, npasses)
+            if compensate:
+                repeat_filter(pyfields.threeD.Compensator2(Nx, Ny, Nz), grid0, 1)
+
+            flt = pyfields.threeD.MultiBinomial2(Nx, Ny, Nz)
+            flt.npasses = npasses
+            flt.compensate = compensate
+            self.assertEqual(flt.groups(), groups)
+            multipass_filter(flt, grid1)
+
+            for j0, j1 in zip(global_js(grid0, conf), global_js(grid1, conf)):
+                np.testing.assert_allclose(j1, j0, atol=1e-6)
+
+
+    @unittest.skipUnless(has_fourier, "built without fftw (RUNKO_FFTW)")
+    def test_fourier(self):
+
+        conf = Conf()
+        conf.twoD = True
+        conf.NxMesh = 12
+        conf.NyMesh = 9
+
+        tile1 = pyfields.twoD.Tile(conf.NxMesh, conf.NyMesh, conf.NzMesh)
+        tile2 = pyfields.twoD.Tile(conf.NxMesh, conf.NyMesh, conf.NzMesh)
+        insert_em_tile(tile1, conf, linear_ramp)
+        insert_em_tile(tile2, conf, linear_ramp)
+
+        # three binomial passes reach as far as the halo
+        flt = pyfields.twoD.Fourier(conf.NxMesh, conf.NyMesh, conf.NzMesh)
+        flt.set_kernel(pyfields.fourier_binomial(3))
+        flt.solve(tile1)
+
+        flt1 = pyfields.twoD.MultiBinomial2(conf.NxMesh, conf.NyMesh, conf.NzMesh)
+        flt1.npasses = 3
+        flt1.solve(tile2, 0)
+
+        jx0, jy0, jz0 = get_js(tile1, conf)
+        jx1, jy1, jz1 = get_js(tile2, conf)
+        np.testing.assert_allclose(jx0, jx1, rtol=1e-5, atol=1e-5)
+        np.testing.assert_allclose(jy0, jy1, rtol=1e-5, atol=1e-5)
+        np.testing.assert_allclose(jz0, jz1, rtol=1e-5, atol=1e-5)
+
+        # a kernel defined in python; the all-pass leaves the currents as is
+        flt.set_kernel(pyfields.FourierKernel(lambda kx, ky, kz: 1.0, 1))
+        flt.solve(tile1)
+
+        jx2, jy2, jz2 = get_js(tile1, conf)
+        np.testing.assert_allclose(jx2, jx0, rtol=1e-5, atol=1e-5)
+
+    @unittest.skipUnless(has_fourier, "built without fftw (RUNKO_FFTW)")
+    def test_fourier_grid(self):
+
+        conf = Conf()
+        conf.twoD = True
+        conf.Nx = 3
+        conf.Ny = 3
+        conf.NxMesh = 6
+        conf.NyMesh = 6
+        conf.NzMesh = 1
+
+        Nx, Ny, Nz = conf.NxMesh, conf.NyMesh, conf.NzMesh
+        flt = pyfields.twoD.Fourier(Nx, Ny, Nz)
+
+        # more passes than the halo allows; one transform per tile
+        for npasses in [4, 6]:
+            grid0 = periodic_grid(conf)
+            grid1 = periodic_grid(conf)
+
+            flt0 = pyfields.twoD.MultiBinomial2(Nx, Ny, Nz)
+            flt0.npasses = npasses
+            self.assertEqual(flt0.groups(), 2)
+            multipass_filter(flt0, grid0)
+
+            flt.set_kernel(pyfields.fourier_binomial(npasses))
+            fourier_filter(flt, grid1)
+
+            for j0, j1 in zip(global_js(grid0, conf), global_js(grid1, conf)):
+                np.testing.assert_allclose(j1, j0, atol=2e-6)
+
+        # binomial passes followed by the 3-point compensator
+        # with alpha = 1 + npasses/2
+        for npasses in [2, 4]:
+            grid0 = periodic_grid(conf)
+            grid1 = periodic_grid(conf)
+
+            repeat_filter(pyfields.twoD.Binomial2(Nx, Ny, Nz), grid0, npasses)
+            fltC = pyfields.twoD.General3p(Nx, Ny, Nz)
+            fltC.alpha = 1.0 + npasses / 2
+            repeat_filter(fltC, grid0, 1)
+
+            flt.set_kernel(pyfields.fourier_compensated(npasses))
+            fourier_filter(flt, grid1)
+
+            for j0, j1 in zip(global_js(grid0, conf), global_js(grid1, conf)):
+                np.testing.assert_allclose(j1, j0, atol=2e-6)
+
+        # sharp cutoff reaching over a full tile is the cutoff of the
+        # periodic domain
+        kmax = 1.5
+        grid1 = periodic_grid(conf)
+        flt.set_kernel(pyfields.fourier_cutoff(kmax, conf.NxMesh))
+        fourier_filter(flt, grid1)
+
+        Lx, Ly = conf.Nx * conf.NxMesh, conf.Ny * conf.NyMesh
+        x, y = np.meshgrid(np.arange(Lx), np.arange(Ly), indexing="ij")
+        kx, ky = np.meshgrid(
+            2.0 * np.pi * np.fft.fftfreq(Lx),
+            2.0 * np.pi * np.fft.fftfreq(Ly), indexing="ij")
+        mask = kx**2 + ky**2 < kmax**2
+
+        for j0, j1 in zip(rough_field(x, y, 0.0), global_js(grid1, conf)):
+            ref = np.real(np.fft.ifft2(np.fft.fft2(j0) * mask))
+            np.testing.assert_allclose(j1[:, :, 0], ref, atol=2e-6)
+
+        # kernels reaching beyond the available padding are rejected
+        flt.set_kernel(pyfields.fourier_binomial(4))
+        with self.assertRaises(ValueError):
+            flt.solve(grid1.get_tile(0, 0))
+
+        flt.set_kernel(pyfields.fourier_binomial(7))
+        with self.assertRaises(ValueError):
+            flt.solve(grid1.get_tile(0, 0), grid1)
+
+    @unittest.skipUnless(has_fourier, "built without fftw (RUNKO_FFTW)")
+    def test_fourier_grid3D(self):
+
+        conf = Conf()
+        conf.threeD = True
+        conf.Nx = 3
+        conf.Ny = 3
+        conf.Nz = 3
+        conf.NxMesh = 4
+        conf.NyMesh = 4
+        conf.NzMesh = 4
+
+        Nx, Ny, Nz = conf.NxMesh, conf.NyMesh, conf.NzMesh
+        flt = pyfields.threeD.Fourier(Nx, Ny, Nz)
+
+        grid0 = periodic_grid(conf)
+        grid1 = periodic_grid(conf)
+
+        flt0 = pyfields.threeD.MultiBinomial2(Nx, Ny, Nz)
+        flt0.npasses = 4
+        multipass_filter(flt0, grid0)
+
+        flt.set_kernel(pyfields.fourier_binomial(4))
+        fourier_filter(flt, grid1)
+
+        for j0, j1 in zip(global_js(grid0, conf), global_js(grid1, conf)):
+            np.testing.assert_allclose(j1, j0, atol=2e-6)
+
+        grid0 = periodic_grid(conf)
+        grid1 = periodic_grid(conf)
+
+        repeat_filter(pyfields.threeD.Binomial2(Nx, Ny, Nz), grid0, 2)
+        fltC = pyfields.threeD.General3p(Nx, Ny, Nz)
+        fltC.alpha = 2.0
+        repeat_filter(fltC, grid0, 1)
+
+        flt.set_kernel(pyfields.fourier_compensated(2))
+        fourier_filter(flt, grid1)
+
+        for j0, j1 in zip(global_js(grid0, conf), global_js(grid1, conf)):
+            np.testing.assert_allclose(j1, j0, atol=2e-6)
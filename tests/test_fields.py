@@ -75,6 +75,117 @@ def loadTiles3D(n, conf):
 
 
 
+def tiles(grid):
+    return [grid.get_tile(cid) for cid in grid.get_tile_ids()]
+
+
+# 1D grid of smooth periodic fields and currents with up-to-date halos
+def periodicGrid1D(conf):
+    grid = pycorgi.oneD.Grid(conf.Nx, 1, 1)
+    grid.set_grid_lims(conf.xmin, conf.xmax)
+    loadTiles1D(grid, conf)
+
+    for c in tiles(grid):
+        (i,) = c.index
+        gs = c.get_grids(0)
+        for q in range(conf.NxMesh):
+            x = 2.0*np.pi*(i*conf.NxMesh + q)/(conf.Nx*conf.NxMesh)
+            gs.ex[q,0,0] = np.sin(x)
+            gs.ey[q,0,0] = np.cos(x + 0.5)
+            gs.ez[q,0,0] = np.sin(2.0*x)
+            gs.bx[q,0,0] = np.cos(2.0*x)
+            gs.by[q,0,0] = np.sin(3.0*x + 0.2)
+            gs.bz[q,0,0] = np.cos(x)
+            gs.jx[q,0,0] = 0.1*np.sin(2.0*x)
+            gs.jy[q,0,0] = 0.1*np.cos(x)
+            gs.jz[q,0,0] = 0.1*np.sin(x + 0.3)
+
+    for c in tiles(grid):
+        c.update_boundaries(grid)
+    return grid
+
+
+# 2D grid of smooth periodic fields and currents with up-to-date halos
+def periodicGrid2D(conf):
+    grid = pycorgi.twoD.Grid(conf.Nx, conf.Ny)
+    grid.set_grid_lims(conf.xmin, conf.xmax, conf.ymin, conf.ymax)
+    loadTiles2D(grid, conf)
+
+    for c in tiles(grid):
+        (i, j) = c.index
+        gs = c.get_grids(0)
+        for r in range(conf.NyMesh):
+            for q in range(conf.NxMesh):
+                x = 2.0*np.pi*(i*conf.NxMesh + q)/(conf.Nx*conf.NxMesh)
+                y = 2.0*np.pi*(j*conf.NyMesh + r)/(conf.Ny*conf.NyMesh)
+                gs.ex[q,r,0] = np.sin(y)
+                gs.ey[q,r,0] = np.cos(x + y)
+                gs.ez[q,r,0] = np.sin(2.0*x)
+                gs.bx[q,r,0] = np.cos(2.0*y)
+                gs.by[q,r,0] = np.sin(x - y)
+                gs.bz[q,r,0] = np.cos(x)
+                gs.jx[q,r,0] = 0.1*np.sin(x + 2.0*y)
+                gs.jy[q,r,0] = 0.1*np.cos(x)
+                gs.jz[q,r,0] = 0.1*np.sin(y)
+
+    for c in tiles(grid):
+        c.update_boundaries(grid)
+    return grid
+
+
+# 3D grid of periodic fields ffunc(X,Y,Z) -> (ex,ey,ez,bx,by,bz[,jx,jy,jz]) with up-to-date halos
+def periodicGrid3D(conf, ffunc):
+    grid = pycorgi.threeD.Grid(conf.Nx, conf.Ny, conf.Nz)
+    grid.set_grid_lims(conf.xmin, conf.xmax, conf.ymin, conf.ymax, conf.zmin, conf.zmax)
+    loadTiles3D(grid, conf)
+
+    for c in tiles(grid):
+        (i, j, k) = c.index
+        gs = c.get_grids(0)
+        for s in range(conf.NzMesh):
+            for r in range(conf.NyMesh):
+                for q in range(conf.NxMesh):
+                    vals = ffunc(i*conf.NxMesh + q, j*conf.NyMesh + r, k*conf.NzMesh + s)
+                    for f, v in zip([gs.ex, gs.ey, gs.ez, gs.bx, gs.by, gs.bz,
+                                     gs.jx, gs.jy, gs.jz], vals):
+                        f[q,r,s] = v
+
+    for c in tiles(grid):
+        c.update_boundaries(grid)
+    return grid
+
+
+# reference Yee laps: B half, E (and current), B half with boundary updates in between
+def yeeLaps(grid, fdtd, nsteps, current=False):
+    for s in range(nsteps):
+        for c in tiles(grid):
+            fdtd.push_half_b(c)
+        for c in tiles(grid):
+            c.update_boundaries(grid)
+        for c in tiles(grid):
+            fdtd.push_e(c)
+            if current:
+                c.deposit_current()
+        for c in tiles(grid):
+            c.update_boundaries(grid)
+        for c in tiles(grid):
+            fdtd.push_half_b(c)
+        for c in tiles(grid):
+            c.update_boundaries(grid)
+
+
+# E and B values of cells [lo, L+hi) along the first D dimensions
+def yeeValues(grid, conf, D, lo=0, hi=0):
+    Ls = [conf.NxMesh, conf.NyMesh, conf.NzMesh]
+    rng = [range(lo, Ls[d] + hi) if d < D else range(1) for d in range(3)]
+    vals = []
+    for c in tiles(grid):
+        gs = c.get_grids(0)
+        for f in [gs.ex, gs.ey, gs.ez, gs.bx, gs.by, gs.bz]:
+            vals += [f[q,r,s] for s in rng[2] for r in rng[1] for q in rng[0]]
+    return vals
+
+
 def wrap(ii, N):
     return (N + ii % N) % N
     #if ii < 0:
@@ -109,6 +220,462 @@ class FLD_inits(unittest.TestCase):
         fdtd2.push_e(tile)
         fdtd2.push_half_b(tile)
 
+    def test_blocked_steps_2d(self):
+        """ push_steps equals the half-step sweeps with boundary updates in between"""
+        conf = Conf()
+        conf.twoD = True
+        conf.NxMesh = 6
+        conf.NyMesh = 5
+        conf.NzMesh = 1 #force 2D
+
+        grids = [periodicGrid2D(conf), periodicGrid2D(conf)]
+
+        fdtd2 = pyrunko.emf.twoD.FDTD2()
+        nsteps = fdtd2.max_steps
+        self.assertEqual(nsteps, 2)
+
+        # reference: three sweeps per step with halo updates in between
+        for s in range(nsteps):
+            for c in tiles(grids[0]):
+                fdtd2.push_half_b(c)
+            for c in tiles(grids[0]):
+                c.update_boundaries(grids[0])
+            for c in tiles(grids[0]):
+                fdtd2.push_e(c)
+            for c in tiles(grids[0]):
+                c.update_boundaries(grids[0])
+            for c in tiles(grids[0]):
+                fdtd2.push_half_b(c)
+            for c in tiles(grids[0]):
+                c.update_boundaries(grids[0])
+
+        for c in tiles(grids[1]):
+            fdtd2.push_steps(c, nsteps)
+
+        for c, cb in zip(tiles(grids[0]), tiles(grids[1])):
+            gs  = c.get_grids(0)
+            gsb = cb.get_grids(0)
+            for r in range(conf.NyMesh):
+                for q in range(conf.NxMesh):
+                    for f, fb in [(gs.ex, gsb.ex), (gs.ey, gsb.ey), (gs.ez, gsb.ez),
+                                  (gs.bx, gsb.bx), (gs.by, gsb.by), (gs.bz, gsb.bz)]:
+                        self.assertAlmostEqual(f[q,r,0], fb[q,r,0], places=6)
+
+        # more steps than the halo allows
+        with self.assertRaises(ValueError):
+            fdtd2.push_steps(tiles(grids[1])[0], nsteps+1)
+
+    def test_blocked_steps_1d(self):
+        """ push_steps equals the half-step sweeps bitwise in 1D (slabs along x)"""
+        conf = Conf()
+        conf.oneD = True
+        conf.NxMesh = 7
+        conf.NyMesh = 1 #force 1D
+        conf.NzMesh = 1 #
+
+        grids = [periodicGrid1D(conf), periodicGrid1D(conf)]
+        fdtd2 = pyrunko.emf.oneD.FDTD2()
+        nsteps = fdtd2.max_steps
+
+        yeeLaps(grids[0], fdtd2, nsteps)
+        for c in tiles(grids[1]):
+            fdtd2.push_steps(c, nsteps)
+
+        self.assertEqual(yeeValues(grids[0], conf, 1), yeeValues(grids[1], conf, 1))
+
+    def test_blocked_steps_3d(self):
+        """ push_steps equals the half-step sweeps bitwise in 3D (rows over z-planes)"""
+        conf = Conf()
+        conf.threeD = True
+        conf.Nx = 2
+        conf.Ny = 2
+        conf.Nz = 2
+        conf.NxMesh = 6
+        conf.NyMesh = 5
+        conf.NzMesh = 4
+
+        L = 2.0*np.pi
+        def smooth(X, Y, Z):
+            x, y, z = L*X/12.0, L*Y/10.0, L*Z/8.0
+            return (np.sin(y + z), np.cos(x + y), np.sin(2.0*x - z),
+                    np.cos(2.0*y), np.sin(x - y + z), np.cos(x + 2.0*z))
+
+        grids = [periodicGrid3D(conf, smooth), periodicGrid3D(conf, smooth)]
+        fdtd2 = pyrunko.emf.threeD.FDTD2()
+        nsteps = fdtd2.max_steps
+
+        yeeLaps(grids[0], fdtd2, nsteps)
+        for c in tiles(grids[1]):
+            fdtd2.push_steps(c, nsteps)
+
+        self.assertEqual(yeeValues(grids[0], conf, 3), yeeValues(grids[1], conf, 3))
+
+    def test_fused_lap_2d(self):
+        """ push_fused equals B half, E, current, B half with boundary updates in between"""
+        conf = Conf()
+        conf.twoD = True
+        conf.NxMesh = 6
+        conf.NyMesh = 5
+        conf.NzMesh = 1 #force 2D
+
+        grids = [periodicGrid2D(conf), periodicGrid2D(conf)]
+        fdtd2 = pyrunko.emf.twoD.FDTD2()
+
+        for c in tiles(grids[0]):
+            fdtd2.push_half_b(c)
+        for c in tiles(grids[0]):
+            c.update_boundaries(grids[0])
+        for c in tiles(grids[0]):
+            fdtd2.push_e(c)
+            c.deposit_current()
+        for c in tiles(grids[0]):
+            c.update_boundaries(grids[0])
+        for c in tiles(grids[0]):
+            fdtd2.push_half_b(c)
+        for c in tiles(grids[0]):
+            c.update_boundaries(grids[0])
+
+        for c in tiles(grids[1]):
+            fdtd2.push_fused(c)
+
+        # valid on the interior and one halo cell without another update
+        for c, cb in zip(tiles(grids[0]), tiles(grids[1])):
+            gs  = c.get_grids(0)
+            gsb = cb.get_grids(0)
+            for r in range(-1, conf.NyMesh+1):
+                for q in range(-1, conf.NxMesh+1):
+                    for f, fb in [(gs.ex, gsb.ex), (gs.ey, gsb.ey), (gs.ez, gsb.ez),
+                                  (gs.bx, gsb.bx), (gs.by, gsb.by), (gs.bz, gsb.bz)]:
+                        self.assertAlmostEqual(f[q,r,0], fb[q,r,0], places=6)
+
+    def test_fused_lap_1d(self):
+        """ push_fused equals the half-step sweeps with current bitwise in 1D"""
+        conf = Conf()
+        conf.oneD = True
+        conf.NxMesh = 7
+        conf.NyMesh = 1 #force 1D
+        conf.NzMesh = 1 #
+
+        grids = [periodicGrid1D(conf), periodicGrid1D(conf)]
+        fdtd2 = pyrunko.emf.oneD.FDTD2()
+
+        yeeLaps(grids[0], fdtd2, 1, current=True)
+        for c in tiles(grids[1]):
+            fdtd2.push_fused(c)
+
+        # valid on the interior and one halo cell without another update
+        self.assertEqual(yeeValues(grids[0], conf, 1, -1, 1), yeeValues(grids[1], conf, 1, -1, 1))
+
+    def test_fused_lap_3d(self):
+        """ push_fused equals the half-step sweeps with current bitwise in 3D"""
+        conf = Conf()
+        conf.threeD = True
+        conf.Nx = 2
+        conf.Ny = 2
+        conf.Nz = 2
+        conf.NxMesh = 6
+        conf.NyMesh = 5
+        conf.NzMesh = 4
+
+        L = 2.0*np.pi
+        def smooth(X, Y, Z):
+            x, y, z = L*X/12.0, L*Y/10.0, L*Z/8.0
+            return (np.sin(y + z), np.cos(x + y), np.sin(2.0*x - z),
+                    np.cos(2.0*y), np.sin(x - y + z), np.cos(x + 2.0*z),
+                    0.1*np.sin(x + 2.0*y), 0.1*np.cos(x - z), 0.1*np.sin(y + z))
+
+        grids = [periodicGrid3D(conf, smooth), periodicGrid3D(conf, smooth)]
+        fdtd2 = pyrunko.emf.threeD.FDTD2()
+
+        yeeLaps(grids[0], fdtd2, 1, current=True)
+        for c in tiles(grids[1]):
+            fdtd2.push_fused(c)
+
+        # valid on the interior and one halo cell without another update
+        self.assertEqual(yeeValues(grids[0], conf, 3, -1, 1), yeeValues(grids[1], conf, 3, -1, 1))
+
+    def test_fixed_stencil_2d(self):
+        """ compiled fourth order stencil equals the runtime-coefficient curl"""
+        conf = Conf()
+        conf.twoD = True
+        conf.NxMesh = 6
+        conf.NyMesh = 5
+        conf.NzMesh = 1 #force 2D
+
+        grids = [periodicGrid2D(conf), periodicGrid2D(conf)]
+
+        fixed = pyrunko.emf.twoD.FDTD4()
+        runtime = pyrunko.emf.twoD.FDTD4()
+        runtime.coeff1 = 9.0/8.0 + 1.0e-12 # non-default; same single precision value
+
+        for fdtd4, grid in zip([fixed, runtime], grids):
+            for c in tiles(grid):
+                fdtd4.push_half_b(c)
+                fdtd4.push_e(c)
+
+        for c, cb in zip(tiles(grids[0]), tiles(grids[1])):
+            gs  = c.get_grids(0)
+            gsb = cb.get_grids(0)
+            for r in range(conf.NyMesh):
+                for q in range(conf.NxMesh):
+                    for f, fb in [(gs.ex, gsb.ex), (gs.ey, gsb.ey), (gs.ez, gsb.ez),
+                                  (gs.bx, gsb.bx), (gs.by, gsb.by), (gs.bz, gsb.bz)]:
+                        self.assertAlmostEqual(f[q,r,0], fb[q,r,0], places=5)
+
+
+
+    def test_fixed_stencil_3d(self):
+        """ compiled fourth order stencil equals the runtime-coefficient curl in 3D"""
+        conf = Conf()
+        conf.threeD = True
+        conf.Nx = 2
+        conf.Ny = 2
+        conf.Nz = 2
+
+        L = 2.0*np.pi/10.0
+        def smooth(X, Y, Z):
+            x, y, z = L*X, L*Y, L*Z
+            return (np.sin(y + z), np.cos(x + y), np.sin(2.0*x - z),
+                    np.cos(2.0*y), np.sin(x - y + z), np.cos(x + 2.0*z))
+
+        grids = [periodicGrid3D(conf, smooth), periodicGrid3D(conf, smooth)]
+
+        fixed = pyrunko.emf.threeD.FDTD4()
+        runtime = pyrunko.emf.threeD.FDTD4()
+        runtime.coeff1 = 9.0/8.0 + 1.0e-12 # non-default; same single precision value
+
+        for fdtd4, grid in zip([fixed, runtime], grids):
+            for c in tiles(grid):
+                fdtd4.push_half_b(c)
+                fdtd4.push_e(c)
+
+        for c, cb in zip(tiles(grids[0]), tiles(grids[1])):
+            gs  = c.get_grids(0)
+            gsb = cb.get_grids(0)
+            for s in range(conf.NzMesh):
+                for r in range(conf.NyMesh):
+                    for q in range(conf.NxMesh):
+                        for f, fb in [(gs.ex, gsb.ex), (gs.ey, gsb.ey), (gs.ez, gsb.ez),
+                                      (gs.bx, gsb.bx), (gs.by, gsb.by), (gs.bz, gsb.bz)]:
+                            self.assertAlmostEqual(f[q,r,s], fb[q,r,s], places=5)
+
+    def test_pukhov_stencil_3d(self):
+        """ Pukhov's compiled stencil equals FDTDGen with the same alpha/beta"""
+        conf = Conf()
+        conf.threeD = True
+        conf.Nx = 2
+        conf.Ny = 2
+        conf.Nz = 2
+
+        # FDTDGen applies the transverse weight at shifts 1, 2, and 3 whereas
+        # Pukhov's stencil only has the shift 1. Modes with wavenumbers k =
+        # pi/5 and 3pi/5 (period 10) satisfy cos(2k) + cos(3k) = 0, so that the
+        # extra legs cancel and both curls agree exactly.
+        a, b = np.pi/5.0, 3.0*np.pi/5.0
+        def modes(X, Y, Z):
+            return (np.sin(a*X + 0.3)*np.cos(b*Y)*np.sin(a*Z + 1.0),
+                    np.cos(b*X)*np.sin(a*Y + 0.2)*np.cos(a*Z),
+                    np.sin(a*X)*np.sin(a*Y + 0.7)*np.cos(b*Z + 0.1),
+                    np.cos(a*X + 0.4)*np.cos(a*Y)*np.sin(b*Z),
+                    np.sin(b*X + 0.5)*np.cos(a*Y + 0.9)*np.sin(a*Z),
+                    np.cos(a*X)*np.sin(b*Y)*np.cos(a*Z + 0.6))
+
+        grids = [periodicGrid3D(conf, modes), periodicGrid3D(conf, modes)]
+
+        pukhov = pyrunko.emf.threeD.FDTDPukhov()
+
+        gen = pyrunko.emf.threeD.FDTDGen()
+        gen.CXs[1,0,0] = 0.5 # alpha = 1 - 2*(D-1)/8
+        gen.CYs[0,1,0] = 0.5
+        gen.CZs[0,0,1] = 0.5
+        gen.CXs[1,1,1] = 1.0/8.0 # beta
+        gen.CYs[1,1,1] = 1.0/8.0
+        gen.CZs[1,1,1] = 1.0/8.0
+
+        for fdtd, grid in zip([pukhov, gen], grids):
+            for c in tiles(grid):
+                fdtd.push_half_b(c)
+            for c in tiles(grid):
+                c.update_boundaries(grid)
+            for c in tiles(grid):
+                fdtd.push_e(c)
+
+        for c, cb in zip(tiles(grids[0]), tiles(grids[1])):
+            gs  = c.get_grids(0)
+            gsb = cb.get_grids(0)
+            for s in range(conf.NzMesh):
+                for r in range(conf.NyMesh):
+                    for q in range(conf.NxMesh):
+                        for f, fb in [(gs.ex, gsb.ex), (gs.ey, gsb.ey), (gs.ez, gsb.ez),
+                                      (gs.bx, gsb.bx), (gs.by, gsb.by), (gs.bz, gsb.bz)]:
+                            self.assertAlmostEqual(f[q,r,s], fb[q,r,s], places=5)
+
+    def test_pml_interior_2d(self):
+        """ FDTD2_pml equals FDTD2 away from the absorbing layer and damps inside it"""
+        conf = Conf()
+        conf.twoD = True
+        conf.NxMesh = 6
+        conf.NyMesh = 5
+        conf.NzMesh = 1 #force 2D
+
+        grids = [periodicGrid2D(conf), periodicGrid2D(conf)]
+        for grid in grids:
+            for c in tiles(grid):
+                (i, j) = c.index
+                c.set_tile_mins([i*conf.NxMesh, j*conf.NyMesh])
+
+        fdtd2 = pyrunko.emf.twoD.FDTD2()
+
+        pml = pyrunko.emf.twoD.FDTD2_pml()
+        pml.cenx = 0.5*conf.Nx*conf.NxMesh
+        pml.ceny = 0.5*conf.Ny*conf.NyMesh
+        pml.cenz = 0.0
+        pml.radx = 0.5*conf.Nx*conf.NxMesh
+        pml.rady = 0.5*conf.Ny*conf.NyMesh
+        pml.radz = 1.0
+        pml.rad_lim = 0.6
+        pml.norm_abs = 0.3
+
+        for c, cb in zip(tiles(grids[0]), tiles(grids[1])):
+            fdtd2.push_half_b(c)
+            fdtd2.push_e(c)
+            pml.push_half_b(cb)
+            pml.push_e(cb)
+
+        for c, cb in zip(tiles(grids[0]), tiles(grids[1])):
+            # only the middle tile is clear of the layer
+            self.assertEqual(pml.absorbs(cb), tuple(cb.index) != (1, 1))
+
+            gs  = c.get_grids(0)
+            gsb = cb.get_grids(0)
+            diff = 0.0
+            for r in range(conf.NyMesh):
+                for q in range(conf.NxMesh):
+                    for f, fb in [(gs.ex, gsb.ex), (gs.ey, gsb.ey), (gs.ez, gsb.ez),
+                                  (gs.bx, gsb.bx), (gs.by, gsb.by), (gs.bz, gsb.bz)]:
+                        diff = max(diff, abs(f[q,r,0] - fb[q,r,0]))
+
+            if pml.absorbs(cb):
+                self.assertGreater(diff, 1.0e-4)
+            else:
+                self.assertAlmostEqual(diff, 0.0, places=6)
+
+        # direct check of one damped tile against the per-cell update
+        # (f (1+lam) + df)/(1-lam) with E damped by lam/2 at the cell edges
+        # and B by lam/4 at the cell faces
+        def lam(sx, sy, sz):
+            r = np.sqrt(((sx - pml.cenx)/pml.radx)**2 + ((sy - pml.ceny)/pml.rady)**2 + ((sz - pml.cenz)/pml.radz)**2)
+            if r <= pml.rad_lim:
+                return 0.0
+            return -min(pml.norm_abs*((r - pml.rad_lim)/(1.0 - pml.rad_lim))**3, pml.norm_abs)
+
+        def damp(f, df, l):
+            return (f*(1.0 + l) + df)/(1.0 - l)
+
+        grid = periodicGrid2D(conf)
+        c = grid.get_tile(0, 0)
+        c.set_tile_mins([0, 0])
+        self.assertTrue(pml.absorbs(c))
+        gs = c.get_grids(0)
+
+        # B half step from the initial E
+        C = 0.5*c.cfl
+        ref = {}
+        lmax = 0.0
+        for r in range(conf.NyMesh):
+            for q in range(conf.NxMesh):
+                x, y = float(q), float(r) # tile mins are zero
+                dbx = C*(-gs.ez[q,r+1,0] + gs.ez[q,r,0])
+                dby = C*( gs.ez[q+1,r,0] - gs.ez[q,r,0])
+                dbz = C*( gs.ex[q,r+1,0] - gs.ex[q,r,0]) + C*(-gs.ey[q+1,r,0] + gs.ey[q,r,0])
+                ref[q,r] = (damp(gs.bx[q,r,0], dbx, 0.25*lam(x,       y + 0.5, 0.0)),
+                            damp(gs.by[q,r,0], dby, 0.25*lam(x + 0.5, y,       0.0)),
+                            damp(gs.bz[q,r,0], dbz, 0.25*lam(x + 0.5, y + 0.5, 0.0)))
+                lmax = max(lmax, abs(lam(x, y, 0.0)))
+        self.assertGreater(lmax, 1.0e-3)
+
+        pml.push_half_b(c)
+        for (q, r), (bx, by, bz) in ref.items():
+            self.assertAlmostEqual(gs.bx[q,r,0], bx, places=5)
+            self.assertAlmostEqual(gs.by[q,r,0], by, places=5)
+            self.assertAlmostEqual(gs.bz[q,r,0], bz, places=5)
+
+        # E full step from the updated B
+        C = c.cfl
+        ref = {}
+        for r in range(conf.NyMesh):
+            for q in range(conf.NxMesh):
+                x, y = float(q), float(r) # tile mins are zero
+                dex = C*(-gs.bz[q,r-1,0] + gs.bz[q,r,0])
+                dey = C*( gs.bz[q-1,r,0] - gs.bz[q,r,0])
+                dez = C*( gs.bx[q,r-1,0] - gs.bx[q,r,0]) + C*(-gs.by[q-1,r,0] + gs.by[q,r,0])
+                ref[q,r] = (damp(gs.ex[q,r,0], dex, 0.5*lam(x + 0.5, y,       0.0)),
+                            damp(gs.ey[q,r,0], dey, 0.5*lam(x,       y + 0.5, 0.0)),
+                            damp(gs.ez[q,r,0], dez, 0.5*lam(x,       y,       0.0)))
+
+        pml.push_e(c)
+        for (q, r), (ex, ey, ez) in ref.items():
+            self.assertAlmostEqual(gs.ex[q,r,0], ex, places=5)
+            self.assertAlmostEqual(gs.ey[q,r,0], ey, places=5)
+            self.assertAlmostEqual(gs.ez[q,r,0], ez, places=5)
+
+
+    def test_lazy_components(self):
+        """ rho is allocated on first use; currents can be released and re-allocated"""
+        gs = pyrunko.emf.Grids(4, 3, 2)
+
+        self.assertFalse(gs.has_rho())
+        self.assertTrue(gs.has_currents())
+
+        self.assertEqual(gs.rho[1,1,1], 0.0) # access allocates
+        self.assertTrue(gs.has_rho())
+        gs.free_rho()
+        self.assertFalse(gs.has_rho())
+
+        gs.free_currents()
+        self.assertFalse(gs.has_currents())
+        gs.alloc_currents()
+        self.assertTrue(gs.has_currents())
+        self.assertEqual(gs.jz[3,2,1], 0.0)
+
+        # field-only tiles skip the current routines
+        conf = Conf()
+        conf.twoD = True
+        conf.NxMesh = 3
+        conf.NyMesh = 3
+        conf.NzMesh = 1 #force 2D
+        grid = periodicGrid2D(conf)
+
+        for c in tiles(grid):
+            c.get_grids(0).free_currents()
+        for c in tiles(grid):
+            c.deposit_current()
+            c.exchange_currents(grid)
+            c.update_boundaries(grid, [0,1,2])
+            self.assertFalse(c.get_grids(0).has_currents())
+
+        # mixed state: reading jx re-allocates the currents of one tile
+        # only; its released neighbours count as zero currents
+        c0 = grid.get_tile(1,1)
+        gs0 = c0.get_grids(0)
+        for r in range(-3, conf.NyMesh+3):
+            for q in range(-3, conf.NxMesh+3):
+                gs0.jx[q,r,0] = 1.0
+        self.assertTrue(gs0.has_currents())
+
+        for c in tiles(grid):
+            c.exchange_currents(grid)
+            c.update_boundaries(grid, [0,1,2])
+            if c.index != (1,1):
+                self.assertFalse(c.get_grids(0).has_currents())
+
+        for r in range(conf.NyMesh):
+            for q in range(conf.NxMesh):
+                self.assertEqual(gs0.jx[q,r,0], 1.0)
+
+        for c in tiles(grid):
+            c.clear_current()
+            self.assertTrue(c.get_grids(0).has_currents())
 
 
 
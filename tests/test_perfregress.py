@@ -0,0 +1,54 @@
+import unittest
+
+import pytools.perfregress as pr
+
+
+def make_hist(medians, std=0.01):
+    config = {"dim": 3, "nx": 32}
+    hist = {"runs": []}
+    for m in medians:
+        pr.add_run(hist, config, {"BorisPusher": [m - std, m, m + std]}, commit="test")
+    return config, hist
+
+
+class PerfRegress(unittest.TestCase):
+
+    def test_baseline(self):
+        config, hist = make_hist([1.0, 1.1, 0.9, 5.0], std=0.01)
+
+        # window picks the latest runs only
+        base = pr.baseline(hist, config, window=3)
+        self.assertAlmostEqual(base["BorisPusher"]["median"], 1.1)
+
+        # runs with a different config are ignored
+        base = pr.baseline(hist, {"dim": 2}, window=3)
+        self.assertEqual(len(base), 0)
+
+    def test_regression(self):
+        config, hist = make_hist([1.0, 1.0, 1.0], std=0.001)
+        base = pr.baseline(hist, config)
+
+        # 15% slowdown is caught with the default threshold
+        rep = pr.compare({"BorisPusher": [1.15, 1.15, 1.15]}, base)
+        self.assertTrue(rep["BorisPusher"]["regression"])
+        self.assertAlmostEqual(rep["BorisPusher"]["change"], 0.15)
+
+        # per-kernel threshold
+        rep = pr.compare({"BorisPusher": [1.15, 1.15, 1.15]}, base, thresholds={"BorisPusher": 0.2})
+        self.assertFalse(rep["BorisPusher"]["regression"])
+
+        # speedups are never flagged
+        rep = pr.compare({"BorisPusher": [0.5, 0.5, 0.5]}, base)
+        self.assertFalse(rep["BorisPusher"]["regression"])
+
+    def test_noise(self):
+        # baseline with large scatter hides an apparent 10% slowdown
+        config, hist = make_hist([0.8, 1.0, 1.2], std=0.2)
+        base = pr.baseline(hist, config)
+
+        rep = pr.compare({"BorisPusher": [0.9, 1.1, 1.3]}, base)
+        self.assertFalse(rep["BorisPusher"]["regression"])
+
+
+if __name__ == "__main__":
+    unittest.main()
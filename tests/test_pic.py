@@ -145,6 +145,21 @@ def filler_xvel3D(xloc, ispcs, conf):
     return x0, u0
 
 
+def filler_speeds(xloc, ispcs, conf):
+
+    # in-plane velocities with a spread of Lorentz factors
+    xx = xloc[0] + np.random.rand()
+    yy = xloc[1] + np.random.rand()
+    zz = 0.5
+
+    ur = randab(0.0, 3.0)
+    uc = randab(0.0, 2.0*np.pi)
+
+    x0 = [xx, yy, zz]
+    u0 = [ur*np.sin(uc), ur*np.cos(uc), 0.0]
+    return x0, u0
+
+
 def zero_field(x,y,z):
     return 0.0
 
@@ -241,8 +256,65 @@ def insert_em(grid, conf, ffunc, zero_field=False):
 
 
 
+# staggering of the Yee components in emf::StaggeredSphericalCoordinates
+conductor_staggering = {
+    "ex": (1, 0, 0), "ey": (0, 1, 0), "ez": (1, 0, 1),
+    "bx": (0, 1, 1), "by": (1, 0, 1), "bz": (1, 1, 0),
+}
+
+# analytic corotating dipole of a 3D emf::Conductor at cell (i,j,k)
+def conductor_dipole(cond, mins, i, j, k):
+    mu = np.array([
+        np.sin(cond.chi_mu)*np.cos(cond.phase_mu),
+        np.sin(cond.chi_mu)*np.sin(cond.phase_mu),
+        np.cos(cond.chi_mu)])
+
+    Omega = 2.0*np.pi/cond.period if cond.period > 0.0 else 0.0
+    om = Omega*np.array([
+        np.sin(cond.chi_om)*np.cos(cond.phase_om),
+        np.sin(cond.chi_om)*np.sin(cond.phase_om),
+        np.cos(cond.chi_om)])
+
+    cen = np.array([cond.cenx, cond.ceny, cond.cenz])
+
+    flds = {}
+    for comp, stag in conductor_staggering.items():
+        r = np.array([mins[0] + i, mins[1] + j, mins[2] + k]) + 0.5*np.array(stag) - cen
+        rad = np.sqrt(np.dot(r, r))
+        b = cond.B0*(3.0*r*np.dot(mu, r)/rad**5 - mu/rad**3)
+
+        # E = -(Omega x r) x B
+        f = b if comp[0] == "b" else -np.cross(np.cross(om, r), b)
+        flds[comp] = f["xyz".index(comp[1])]
+    return flds
+
+
+
 
 # basic Conf file/class for PiC simulation testing
+# scalar reference of the rGCA full-orbit bin: ns Boris sub-steps of dt/ns
+def boris_substeps(c, qm, u, x, e, b, ns, D):
+    qms = qm/ns
+    e = [ei*0.5*qms for ei in e]
+    b = [bi*0.5*qms/c for bi in b]
+    u = list(u)
+    x = list(x)
+
+    for _ in range(ns):
+        u0 = [ui*c + ei for ui, ei in zip(u, e)]
+        ginv = c/np.sqrt(c*c + np.dot(u0, u0))
+        bb = [bi*ginv for bi in b]
+        f = 2.0/(1.0 + np.dot(bb, bb))
+        u1 = [(a + r)*f for a, r in zip(u0, np.cross(u0, bb))]
+        u0 = [a + r + ei for a, r, ei in zip(u0, np.cross(u1, bb), e)]
+
+        u = [a/c for a in u0]
+        ginv = c/np.sqrt(c*c + np.dot(u0, u0))
+        for i in range(D):
+            x[i] += u[i]*ginv*c/ns
+    return u, x
+
+
 class Conf:
 
     Nx = 1
@@ -644,6 +716,13 @@ class PIC(unittest.TestCase):
         fintps = []
 
         fintps.append( pyrunko.pic.twoD.LinearInterpolator() )
+        fintp_col = pyrunko.pic.twoD.LinearInterpolator()
+        fintp_col.collocated = True
+        fintps.append( fintp_col )
+        fintp_brk = pyrunko.pic.twoD.LinearInterpolator()
+        fintp_brk.collocated = True
+        fintp_brk.bricked = True
+        fintps.append( fintp_brk )
         fintps.append( pyrunko.pic.twoD.QuadraticInterpolator() )
 
         for fintp in fintps:
@@ -714,8 +793,15 @@ class PIC(unittest.TestCase):
         #interpolate emf
         fintps = []
         fintps.append( pyrunko.pic.threeD.LinearInterpolator() )
+        fintp_col = pyrunko.pic.threeD.LinearInterpolator()
+        fintp_col.collocated = True
+        fintps.append( fintp_col )
+        fintp_brk = pyrunko.pic.threeD.LinearInterpolator()
+        fintp_brk.collocated = True
+        fintp_brk.bricked = True
+        fintps.append( fintp_brk )
         fintps.append( pyrunko.pic.threeD.QuadraticInterpolator() )
-        #fintps.append( pyrunko.pic.threeD.CubicInterpolator() )
+        fintps.append( pyrunko.pic.threeD.CubicInterpolator() )
         fintps.append( pyrunko.pic.threeD.QuarticInterpolator() )
 
         for fintp in fintps:
@@ -775,6 +861,13 @@ class PIC(unittest.TestCase):
         fintps = []
 
         fintps.append( pyrunko.pic.twoD.LinearInterpolator() )
+        fintp_col = pyrunko.pic.twoD.LinearInterpolator()
+        fintp_col.collocated = True
+        fintps.append( fintp_col )
+        fintp_brk = pyrunko.pic.twoD.LinearInterpolator()
+        fintp_brk.collocated = True
+        fintp_brk.bricked = True
+        fintps.append( fintp_brk )
         fintps.append( pyrunko.pic.twoD.QuadraticInterpolator() )
 
         for fintp in fintps:
@@ -839,8 +932,15 @@ class PIC(unittest.TestCase):
         #interpolate emf
         fintps = []
         fintps.append( pyrunko.pic.threeD.LinearInterpolator() )
+        fintp_col = pyrunko.pic.threeD.LinearInterpolator()
+        fintp_col.collocated = True
+        fintps.append( fintp_col )
+        fintp_brk = pyrunko.pic.threeD.LinearInterpolator()
+        fintp_brk.collocated = True
+        fintp_brk.bricked = True
+        fintps.append( fintp_brk )
         fintps.append( pyrunko.pic.threeD.QuadraticInterpolator() )
-        #fintps.append( pyrunko.pic.threeD.CubicInterpolator() )
+        fintps.append( pyrunko.pic.threeD.CubicInterpolator() )
         fintps.append( pyrunko.pic.threeD.QuarticInterpolator() )
 
         for fintp in fintps:
@@ -878,6 +978,214 @@ class PIC(unittest.TestCase):
                             self.assertAlmostEqual( container.bz(i), ref+5.0, places=4 )
 
 
+    def test_cell_block_gather(self):
+        """ interpolation of cell-block sorted particles equals the unsorted result"""
+        conf = Conf()
+
+        conf.Nx = 3
+        conf.Ny = 3
+        conf.Nz = 3
+
+        conf.NxMesh = 5
+        conf.NyMesh = 5
+        conf.NzMesh = 5
+
+        conf.threeD = True
+        conf.update_bbox()
+
+        def setup_grid():
+            np.random.seed(1)
+            grid = pycorgi.threeD.Grid(conf.Nx, conf.Ny, conf.Nz)
+            grid.set_grid_lims(conf.xmin, conf.xmax, 
+                               conf.ymin, conf.ymax, 
+                               conf.zmin, conf.zmax)
+            pytools.pic.load_tiles( grid, conf)
+            insert_em( grid, conf, linear_field_3d)
+            pytools.pic.inject(grid, filler3D, density_profile, conf)
+
+            for tile in pytools.tiles_local(grid):
+                tile.update_boundaries(grid, iarr=[0,1,2])
+            return grid
+
+        # sorted grid and its unsorted reference
+        grid = setup_grid()
+        gridr = setup_grid()
+
+        fintps = []
+        fintps.append( pyrunko.pic.threeD.LinearInterpolator() )
+        fintps.append( pyrunko.pic.threeD.QuadraticInterpolator() )
+        fintps.append( pyrunko.pic.threeD.CubicInterpolator() )
+        fintps.append( pyrunko.pic.threeD.QuarticInterpolator() )
+
+        def fields(tile):
+            c = tile.get_container(0)
+            xx, yy, zz = c.loc(0), c.loc(1), c.loc(2)
+            return { (xx[i], yy[i], zz[i]) : 
+                     (c.ex(i), c.ey(i), c.ez(i), c.bx(i), c.by(i), c.bz(i)) for i in range(c.size()) }
+
+        def compare():
+            for fintp in fintps:
+                for tile, tiler in zip(pytools.tiles_local(grid), pytools.tiles_local(gridr)):
+                    self.assertFalse(tiler.get_container(0).is_cell_sorted())
+                    fintp.solve(tile)
+                    fintp.solve(tiler)
+                    vals, ref = fields(tile), fields(tiler)
+                    self.assertEqual(len(vals), len(ref))
+                    for key, val in vals.items():
+                        for v, r in zip(val, ref[key]):
+                            self.assertAlmostEqual(v, r, places=6)
+
+        # shift particle n of tile and the same particle of the reference
+        def move(tile, tiler, n, shift):
+            con, conr = tile.get_container(0), tiler.get_container(0)
+            key = (con.loc(0)[n], con.loc(1)[n], con.loc(2)[n])
+            nr = [(x, y, z) for x, y, z in zip(conr.loc(0), conr.loc(1), conr.loc(2))].index(key)
+            for dim in range(3):
+                con[n, dim]  = key[dim] + shift[dim]
+                conr[nr, dim] = key[dim] + shift[dim]
+
+        # 5^3 cells in blocks of 2^3; the last blocks are partial
+        for tile in pytools.tiles_local(grid):
+            tile.sort_in_cell_blocks(2)
+            self.assertTrue(tile.get_container(0).is_cell_sorted())
+        compare()
+
+        # the first particle (in block 0) moves to another block of the
+        # tile; the container stays sorted and the particle falls back to
+        # the tile meshes
+        for tile, tiler in zip(pytools.tiles_local(grid), pytools.tiles_local(gridr)):
+            move(tile, tiler, 0, [3.0, 3.0, 3.0])
+            self.assertTrue(tile.get_container(0).is_cell_sorted())
+        compare()
+
+        # deleting particles drops the grouping
+        for tile, tiler in zip(pytools.tiles_local(grid), pytools.tiles_local(gridr)):
+            move(tile, tiler, 1, [-6.0, 0.0, 0.0])
+            for t in [tile, tiler]:
+                t.check_outgoing_particles()
+                t.delete_transferred_particles()
+            self.assertFalse(tile.get_container(0).is_cell_sorted())
+        compare()
+
+
+    def test_cell_block_scatter(self):
+        """ current deposit of cell-block sorted particles equals the unsorted result"""
+        conf = Conf()
+
+        conf.Nx = 3
+        conf.Ny = 3
+        conf.Nz = 3
+
+        conf.NxMesh = 5
+        conf.NyMesh = 5
+        conf.NzMesh = 5
+
+        conf.vel = 0.3
+        conf.threeD = True
+        conf.update_bbox()
+
+        grid = pycorgi.threeD.Grid(conf.Nx, conf.Ny, conf.Nz)
+        grid.set_grid_lims(conf.xmin, conf.xmax, 
+                           conf.ymin, conf.ymax, 
+                           conf.zmin, conf.zmax)
+        pytools.pic.load_tiles( grid, conf)
+        pytools.pic.inject(grid, filler3D, density_profile, conf)
+
+        # all shape orders share the particle loop (see pic::ShapeDepositer)
+        currints = []
+        currints.append( pyrunko.pic.threeD.ZigZag() )
+        currints.append( pyrunko.pic.threeD.ZigZag_2nd() )
+        currints.append( pyrunko.pic.threeD.ZigZag_3rd() )
+        currints.append( pyrunko.pic.threeD.ZigZag_4th() )
+        currints.append( pyrunko.pic.threeD.Esikerpov_2nd() )
+        currints.append( pyrunko.pic.threeD.Esikerpov_4th() )
+
+        def currents(tile):
+            gs = tile.get_grids(0)
+            return [ (gs.jx[l,m,n], gs.jy[l,m,n], gs.jz[l,m,n])
+                     for l in range(conf.NxMesh) 
+                     for m in range(conf.NyMesh) 
+                     for n in range(conf.NzMesh) ]
+
+        # reference from the unsorted containers
+        refs = {}
+        for ic, currint in enumerate(currints):
+            for tile in pytools.tiles_local(grid):
+                self.assertFalse(tile.get_container(0).is_cell_sorted())
+                currint.solve(tile)
+                refs[(ic, tile.cid)] = currents(tile)
+
+        # 5^3 cells in blocks of 2^3; the last blocks are partial
+        for tile in pytools.tiles_local(grid):
+            tile.sort_in_cell_blocks(2)
+            self.assertTrue(tile.get_container(0).is_cell_sorted())
+
+        for ic, currint in enumerate(currints):
+            for tile in pytools.tiles_local(grid):
+                currint.solve(tile)
+                for val, ref in zip(currents(tile), refs[(ic, tile.cid)]):
+                    for v, r in zip(val, ref):
+                        self.assertAlmostEqual(v, r, places=5)
+
+
+    def test_fused_push_deposit(self):
+        """ fused Boris + ZigZag sweep equals the separate pusher and depositer"""
+        conf = Conf()
+        conf.twoD = True
+        conf.NxMesh = 5
+        conf.NyMesh = 5
+        conf.ppc = 3
+        conf.vel = 0.3
+        conf.update_bbox()
+
+        grids = []
+        for i in range(2):
+            np.random.seed(1)
+            grid = pycorgi.twoD.Grid(conf.Nx, conf.Ny, conf.Nz)
+            grid.set_grid_lims(conf.xmin, conf.xmax, conf.ymin, conf.ymax)
+            pytools.pic.load_tiles(grid, conf)
+            insert_em(grid, conf, linear_field)
+            pytools.pic.inject(grid, filler, density_profile, conf)
+
+            fintp = pyrunko.pic.twoD.LinearInterpolator()
+            for tile in pytools.tiles_all(grid):
+                tile.update_boundaries(grid)
+                fintp.solve(tile)
+            grids.append(grid)
+
+        pusher   = pyrunko.pic.twoD.BorisPusher()
+        currint  = pyrunko.pic.twoD.ZigZag()
+        pushdep  = pyrunko.pic.twoD.BorisZigZag()
+
+        for tile in pytools.tiles_all(grids[0]):
+            pusher.solve(tile)
+            currint.solve(tile)
+        for tile in pytools.tiles_all(grids[1]):
+            pushdep.solve(tile)
+
+        for tile, tilef in zip(pytools.tiles_all(grids[0]), pytools.tiles_all(grids[1])):
+            for ispcs in range(Conf.Nspecies):
+                con  = tile.get_container(ispcs)
+                conb = tilef.get_container(ispcs)
+                self.assertEqual(con.size(), conb.size())
+
+                for dim in range(3):
+                    for x, xf in zip(con.loc(dim), conb.loc(dim)):
+                        self.assertAlmostEqual(x, xf, places=6)
+                    for u, uf in zip(con.vel(dim), conb.vel(dim)):
+                        self.assertAlmostEqual(u, uf, places=6)
+
+            # the separate path reconstructs the old location from the
+            # velocity; both agree up to float round-off
+            gs  = tile.get_grids()
+            gsf = tilef.get_grids()
+            for l in range(conf.NxMesh):
+                for m in range(conf.NyMesh):
+                    self.assertAlmostEqual(gs.jx[l,m,0], gsf.jx[l,m,0], places=5)
+                    self.assertAlmostEqual(gs.jy[l,m,0], gsf.jy[l,m,0], places=5)
+                    self.assertAlmostEqual(gs.jz[l,m,0], gsf.jz[l,m,0], places=5)
+
+
     def skip_test_filters(self):
         """ filter integration test with rest of the PIC functions"""
 
@@ -1767,3 +2075,644 @@ class PIC(unittest.TestCase):
 
 
 
+    def test_float_pushers(self):
+
+        # single precision pushers should follow their double precision
+        # counterparts up to float round-off
+        def setup_grid():
+            conf = Conf()
+            conf.twoD = True
+            conf.NxMesh = 5
+            conf.NyMesh = 5
+            conf.ppc = 3
+            conf.vel = 0.3
+            conf.update_bbox()
+
+            np.random.seed(1)
+            grid = pycorgi.twoD.Grid(conf.Nx, conf.Ny, conf.Nz)
+            grid.set_grid_lims(conf.xmin, conf.xmax, conf.ymin, conf.ymax)
+            pytools.pic.load_tiles(grid, conf)
+            insert_em(grid, conf, const_field)
+            pytools.pic.inject(grid, filler, density_profile, conf)
+
+            fintp = pyrunko.pic.twoD.LinearInterpolator()
+            for tile in pytools.tiles_all(grid):
+                tile.update_boundaries(grid)
+                fintp.solve(tile)
+
+            return grid
+
+        pairs = [
+            (pyrunko.pic.twoD.BorisPusher(),       pyrunko.pic.twoD.BorisPusherFloat()),
+            (pyrunko.pic.twoD.VayPusher(),         pyrunko.pic.twoD.VayPusherFloat()),
+            (pyrunko.pic.twoD.HigueraCaryPusher(), pyrunko.pic.twoD.HigueraCaryPusherFloat()),
+        ]
+
+        for pusher, pusherf in pairs:
+            grid  = setup_grid()
+            gridf = setup_grid()
+
+            for tile in pytools.tiles_all(grid):
+                pusher.solve(tile)
+            for tile in pytools.tiles_all(gridf):
+                pusherf.solve(tile)
+
+            for tile, tilef in zip(pytools.tiles_all(grid), pytools.tiles_all(gridf)):
+                for ispcs in range(Conf.Nspecies):
+                    con   = tile.get_container(ispcs)
+                    con32 = tilef.get_container(ispcs)
+                    self.assertEqual(con.size(), con32.size())
+
+                    for dim in range(3):
+                        for u, uf in zip(con.vel(dim), con32.vel(dim)):
+                            self.assertAlmostEqual(u, uf, delta=1.0e-4*max(1.0, abs(u)))
+                        for x, xf in zip(con.loc(dim), con32.loc(dim)):
+                            self.assertAlmostEqual(x, xf, delta=1.0e-4*max(1.0, abs(x)))
+
+    def test_analytic_ext_field(self):
+
+        # a constant analytic field function on top of the uniform external
+        # fields equals the sum of both as uniform fields
+        conf = Conf()
+        conf.twoD = True
+        conf.NxMesh = 5
+        conf.NyMesh = 5
+        conf.ppc = 3
+        conf.vel = 0.3
+        conf.update_bbox()
+
+        grids = []
+        for i in range(2):
+            np.random.seed(1)
+            grid = pycorgi.twoD.Grid(conf.Nx, conf.Ny, conf.Nz)
+            grid.set_grid_lims(conf.xmin, conf.xmax, conf.ymin, conf.ymax)
+            pytools.pic.load_tiles(grid, conf)
+            insert_em(grid, conf, const_field)
+            pytools.pic.inject(grid, filler, density_profile, conf)
+
+            fintp = pyrunko.pic.twoD.LinearInterpolator()
+            for tile in pytools.tiles_all(grid):
+                tile.update_boundaries(grid)
+                fintp.solve(tile)
+            grids.append(grid)
+
+        # field function adds E = (0.1, 0.2, 0.3) and B = (0.4, 0.5, 0.6)
+        analytic = pyrunko.pic.twoD.BorisPusherAnalytic()
+        analytic.ex_ext = 0.05
+        analytic.bz_ext = -0.1
+
+        boris = pyrunko.pic.twoD.BorisPusher()
+        boris.ex_ext, boris.ey_ext, boris.ez_ext = 0.15, 0.2, 0.3
+        boris.bx_ext, boris.by_ext, boris.bz_ext = 0.4, 0.5, 0.5
+
+        for tile in pytools.tiles_all(grids[0]):
+            analytic.solve(tile)
+        for tile in pytools.tiles_all(grids[1]):
+            boris.solve(tile)
+
+        for tile, tileb in zip(pytools.tiles_all(grids[0]), pytools.tiles_all(grids[1])):
+            for ispcs in range(Conf.Nspecies):
+                con  = tile.get_container(ispcs)
+                conb = tileb.get_container(ispcs)
+                self.assertEqual(con.size(), conb.size())
+                for dim in range(3):
+                    for u, ub in zip(con.vel(dim), conb.vel(dim)):
+                        self.assertAlmostEqual(u, ub, places=5)
+                    for x, xb in zip(con.loc(dim), conb.loc(dim)):
+                        self.assertAlmostEqual(x, xb, places=5)
+
+    def test_rgca_full_orbit_bin(self):
+
+        # particles outside the GCA validity region are pushed with Boris
+        conf = Conf()
+        conf.twoD = True
+        conf.NxMesh = 5
+        conf.NyMesh = 5
+        conf.ppc = 3
+        conf.vel = 0.3
+        conf.update_bbox()
+
+        grids = []
+        for i in range(2):
+            np.random.seed(1)
+            grid = pycorgi.twoD.Grid(conf.Nx, conf.Ny, conf.Nz)
+            grid.set_grid_lims(conf.xmin, conf.xmax, conf.ymin, conf.ymax)
+            pytools.pic.load_tiles(grid, conf)
+            insert_em(grid, conf, const_field)
+            pytools.pic.inject(grid, filler, density_profile, conf)
+
+            fintp = pyrunko.pic.twoD.LinearInterpolator()
+            for tile in pytools.tiles_all(grid):
+                tile.update_boundaries(grid)
+                fintp.solve(tile)
+            grids.append(grid)
+
+        # no particle satisfies |E| < 0 |B|; all go to the single-step Boris bin
+        rgca = pyrunko.pic.twoD.rGCAPusher()
+        rgca.full_orbit = True
+        rgca.gca_max_eb = 0.0
+        rgca.max_substeps = 1
+        boris = pyrunko.pic.twoD.BorisPusher()
+
+        for tile in pytools.tiles_all(grids[0]):
+            rgca.solve(tile)
+        for tile in pytools.tiles_all(grids[1]):
+            boris.solve(tile)
+
+        for tile, tileb in zip(pytools.tiles_all(grids[0]), pytools.tiles_all(grids[1])):
+            for ispcs in range(Conf.Nspecies):
+                con  = tile.get_container(ispcs)
+                conb = tileb.get_container(ispcs)
+                for dim in range(3):
+                    for u, ub in zip(con.vel(dim), conb.vel(dim)):
+                        self.assertAlmostEqual(u, ub, places=5)
+                    for x, xb in zip(con.loc(dim), conb.loc(dim)):
+                        self.assertAlmostEqual(x, xb, places=5)
+
+    def test_rgca_substep_bin(self):
+
+        # strongly magnetized orbits are pushed with up to max_substeps
+        # Boris sub-steps; compare against the scalar reference
+        conf = Conf()
+        conf.twoD = True
+        conf.NxMesh = 5
+        conf.NyMesh = 5
+        conf.ppc = 3
+        conf.update_bbox()
+
+        np.random.seed(1)
+        grid = pycorgi.twoD.Grid(conf.Nx, conf.Ny, conf.Nz)
+        grid.set_grid_lims(conf.xmin, conf.xmax, conf.ymin, conf.ymax)
+        pytools.pic.load_tiles(grid, conf)
+        insert_em(grid, conf, zero_field, zero_field=True)
+        pytools.pic.inject(grid, filler_speeds, density_profile, conf)
+
+        fintp = pyrunko.pic.twoD.LinearInterpolator()
+        for tile in pytools.tiles_all(grid):
+            tile.update_boundaries(grid)
+            fintp.solve(tile)
+
+        ext_e = [0.1, -0.05, 0.02]
+        ext_b = [0.1, 0.2, 0.5]
+
+        # no particle satisfies |E| < 0 |B|; all are in the full-orbit bins
+        rgca = pyrunko.pic.twoD.rGCAPusher()
+        rgca.full_orbit = True
+        rgca.gca_max_eb = 0.0
+        rgca.max_phase = 0.4
+        rgca.max_substeps = 3
+        rgca.ex_ext, rgca.ey_ext, rgca.ez_ext = ext_e
+        rgca.bx_ext, rgca.by_ext, rgca.bz_ext = ext_b
+
+        c = conf.cfl
+        for tile in pytools.tiles_all(grid):
+            for ispcs in range(Conf.Nspecies):
+                con = tile.get_container(ispcs)
+                qm = np.sign(con.q)/con.m
+
+                refs = []
+                nsteps = set()
+                for n in range(con.size()):
+                    u = [con.vel(dim)[n] for dim in range(3)]
+                    x = [con.loc(dim)[n] for dim in range(3)]
+                    e = [con.ex(n) + ext_e[0], con.ey(n) + ext_e[1], con.ez(n) + ext_e[2]]
+                    b = [con.bx(n) + ext_b[0], con.by(n) + ext_b[1], con.bz(n) + ext_b[2]]
+
+                    phase = abs(qm)*np.sqrt(np.dot(b, b))/(c*np.sqrt(1.0 + np.dot(u, u)))
+                    ns = max(1, min(rgca.max_substeps, int(np.ceil(phase/rgca.max_phase))))
+                    nsteps.add(ns)
+
+                    refs.append( boris_substeps(c, qm, u, x, e, b, ns, 2) )
+
+                # both the single-step and the sub-step bins are populated
+                self.assertEqual(sorted(nsteps), [1, 2, 3])
+
+                rgca.solve(tile)
+
+                for n, (u, x) in enumerate(refs):
+                    for dim in range(3):
+                        self.assertAlmostEqual(con.vel(dim)[n], u[dim], places=5)
+                        self.assertAlmostEqual(con.loc(dim)[n], x[dim], places=5)
+
+    def test_rgca_gca_split(self):
+
+        # particles are split between the GCA and the full-orbit bins;
+        # each bin should follow its own scalar pusher
+        conf = Conf()
+        conf.twoD = True
+        conf.NxMesh = 5
+        conf.NyMesh = 5
+        conf.ppc = 3
+        conf.update_bbox()
+
+        ext_e = [0.1, -0.05, 0.02]
+        ext_b = [0.1, 0.2, 0.5]
+
+        grids = []
+        for i in range(3):
+            np.random.seed(1)
+            grid = pycorgi.twoD.Grid(conf.Nx, conf.Ny, conf.Nz)
+            grid.set_grid_lims(conf.xmin, conf.xmax, conf.ymin, conf.ymax)
+            pytools.pic.load_tiles(grid, conf)
+            insert_em(grid, conf, zero_field, zero_field=True)
+            pytools.pic.inject(grid, filler_speeds, density_profile, conf)
+
+            fintp = pyrunko.pic.twoD.LinearInterpolator()
+            for tile in pytools.tiles_all(grid):
+                tile.update_boundaries(grid)
+                fintp.solve(tile)
+            grids.append(grid)
+
+        # split pusher; gyration phase per step ranges from ~0.3 to ~1.2
+        rgca = pyrunko.pic.twoD.rGCAPusher()
+        rgca.full_orbit = True
+        rgca.gca_min_phase = 0.7
+        rgca.max_substeps = 1
+
+        # references: GCA for all particles and plain Boris
+        gca = pyrunko.pic.twoD.rGCAPusher()
+        boris = pyrunko.pic.twoD.BorisPusher()
+
+        for pusher in [rgca, gca, boris]:
+            pusher.ex_ext, pusher.ey_ext, pusher.ez_ext = ext_e
+            pusher.bx_ext, pusher.by_ext, pusher.bz_ext = ext_b
+
+        # classify with the pre-push state
+        c = conf.cfl
+        bins = []
+        for tile in pytools.tiles_all(grids[0]):
+            for ispcs in range(Conf.Nspecies):
+                con = tile.get_container(ispcs)
+                qm = np.sign(con.q)/con.m
+
+                for n in range(con.size()):
+                    u = [con.vel(dim)[n] for dim in range(3)]
+                    e = [con.ex(n) + ext_e[0], con.ey(n) + ext_e[1], con.ez(n) + ext_e[2]]
+                    b = [con.bx(n) + ext_b[0], con.by(n) + ext_b[1], con.bz(n) + ext_b[2]]
+
+                    phase = abs(qm)*np.sqrt(np.dot(b, b))/(c*np.sqrt(1.0 + np.dot(u, u)))
+                    is_gca = np.dot(e, e) < rgca.gca_max_eb**2*np.dot(b, b) and phase > rgca.gca_min_phase
+                    bins.append(is_gca)
+
+        self.assertTrue(any(bins))
+        self.assertFalse(all(bins))
+
+        for pusher, grid in zip([rgca, gca, boris], grids):
+            for tile in pytools.tiles_all(grid):
+                pusher.solve(tile)
+
+        n0 = 0
+        for tile, tileg, tileb in zip(*[pytools.tiles_all(grid) for grid in grids]):
+            for ispcs in range(Conf.Nspecies):
+                con  = tile.get_container(ispcs)
+                cong = tileg.get_container(ispcs)
+                conb = tileb.get_container(ispcs)
+
+                for n in range(con.size()):
+                    ref = cong if bins[n0 + n] else conb
+                    for dim in range(3):
+                        self.assertAlmostEqual(con.vel(dim)[n], ref.vel(dim)[n], places=5)
+                        self.assertAlmostEqual(con.loc(dim)[n], ref.loc(dim)[n], places=5)
+                n0 += con.size()
+
+    def test_species_subcycling(self):
+
+        # sub-cycled species moves only on every N:th lap by N steps and
+        # deposits the mean current of that push on every lap
+        conf = Conf()
+        conf.twoD = True
+        conf.NxMesh = 10
+        conf.NyMesh = 10
+        conf.subcycle = [4]
+        conf.cfl = 0.2 # subcycle*cfl < 1
+        conf.update_bbox()
+
+        grid = pycorgi.twoD.Grid(conf.Nx, conf.Ny, conf.Nz)
+        grid.set_grid_lims(conf.xmin, conf.xmax, conf.ymin, conf.ymax)
+        pytools.pic.load_tiles(grid, conf)
+        insert_em(grid, conf, zero_field, zero_field=True)
+
+        tile = grid.get_tile(0,0)
+        container = tile.get_container(0)
+        self.assertEqual(container.subcycle, 4)
+
+        ux, uy = 0.1, 0.05
+        container.add_particle([3.2, 4.3, 0.5], [ux, uy, 0.0], 1.0)
+
+        # displacement per lap
+        dx1 = ux*conf.cfl/np.sqrt(1.0 + ux*ux + uy*uy)
+
+        fintp   = pyrunko.pic.twoD.LinearInterpolator()
+        pusher  = pyrunko.pic.twoD.BorisPusher()
+        currint = pyrunko.pic.twoD.ZigZag()
+
+        # averaged fields are only available after accumulation
+        with self.assertRaises(RuntimeError):
+            fintp.solve(tile)
+
+        for lap in range(8):
+            tile.set_subcycle_lap(lap)
+            tile.accumulate_subcycle_fields()
+
+            fintp.solve(tile)
+            pusher.solve(tile)
+            currint.solve(tile)
+
+            npush = (lap + 1)//4
+            self.assertEqual(container.is_active(), lap % 4 == 3)
+            self.assertAlmostEqual(container.loc(0)[0], 3.2 + 4*npush*dx1, places=5)
+
+            gs = tile.get_grids()
+            jx = sum(gs.jx[l,m,0] for l in range(conf.NxMesh) for m in range(conf.NyMesh))
+            jx_ref = container.q*dx1 if npush > 0 else 0.0
+            self.assertAlmostEqual(jx, jx_ref, places=5)
+
+
+    def test_species_subcycling_restart(self):
+
+        # the sub-cycle average is not restart state; a tile that starts
+        # mid sub-cycle averages over the laps it has actually seen
+        conf = Conf()
+        conf.twoD = True
+        conf.NxMesh = 10
+        conf.NyMesh = 10
+        conf.subcycle = [4]
+        conf.update_bbox()
+
+        grid = pycorgi.twoD.Grid(conf.Nx, conf.Ny, conf.Nz)
+        grid.set_grid_lims(conf.xmin, conf.xmax, conf.ymin, conf.ymax)
+        pytools.pic.load_tiles(grid, conf)
+        insert_em(grid, conf, const_field)
+
+        tile = grid.get_tile(0,0)
+        container = tile.get_container(0)
+        container.add_particle([3.2, 4.3, 0.5], [0.0, 0.0, 0.0], 1.0)
+
+        fintp = pyrunko.pic.twoD.LinearInterpolator()
+        for lap in [6, 7]:
+            tile.set_subcycle_lap(lap)
+            tile.accumulate_subcycle_fields()
+        self.assertTrue(container.is_active())
+
+        fintp.solve(tile)
+        self.assertAlmostEqual(container.ex(0), 1.0, places=5)
+
+        # pushes of a full cell or more per sub-cycle are rejected
+        tile.cfl = 0.25
+        currint = pyrunko.pic.twoD.ZigZag()
+        with self.assertRaises(ValueError):
+            currint.solve(tile)
+
+
+    def test_ghost_tile(self):
+
+        # ghost tile as a neighbour of full tiles: fields are read into the
+        # halos and the (empty) particle messages are transferred
+        conf = Conf()
+        conf.twoD = True
+        conf.Nx = 3
+        conf.Ny = 1
+        conf.NxMesh = 5
+        conf.NyMesh = 5
+        conf.update_bbox()
+
+        grid = pycorgi.twoD.Grid(conf.Nx, conf.Ny, conf.Nz)
+        grid.set_grid_lims(conf.xmin, conf.xmax, conf.ymin, conf.ymax)
+
+        for i in [0, 2]:
+            tile = pyrunko.pic.twoD.Tile(conf.NxMesh, conf.NyMesh, conf.NzMesh)
+            pytools.pic.initialize_tile(tile, (i,0,0), grid, conf)
+            grid.add_tile(tile, (i,0))
+
+        ghost = pyrunko.pic.twoD.GhostTile(conf.NxMesh, conf.NyMesh, conf.NzMesh, conf.Nspecies)
+        pytools.pic.initialize_ghost_tile(ghost, (1,0,0), grid, conf)
+        grid.add_tile(ghost, (1,0))
+
+        ghost = grid.get_tile(1,0)
+        self.assertEqual(ghost.Nspecies(), 1)
+        self.assertFalse(ghost.get_grids().has_rho())
+
+        gs = ghost.get_grids()
+        for l in range(conf.NxMesh):
+            for m in range(conf.NyMesh):
+                gs.ex[l,m,0] = 2.0
+
+        tile = grid.get_tile(0,0)
+        tile.update_boundaries(grid)
+        self.assertEqual(tile.get_grids().ex[conf.NxMesh, 2, 0], 2.0)
+
+        # particle leaving tile 0 over the periodic boundary goes to tile 2
+        # while both read the (empty) messages of the ghost tile
+        tile.get_container(0).add_particle([-0.5, 2.5, 0.5], [-0.1, 0.0, 0.0], 1.0)
+
+        ghost.unpack_incoming_particles()
+        ghost.check_outgoing_particles()
+
+        for i in [0, 2]:
+            grid.get_tile(i,0).check_outgoing_particles()
+        for i in [0, 2]:
+            grid.get_tile(i,0).get_incoming_particles(grid)
+        for i in [0, 2]:
+            grid.get_tile(i,0).delete_transferred_particles()
+        ghost.delete_all_particles()
+        ghost.shrink_to_fit_all_particles()
+
+        self.assertEqual(ghost.number_of_particles(0), 0)
+        self.assertEqual(len(grid.get_tile(0,0).get_container(0).loc(0)), 0)
+
+        container = grid.get_tile(2,0).get_container(0)
+        self.assertEqual(len(container.loc(0)), 1)
+        self.assertAlmostEqual(container.loc(0)[0], 14.5, places=5)
+
+    def test_ghost_tile_messages(self):
+
+        # particles received by a ghost tile at the upper grid edge flow
+        # into its local neighbours; the message is longer than the first
+        # (fixed-size) one so that the extra message is appended to it
+        conf = Conf()
+        conf.twoD = True
+        conf.Nx = 3
+        conf.Ny = 1
+        conf.NxMesh = 5
+        conf.NyMesh = 5
+        conf.update_bbox()
+
+        grid = pycorgi.twoD.Grid(conf.Nx, conf.Ny, conf.Nz)
+        grid.set_grid_lims(conf.xmin, conf.xmax, conf.ymin, conf.ymax)
+
+        for i in [0, 1]:
+            tile = pyrunko.pic.twoD.Tile(conf.NxMesh, conf.NyMesh, conf.NzMesh)
+            pytools.pic.initialize_tile(tile, (i,0,0), grid, conf)
+            grid.add_tile(tile, (i,0))
+
+        ghost = pyrunko.pic.twoD.GhostTile(conf.NxMesh, conf.NyMesh, conf.NzMesh, conf.Nspecies)
+        pytools.pic.initialize_ghost_tile(ghost, (2,0,0), grid, conf)
+        grid.add_tile(ghost, (2,0))
+        ghost = grid.get_tile(2,0)
+
+        # the owning rank of the ghost packs its outflowing particles:
+        # odd ones go to tile 1, even ones over the periodic edge to tile 0
+        remote = pyrunko.pic.twoD.Tile(conf.NxMesh, conf.NyMesh, conf.NzMesh)
+        pytools.pic.initialize_tile(remote, (2,0,0), grid, conf)
+
+        N = 5000 # > first_message_size = 4096
+        container = remote.get_container(0)
+        for n in range(N):
+            x = 9.5 if n % 2 else 15.25
+            container.add_particle([x, 2.5, 0.5], [0.0, 0.0, 0.0], 1.0)
+
+        remote.check_outgoing_particles()
+        remote.pack_outgoing_particles()
+        ghost.receive_particles(remote)
+
+        ghost.unpack_incoming_particles()
+        self.assertEqual(ghost.number_of_particles(0), N)
+        ghost.check_outgoing_particles()
+
+        for i in [0, 1]:
+            grid.get_tile(i,0).check_outgoing_particles()
+        for i in [0, 1]:
+            grid.get_tile(i,0).get_incoming_particles(grid)
+        for i in [0, 1]:
+            grid.get_tile(i,0).delete_transferred_particles()
+        ghost.delete_all_particles()
+        self.assertEqual(ghost.number_of_particles(0), 0)
+
+        # wrapped by the global box length
+        x0 = np.array(grid.get_tile(0,0).get_container(0).loc(0))
+        self.assertEqual(len(x0), N//2)
+        np.testing.assert_allclose(x0, 0.25, rtol=1e-6)
+
+        x1 = np.array(grid.get_tile(1,0).get_container(0).loc(0))
+        self.assertEqual(len(x1), N//2)
+        np.testing.assert_allclose(x1, 9.5, rtol=1e-6)
+
+    def test_conductor_background(self):
+
+        # tabulated background is the analytic dipole and follows the
+        # conductor parameters
+        tile = pyrunko.emf.threeD.Tile(4, 5, 6)
+        mins = [3.0, -2.0, 1.0]
+        tile.set_tile_mins(mins)
+        tile.set_tile_maxs([mins[0] + 4, mins[1] + 5, mins[2] + 6])
+        self.assertFalse(tile.has_background())
+
+        cond = pyrunko.emf.threeD.Conductor()
+        cond.B0       = 3.0
+        cond.period   = 40.0
+        cond.chi_mu   = 0.3
+        cond.chi_om   = 0.1
+        cond.phase_mu = 0.2
+        cond.phase_om = 0.4
+        cond.cenx, cond.ceny, cond.cenz = -4.0, -3.0, -5.0
+
+        for lap in range(2):
+            cond.tabulate_background(tile)
+            self.assertTrue(tile.has_background())
+
+            bg = tile.get_background()
+            for k in range(-3, 6+3):
+                for j in range(-3, 5+3):
+                    for i in range(-3, 4+3):
+                        ref = conductor_dipole(cond, mins, i, j, k)
+                        for comp, val in ref.items():
+                            self.assertAlmostEqual(
+                                getattr(bg, comp)[i,j,k], val, delta=1.0e-5*max(1.0, abs(val)))
+
+            # rotated dipole and a new period need a new tabulation
+            cond.phase_mu += 0.7
+            cond.period = 25.0
+
+    def test_conductor_background_tiles(self):
+
+        # only tiles with a boundary region around the star or the box
+        # edges keep a background tabulation
+        cond = pyrunko.emf.threeD.Conductor()
+        cond.Nx, cond.Ny, cond.Nz = 100, 100, 100
+        cond.cenx, cond.ceny, cond.cenz = 50.0, 50.0, 0.0
+        cond.radius = 10.0
+        cond.period = 40.0
+
+        for mins, needs in [([40.0, 40.0, 40.0], False), ([48.0, 48.0, 0.0], True)]:
+            tile = pyrunko.emf.threeD.Tile(5, 5, 5)
+            tile.set_tile_mins(mins)
+            tile.set_tile_maxs([m + 5 for m in mins])
+
+            # insertion alone does not keep it
+            cond.insert_em(tile)
+            self.assertFalse(tile.has_background())
+
+            cond.update_b(tile)
+            self.assertEqual(tile.has_background(), needs)
+            cond.update_e(tile)
+            self.assertEqual(tile.has_background(), needs)
+
+            tile.release_background()
+            self.assertFalse(tile.has_background())
+
+    def test_pulsar_background(self):
+
+        # pulsar pusher adding the tabulated background to empty fields
+        # follows one reading the same dipole from the dynamic fields
+        conf = Conf()
+        conf.threeD = True
+        conf.NxMesh = 6
+        conf.NyMesh = 6
+        conf.NzMesh = 6
+        conf.update_bbox()
+        conf.zmin = 0.0
+        conf.zmax = conf.NzMesh
+
+        grids = []
+        for n in range(2):
+            grid = pycorgi.threeD.Grid(conf.Nx, conf.Ny, conf.Nz)
+            grid.set_grid_lims(conf.xmin, conf.xmax, conf.ymin, conf.ymax, conf.zmin, conf.zmax)
+            pytools.pic.load_tiles(grid, conf)
+
+            container = grid.get_tile(0,0,0).get_container(0)
+            container.add_particle([2.3, 3.4, 2.7], [ 0.1, -0.2, 0.05], 1.0)
+            container.add_particle([3.6, 2.2, 3.1], [-0.3,  0.1, 0.20], 1.0)
+            grids.append(grid)
+
+        tile0 = grids[0].get_tile(0,0,0)
+        tile1 = grids[1].get_tile(0,0,0)
+
+        cond = pyrunko.emf.threeD.Conductor()
+        cond.B0       = 50.0
+        cond.period   = 60.0
+        cond.chi_mu   = 0.3
+        cond.phase_mu = 0.2
+        cond.cenx, cond.ceny, cond.cenz = -3.0, -2.0, -4.0
+
+        pushers = []
+        for add_background in [True, False]:
+            pusher = pyrunko.pic.threeD.PulsarPusher()
+            pusher.radius = 2.0
+            pusher.cenx, pusher.ceny, pusher.cenz = cond.cenx, cond.ceny, cond.cenz
+            pusher.period = cond.period
+            pusher.add_background = add_background
+            pushers.append(pusher)
+
+        for lap in range(2):
+            cond.tabulate_background(tile0)
+
+            gs = tile1.get_grids()
+            for k in range(-3, conf.NzMesh+3):
+                for j in range(-3, conf.NyMesh+3):
+                    for i in range(-3, conf.NxMesh+3):
+                        for comp, val in conductor_dipole(cond, [0.0, 0.0, 0.0], i, j, k).items():
+                            getattr(gs, comp)[i,j,k] = val
+
+            pushers[0].solve(tile0)
+            pushers[1].solve(tile1)
+
+            con0 = tile0.get_container(0)
+            con1 = tile1.get_container(0)
+            for dim in range(3):
+                for u0, u1 in zip(con0.vel(dim), con1.vel(dim)):
+                    self.assertAlmostEqual(u0, u1, delta=1.0e-4*max(1.0, abs(u1)))
+                for x0, x1 in zip(con0.loc(dim), con1.loc(dim)):
+                    self.assertAlmostEqual(x0, x1, delta=1.0e-5*max(1.0, abs(x1)))
+
+            # rotated dipole; the background is re-tabulated on the next lap
+            cond.phase_mu += 0.5
@@ -0,0 +1,114 @@
+from mpi4py import MPI
+import unittest
+import json
+import os
+
+import pyrunko
+
+
+class Tracing(unittest.TestCase):
+
+    outdir = "trace_test/"
+
+    def setUp(self):
+        if not os.path.exists(self.outdir):
+            os.makedirs(self.outdir)
+
+        self.tr = pyrunko.tools.trace
+        self.tr.clear()
+        self.tr.reset_epoch()
+        self.tr.enable()
+
+    def tearDown(self):
+        self.tr.disable()
+        self.tr.clear()
+
+    # python-issued begin/end pairs and C++ scopes end up in the same dump
+    def test_dump(self):
+
+        self.tr.begin("step", "stage")
+        tile = pyrunko.emf.twoD.Tile(5, 5, 1)
+        tile.clear_current()
+        self.tr.end()
+
+        self.assertEqual(self.tr.size(), 2)
+
+        fname = self.outdir + "trace_0.json"
+        self.tr.dump(fname, 0)
+
+        with open(fname, "r") as f:
+            data = json.load(f)
+
+        events = [e for e in data["traceEvents"] if e["ph"] == "X"]
+        names = [e["name"] for e in events]
+        self.assertEqual(len(events), 2)
+        self.assertTrue("step" in names)
+        self.assertTrue("emf::Tile<D>::clear_current" in names)
+
+        # kernel is nested inside the stage
+        step = events[names.index("step")]
+        kern = events[names.index("emf::Tile<D>::clear_current")]
+        self.assertTrue(step["ts"] <= kern["ts"])
+        self.assertTrue(kern["ts"] + kern["dur"] <= step["ts"] + step["dur"])
+
+    # oldest events are dropped once the ring buffer is full
+    def test_ring_buffer(self):
+        self.tr.set_capacity(4)
+
+        for i in range(10):
+            self.tr.begin("ev{}".format(i), "stage")
+            self.tr.end()
+
+        self.assertEqual(self.tr.size(), 4)
+
+        fname = self.outdir + "trace_ring.json"
+        self.tr.dump(fname, 0)
+        with open(fname, "r") as f:
+            data = json.load(f)
+
+        names = [e["name"] for e in data["traceEvents"] if e["ph"] == "X"]
+        self.assertEqual(names, ["ev6", "ev7", "ev8", "ev9"])
+
+        self.tr.set_capacity(1 << 16)
+
+    def test_disabled(self):
+        self.tr.disable()
+        self.tr.begin("step", "stage")
+        self.tr.end()
+        self.assertEqual(self.tr.size(), 0)
+
+
+class PerfCounters(unittest.TestCase):
+
+    def tearDown(self):
+        pyrunko.tools.perf.disable()
+        pyrunko.tools.perf.clear()
+
+    # counters are aggregated per kernel if the OS grants access to them
+    def test_report(self):
+        perf = pyrunko.tools.perf
+        perf.clear()
+
+        names = perf.counter_names()
+        self.assertTrue("cycles" in names)
+
+        if not perf.enable():
+            self.skipTest("perf_event_open not permitted")
+
+        tile = pyrunko.emf.twoD.Tile(5, 5, 1)
+        for lap in range(3):
+            tile.clear_current()
+
+        rep = perf.report()
+        keys = [k for k in rep if k.startswith("emf::Tile<D>::clear_current")]
+        self.assertEqual(len(keys), 1)
+
+        r = rep[keys[0]]
+        self.assertEqual(r["calls"], 3)
+        for name in names:
+            self.assertTrue(name in r)
+            self.assertTrue(r[name] >= 0.0)
+
+
+if __name__ == "__main__":
+    unittest.main()
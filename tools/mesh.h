@@ -20,13 +20,98 @@
 namespace toolbox {
 
 
+/// x-fastest storage of the (Nx+2H)(Ny+2H)(Nz+2H) cube with halo padding
+struct LinearLayout
+{
+  DEVCALLABLE
+  static inline size_t count(int Nx, int Ny, int Nz, int H) {
+    return size_t(Nx + 2*H)*(Ny + 2*H)*(Nz + 2*H);
+  }
+
+  DEVCALLABLE
+  static inline size_t indx(int i, int j, int k, int Nx, int Ny, int /*Nz*/, int H) {
+    return i + H + (Nx + 2*H)*( (j + H) + (Ny + 2*H)*(k + H));
+  }
+
+  DEVCALLABLE
+  static inline size_t step(int dim, int /*c*/, int Nx, int Ny, int /*Nz*/, int H) {
+    return dim == 0 ? 1 : dim == 1 ? size_t(Nx + 2*H) : size_t(Nx + 2*H)*(Ny + 2*H);
+  }
+};
+
+
+/// storage in bricks of B^3 cells (B a power of two)
+//
+// Cells of a brick are contiguous (x-fastest) and bricks are stored
+// x-fastest over the padded mesh. A trilinear stencil then mostly falls
+// into one brick instead of touching a separate row per (j,k) pair.
+// Collapsed dimensions (extent 1) are not bricked, so that a 2D mesh is
+// stored in B^2 tiles of the x-y plane. The padded extents are rounded up
+// to whole bricks.
+//
+// Only the bricked collocated gather cache of pic::Tile uses this layout;
+// the emf::Grids field and current meshes are swept with fixed strides by
+// the FDTD, filter and depositer kernels and stay linear.
+template<int B>
+struct BrickLayout
+{
+  static_assert(B > 0 && (B & (B-1)) == 0, "brick size must be a power of two");
+
+  /// log2 of the brick size
+  static constexpr int S = [](){ int s = 0; while((1 << s) < B) s++; return s; }();
+
+  DEVCALLABLE
+  static inline int shift(int N) { return N > 1 ? S : 0; }
+
+  DEVCALLABLE
+  static inline size_t bricks(int N, int H) { 
+    return (N + 2*H + (1 << shift(N)) - 1) >> shift(N); 
+  }
+
+  DEVCALLABLE
+  static inline size_t count(int Nx, int Ny, int Nz, int H) {
+    return (bricks(Nx,H)*bricks(Ny,H)*bricks(Nz,H)) << (shift(Nx) + shift(Ny) + shift(Nz));
+  }
+
+  DEVCALLABLE
+  static inline size_t indx(int i, int j, int k, int Nx, int Ny, int Nz, int H) {
+    const int sx = shift(Nx), sy = shift(Ny), sz = shift(Nz);
+    const unsigned ii = i + H, jj = j + H, kk = k + H;
+
+    const size_t brick = ((kk >> sz)*bricks(Ny,H) + (jj >> sy))*bricks(Nx,H) + (ii >> sx);
+    const size_t cell  = (((kk & ((1u << sz) - 1)) << sy | (jj & ((1u << sy) - 1))) << sx) 
+                       | (ii & ((1u << sx) - 1));
+
+    return (brick << (sx + sy + sz)) | cell;
+  }
+
+  DEVCALLABLE
+  static inline size_t step(int dim, int c, int Nx, int Ny, int Nz, int H) {
+    const int sx = shift(Nx), sy = shift(Ny), sz = shift(Nz);
+
+    // cell stride inside a brick, and brick stride
+    size_t cs = 1, bs = size_t(1) << (sx + sy + sz);
+    int s = sx;
+    if(dim >= 1) { cs <<= sx;      bs *= bricks(Nx,H); s = sy; }
+    if(dim >= 2) { cs <<= sy;      bs *= bricks(Ny,H); s = sz; }
+
+    // last cell of a brick steps to the first cell of the next brick
+    const int last = (1 << s) - 1;
+    return ((c + H) & last) != last ? cs : bs - last*cs;
+  }
+};
+
+
 /*! \brief simple dense 3D simulation mesh class
  *
  * Internally this is just a thin wrapper around STL vector class.
  *
+ * Storage order is set by the layout L (LinearLayout or BrickLayout); 
+ * element-wise arithmetics between meshes assume equal layouts. Kernels 
+ * that step through data() with fixed strides need the linear layout.
  */
 
-template <typename T, int H> 
+template <typename T, int H, typename L = LinearLayout> 
 class Mesh 
 {
 
@@ -80,7 +165,13 @@ class Mesh
 #endif
 
       //return indx;
-      return i + H + (Nx + 2*H)*( (j + H) + (Ny + 2*H)*(k + H));
+      return L::indx(i, j, k, Nx, Ny, Nz, H);
+    }
+
+    /// flat index increment from coordinate c to c+1 along dimension dim
+    DEVCALLABLE
+    inline size_t step(int dim, int c) const {
+      return L::step(dim, c, Nx, Ny, Nz, H);
     }
 
     /// 1D index 
@@ -131,7 +222,7 @@ class Mesh
       Nz(Nz)
       //mat( (Nx + 2*H)*(Ny + 2*H)*(Nz + 2*H) )
     {
-      alloc( (Nx + 2*H)*(Ny + 2*H)*(Nz + 2*H));
+      alloc( L::count(Nx, Ny, Nz, H) );
       try {
         //mat.resize( (Nx + 2*H)*(Ny + 2*H)*(Nz + 2*H) ); //automatically done at construction
         //std::fill(ptr, ptr+count, T() ); // fill with zeros
@@ -282,7 +373,7 @@ class Mesh
       Nx = Nx_in;
       Ny = Ny_in;
       Nz = Nz_in;
-      alloc( (Nx + 2*H)*(Ny + 2*H)*(Nz + 2*H) );
+      alloc( L::count(Nx, Ny, Nz, H) );
 
       int q = 0;
       for(int k=0; k<int(Nz); k++)
@@ -308,24 +399,24 @@ class Mesh
     //=
     //Mesh& operator=(const Mesh<T, H>& rhs);
 
-    template<int H2>
-    Mesh& operator=(const Mesh<T, H2>& rhs);
+    template<int H2, typename L2>
+    Mesh& operator=(const Mesh<T,H2,L2>& rhs);
 
 
     // scalar assignment
     Mesh& operator=(const T& rhs);
 
     //+=
-    Mesh& operator+=(const Mesh<T, H>& rhs);
+    Mesh& operator+=(const Mesh<T,H,L>& rhs);
 
-    template<int H2>
-    Mesh& operator+=(const Mesh<T, H2>& rhs);
+    template<int H2, typename L2>
+    Mesh& operator+=(const Mesh<T,H2,L2>& rhs);
 
     //-=
-    Mesh& operator-=(const Mesh<T, H>& rhs);
+    Mesh& operator-=(const Mesh<T,H,L>& rhs);
 
-    template<int H2>
-    Mesh& operator-=(const Mesh<T, H2>& rhs);
+    template<int H2, typename L2>
+    Mesh& operator-=(const Mesh<T,H2,L2>& rhs);
 
     //*=
     Mesh& operator*=(const T& rhs);
@@ -336,8 +427,8 @@ class Mesh
 
     /// Validate that two grids match
     // TODO: unify index testing; use assert() ?
-    template<int H2>
-    void validateDims(const Mesh<T,H2>& rhs) {
+    template<int H2, typename L2>
+    void validateDims(const Mesh<T,H2,L2>& rhs) {
       //if(this->Nx != rhs.Nx) throw std::range_error ("x dimensions do not match");
       //if(this->Ny != rhs.Ny) throw std::range_error ("y dimensions do not match");
       //if(this->Nz != rhs.Nz) throw std::range_error ("z dimensions do not match");
@@ -355,9 +446,9 @@ class Mesh
 //--------------------------------------------------
 
 /// = with differing halo size
-template<typename T, int H>
-template <int H2>
-inline Mesh<T,H>& Mesh<T,H>::operator=(const Mesh<T,H2>& rhs) {
+template<typename T, int H, typename L>
+template <int H2, typename L2>
+inline Mesh<T,H,L>& Mesh<T,H,L>::operator=(const Mesh<T,H2,L2>& rhs) {
   validateDims(rhs);
   //for(size_t i=0; i<this->mat.size(); i++) this->mat[i] = rhs.mat[i];
 
@@ -373,8 +464,8 @@ inline Mesh<T,H>& Mesh<T,H>::operator=(const Mesh<T,H2>& rhs) {
 }
 
 /// + with same halo size
-template <class T, int H>
-inline Mesh<T,H>& Mesh<T,H>::operator=(const T& rhs) {
+template <class T, int H, typename L>
+inline Mesh<T,H,L>& Mesh<T,H,L>::operator=(const T& rhs) {
   // overwriting internal container with a scalar
   for(size_t i=0; i<this->size(); i++) {
     this->ptr[i] = rhs;
@@ -383,8 +474,8 @@ inline Mesh<T,H>& Mesh<T,H>::operator=(const T& rhs) {
 }
 
 
-template<typename T, int H>
-inline Mesh<T,H>& Mesh<T,H>::operator+=(const Mesh<T,H>& rhs) {
+template<typename T, int H, typename L>
+inline Mesh<T,H,L>& Mesh<T,H,L>::operator+=(const Mesh<T,H,L>& rhs) {
   validateDims(rhs);
   for(size_t i=0; i<this->size(); i++) this->ptr[i] += rhs.ptr[i];
 
@@ -400,9 +491,9 @@ inline Mesh<T,H>& Mesh<T,H>::operator+=(const Mesh<T,H>& rhs) {
   return *this;
 }
 
-template<typename T, int H>
-template <int H2>
-inline Mesh<T,H>& Mesh<T,H>::operator+=(const Mesh<T,H2>& rhs) {
+template<typename T, int H, typename L>
+template <int H2, typename L2>
+inline Mesh<T,H,L>& Mesh<T,H,L>::operator+=(const Mesh<T,H2,L2>& rhs) {
   validateDims(rhs);
   //for(size_t i=0; i<this->mat.size(); i++) this->mat[i] += rhs.mat[i];
 
@@ -418,8 +509,8 @@ inline Mesh<T,H>& Mesh<T,H>::operator+=(const Mesh<T,H2>& rhs) {
 }
 
 
-template<typename T, int H>
-inline Mesh<T,H>& Mesh<T,H>::operator-=(const Mesh<T,H>& rhs) {
+template<typename T, int H, typename L>
+inline Mesh<T,H,L>& Mesh<T,H,L>::operator-=(const Mesh<T,H,L>& rhs) {
   validateDims(rhs);
 
   // purely vectorized version
@@ -439,9 +530,9 @@ inline Mesh<T,H>& Mesh<T,H>::operator-=(const Mesh<T,H>& rhs) {
 }
 
 // -= for differing halos
-template<typename T, int H>
-template <int H2>
-inline Mesh<T,H>& Mesh<T,H>::operator-=(const Mesh<T,H2>& rhs) {
+template<typename T, int H, typename L>
+template <int H2, typename L2>
+inline Mesh<T,H,L>& Mesh<T,H,L>::operator-=(const Mesh<T,H2,L2>& rhs) {
   validateDims(rhs);
   //for(size_t i=0; i<this->mat.size(); i++) this->mat[i] -= rhs.mat[i];
 
@@ -456,16 +547,16 @@ inline Mesh<T,H>& Mesh<T,H>::operator-=(const Mesh<T,H2>& rhs) {
   return *this;
 }
 
-template <class T, int H>
-inline Mesh<T,H>& Mesh<T,H>::operator*=(const T& rhs) {
+template <class T, int H, typename L>
+inline Mesh<T,H,L>& Mesh<T,H,L>::operator*=(const T& rhs) {
   for(size_t i=0; i<this->size(); i++) {
     this->ptr[i] *= rhs;
   }
   return *this;
 }
 
-template <class T, int H>
-inline Mesh<T,H>& Mesh<T,H>::operator/=(const T& rhs) {
+template <class T, int H, typename L>
+inline Mesh<T,H,L>& Mesh<T,H,L>::operator/=(const T& rhs) {
   for(size_t i=0; i<this->size(); i++) {
     this->ptr[i] /= rhs;
   }
@@ -475,28 +566,28 @@ inline Mesh<T,H>& Mesh<T,H>::operator/=(const T& rhs) {
 
 // Array arithmetics 
 //-------------------------------------------------- 
-template <class T, int H, int H2>
-inline Mesh<T,H> operator+(Mesh<T,H> lhs, const Mesh<T,H2>& rhs) {
+template <class T, int H, typename L, int H2, typename L2>
+inline Mesh<T,H,L> operator+(Mesh<T,H,L> lhs, const Mesh<T,H2,L2>& rhs) {
   lhs += rhs;
   return lhs;
 }
 
-template <class T, int H, int H2>
-inline Mesh<T,H> operator-(Mesh<T,H> lhs, const Mesh<T,H2>& rhs) {
+template <class T, int H, typename L, int H2, typename L2>
+inline Mesh<T,H,L> operator-(Mesh<T,H,L> lhs, const Mesh<T,H2,L2>& rhs) {
   lhs -= rhs;
   return lhs;
 }
 
 // Single value operators
 //-------------------------------------------------- 
-template <class T, int H>
-inline Mesh<T,H> operator*(Mesh<T,H> lhs, const T& rhs) {
+template <class T, int H, typename L>
+inline Mesh<T,H,L> operator*(Mesh<T,H,L> lhs, const T& rhs) {
   lhs *= rhs;
   return lhs;
 }
 
-template <class T, int H>
-inline Mesh<T,H> operator/(Mesh<T,H> lhs, const T& rhs) {
+template <class T, int H, typename L>
+inline Mesh<T,H,L> operator/(Mesh<T,H,L> lhs, const T& rhs) {
   lhs /= rhs;
   return lhs;
 }